@@ -14,7 +14,6 @@
 #include <Adafruit_GFX.h>    // Core graphics library
 #include <Adafruit_ST7789.h> // Hardware-specific library for ST7789
 #include <SPI.h>
-#include <ArduinoJson.h>
 
 // Phase 2 Component-Based UI Framework  
 #include "src/config/DisplayConfig.h"
@@ -23,7 +22,12 @@
 #include "src/ui/core/Component.h"
 #include "src/ui/core/Screen.h"
 #include "src/ui/core/ScreenManager.h"
+#include "src/ui/core/FrameScheduler.h"
+#include "src/ui/core/RenderManager.h"
 #include "src/ui/core/DisplayUtils.h"
+#include "src/ui/core/DisplayDriver.h"
+#include "src/ui/core/RenderProfiler.h"
+#include "src/ui/core/OverdrawAnalyzer.h"
 #include "src/ui/components/MenuItem.h"
 #include "src/ui/components/MenuContainer.h"
 #include "src/ui/screens/MainMenuScreen.h"
@@ -34,10 +38,21 @@
 #include "src/hardware/LED.h"
 #include "src/ui/core/InputRouter.h"
 #include "src/ringtones/RingtonePlayer.h"
+#include "src/ringtones/ToneSequencer.h"
 #include "src/mqtt/MQTTClient.h"
+#include "src/mqtt/JsonFieldExtractor.h"
+#include "src/mqtt/AlertWire.h"
+#include "src/mqtt/AlertQueue.h"
+#include "src/mqtt/AlertDeduper.h"
+#include "src/mqtt/AlertStorm.h"
+#include "src/mqtt/RedeliveryFilter.h"
+#include "src/mqtt/WifiCache.h"
+#include "src/mqtt/Telemetry.h"
+#include "src/storage/AlertLog.h"
+#include "src/power/PowerManager.h"
 
-// Use dedicated hardware SPI pins
-Adafruit_ST7789 tft = Adafruit_ST7789(TFT_CS, TFT_DC, TFT_RST);
+// Use dedicated hardware SPI pins (ST7789 plus clipping and hardware scroll)
+DisplayDriver tft(TFT_CS, TFT_DC, TFT_RST);
 
 // Phase 2 Component-Based UI Framework
 ScreenManager* screenManager;
@@ -48,29 +63,210 @@ ButtonManager buttonManager;
 InputRouter* inputRouter;
 LED statusLed;
 
-static void onMqttMessage(char* topic, uint8_t* payload, unsigned int length) {
-  // Copy payload to null-terminated buffer
-  // Increased buffer size to handle large Sentry messages
-  static char buffer[2048];
-  unsigned int copyLen = (length < sizeof(buffer) - 1) ? length : (sizeof(buffer) - 1);
-  memcpy(buffer, payload, copyLen);
-  buffer[copyLen] = '\0';
+// Alert fields pulled out of the Sentry payload. The extractor is PubSubClient's
+// payload stream, so it has seen every byte by the time the callback runs,
+// however large the message (the callback itself only gets the first 256).
+static char alertTitle[64];
+static char alertMessage[96];
+static char alertTimestamp[24];
+static char alertProject[24];
+static char alertLevel[12];
+static char alertId[48];
+static char alertPriority[12];
+static JsonFieldExtractor alertFields;
+static int titleField, messageField, timestampField, projectField, levelField, idField, priorityField;
+
+// Timer wake handled in the background: no screens exist, alerts go
+// straight to the flash log
+static bool backgroundWake = false;
+static uint16_t backgroundAlerts = 0;
+
+// Pop the notification up unless it is already showing
+static void showNotification() {
+  ScreenManager* manager = GlobalScreenManager::getInstance();
+  if (manager && manager->getCurrentScreen() != alertNotificationScreen) {
+    manager->pushScreen(alertNotificationScreen, false);  // Don't take ownership
+    Serial.println("MQTT: Showing alert notification popup");
+  }
+}
+
+// During a storm: refresh the one summary popup. It is pushed when the storm
+// starts; once dismissed it stays down until the next storm
+static void showStormSummary(const char* latestTitle, bool stormStarted) {
+  if (!alertNotificationScreen) return;
+  uint32_t now = millis();
+  alertNotificationScreen->setSummary(AlertStorm::getStormCount(), AlertStorm::getStormSeconds(now), latestTitle);
+  if (stormStarted) showNotification();
+}
+
+// Alert ringtone, as AlertsScreen plays it for a new row
+static void ringAlert() {
+  int idx = SettingsManager::getRingtoneIndex();
+  ringtonePlayer.playRingtoneByIndex(idx < 0 ? 0 : idx);
+}
+
+// Hand an alert to the alert list and the notification popup. A repeat of
+// a recent alert (same project, title and level) only bumps the count on
+// its existing row: no new row, popup or ringtone. While alerts arrive
+// faster than AlertStorm's threshold, rows are still added but the ringtone
+// stays quiet and a single summary popup replaces the per-alert ones. While
+// a game runs, alerts only add their row.
+//
+// Critical alerts always get their popup and ringtone, over a game, a
+// ringtone preview or a storm, repeats included.
+//
+// On a background wake every alert is appended to the log as a new row;
+// dedupe and storm handling need the list, so they start with the UI.
+static void showAlert(uint8_t priority, const char* project, const char* level, const char* title,
+                      const char* message, const char* time) {
+  Telemetry::noteAlert();
+  if (backgroundWake) {
+    uint32_t rowId = AlertLog::appendNew(title, message, time);
+    backgroundAlerts++;
+    Serial.printf("MQTT: '%s' stored as row %lu (background)\n", title, (unsigned long)rowId);
+    return;
+  }
+  AlertsScreen* alerts = AlertsScreen::getInstance();
+  if (alerts) {
+    uint32_t now = millis();
+    bool critical = (priority == AlertWire::PRIORITY_CRITICAL);
+    ScreenManager* manager = GlobalScreenManager::getInstance();
+    Screen* current = manager ? manager->getCurrentScreen() : nullptr;
+    bool quiet = !critical && current && current->holdsAlerts();
+    bool wasStorm = AlertStorm::isActive();
+    bool storm = AlertStorm::noteArrival(now);
+    if (storm && !wasStorm) {
+      alerts->setInsertBatching(STORM_LIST_REFRESH_MS);
+    }
+
+    uint32_t fingerprint = AlertDeduper::fingerprint(project, title, level);
+    uint32_t rowId;
+    bool merged = AlertDeduper::find(fingerprint, now, rowId) && alerts->mergeMessage(rowId, message, time);
+    if (!merged) {
+      rowId = alerts->addMessage(title, message, time, critical || (!storm && !quiet));
+    } else {
+      AlertDeduper::noteMerged();
+      Serial.printf("MQTT: repeat of '%s' merged\n", title);
+      if (critical) ringAlert();
+    }
+    AlertDeduper::remember(fingerprint, rowId, now);
+
+    if (!critical && storm) {
+      showStormSummary(title, !wasStorm && !quiet);
+      return;
+    }
+    if (quiet || (merged && !critical)) return;
+
+    // Show notification popup
+    if (alertNotificationScreen) {
+      alertNotificationScreen->setMessage(title, message, time);
+      showNotification();
+    }
+  }
+}
+
+// Loop side of AlertQueue: everything due, most urgent first. Latency is
+// taken at the next draw pass, when the alert is on the panel
+static bool alertShownPending[AlertQueue::PRIORITIES];
+static unsigned long alertArrivalUs[AlertQueue::PRIORITIES];
+
+static void dispatchAlerts() {
+  AlertQueue::Entry entry;
+  bool any = false;
+  while (AlertQueue::pop(entry)) {
+    if (entry.priority == AlertWire::PRIORITY_CRITICAL) {
+      PowerManager::notifyActivity();   // Backlight on now
+    }
+    showAlert(entry.priority, entry.project, entry.level, entry.title, entry.message, entry.time);
+    if (!alertShownPending[entry.priority]) {
+      alertShownPending[entry.priority] = true;
+      alertArrivalUs[entry.priority] = entry.arrivalUs;
+    }
+    any = true;
+  }
+  if (any) FrameScheduler::requestFrame();
+}
 
+static void noteAlertsShown() {
+  for (uint8_t p = 0; p < AlertQueue::PRIORITIES; p++) {
+    if (!alertShownPending[p]) continue;
+    AlertQueue::noteShown(p, micros() - alertArrivalUs[p]);
+    alertShownPending[p] = false;
+  }
+}
+
+// MQTT callback side: copy the alert into the queue and return (on a
+// background wake there is no UI: straight to the log)
+static void enqueueAlert(uint8_t priority, const char* project, const char* level, const char* title,
+                         const char* message, const char* time) {
+  if (backgroundWake) {
+    showAlert(priority, project, level, title, message, time);
+    return;
+  }
+  AlertQueue::push(priority, project, level, title, message, time);
+}
+
+// Priority from the topic's last level (alerts/<priority>), for payloads
+// without one
+static uint8_t topicPriority(const char* topic) {
+  const char* last = topic ? strrchr(topic, '/') : nullptr;
+  return AlertWire::priorityFromName(last ? last + 1 : topic, AlertWire::PRIORITY_HIGH);
+}
+
+// Storm over: list back to per-insert repaints, summary shows the final tally
+// and auto-dismisses as usual
+static void endAlertStorm() {
+  AlertsScreen* alerts = AlertsScreen::getInstance();
+  if (alerts) alerts->setInsertBatching(0);
+  if (alertNotificationScreen) {
+    alertNotificationScreen->setSummary(AlertStorm::getStormCount(), AlertStorm::getStormSeconds(millis()), nullptr);
+  }
+}
+
+static void handleMqttMessage(char* topic, uint8_t* payload, unsigned int length) {
   Serial.printf("MQTT: message on topic '%s', %u bytes\n", (topic ? topic : ""), length);
 
-  // Parse minimal JSON fields
-  // Increased size to handle Sentry webhooks (they can be 1600+ bytes)
-  StaticJsonDocument<2048> doc;
-  DeserializationError err = deserializeJson(doc, buffer);
-  if (err) {
-    Serial.printf("MQTT JSON parse error: %s\n", err.c_str());
-    Serial.printf("Buffer size: %u bytes\n", length);
+  // Binary alert frame (alerts-bin/#): decoded in place, no JSON involved
+  if (AlertWire::isFrame(payload, length)) {
+    alertFields.reset();   // The payload stream saw the frame bytes too
+    AlertFrame frame;
+    AlertWire::Result result = AlertWire::decode(payload, length, frame);
+    if (result != AlertWire::OK) {
+      Serial.printf("MQTT alert frame error: %s\n", AlertWire::resultName(result));
+      return;
+    }
+    if (RedeliveryFilter::isDuplicate(frame.id)) {
+      Serial.println("MQTT: alert already handled (redelivery), dropped");
+      return;
+    }
+    char timeBuf[6] = {0};
+    if (frame.timestamp) AlertWire::formatTime(frame.timestamp, timeBuf);
+    enqueueAlert(frame.priority, frame.project, AlertWire::levelName(frame.level),
+                 frame.title[0] ? frame.title : "Alert", frame.message, timeBuf);
     return;
   }
 
-  const char* title = doc["data"]["title"] | "Alert";
-  const char* message = doc["data"]["message"] | "";
-  const char* ts = doc["timestamp"] | "";
+  // Without a stream attached, parse the payload in place
+  if (alertFields.getBytesFed() == 0) {
+    alertFields.feed((const char*)payload, length);
+  }
+  JsonFieldExtractor::Result result = alertFields.finish();
+  if (result != JsonFieldExtractor::OK) {
+    Serial.printf("MQTT JSON parse error: %s\n", JsonFieldExtractor::resultName(result));
+    Serial.printf("Payload size: %u bytes\n", (unsigned)alertFields.getBytesFed());
+    alertFields.reset();
+    return;
+  }
+  // QoS 1 redelivers anything whose ack was lost, e.g. to deep sleep
+  if (RedeliveryFilter::isDuplicate(RedeliveryFilter::hashId(alertFields.get(idField, "")))) {
+    Serial.println("MQTT: alert already handled (redelivery), dropped");
+    alertFields.reset();
+    return;
+  }
+
+  const char* title = alertFields.get(titleField, "Alert");
+  const char* message = alertFields.get(messageField, "");
+  const char* ts = alertFields.get(timestampField, "");
 
   // Derive short time (HH:MM) if timestamp present
   char timeBuf[6] = {0};
@@ -84,32 +280,205 @@ static void onMqttMessage(char* topic, uint8_t* payload, unsigned int length) {
     timeBuf[5] = '\0';
   }
 
-  AlertsScreen* alerts = AlertsScreen::getInstance();
-  if (alerts) {
-    alerts->addMessage(title, message, (timeBuf[0] ? timeBuf : ts), true);  // Play ringtone
-    
-    // Show notification popup
-    if (alertNotificationScreen) {
-      alertNotificationScreen->setMessage(title, message, (timeBuf[0] ? timeBuf : ts));
-      
-      ScreenManager* manager = GlobalScreenManager::getInstance();
-      if (manager) {
-        // Only show notification if we're not already showing one
-        Screen* currentScreen = manager->getCurrentScreen();
-        if (currentScreen != alertNotificationScreen) {
-          manager->pushScreen(alertNotificationScreen, false);  // Don't take ownership
-          Serial.println("MQTT: Showing alert notification popup");
-        }
-      }
+  uint8_t priority = AlertWire::priorityFromName(alertFields.get(priorityField, nullptr), topicPriority(topic));
+  enqueueAlert(priority, alertFields.get(projectField, ""), alertFields.get(levelField, ""), title, message,
+               (timeBuf[0] ? timeBuf : ts));
+  alertFields.reset();
+}
+
+static void onMqttMessage(char* topic, uint8_t* payload, unsigned int length) {
+  unsigned long startUs = micros();
+  handleMqttMessage(topic, payload, length);
+  AlertQueue::noteCallback(micros() - startUs);
+}
+
+MQTTClient mqtt(onMqttMessage);
+
+// Everything an alert needs from MQTT to the flash log, without the UI:
+// shared by the background wake and the normal boot, run once per boot
+static bool alertPipelineReady = false;
+
+static void beginAlertPipeline() {
+  if (alertPipelineReady) return;
+  alertPipelineReady = true;
+
+  Serial.println("9. Initializing MQTT...");
+  String ssid = SettingsManager::getWifiSsid();
+  String pass = SettingsManager::getWifiPassword();
+  String broker = SettingsManager::getMqttBroker();
+  int port = SettingsManager::getMqttPort();
+  String cid = SettingsManager::getMqttClientId();
+  Serial.printf("   WiFi SSID: '%s' (len=%d)\n", ssid.c_str(), (int)ssid.length());
+  Serial.printf("   MQTT broker: %s:%d\n", broker.c_str(), port);
+  alertFields.clearFields();
+  titleField = alertFields.addField("data.title", alertTitle, sizeof(alertTitle));
+  messageField = alertFields.addField("data.message", alertMessage, sizeof(alertMessage));
+  timestampField = alertFields.addField("timestamp", alertTimestamp, sizeof(alertTimestamp));
+  projectField = alertFields.addField("data.project", alertProject, sizeof(alertProject));
+  levelField = alertFields.addField("data.level", alertLevel, sizeof(alertLevel));
+  idField = alertFields.addField("id", alertId, sizeof(alertId));
+  priorityField = alertFields.addField("priority", alertPriority, sizeof(alertPriority));
+  alertFields.reset();
+  mqtt.setPayloadStream(alertFields);
+  AlertDeduper::setWindow(SettingsManager::getAlertDedupeWindowMs());
+  mqtt.begin(ssid.c_str(), pass.c_str(), broker.c_str(), port, cid.c_str());
+  if (pass.length() == 0) {
+    Serial.println("   Note: WiFi password is empty. If SSID is secured, connection will fail.");
+  }
+  String sub = SettingsManager::getMqttSubscribeTopic();
+  if (sub.length() > 0) {
+    mqtt.subscribe(sub.c_str());
+    Serial.printf("Subscribed to MQTT topic: %s\n", sub.c_str());
+  }
+
+  // Alert history from flash: survives reboots and deep sleep
+  AlertLog::begin();
+  Telemetry::begin();
+}
+
+// Periodic timer wake (PowerManager): get online over the cached link, take
+// whatever the broker queued while asleep, and only wake the UI for it.
+// Returns true when alerts were stored, or are waiting in AlertQueue.
+//
+// Without the flash log there is nowhere to keep alerts with the screen off:
+// the wake stops at the first delivery, which stays in AlertQueue while the UI
+// comes up; the rest of the session queue follows over the normal path
+static bool checkAlertsInBackground(unsigned long budgetMs) {
+  unsigned long start = millis();
+  SettingsManager::begin();
+  beginAlertPipeline();
+
+  // The queue starts arriving right after the connect
+  backgroundWake = AlertLog::isPersistent();
+  backgroundAlerts = 0;
+  while (!mqtt.isMqttConnected() && millis() - start < budgetMs) {
+    mqtt.loop();
+    delay(10);
+  }
+  if (!mqtt.isMqttConnected()) {
+    Serial.printf("Background wake: no MQTT connection within %lu ms\n", budgetMs);
+    backgroundWake = false;
+    return false;
+  }
+
+  if (!backgroundWake) {
+    Serial.println("Background wake: no alert log, waiting for the first alert only");
+    unsigned long quietStart = millis();
+    while (AlertQueue::size() == 0 && millis() - quietStart < BACKGROUND_DRAIN_QUIET_MS &&
+           millis() - start < budgetMs) {
+      mqtt.loop();
+      delay(1);
     }
+    Telemetry::update(millis(), mqtt);
+    return AlertQueue::size() > 0;
   }
+
+  unsigned long elapsed = millis() - start;
+  mqtt.drain(BACKGROUND_DRAIN_QUIET_MS, budgetMs > elapsed ? budgetMs - elapsed : 0);
+  backgroundWake = false;
+  Telemetry::update(millis(), mqtt);   // Online anyway: send the window if it is due
+  return backgroundAlerts > 0;
 }
 
-MQTTClient mqtt(onMqttMessage);
+// Alerts stored by the background wake: pop up the newest with the ringtone
+static void showWakeAlert() {
+  AlertRecord record;
+  if (!alertNotificationScreen || !AlertLog::readLatest(AlertLog::getNewestId(), record)) return;
+  record.title[sizeof(record.title) - 1] = '\0';
+  record.message[sizeof(record.message) - 1] = '\0';
+  record.timestamp[sizeof(record.timestamp) - 1] = '\0';
+  alertNotificationScreen->setMessage(record.title, record.message, record.timestamp);
+  showNotification();
+  ringAlert();
+}
+
+// Serial console: "prof" prints the render profile, "prof reset" clears it;
+// "overdraw on|off|reset|map" drives the overdraw analyzer, "overdraw" reports;
+// "dedupe" shows alert dedupe, "dedupe <seconds>" sets its window (0 = off);
+// "storm" shows the alert rate and storm state; "log" shows the flash alert
+// log, "log flush" writes out buffered records; "mqtt" shows the connection,
+// session, redelivered alerts dropped and the cached link with connect timings;
+// "power" shows the background wake counts and active time, "power sleep"
+// goes to deep sleep now (not on USB power); "telemetry" shows
+// the health window and its message, "telemetry <seconds>" sets the interval;
+// "queue" shows the alert queue with latency to screen per priority; "audio"
+// shows the tone sequencer's queue and note onset jitter
+static void handleSerialCommands() {
+  static char line[32];
+  static uint8_t len = 0;
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c != '\n' && c != '\r') {
+      if (len < sizeof(line) - 1) line[len++] = c;
+      continue;
+    }
+    line[len] = '\0';
+    if (strcmp(line, "prof") == 0) {
+      RenderProfiler::printReport();
+    } else if (strcmp(line, "prof reset") == 0) {
+      RenderProfiler::reset();
+      Serial.println("RenderProfiler reset");
+    } else if (strcmp(line, "overdraw on") == 0) {
+      OverdrawAnalyzer::begin(tft.width(), tft.height());
+    } else if (strcmp(line, "overdraw off") == 0) {
+      OverdrawAnalyzer::end();
+      Serial.println("OverdrawAnalyzer: off");
+    } else if (strcmp(line, "overdraw reset") == 0) {
+      OverdrawAnalyzer::reset();
+    } else if (strcmp(line, "overdraw map") == 0) {
+      OverdrawAnalyzer::printHeatmap();
+    } else if (strcmp(line, "overdraw") == 0) {
+      OverdrawAnalyzer::printReport();
+    } else if (strcmp(line, "dedupe") == 0) {
+      AlertDeduper::printStatus(millis());
+    } else if (strncmp(line, "dedupe ", 7) == 0) {
+      uint32_t ms = (uint32_t)strtoul(line + 7, nullptr, 10) * 1000UL;
+      SettingsManager::setAlertDedupeWindowMs(ms);
+      AlertDeduper::setWindow(ms);
+      AlertDeduper::printStatus(millis());
+    } else if (strcmp(line, "storm") == 0) {
+      AlertStorm::printStatus(millis());
+    } else if (strcmp(line, "log") == 0) {
+      AlertLog::printStatus();
+    } else if (strcmp(line, "log flush") == 0) {
+      AlertLog::flush();
+      AlertLog::printStatus();
+    } else if (strcmp(line, "mqtt") == 0) {
+      mqtt.printDebugStatus();
+      RedeliveryFilter::printStatus();
+      WifiCache::printStatus();
+    } else if (strcmp(line, "power") == 0) {
+      PowerManager::printWakeStats();
+    } else if (strcmp(line, "power sleep") == 0) {
+      PowerManager::requestSleepNow();
+    } else if (strcmp(line, "telemetry") == 0) {
+      Telemetry::printStatus();
+    } else if (strncmp(line, "telemetry ", 10) == 0) {
+      uint32_t ms = (uint32_t)strtoul(line + 10, nullptr, 10) * 1000UL;
+      SettingsManager::setTelemetryIntervalMs(ms);
+      Telemetry::setInterval(ms);
+      Telemetry::printStatus();
+    } else if (strcmp(line, "queue") == 0) {
+      AlertQueue::printStatus();
+    } else if (strcmp(line, "audio") == 0) {
+      ToneSequencer::printStatus();
+    } else if (len > 0) {
+      Serial.printf("Unknown command '%s' (try: prof, prof reset, overdraw [on|off|reset|map], dedupe [seconds], storm, log [flush], mqtt, power [sleep], telemetry [seconds], queue, audio)\n", line);
+    }
+    len = 0;
+  }
+}
 
 void setup(void) {
   Serial.begin(115200);
-  delay(2000);
+
+  // A timer wake checks MQTT before any display init and only returns here
+  // if there is something to show; otherwise the device is asleep again
+  PowerManager::setBackgroundWakeHandler(checkAlertsInBackground);
+  bool skipSplash = PowerManager::onWake();
+  if (!PowerManager::lastWakeWasFromSleep()) {
+    delay(2000);  // Time to open the serial monitor after a reset
+  }
   Serial.println(F("=== AlertTX-1 Phase 2 Component Framework ==="));
 
   // STEP 1: turn on backlite FIRST (from Adafruit example)
@@ -123,6 +492,9 @@ void setup(void) {
   digitalWrite(TFT_I2C_POWER, HIGH);
   delay(10);
 
+  // Fuel gauge (on the I2C supply just turned on) and the inactivity timer
+  PowerManager::begin();
+
   // STEP 3: initialize TFT (exact sequence from Adafruit)
   Serial.println("3. Initializing TFT...");
   tft.init(135, 240); // Init ST7789 240x135
@@ -131,9 +503,10 @@ void setup(void) {
 
   Serial.println(F("4. Display initialized successfully!"));
 
-  // STEP 4: Initialize Settings Manager (persistent storage)
+  // STEP 4: Initialize Settings Manager (persistent storage; the
+  // background wake has opened it already)
   Serial.println("5. Initializing settings manager...");
-  SettingsManager::begin();
+  if (!PowerManager::hasNewMessagesOnWake()) SettingsManager::begin();
   
   // STEP 5: Initialize Theme System with saved preferences
   Serial.println("6. Initializing theme system...");
@@ -154,47 +527,48 @@ void setup(void) {
     Serial.println("Flashlight mode restored: ON");
   }
 
-  // Initialize ringtone player and attach LED sync
+  // Initialize ringtone players (alerts, previews) and attach LED sync
   Serial.println("8. Initializing ringtone player...");
   ringtonePlayer.begin(BUZZER_PIN);
   ringtonePlayer.attachLed(&statusLed);
+  previewPlayer.begin(BUZZER_PIN);
+  previewPlayer.attachLed(&statusLed);
   // Only enable LED sync if flashlight mode is off
   ringtonePlayer.setLedSyncEnabled(!SettingsManager::getFlashlightEnabled());
+  previewPlayer.setLedSyncEnabled(!SettingsManager::getFlashlightEnabled());
 
-  // Initialize MQTT
-  Serial.println("9. Initializing MQTT...");
-  String ssid = SettingsManager::getWifiSsid();
-  String pass = SettingsManager::getWifiPassword();
-  String broker = SettingsManager::getMqttBroker();
-  int port = SettingsManager::getMqttPort();
-  String cid = SettingsManager::getMqttClientId();
-  Serial.printf("   WiFi SSID: '%s' (len=%d)\n", ssid.c_str(), (int)ssid.length());
-  Serial.printf("   MQTT broker: %s:%d\n", broker.c_str(), port);
-  mqtt.begin(ssid.c_str(), pass.c_str(), broker.c_str(), port, cid.c_str());
-  if (pass.length() == 0) {
-    Serial.println("   Note: WiFi password is empty. If SSID is secured, connection will fail.");
-  }
-  String sub = SettingsManager::getMqttSubscribeTopic();
-  if (sub.length() > 0) {
-    mqtt.subscribe(sub.c_str());
-    Serial.printf("Subscribed to MQTT topic: %s\n", sub.c_str());
-  }
+  // MQTT and the alert log (already up after a background wake with alerts)
+  beginAlertPipeline();
 
   // STEP 7: Initialize Phase 2 Component Framework
   Serial.println("10. Initializing component framework...");
+  GlobalRenderManager::initialize(&tft);  // Damage tracking for partial redraws
   screenManager = new ScreenManager(&tft);
   mainMenuScreen = new MainMenuScreen(&tft);
   splashScreen = new SplashScreen(&tft, mainMenuScreen);
   alertNotificationScreen = new AlertNotificationScreen(&tft);
+
+  // Alert history from the flash log, including alerts a background wake stored
+  if (AlertsScreen::getInstance()) AlertsScreen::getInstance()->restoreFromLog();
   
   // STEP 8: Set up global screen manager access
   Serial.println("11. Setting up global screen manager...");
   GlobalScreenManager::setInstance(screenManager);
   inputRouter = new InputRouter(screenManager, &buttonManager);
+
+  // Frames are presented on demand; idle time goes back to the CPU
+  FrameScheduler::begin();
+  FrameScheduler::setWakeCheck([]() { return buttonManager.needsPolling(); });
   
-  // STEP 9: Start with splash screen
-  Serial.println("12. Starting with splash screen...");
-  screenManager->pushScreen(splashScreen);
+  // STEP 9: Start with splash screen (straight to the menu after a wake)
+  if (skipSplash) {
+    Serial.println("12. Woken from sleep, skipping splash...");
+    screenManager->pushScreen(mainMenuScreen);
+    if (PowerManager::hasNewMessagesOnWake()) showWakeAlert();
+  } else {
+    Serial.println("12. Starting with splash screen...");
+    screenManager->pushScreen(splashScreen);
+  }
   
   Serial.println("=== Phase 2 Component Framework Ready! ===");
   Serial.println("Showing splash screen for 2 seconds...");
@@ -202,26 +576,58 @@ void setup(void) {
 }
 
 void loop() {
+  unsigned long loopStartUs = micros();
+
   // Route input centrally
   inputRouter->update();
   
   // Update framework
   screenManager->update();
+  unsigned long frames = FrameScheduler::getFramesPresented();
+  unsigned long drawStartUs = micros();
   screenManager->draw();
+  if (FrameScheduler::getFramesPresented() != frames) Telemetry::noteFrame(micros() - drawStartUs);
+  noteAlertsShown();
 
   // Update audio and MQTT
   ringtonePlayer.update();
+  previewPlayer.update();
   mqtt.update();
+  dispatchAlerts();
+  Telemetry::update(millis(), mqtt);
+  if (AlertStorm::update(millis())) endAlertStorm();
+  AlertLog::update(millis());
+  PowerManager::update(millis());   // Battery, dim and deep sleep after inactivity
   statusLed.update();
+  handleSerialCommands();
   
   static unsigned long lastDebug = 0;
   if (millis() - lastDebug > 30000) {
     Serial.println("=== Periodic Debug ===");
     screenManager->printPerformanceStats();
+    FrameScheduler::printStats();
+    FrameScheduler::resetStats();
+    GlobalRenderManager::getInstance()->printStats();
+    GlobalRenderManager::getInstance()->resetStats();
+    RenderProfiler::printSummary();
     screenManager->printStackState();
     Serial.printf("Free heap: %u bytes\n", ESP.getFreeHeap());
     mqtt.printDebugStatus();
     Serial.println("=========================");
     lastDebug = millis();
   }
+
+  // A timer plays the notes; wake at the next one for LED sync and to top
+  // up the sequencer's queue. A held player waits for the buzzer and needs
+  // no wake of its own
+  bool audioActive = false;
+  RingtonePlayer* players[] = { &ringtonePlayer, &previewPlayer };
+  for (RingtonePlayer* player : players) {
+    if (!player->isPlaying() || player->isHeld()) continue;
+    audioActive = true;
+    FrameScheduler::wakeWithin(player->getTimeToNextNote());
+  }
+  FrameScheduler::setLightSleepAllowed(!audioActive && WiFi.getMode() == WIFI_OFF);
+  Telemetry::noteLoop(micros() - loopStartUs);
+  FrameScheduler::idle();
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "AudioRender.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const uint8_t SILENCE = 128;
+static const uint8_t AMPLITUDE = 64;
+
+static std::string trim(const std::string& s) {
+    size_t a = 0, b = s.size();
+    while (a < b && isspace((unsigned char)s[a])) a++;
+    while (b > a && isspace((unsigned char)s[b - 1])) b--;
+    return s.substr(a, b - a);
+}
+
+static int64_t absUs(int64_t v) {
+    return v < 0 ? -v : v;
+}
+
+// name:d=<duration>,o=<octave>,b=<bpm>:<notes>; spec defaults d=4, o=6, b=63.
+// A note is [duration]<letter>[#][.][octave][.], letters c..b or p (rest)
+bool AudioRender::parseRtttl(const std::string& text, Spec& out) {
+    size_t first = text.find(':');
+    size_t second = first == std::string::npos ? first : text.find(':', first + 1);
+    if (second == std::string::npos) return false;
+    out = Spec();
+    out.name = trim(text.substr(0, first));
+
+    unsigned defDuration = 4, defOctave = 6, bpm = 63;
+    std::string control = text.substr(first + 1, second - first - 1);
+    size_t pos = 0;
+    while (pos <= control.size()) {
+        size_t end = control.find(',', pos);
+        if (end == std::string::npos) end = control.size();
+        std::string item = trim(control.substr(pos, end - pos));
+        if (item.size() > 2 && item[1] == '=') {
+            unsigned value = (unsigned)atoi(item.c_str() + 2);
+            if (item[0] == 'd' && value) defDuration = value;
+            else if (item[0] == 'o') defOctave = value;
+            else if (item[0] == 'b' && value) bpm = value;
+        }
+        pos = end + 1;
+    }
+    out.bpm = bpm;
+
+    static const int SEMITONES[7] = { 9, 11, 0, 2, 4, 5, 7 };   // a..g from C
+    double wholeUs = 240e6 / bpm;
+    double atUs = 0;
+    std::string notes = text.substr(second + 1);
+    pos = 0;
+    while (pos < notes.size()) {
+        size_t end = notes.find(',', pos);
+        if (end == std::string::npos) end = notes.size();
+        std::string note = trim(notes.substr(pos, end - pos));
+        pos = end + 1;
+        if (note.empty()) continue;
+
+        size_t i = 0;
+        unsigned duration = 0;
+        while (i < note.size() && isdigit((unsigned char)note[i])) duration = duration * 10 + (note[i++] - '0');
+        if (!duration) duration = defDuration;
+        bool dotted = false;
+        if (i < note.size() && note[i] == '.') {
+            dotted = true;
+            i++;
+        }
+        char letter = i < note.size() ? (char)tolower((unsigned char)note[i++]) : 0;
+        if (letter != 'p' && (letter < 'a' || letter > 'g')) {
+            out.unparsed++;
+            continue;
+        }
+        bool sharp = i < note.size() && note[i] == '#';
+        if (sharp) i++;
+        if (i < note.size() && note[i] == '.') {
+            dotted = true;
+            i++;
+        }
+        unsigned octave = defOctave;
+        if (i < note.size() && isdigit((unsigned char)note[i])) octave = note[i++] - '0';
+        if (i < note.size() && note[i] == '.') dotted = true;
+
+        double lengthUs = wholeUs / duration * (dotted ? 1.5 : 1.0);
+        SpecNote spec;
+        spec.startUs = (uint64_t)llround(atUs);
+        atUs += lengthUs;
+        spec.durationUs = (uint64_t)llround(atUs) - spec.startUs;
+        spec.frequency = 0;
+        if (letter != 'p') {
+            int midi = (int)(octave + 1) * 12 + SEMITONES[letter - 'a'] + (sharp ? 1 : 0);
+            spec.frequency = 440.0 * pow(2.0, (midi - 69) / 12.0);
+        }
+        out.notes.push_back(spec);
+    }
+    out.lengthUs = (uint64_t)llround(atUs);
+    return !out.notes.empty();
+}
+
+AudioRender::Analysis AudioRender::analyze(const std::vector<Change>& changes, uint64_t startUs, const Spec& spec) {
+    Analysis result;
+    size_t c = 0;
+    while (c < changes.size() && changes[c].atUs < startUs) c++;
+
+    // Least squares over (specified, played) onsets
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (const SpecNote& note : spec.notes) {
+        if (note.frequency == 0) continue;
+        while (c < changes.size() && changes[c].frequency == 0) c++;
+        if (c >= changes.size()) {
+            result.missing++;
+            continue;
+        }
+        Onset onset;
+        onset.specUs = note.startUs;
+        onset.specHz = note.frequency;
+        onset.playedHz = changes[c].frequency;
+        uint64_t playedUs = changes[c].atUs - startUs;
+        uint64_t endUs = (c + 1 < changes.size() ? changes[c + 1].atUs : changes[c].atUs) - startUs;
+        onset.errorUs = (int64_t)playedUs - (int64_t)note.startUs;
+        onset.lengthErrorUs = (int64_t)(endUs - playedUs) - (int64_t)note.durationUs;
+        result.onsets.push_back(onset);
+        result.songLenErrUs = (int64_t)endUs - (int64_t)(note.startUs + note.durationUs);
+        c++;
+
+        double cents = fabs(1200.0 * log2(onset.playedHz / note.frequency));
+        if (cents > 50) result.wrongPitch++;
+        if ((uint32_t)lround(cents) > result.maxCents) result.maxCents = (uint32_t)lround(cents);
+        if ((uint64_t)absUs(onset.errorUs) > result.onsetErrMaxUs) result.onsetErrMaxUs = (uint64_t)absUs(onset.errorUs);
+        if ((uint64_t)absUs(onset.lengthErrorUs) > result.noteLenErrMaxUs) {
+            result.noteLenErrMaxUs = (uint64_t)absUs(onset.lengthErrorUs);
+        }
+        double x = (double)note.startUs, y = (double)playedUs;
+        n++;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    while (c < changes.size()) {
+        if (changes[c++].frequency) result.missing++;
+    }
+    double var = n * sxx - sx * sx;
+    if (n >= 2 && var > 0) result.tempoErrPpm = (int32_t)llround(((n * sxy - sx * sy) / var - 1.0) * 1e6);
+    return result;
+}
+
+std::vector<uint8_t> AudioRender::render(const std::vector<Change>& changes, uint64_t startUs, uint64_t endUs,
+                                         uint32_t sampleRate) {
+    std::vector<uint8_t> pcm;
+    if (endUs <= startUs || !sampleRate) return pcm;
+    size_t count = (size_t)((endUs - startUs) * sampleRate / 1000000ULL);
+    pcm.reserve(count);
+    size_t c = 0;
+    uint16_t frequency = 0;
+    double phase = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t atUs = startUs + (uint64_t)i * 1000000ULL / sampleRate;
+        while (c < changes.size() && changes[c].atUs <= atUs) {
+            frequency = changes[c++].frequency;
+            phase = 0;      // LEDC restarts its period on a new frequency
+        }
+        if (!frequency) {
+            pcm.push_back(SILENCE);
+            continue;
+        }
+        pcm.push_back(phase < 0.5 ? SILENCE + AMPLITUDE : SILENCE - AMPLITUDE);
+        phase += (double)frequency / sampleRate;
+        phase -= floor(phase);
+    }
+    return pcm;
+}
+
+bool AudioRender::writeTimeline(const char* path, const Analysis& analysis) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "note,spec_us,onset_error_us,length_error_us,spec_hz,played_hz\n");
+    for (size_t i = 0; i < analysis.onsets.size(); i++) {
+        const Onset& o = analysis.onsets[i];
+        fprintf(f, "%zu,%llu,%lld,%lld,%.1f,%u\n", i, (unsigned long long)o.specUs, (long long)o.errorUs,
+                (long long)o.lengthErrorUs, o.specHz, (unsigned)o.playedHz);
+    }
+    return fclose(f) == 0;
+}
@@ -0,0 +1,74 @@
+#ifndef HOST_AUDIO_RENDER_H
+#define HOST_AUDIO_RENDER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * AudioRender
+ *
+ * Turns the buzzer's tone changes (HostHooks::toneHook) into something to
+ * listen to and something to measure, with the RTTTL source as reference.
+ *
+ * Features:
+ * - RTTTL parser written from the spec, independent of the generator: exact
+ *   tempo math (a whole note is 240 s / bpm) and equal-tempered pitches
+ *   (A4 = 440 Hz), in µs
+ * - Note matching in order: onset error, length error and pitch error in
+ *   cents per note, whole-song length error, and the tempo error as the
+ *   least-squares slope of played against specified onsets
+ * - Square-wave PCM of the changes, as the buzzer would sound them, plus
+ *   a per-note timeline as CSV
+ */
+class AudioRender {
+public:
+    struct Change {
+        uint64_t atUs;
+        uint16_t frequency;     // 0 = silence
+    };
+
+    struct SpecNote {
+        uint64_t startUs;       // From the first note
+        uint64_t durationUs;
+        double frequency;       // 0 = rest
+    };
+
+    struct Spec {
+        std::string name;
+        uint32_t bpm = 0;
+        std::vector<SpecNote> notes;
+        uint64_t lengthUs = 0;
+        uint32_t unparsed = 0;  // Notes the spec does not allow (left out)
+    };
+
+    struct Onset {
+        uint64_t specUs;
+        int64_t errorUs;        // Played minus specified
+        int64_t lengthErrorUs;
+        double specHz;
+        uint16_t playedHz;
+    };
+
+    struct Analysis {
+        std::vector<Onset> onsets;
+        uint32_t missing = 0;       // Sounding notes without a tone, or tones without a note
+        uint32_t wrongPitch = 0;    // More than a quarter tone off
+        uint32_t maxCents = 0;
+        uint64_t onsetErrMaxUs = 0;
+        uint64_t noteLenErrMaxUs = 0;
+        int64_t songLenErrUs = 0;   // End of the last note
+        int32_t tempoErrPpm = 0;
+    };
+
+    static bool parseRtttl(const std::string& text, Spec& out);
+    // Changes from startUs on against the spec. The song length is up to the
+    // end of its last sounding note (trailing rests are not heard)
+    static Analysis analyze(const std::vector<Change>& changes, uint64_t startUs, const Spec& spec);
+    // 8-bit unsigned PCM for [startUs, endUs)
+    static std::vector<uint8_t> render(const std::vector<Change>& changes, uint64_t startUs, uint64_t endUs,
+                                       uint32_t sampleRate);
+    static bool writeTimeline(const char* path, const Analysis& analysis);
+};
+
+#endif // HOST_AUDIO_RENDER_H
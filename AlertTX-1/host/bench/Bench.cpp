@@ -0,0 +1,1484 @@
+/**
+ * AlertTX-1 host benchmark
+ *
+ * Runs the real firmware (setup()/loop() from the sketch) against the host
+ * framebuffer panel and a simulated clock, drives it through fixed button /
+ * MQTT scenarios and reports what every frame cost on the bus.
+ *
+ *   bench [--out DIR] [--baseline FILE] [--update] [--tolerance PCT] [scenario...]
+ *
+ * Writes DIR/report.json (per-scenario totals, overdraw by call site and
+ * per-frame log), one PNG per snapshot and an overdraw heatmap per scenario. With a baseline, exits non-zero when any counter grows by
+ * more than the tolerance or any snapshot changes; --update rewrites it.
+ * Wall time is reported but never gated (it depends on the host).
+ *
+ * Each scenario runs in its own forked process so they all start from a
+ * cold boot and cannot leak state into each other.
+ */
+
+#include "../../AlertTX-1.ino"
+#include "../../src/ui/games/BeeperHeroScreen.h"
+#include "AudioRender.h"
+#include "BenchRecorder.h"
+#include "WavWriter.h"
+#include <ArduinoJson.h>
+#include <HostBroker.h>
+#include <HostClock.h>
+#include <HostHooks.h>
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <vector>
+#include <unistd.h>
+
+static const uint64_t LOOP_STEP_US = 200;       // host time per loop pass
+static const int CLICK_MS = 80;
+static const int SETTLE_MS = 600;               // slide (200 ms) plus input cooldown (300 ms)
+static const int LONG_PRESS_MS = 1700;
+
+static BenchRecorder* recorder = nullptr;
+
+// Scenario helpers
+
+static void runFor(int ms) {
+    uint64_t end = HostClock::nowUs() + (uint64_t)ms * 1000ULL;
+    while (HostClock::nowUs() < end) {
+        recorder->pass(loop);
+        HostClock::advanceUs(LOOP_STEP_US);
+    }
+}
+
+static void setButton(uint8_t pin, bool pressed) {
+    // A idles high (pull-up), B and C idle low (pull-down)
+    bool activeLow = (pin == BUTTON_A_PIN);
+    HostHooks::pinLevels[pin] = (pressed != activeLow) ? HIGH : LOW;
+}
+
+static void click(uint8_t pin) {
+    setButton(pin, true);
+    runFor(CLICK_MS);
+    setButton(pin, false);
+    runFor(SETTLE_MS);
+}
+
+static void holdBack(uint8_t pin = BUTTON_A_PIN) {
+    setButton(pin, true);
+    runFor(LONG_PRESS_MS);
+    setButton(pin, false);
+    runFor(SETTLE_MS);
+}
+
+static void boot() {
+    setup();
+    OverdrawAnalyzer::begin(tft.width(), tft.height());
+    runFor(3200);
+    // Any key skips the splash if it is still up
+    if (screenManager->getCurrentScreen() == splashScreen) click(BUTTON_B_PIN);
+}
+
+// Beeper-Service alert JSON. rawBytes pads the document with a Sentry-style
+// "raw" webhook echo; id is the service's message id (omitted when null).
+static std::string alertJson(const char* title, const char* message, const char* timestamp, size_t rawBytes = 0,
+                             const char* id = nullptr) {
+    std::string payload = "{";
+    if (id) payload += std::string("\"id\":\"") + id + "\",";
+    payload += "\"action\":\"triggered\",\"raw\":\"";
+    for (size_t i = 0; i < rawBytes; i++) payload += (i % 64 == 63) ? ' ' : (char)('a' + i % 26);
+    char fields[384];
+    snprintf(fields, sizeof(fields),
+             "\",\"data\":{\"title\":\"%s\",\"message\":\"%s\"},\"timestamp\":\"%s\"}",
+             title, message, timestamp);
+    payload += fields;
+    return payload;
+}
+
+// Deliver an alert the way PubSubClient does with a payload stream attached:
+// the whole payload goes to the stream in network-sized chunks, then the
+// callback fires with at most one receive buffer (256 bytes) of it.
+static void publish(const char* title, const char* message, const char* timestamp, size_t rawBytes = 0) {
+    std::string payload = alertJson(title, message, timestamp, rawBytes);
+    const size_t CHUNK = 64;
+    for (size_t at = 0; at < payload.size(); at += CHUNK) {
+        size_t n = payload.size() - at < CHUNK ? payload.size() - at : CHUNK;
+        alertFields.write((const uint8_t*)payload.data() + at, n);
+    }
+    char topic[] = "alerts";
+    unsigned len = payload.size() < 256 ? (unsigned)payload.size() : 256;
+    onMqttMessage(topic, (uint8_t*)&payload[0], len);
+    dispatchAlerts();                    // As loop() does right after mqtt.update()
+}
+
+static void seedAlerts() {
+    AlertsScreen* alerts = AlertsScreen::getInstance();
+    if (!alerts) return;
+    alerts->addMessage("Disk space low", "Volume /var on db-02 is 91% full", "08:41", false);
+    alerts->addMessage("Deploy finished", "checkout-service v2.14.1 rolled out to production", "09:15", false);
+    alerts->addMessage("Sentry: TypeError in checkout-service payment handler",
+                       "Cannot read properties of undefined (reading 'amount') at processPayment in handler.js:42",
+                       "10:02", false);
+}
+
+// Scenarios
+
+static void scenarioBoot() {
+    boot();
+    recorder->snapshot("main_menu");
+}
+
+static void scenarioMenuAlertsDetail() {
+    boot();
+    seedAlerts();
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts
+    recorder->snapshot("alerts");
+    click(BUTTON_B_PIN);
+    click(BUTTON_A_PIN);
+    click(BUTTON_C_PIN);                 // Open the newest alert
+    recorder->snapshot("detail");
+    holdBack();
+    recorder->snapshot("back");
+}
+
+static void scenarioThemeSwitch() {
+    boot();
+    click(BUTTON_B_PIN);
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // Settings
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // Themes
+    recorder->snapshot("themes");
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // Apply the second theme
+    runFor(500);
+    recorder->snapshot("applied");
+}
+
+// Notes the buzzer started and how long it sounded (a tone lasts until the
+// next change)
+static uint32_t toneNotes = 0;
+static uint64_t toneUs = 0;
+static uint64_t toneOnUs = 0;
+
+static void countTone(uint8_t pin, unsigned int frequency, unsigned long durationMs) {
+    if (toneOnUs) toneUs += HostClock::nowUs() - toneOnUs;
+    toneOnUs = frequency ? HostClock::nowUs() : 0;
+    if (frequency) toneNotes++;
+}
+
+static void scenarioBeeperHero() {
+    boot();
+    HostHooks::toneHook = countTone;
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // Games
+    click(BUTTON_B_PIN);
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // BeeperHero
+    click(BUTTON_C_PIN);                 // First song
+    runFor(4000);
+    recorder->snapshot("playing");
+    runFor(6000);
+    recorder->metric("notes", toneNotes);
+    recorder->metric("noteMs", toneUs / 1000);
+}
+
+// The same alert as a binary frame on alerts-bin/ (layout in
+// Beeper-Service/src/services/alertWire.ts), streamed like publish()
+static void publishFrame(const char* title, const char* message, uint32_t timestamp) {
+    std::string frame;
+    frame += (char)AlertWire::MAGIC;
+    frame += (char)AlertWire::VERSION;
+    frame += '\0';
+    frame += (char)AlertWire::PRIORITY_HIGH;
+    frame += (char)AlertWire::LEVEL_ERROR;
+    const uint32_t words[] = { timestamp ^ 0x5EED5EEDu, timestamp, 0 };   // id, timestamp, URL hash
+    for (uint32_t w : words) {
+        for (int i = 0; i < 4; i++) frame += (char)(w >> (8 * i));
+    }
+    const char* const strings[] = { title, message, "checkout", "production" };
+    for (const char* text : strings) {
+        size_t n = strlen(text);
+        frame += (char)n;
+        frame.append(text, n);
+        frame += '\0';
+    }
+    alertFields.write((const uint8_t*)frame.data(), frame.size());
+    char topic[] = "alerts-bin/high";
+    onMqttMessage(topic, (uint8_t*)&frame[0], (unsigned)frame.size());
+    dispatchAlerts();
+}
+
+static const char* const BURST_TITLES[] = {
+    "CPU high on web-01", "CPU high on web-02", "5xx rate above 2%", "Queue depth 12k",
+    "Replica lag 45s", "Cert expires in 7 days", "Disk space low", "Health check failed",
+    "Memory pressure", "Login failures spike",
+};
+static const char* const BURST_MESSAGE = "Triggered by the burst benchmark; see the dashboard for details";
+static const size_t BURST_COUNT = sizeof(BURST_TITLES) / sizeof(BURST_TITLES[0]);
+
+static void scenarioAlertBurst() {
+    boot();
+    char ts[32];
+    for (unsigned i = 0; i < BURST_COUNT; i++) {
+        snprintf(ts, sizeof(ts), "2025-01-15T11:%02u:00Z", i);
+        // One Sentry-sized payload, far over PubSubClient's receive buffer
+        size_t raw = (i == 5) ? 6000 : 0;
+        publish(BURST_TITLES[i], BURST_MESSAGE, ts, raw);
+        runFor(100);
+    }
+    runFor(1000);
+    recorder->snapshot("last_alert");
+}
+
+// alert_burst over the binary topic; must render identically
+static void scenarioAlertBurstWire() {
+    boot();
+    for (unsigned i = 0; i < BURST_COUNT; i++) {
+        publishFrame(BURST_TITLES[i], BURST_MESSAGE, 1736938800u + i * 60);   // 2025-01-15T11:0i:00Z
+        runFor(100);
+    }
+    runFor(1000);
+    recorder->snapshot("last_alert");
+}
+
+// Three issues firing eight times each: three rows with counts, one popup
+static void scenarioAlertStorm() {
+    boot();
+    static const char* const issues[] = {
+        "TypeError in checkout-service", "Timeout calling payments-api", "DB pool exhausted",
+    };
+    char ts[32];
+    for (unsigned round = 0; round < 8; round++) {
+        for (unsigned i = 0; i < 3; i++) {
+            snprintf(ts, sizeof(ts), "2025-01-15T12:%02u:00Z", round * 3 + i);
+            publish(issues[i], "Seen again; see the dashboard for details", ts);
+            runFor(50);
+        }
+    }
+    runFor(500);
+    recorder->snapshot("popup");
+    click(BUTTON_A_PIN);                 // Dismiss the popup
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts
+    recorder->snapshot("list");
+}
+
+// Sixty distinct alerts at 20/s with the list open: storm summary, batched
+// list repaints, buttons still handled mid-flood, then the storm ends
+static void scenarioAlertFlood() {
+    boot();
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts
+    char title[48];
+    char ts[32];
+    for (unsigned i = 0; i < 60; i++) {
+        snprintf(title, sizeof(title), "Host web-%02u unreachable", i);
+        snprintf(ts, sizeof(ts), "2025-01-15T13:%02u:00Z", i);
+        publish(title, "Health check timed out after 5s", ts);
+        runFor(50);
+        if (i == 20) click(BUTTON_A_PIN);    // Dismiss the summary, back to the list
+        if (i == 30 || i == 40) click(BUTTON_B_PIN);   // Scroll while alerts pour in
+    }
+    recorder->snapshot("during");
+    runFor(12000);                       // Rate drops: the storm ends
+    click(BUTTON_C_PIN);                 // Open the selected alert
+    recorder->snapshot("after");
+}
+
+// Alerts (one repeat, one read) before a reboot; after it the list comes
+// back from the flash log. The first boot runs in a forked process that
+// hands its flash image over; only the second boot is measured.
+static void scenarioAlertLogReboot() {
+    char image[64];
+    snprintf(image, sizeof(image), "/tmp/alerttx1-bench-flash-%d", (int)getpid());
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        boot();
+        seedAlerts();
+        publish("Replica lag 45s", "db-03 is 45 s behind the primary", "2025-01-15T14:00:00Z");
+        publish("Replica lag 45s", "db-03 is 52 s behind the primary", "2025-01-15T14:01:00Z");
+        click(BUTTON_A_PIN);             // Dismiss the popup
+        click(BUTTON_C_PIN);             // Main menu -> Alerts
+        click(BUTTON_C_PIN);             // Open (and read) the newest alert
+        runFor(AlertLog::FLUSH_DELAY_MS + 500);
+        _exit(HostHooks::saveFlash(image) ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    bool loaded = WIFEXITED(status) && WEXITSTATUS(status) == 0 && HostHooks::loadFlash(image);
+    unlink(image);
+    if (!loaded) {
+        fprintf(stderr, "alert_log_reboot: first boot failed\n");
+        _exit(1);
+    }
+
+    boot();
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts
+    recorder->snapshot("restored");
+}
+
+// Over the broker stand-in: the device holds a persistent QoS 1 session,
+// loses the ack of one alert when its link drops, misses twelve while it is
+// away (deep sleep), and on reconnect drains the queue in one burst; the
+// redelivered alert is dropped instead of shown twice
+static void scenarioMqttWakeDrain() {
+    boot();
+    HostHooks::wifiConnected = true;
+    mqtt.begin("bench-ap", "", "broker.local", 1883, "alerttx1-bench");
+    mqtt.subscribe("alerts/#");
+    runFor(500);
+
+    char title[48];
+    char ts[32];
+    char id[16];
+    HostBroker::loseNextAck();
+    HostBroker::publish("alerts/checkout", alertJson("Payment webhook failing", "Stripe returned 500 for 3 minutes",
+                                                     "2025-01-15T15:00:00Z", 0, "evt-0000"), 1);
+    runFor(500);
+    HostBroker::setOnline(false);
+    for (unsigned i = 1; i <= 12; i++) {
+        snprintf(title, sizeof(title), "Nightly job %02u failed", i);
+        snprintf(ts, sizeof(ts), "2025-01-15T15:%02u:00Z", i);
+        snprintf(id, sizeof(id), "evt-%04u", i);
+        HostBroker::publish("alerts/batch", alertJson(title, "Exited with status 1 after retries", ts, 0, id), 1);
+        runFor(200);
+    }
+    HostBroker::setOnline(true);
+    runFor(4000);                        // Reconnect (3 s backoff) and drain
+    // Every alert delivered once more than published (the redelivery), none
+    // left behind, the duplicate filtered
+    const HostBroker::Stats& stats = HostBroker::stats();
+    if (stats.delivered != stats.published + 1 || stats.redelivered != 1 || stats.dropped != 0 ||
+        HostBroker::queued("alerttx1-bench") != 0 || RedeliveryFilter::getDropped() != 1) {
+        fprintf(stderr, "mqtt_wake_drain: %u published, %u delivered, %u redelivered, %u dropped, %u queued, %u filtered\n",
+                stats.published, stats.delivered, stats.redelivered, stats.dropped,
+                (unsigned)HostBroker::queued("alerttx1-bench"), (unsigned)RedeliveryFilter::getDropped());
+        _exit(1);
+    }
+    recorder->snapshot("drained");
+    click(BUTTON_A_PIN);                 // Dismiss the summary
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts
+    recorder->snapshot("list");
+}
+
+// The link dies 40 bytes into a QoS 1 alert: the payload stream holds the
+// start of it when the broker sends it again after the reconnect, and the
+// redelivery has to parse on its own instead of after the stale bytes
+static void scenarioMqttCutPayload() {
+    boot();
+    HostHooks::wifiConnected = true;
+    mqtt.begin("bench-ap", "", "broker.local", 1883, "alerttx1-bench");
+    mqtt.subscribe("alerts/#");
+    runFor(500);
+
+    HostBroker::cutNextDelivery(40);
+    HostBroker::publish("alerts/checkout", alertJson("Payment webhook failing", "Stripe returned 500 for 3 minutes",
+                                                     "2025-01-15T15:00:00Z", 0, "evt-0000"), 1);
+    runFor(4000);                        // Reconnect (3 s backoff) and redelivery
+    uint32_t shown = 0;
+    for (uint8_t p = AlertWire::PRIORITY_LOW; p <= AlertWire::PRIORITY_CRITICAL; p++) shown += AlertQueue::getShown(p);
+    const HostBroker::Stats& stats = HostBroker::stats();
+    if (shown != 1 || stats.redelivered != 1 || HostBroker::queued("alerttx1-bench") != 0) {
+        fprintf(stderr, "mqtt_cut_payload: %u shown, %u redelivered, %u queued\n", (unsigned)shown,
+                stats.redelivered, (unsigned)HostBroker::queued("alerttx1-bench"));
+        _exit(1);
+    }
+}
+
+// Wi-Fi + MQTT connect on a cold boot (scan, DHCP, DNS), after a wake with
+// the cached link (direct association, static IP, cached broker address),
+// and after the AP moved to another channel (fast attempt fails, full scan).
+// Each "wake" drops the link and starts the client again as setup() does;
+// the cache is a static, as RTC memory is across deep sleep.
+static uint32_t connectMqtt(const char* phase) {
+    unsigned long start = millis();
+    mqtt.begin("bench-ap", "bench-pass", "broker.local", 1883, "alerttx1-bench");
+    while (!mqtt.isMqttConnected() && millis() - start < 10000) runFor(10);
+    if (!mqtt.isMqttConnected()) {
+        fprintf(stderr, "wifi_fast_reconnect: no MQTT connection (%s)\n", phase);
+        _exit(1);
+    }
+    return millis() - start;
+}
+
+static void sleepAndWake() {
+    WiFi.disconnect();
+    HostBroker::setOnline(false);
+    HostBroker::setOnline(true);
+    runFor(100);
+}
+
+static void scenarioWifiFastReconnect() {
+    boot();
+    HostHooks::wifiApChannel = 6;
+    uint32_t coldMs = connectMqtt("cold boot");
+    recorder->metric("coldConnectMs", coldMs);
+
+    sleepAndWake();
+    uint32_t wakeMs = connectMqtt("wake");
+    recorder->metric("wakeConnectMs", wakeMs);
+
+    HostHooks::wifiApChannel = 11;       // AP changed channel while asleep
+    sleepAndWake();
+    uint32_t movedMs = connectMqtt("AP moved");
+    recorder->metric("fallbackConnectMs", movedMs);
+
+    // The cached path must stay a few hundred ms, well under the full one
+    if (wakeMs > 300 || wakeMs * 5 > coldMs || WifiCache::getLastMqttMs(true) == 0) {
+        fprintf(stderr, "wifi_fast_reconnect: cold %u ms, wake %u ms, AP moved %u ms\n",
+                (unsigned)coldMs, (unsigned)wakeMs, (unsigned)movedMs);
+        _exit(1);
+    }
+    recorder->snapshot("connected");
+}
+
+// Periodic timer wakes (PowerManager + checkAlertsInBackground). The device
+// connects once on a cold boot, then sleeps; each wake runs setup() again as
+// a reset would, with the timer as wake cause. Deep sleep throws back to the
+// scenario. RAM does not survive deep sleep, so the sketch state setup()
+// relies on is reset between wakes; RTC-held state (link cache, wake stats,
+// redelivery filter) and the flash log carry over.
+struct DeepSleepReached {
+    uint64_t timerUs;
+};
+
+static void throwOnDeepSleep(uint64_t timerUs) { throw DeepSleepReached{timerUs}; }
+
+static void enterSleep(uint64_t timerUs) {
+    WiFi.disconnect();
+    HostBroker::setOnline(false);    // The broker sees the link drop
+    HostBroker::setOnline(true);
+    HostClock::sleepUs(timerUs);
+}
+
+// One timer wake; true if the device went straight back to sleep
+static bool timerWake() {
+    HostHooks::wakeCause = ESP_SLEEP_WAKEUP_TIMER;
+    alertPipelineReady = false;
+    try {
+        setup();
+    } catch (const DeepSleepReached& sleep) {
+        enterSleep(sleep.timerUs);
+        return true;
+    }
+    return false;
+}
+
+// Cold boot on battery with saved Wi-Fi and MQTT settings: full connect,
+// persistent session, link cached, then the first deep sleep
+static void bootAndSleep() {
+    SettingsManager::begin();
+    SettingsManager::setWifiSsid("bench-ap");
+    SettingsManager::setWifiPassword("bench-pass");
+    SettingsManager::setMqttBroker("broker.local");
+    SettingsManager::setMqttClientId("alerttx1-bench");
+    SettingsManager::setMqttSubscribeTopic("alerts/#");
+    HostHooks::wifiApChannel = 6;
+    HostHooks::deepSleepHook = throwOnDeepSleep;
+    HostHooks::batteryMv = 3800;           // On USB power it would not sleep
+
+    boot();
+    unsigned long start = millis();
+    while (!mqtt.isMqttConnected() && millis() - start < 10000) runFor(10);
+    try {
+        PowerManager::requestSleepNow();
+    } catch (const DeepSleepReached& sleep) {
+        enterSleep(sleep.timerUs);
+    }
+}
+
+static void scenarioPeriodicWake() {
+    bootAndSleep();
+
+    // Nothing queued: connect, find the queue empty, sleep again
+    bool slept = timerWake();
+    uint32_t idleMs = PowerManager::getLastWakeActiveMs();
+    recorder->metric("idleWakeActiveMs", idleMs);
+    if (!slept || idleMs > 1000) {
+        fprintf(stderr, "periodic_wake: idle wake %s after %u ms\n", slept ? "slept" : "stayed up", (unsigned)idleMs);
+        _exit(1);
+    }
+
+    // AP gone: the wake gives up at the budget instead of scanning on
+    HostHooks::wifiApChannel = 0;
+    slept = timerWake();
+    uint32_t noApMs = PowerManager::getLastWakeActiveMs();
+    recorder->metric("noNetworkWakeActiveMs", noApMs);
+    if (!slept || noApMs > BACKGROUND_WAKE_BUDGET_MS + 100) {
+        fprintf(stderr, "periodic_wake: no-AP wake %s after %u ms\n", slept ? "slept" : "stayed up", (unsigned)noApMs);
+        _exit(1);
+    }
+    HostHooks::wifiApChannel = 6;
+
+    // AP back: the cache was dropped, so a full connect learns it again
+    slept = timerWake();
+    uint32_t recoverMs = PowerManager::getLastWakeActiveMs();
+    recorder->metric("recoveryWakeActiveMs", recoverMs);
+    if (!slept || recoverMs >= BACKGROUND_WAKE_BUDGET_MS) {
+        fprintf(stderr, "periodic_wake: recovery wake %s after %u ms\n", slept ? "slept" : "stayed up",
+                (unsigned)recoverMs);
+        _exit(1);
+    }
+
+    // Alerts arrived while asleep: stored in the background, then the screen
+    // comes on with the newest as a popup
+    HostBroker::publish("alerts/db", alertJson("Replica lag 45s", "db-03 is 45 s behind the primary",
+                                               "2025-01-15T16:00:00Z", 0, "evt-0101"), 1);
+    HostBroker::publish("alerts/db", alertJson("Disk space low", "Volume /var on db-02 is 91% full",
+                                               "2025-01-15T16:02:00Z", 0, "evt-0102"), 1);
+    slept = timerWake();
+    uint32_t alertMs = PowerManager::getLastWakeActiveMs();
+    recorder->metric("alertWakeActiveMs", alertMs);
+    if (slept || !PowerManager::hasNewMessagesOnWake() || HostBroker::queued("alerttx1-bench") != 0) {
+        fprintf(stderr, "periodic_wake: alert wake %s, %u still queued\n", slept ? "slept" : "stayed up",
+                (unsigned)HostBroker::queued("alerttx1-bench"));
+        _exit(1);
+    }
+    OverdrawAnalyzer::begin(tft.width(), tft.height());
+    runFor(1000);
+    recorder->snapshot("woken");
+    click(BUTTON_A_PIN);                 // Dismiss the popup
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts
+    recorder->snapshot("list");
+}
+
+// Timer wakes without the flash log (no "alertlog" or "ffat" partition): the
+// background path cannot store alerts, so it must not ack them into nothing.
+// An empty queue still means straight back to sleep; two alerts queued while
+// asleep bring the screen up and both reach it
+static void scenarioWakeNoLog() {
+    HostHooks::alertLogPresent = false;
+    bootAndSleep();
+
+    bool idleSlept = timerWake();
+    HostBroker::publish("alerts/db", alertJson("Replica lag 45s", "db-03 is 45 s behind the primary",
+                                               "2025-01-15T16:00:00Z", 0, "evt-0101"), 1);
+    HostBroker::publish("alerts/db", alertJson("Disk space low", "Volume /var on db-02 is 91% full",
+                                               "2025-01-15T16:02:00Z", 0, "evt-0102"), 1);
+    bool alertSlept = timerWake();
+    if (!alertSlept) runFor(2000);
+    uint32_t shown = 0;
+    for (uint8_t p = AlertWire::PRIORITY_LOW; p <= AlertWire::PRIORITY_CRITICAL; p++) shown += AlertQueue::getShown(p);
+    if (!idleSlept || alertSlept || shown == 0 || AlertQueue::size() != 0 || HostBroker::queued("alerttx1-bench") != 0) {
+        fprintf(stderr, "wake_no_log: idle wake %s, alert wake %s, %u shown, %u in AlertQueue, %u still queued\n",
+                idleSlept ? "slept" : "stayed up", alertSlept ? "slept" : "stayed up", (unsigned)shown,
+                (unsigned)AlertQueue::size(), (unsigned)HostBroker::queued("alerttx1-bench"));
+        _exit(1);
+    }
+    recorder->snapshot("woken");
+    click(BUTTON_A_PIN);                 // Dismiss the popup
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts: both rows
+    recorder->snapshot("list");
+}
+
+// Device health telemetry: a fleet client on the status topic sees one
+// message per interval while the device is online. While the broker is
+// unreachable for two intervals nothing is sent; after the reconnect one
+// message covers the whole outage
+static bool nextTelemetry(DynamicJsonDocument& doc, std::string& raw) {
+    HostBroker::Message message;
+    if (!HostBroker::next("fleet-monitor", message)) return false;
+    raw = message.payload;
+    return !deserializeJson(doc, raw.c_str(), raw.size());
+}
+
+static void scenarioTelemetry() {
+    SettingsManager::begin();
+    SettingsManager::setTelemetryIntervalMs(60000);
+    boot();
+    HostHooks::wifiConnected = true;
+    mqtt.begin("bench-ap", "", "broker.local", 1883, "alerttx1-bench");
+    mqtt.subscribe("alerts/#");
+    HostBroker::connect("fleet-monitor", true);
+    HostBroker::subscribe("fleet-monitor", "alerttx1/status", 0);
+
+    publish("Disk space low", "Volume /var on db-02 is 91% full", "2025-01-15T17:00:00Z");
+    click(BUTTON_A_PIN);                 // Dismiss the popup
+    click(BUTTON_C_PIN);                 // Main menu -> Alerts
+    click(BUTTON_B_PIN);
+
+    // With less room than the message needs (a long topic), it goes out
+    // without the frame histogram instead of not at all
+    char message[Telemetry::PACKET_SIZE];
+    size_t full = Telemetry::format(message, sizeof(message));
+    size_t compact = Telemetry::format(message, full);
+    DynamicJsonDocument tight(1024);
+    if (compact == 0 || compact >= full || deserializeJson(tight, message) || !tight["fh"].isNull() || tight["f"].isNull()) {
+        fprintf(stderr, "telemetry: %u-byte message in %u bytes gave %u: %s\n", (unsigned)full, (unsigned)full,
+                (unsigned)compact, compact ? message : "");
+        _exit(1);
+    }
+    runFor(60000);
+
+    DynamicJsonDocument first(1024), second(1024);
+    std::string firstRaw, secondRaw;
+    bool gotFirst = nextTelemetry(first, firstRaw);
+    uint32_t histogram = 0;
+    for (int i = 0; i < Telemetry::FRAME_BUCKETS; i++) histogram += first["fh"][i].as<unsigned long>();
+    if (!gotFirst || Telemetry::getPublished() != 1 || first["a"].as<int>() != 1 || first["f"][0].as<unsigned long>() == 0 ||
+        histogram != first["f"][0].as<unsigned long>() || first["r"].isNull() || first["h"].isNull()) {
+        fprintf(stderr, "telemetry: first window wrong (%u published): %s\n", (unsigned)Telemetry::getPublished(),
+                firstRaw.c_str());
+        _exit(1);
+    }
+    recorder->metric("messageBytes", firstRaw.size());
+    recorder->metric("frames", first["f"][0].as<unsigned long>());
+
+    HostBroker::setOnline(false);
+    publish("Replica lag 45s", "db-03 is 45 s behind the primary", "2025-01-15T17:02:00Z");
+    click(BUTTON_A_PIN);
+    runFor(130000);
+    HostBroker::setOnline(true);
+    HostBroker::connect("fleet-monitor", true);    // Its clean session went with the outage
+    HostBroker::subscribe("fleet-monitor", "alerttx1/status", 0);
+    uint32_t offlinePublished = Telemetry::getPublished();
+    runFor(5000);                        // Reconnect (3 s backoff)
+
+    bool gotSecond = nextTelemetry(second, secondRaw);
+    if (offlinePublished != 1 || !gotSecond || Telemetry::getPublished() != 2 || second["s"].as<unsigned long>() < 130 ||
+        second["a"].as<int>() != 1) {
+        fprintf(stderr, "telemetry: outage window wrong (%u published offline): %s\n", (unsigned)offlinePublished,
+                secondRaw.c_str());
+        _exit(1);
+    }
+    recorder->metric("outageWindowS", second["s"].as<unsigned long>());
+    recorder->snapshot("online");
+}
+
+// Alert priorities over the broker (alerts/<priority>, or "priority" in the
+// JSON). During a game a high alert only adds its row; a critical one pops
+// up over the game within a frame or two. A burst of low alerts published
+// with one critical: the critical is shown first, the lows follow in one
+// batch once the oldest has waited AlertQueue::LOW_BATCH_MS
+static void publishPriority(const char* topic, const char* priority, const char* title, const char* message,
+                            const char* timestamp) {
+    std::string payload = alertJson(title, message, timestamp);
+    if (priority) payload.insert(1, std::string("\"priority\":\"") + priority + "\",");
+    HostBroker::publish(topic, payload, 1);
+}
+
+static void scenarioAlertPriority() {
+    boot();
+    HostHooks::wifiConnected = true;
+    mqtt.begin("bench-ap", "", "broker.local", 1883, "alerttx1-bench");
+    mqtt.subscribe("alerts/#");
+    runFor(500);
+
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // Games
+    click(BUTTON_B_PIN);
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // BeeperHero
+    click(BUTTON_C_PIN);                 // First song
+    runFor(1000);
+    Screen* game = screenManager->getCurrentScreen();
+
+    publishPriority("alerts/high", nullptr, "Replica lag 45s", "db-03 is 45 s behind the primary", "2025-01-15T18:00:00Z");
+    runFor(300);
+    bool stayed = screenManager->getCurrentScreen() == game && AlertQueue::getShown(AlertWire::PRIORITY_HIGH) == 1;
+    recorder->snapshot("high_in_game");
+    publishPriority("alerts", "critical", "Checkout down", "Payments failing in every region", "2025-01-15T18:01:00Z");
+    runFor(300);
+    if (!stayed || !game->holdsAlerts() || screenManager->getCurrentScreen() != alertNotificationScreen ||
+        AlertQueue::getShown(AlertWire::PRIORITY_CRITICAL) != 1) {
+        fprintf(stderr, "alert_priority: game stayed %d, critical shown %u\n", stayed,
+                (unsigned)AlertQueue::getShown(AlertWire::PRIORITY_CRITICAL));
+        _exit(1);
+    }
+    recorder->snapshot("critical_over_game");
+    click(BUTTON_A_PIN);                 // Dismiss, back to the game
+    holdBack();                          // Leave the game
+
+    char title[48];
+    char ts[32];
+    for (unsigned i = 0; i < 6; i++) {
+        snprintf(title, sizeof(title), "Cache miss rate %u%%", 20 + i);
+        snprintf(ts, sizeof(ts), "2025-01-15T18:%02u:00Z", 10 + i);
+        publishPriority("alerts/low", nullptr, title, "Above the 15% budget", ts);
+    }
+    publishPriority("alerts/critical", nullptr, "Primary DB unreachable", "db-01 stopped answering", "2025-01-15T18:20:00Z");
+    runFor(300);
+    bool criticalFirst = AlertQueue::getShown(AlertWire::PRIORITY_CRITICAL) == 2 &&
+                         AlertQueue::getShown(AlertWire::PRIORITY_LOW) == 0 && AlertQueue::size() == 6;
+    recorder->snapshot("critical_first");
+    runFor(1500);
+    if (!criticalFirst || AlertQueue::getShown(AlertWire::PRIORITY_LOW) != 1 || AlertQueue::getLowBatches() != 1 ||
+        AlertQueue::getPreempted() < 1 || AlertQueue::size() != 0 || AlertQueue::getDropped() != 0 ||
+        AlertQueue::getMaxLatencyUs(AlertWire::PRIORITY_CRITICAL) > 20000) {
+        fprintf(stderr, "alert_priority: critical first %d, %u low batches, %u preempted, %u queued\n", criticalFirst,
+                (unsigned)AlertQueue::getLowBatches(), (unsigned)AlertQueue::getPreempted(), (unsigned)AlertQueue::size());
+        _exit(1);
+    }
+    recorder->metric("criticalLatencyMaxUs", AlertQueue::getMaxLatencyUs(AlertWire::PRIORITY_CRITICAL));
+    recorder->metric("lowLatencyMaxMs", AlertQueue::getMaxLatencyUs(AlertWire::PRIORITY_LOW) / 1000);
+    recorder->snapshot("after_batch");
+}
+
+// The global player's timeline against the buzzer: the lookahead cursor
+// read at the start of a song lists exactly the tones that then play, each
+// at its song time, and getCurrentNote() follows along
+struct ToneCall {
+    uint64_t atUs;
+    unsigned int frequency;
+    uint8_t channel;        // ToneSequencer channel with the buzzer
+};
+static std::vector<ToneCall> toneCalls;
+
+static void recordTone(uint8_t pin, unsigned int frequency, unsigned long durationMs) {
+    if (frequency) toneCalls.push_back({HostClock::nowUs(), frequency, ToneSequencer::getActiveChannel()});
+}
+
+// Every note of the player's song from the one under way (or the first)
+static std::vector<NoteInfo> plannedNotes(const RingtonePlayer& player) {
+    std::vector<NoteInfo> planned;
+    NoteCursor cursor = player.getLookahead();
+    if (cursor.index > 0) planned.push_back(player.getCurrentNote());
+    NoteInfo note;
+    while (player.readNote(cursor, note)) planned.push_back(note);
+    return planned;
+}
+
+// Exact song time in µs at which event `events` starts (the song's length
+// for all of them); NoteInfo times are whole ms, rounded down
+static uint64_t songTimeUs(int index, uint16_t events) {
+    const RingtoneEntry* entry = getRingtoneEntry(index);
+    uint32_t ticks = 0;
+    for (uint16_t i = 0; i < events; i++) ticks += pgm_read_byte(&entry->events[i * 2 + 1]);
+    return (uint64_t)ticks * entry->whole_note_us / RINGTONE_TICKS_PER_WHOLE;
+}
+
+static const uint64_t ONSET_LATE_MAX_US = 1000;
+
+// Plays Mario; with blockMs, every 50 ms of loop passes is followed by the
+// loop stuck for blockMs (a slow draw or an MQTT reconnect)
+static void playTimeline(int blockMs) {
+    boot();
+    int song = ringtonePlayer.findRingtoneIndex("Mario");
+    HostHooks::toneHook = recordTone;
+    ToneSequencer::resetStats();
+    uint64_t startUs = HostClock::nowUs();
+    unsigned long startMs = millis();
+    ringtonePlayer.playRingtoneByIndex(song);
+    std::vector<NoteInfo> planned = plannedNotes(ringtonePlayer);
+
+    // The note info is the loop's view: how late a pass first sees a note is
+    // how late a loop-driven buzzer would have started it
+    uint32_t mismatched = 0;
+    uint16_t lastIndex = 0;
+    unsigned long loopLateMaxMs = 0;
+    uint64_t nextBlockUs = startUs + 50000;
+    while (ringtonePlayer.isPlaying()) {
+        unsigned long songMs = millis() - startMs;
+        recorder->pass(loop);
+        HostClock::advanceUs(LOOP_STEP_US);
+        NoteInfo now = ringtonePlayer.getCurrentNote();
+        if (ringtonePlayer.isPlaying()) {
+            if (now.index < lastIndex || songMs < now.startTime) mismatched++;
+            if (now.index != lastIndex && songMs - now.startTime > loopLateMaxMs) loopLateMaxMs = songMs - now.startTime;
+        }
+        lastIndex = now.index;
+        if (blockMs && HostClock::nowUs() >= nextBlockUs) {
+            HostClock::advanceMs(blockMs);
+            nextBlockUs = HostClock::nowUs() + 50000;
+        }
+    }
+
+    size_t call = 0;
+    uint64_t maxLateUs = 0;
+    unsigned long lengthMs = 0;
+    for (const NoteInfo& p : planned) {
+        lengthMs = p.startTime + p.duration;
+        if (p.isRest) continue;
+        uint64_t dueUs = startUs + songTimeUs(song, p.index);
+        if (call >= toneCalls.size() || toneCalls[call].frequency != p.frequency ||
+            toneCalls[call].atUs < dueUs || toneCalls[call].atUs - dueUs > ONSET_LATE_MAX_US) {
+            mismatched++;
+        } else if (toneCalls[call].atUs - dueUs > maxLateUs) {
+            maxLateUs = toneCalls[call].atUs - dueUs;
+        }
+        call++;
+    }
+    if (mismatched || call != toneCalls.size() || lengthMs != getRingtoneLengthMs(song) ||
+        planned.size() != getRingtoneEntry(song)->event_count) {
+        fprintf(stderr, "timeline: %u mismatches, %u planned notes, %u tones, %lu ms planned\n",
+                (unsigned)mismatched, (unsigned)planned.size(), (unsigned)toneCalls.size(), lengthMs);
+        _exit(1);
+    }
+    recorder->metric("notes", toneCalls.size());
+    recorder->metric("lengthMs", lengthMs);
+    recorder->metric("onsetLateMaxUs", maxLateUs);
+    recorder->metric("jitterMaxUs", ToneSequencer::getMaxLateUs());
+    recorder->metric("skipped", ToneSequencer::getSkipped());
+    recorder->metric("loopLateMaxMs", loopLateMaxMs);
+}
+
+static void scenarioRingtoneTimeline() {
+    playTimeline(0);
+}
+
+static void scenarioAudioBusyLoop() {
+    playTimeline(250);
+}
+
+// Onsets of one channel's tones [from, to) against `planned` notes of
+// `song` from `first` on, each due at baseUs plus its song time. Returns
+// the latest
+static uint64_t checkOnsets(uint8_t channel, int song, const std::vector<NoteInfo>& planned, size_t first, uint64_t baseUs,
+                            uint64_t fromUs, uint64_t toUs, uint32_t& mismatched) {
+    size_t call = 0;
+    while (call < toneCalls.size() && (toneCalls[call].channel != channel || toneCalls[call].atUs < fromUs)) call++;
+    uint64_t maxLateUs = 0;
+    for (size_t i = first; i < planned.size(); i++) {
+        if (planned[i].isRest) continue;
+        uint64_t dueUs = baseUs + songTimeUs(song, planned[i].index);
+        if (call >= toneCalls.size() || toneCalls[call].channel != channel || toneCalls[call].atUs >= toUs ||
+            toneCalls[call].frequency != planned[i].frequency || toneCalls[call].atUs < dueUs ||
+            toneCalls[call].atUs - dueUs > ONSET_LATE_MAX_US) {
+            mismatched++;
+            return maxLateUs;
+        }
+        if (toneCalls[call].atUs - dueUs > maxLateUs) maxLateUs = toneCalls[call].atUs - dueUs;
+        call++;
+    }
+    if (call < toneCalls.size() && toneCalls[call].channel == channel && toneCalls[call].atUs < toUs) mismatched++;
+    return maxLateUs;
+}
+
+// A game song on the game channel; an alert ringtone mid-note preempts it
+// and a preview asked for meanwhile waits behind both. The game picks up
+// from the held note once the alert is done, the preview plays from the top
+// once the game is done, and a click gets through only when all are
+static void scenarioAudioPreempt() {
+    boot();
+    static RingtonePlayer game(ToneSequencer::CHANNEL_GAME);
+    game.begin(BUZZER_PIN);
+    HostHooks::toneHook = recordTone;
+    ToneSequencer::resetStats();
+    auto step = []() {
+        recorder->pass(loop);
+        game.update();
+        HostClock::advanceUs(LOOP_STEP_US);
+    };
+
+    int gameSong = game.findRingtoneIndex("Digimon");
+    game.playRingtoneByIndex(gameSong);
+    uint64_t gameStartUs = HostClock::nowUs();
+    std::vector<NoteInfo> gamePlan = plannedNotes(game);
+    size_t heldNote = 0;                 // Middle of the note under way at 2.5 s
+    while (heldNote + 1 < gamePlan.size() && gamePlan[heldNote + 1].startTime <= 2500) heldNote++;
+    unsigned long preemptAtMs = gamePlan[heldNote].startTime + gamePlan[heldNote].duration / 2;
+    while (game.getPlaybackTime() < preemptAtMs) step();
+    bool clickDropped = !ToneSequencer::beep(2000, 20);
+
+    int alertSong = ringtonePlayer.findRingtoneIndex("Desk Phone");
+    uint64_t alertStartUs = HostClock::nowUs();
+    ringtonePlayer.playRingtoneByIndex(alertSong);
+    std::vector<NoteInfo> alertPlan = plannedNotes(ringtonePlayer);
+    int64_t heldAtUs = game.getPlaybackTimeUs();
+    uint16_t heldIndex = game.getNoteIndex();
+    int previewSong = previewPlayer.findRingtoneIndex("Kim Possible");
+    previewPlayer.playRingtoneByIndex(previewSong);
+    std::vector<NoteInfo> previewPlan = plannedNotes(previewPlayer);
+    bool held = game.isHeld() && previewPlayer.isHeld() && !ringtonePlayer.isHeld() &&
+                ToneSequencer::getActiveChannel() == ToneSequencer::CHANNEL_ALERT;
+    recorder->snapshot("alert_over_game");
+
+    bool frozen = true;
+    while (ringtonePlayer.isPlaying()) {
+        step();
+        if (ringtonePlayer.isPlaying() && (game.getPlaybackTimeUs() != heldAtUs || game.getNoteIndex() != heldIndex)) frozen = false;
+    }
+    bool gameBack = !game.isHeld() && previewPlayer.isHeld() &&
+                    ToneSequencer::getActiveChannel() == ToneSequencer::CHANNEL_GAME;
+    while (game.isPlaying()) step();
+    uint64_t previewStartUs = HostClock::nowUs();
+    bool previewBack = !previewPlayer.isHeld() && ToneSequencer::getActiveChannel() == ToneSequencer::CHANNEL_PREVIEW;
+    while (previewPlayer.isPlaying()) step();
+    bool clickPlayed = ToneSequencer::beep(2000, 20);
+    runFor(100);
+
+    // The game up to the hold on its own schedule; after it, the held note
+    // again (the rest of it) and the notes after it shifted by the hold
+    uint32_t mismatched = 0;
+    std::vector<NoteInfo> beforeHold(gamePlan.begin(), gamePlan.begin() + heldNote + 1);
+    uint64_t lateUs = checkOnsets(ToneSequencer::CHANNEL_GAME, gameSong, beforeHold, 0, gameStartUs, 0, alertStartUs, mismatched);
+    // The buzzer comes back when the alert ends (the loop wakes for its
+    // last note); the game's time went on from heldAtUs at that instant
+    uint64_t alertEndUs = alertStartUs + songTimeUs(alertSong, getRingtoneEntry(alertSong)->event_count);
+    std::vector<const ToneCall*> resumed;
+    for (const ToneCall& call : toneCalls) {
+        if (call.channel == ToneSequencer::CHANNEL_GAME && call.atUs > alertStartUs) resumed.push_back(&call);
+    }
+    size_t next = 0;
+    if (!gamePlan[heldNote].isRest) {
+        if (resumed.empty() || resumed[0]->frequency != gamePlan[heldNote].frequency ||
+            resumed[0]->atUs + ONSET_LATE_MAX_US < alertEndUs || resumed[0]->atUs > alertEndUs + ONSET_LATE_MAX_US) {
+            mismatched++;
+        }
+        next = 1;
+    }
+    size_t afterFirst = heldNote + 1;
+    while (afterFirst < gamePlan.size() && gamePlan[afterFirst].isRest) afterFirst++;
+    uint64_t shiftUs = 0;
+    if (next < resumed.size()) shiftUs = resumed[next]->atUs - gameStartUs - songTimeUs(gameSong, afterFirst);
+    uint64_t holdUs = alertEndUs - gameStartUs - (uint64_t)heldAtUs;
+    if (shiftUs + ONSET_LATE_MAX_US < holdUs || shiftUs > holdUs + 2 * ONSET_LATE_MAX_US) mismatched++;
+    uint64_t late = checkOnsets(ToneSequencer::CHANNEL_GAME, gameSong, gamePlan, afterFirst, gameStartUs + shiftUs,
+                                gameStartUs + shiftUs + songTimeUs(gameSong, afterFirst),
+                                previewStartUs, mismatched);
+    if (late > lateUs) lateUs = late;
+    late = checkOnsets(ToneSequencer::CHANNEL_ALERT, alertSong, alertPlan, 0, alertStartUs, 0, UINT64_MAX, mismatched);
+    if (late > lateUs) lateUs = late;
+    uint64_t previewBaseUs = 0;
+    for (const ToneCall& call : toneCalls) {
+        if (call.channel == ToneSequencer::CHANNEL_PREVIEW) {
+            previewBaseUs = call.atUs;
+            break;
+        }
+    }
+    if (previewBaseUs + LOOP_STEP_US < previewStartUs) mismatched++;
+    checkOnsets(ToneSequencer::CHANNEL_PREVIEW, previewSong, previewPlan, 0, previewBaseUs - songTimeUs(previewSong, previewPlan[0].index),
+                0, UINT64_MAX, mismatched);
+
+    if (!held || !frozen || !gameBack || !previewBack || !clickDropped || !clickPlayed || mismatched ||
+        ToneSequencer::getPreemptions() != 1 || heldIndex != heldNote) {
+        fprintf(stderr, "audio_preempt: held %d frozen %d game back %d preview back %d click %d/%d, %u mismatches, "
+                "shift %llu ms, %u preemptions, held note %u of %u\n", held, frozen, gameBack, previewBack, clickDropped,
+                clickPlayed, (unsigned)mismatched, (unsigned long long)(shiftUs / 1000),
+                (unsigned)ToneSequencer::getPreemptions(), (unsigned)heldIndex, (unsigned)heldNote);
+        _exit(1);
+    }
+    recorder->metric("preemptions", ToneSequencer::getPreemptions());
+    recorder->metric("heldNote", heldIndex);
+    recorder->metric("holdShiftMs", shiftUs / 1000);
+    recorder->metric("onsetLateMaxUs", lateUs);
+    recorder->metric("skipped", ToneSequencer::getSkipped());
+    recorder->snapshot("done");
+}
+
+// BeeperHero mid-song, then a critical alert: its popup covers the game and
+// its ringtone takes the buzzer. Under the popup the song is paused at the
+// note it was on, with its channel kept. The popup is dismissed while the
+// ringtone still plays; once that ends the song carries on from where it
+// was: that note again, then the notes after it on the song's own schedule
+static void scenarioGamePopupHold() {
+    boot();
+    HostHooks::wifiConnected = true;
+    mqtt.begin("bench-ap", "", "broker.local", 1883, "alerttx1-bench");
+    mqtt.subscribe("alerts/#");
+    runFor(500);
+
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // Games
+    click(BUTTON_B_PIN);
+    click(BUTTON_B_PIN);
+    click(BUTTON_C_PIN);                 // BeeperHero
+    click(BUTTON_C_PIN);                 // First song
+    runFor(4000);
+    Screen* game = screenManager->getCurrentScreen();
+    const RingtonePlayer& song = static_cast<BeeperHeroScreen*>(game)->getPlayer();
+    bool playing = song.isPlaying() && ToneSequencer::isOwner(&song);
+    HostHooks::toneHook = recordTone;
+
+    publishPriority("alerts/critical", nullptr, "Checkout down", "Payments failing in every region",
+                    "2025-01-15T18:01:00Z");
+    runFor(300);
+    uint64_t coverUs = HostClock::nowUs();
+    int64_t pausedUs = song.getPlaybackTimeUs();
+    uint16_t heldIndex = song.getNoteIndex();
+    std::vector<NoteInfo> plan = plannedNotes(song);
+    bool paused = screenManager->getCurrentScreen() == alertNotificationScreen && song.isPaused() &&
+                  !plan.empty() && plan[0].index == heldIndex;
+    recorder->snapshot("popup_over_game");
+    runFor(2000);
+    bool frozen = screenManager->getCurrentScreen() == alertNotificationScreen && song.isPaused() &&
+                  song.getPlaybackTimeUs() == pausedUs && song.getNoteIndex() == heldIndex &&
+                  ringtonePlayer.isPlaying() && ToneSequencer::getActiveChannel() == ToneSequencer::CHANNEL_ALERT;
+
+    uint64_t dismissUs = HostClock::nowUs();
+    click(BUTTON_A_PIN);                 // Dismiss, back to the game
+    bool back = screenManager->getCurrentScreen() == game && song.isPlaying() && song.isHeld();
+    while (song.isPlaying()) runFor(100);
+    uint64_t lastAlertUs = 0;
+    for (const ToneCall& call : toneCalls) {
+        if (call.channel == ToneSequencer::CHANNEL_ALERT) lastAlertUs = call.atUs;
+    }
+    size_t gameTonesHeld = 0;
+    for (const ToneCall& call : toneCalls) {
+        if (call.channel == ToneSequencer::CHANNEL_GAME && call.atUs >= coverUs && call.atUs <= lastAlertUs) gameTonesHeld++;
+    }
+
+    // The first game tone after the popup is the held note again (or, on a
+    // rest, the note after it); the others follow at their song times
+    uint32_t mismatched = 0;
+    size_t first = 0;
+    while (first < plan.size() && plan[first].isRest) first++;
+    const ToneCall* resumed = nullptr;
+    for (const ToneCall& call : toneCalls) {
+        if (call.channel == ToneSequencer::CHANNEL_GAME && call.atUs >= coverUs) {
+            resumed = &call;
+            break;
+        }
+    }
+    if (!resumed || first >= plan.size() || resumed->frequency != plan[first].frequency) {
+        mismatched++;
+    } else {
+        int64_t firstAtUs = first == 0 ? pausedUs : (int64_t)songTimeUs(0, plan[first].index);
+        uint64_t baseUs = resumed->atUs - (uint64_t)firstAtUs;
+        checkOnsets(ToneSequencer::CHANNEL_GAME, 0, plan, first + 1, baseUs, resumed->atUs + 1, UINT64_MAX, mismatched);
+    }
+
+    if (!playing || !paused || !frozen || !back || gameTonesHeld || mismatched) {
+        fprintf(stderr, "game_popup_hold: playing %d paused %d frozen %d back %d, %u game tones during the alert, "
+                "%u mismatches\n", playing, paused, frozen, back, (unsigned)gameTonesHeld, (unsigned)mismatched);
+        _exit(1);
+    }
+    recorder->metric("heldNote", heldIndex);
+    recorder->metric("heldAfterDismissMs", (lastAlertUs - dismissUs) / 1000);
+}
+
+// Every player begins on the buzzer pin: the alert and preview players at
+// boot, BeeperHero's when its screen opens. A begin on a pin already set
+// up must leave it on LEDC; a pinMode() there detaches it and every tone
+// after that is dropped
+static void scenarioBuzzerRebegin() {
+    boot();
+    bool afterBoot = HostHooks::ledcAttached[BUZZER_PIN];
+    static RingtonePlayer game(ToneSequencer::CHANNEL_GAME);
+    game.begin(BUZZER_PIN);
+    ringtonePlayer.setBuzzerPin(BUZZER_PIN);
+    bool afterBegin = HostHooks::ledcAttached[BUZZER_PIN];
+    HostHooks::toneHook = recordTone;
+    bool beeped = ToneSequencer::beep(2000, 20);
+    runFor(100);
+    if (!afterBoot || !afterBegin || !beeped || toneCalls.size() != 1 || toneCalls[0].frequency != 2000) {
+        fprintf(stderr, "buzzer_rebegin: attached after boot %d, after begin %d, beep %d, %u tones\n",
+                afterBoot, afterBegin, beeped, (unsigned)toneCalls.size());
+        _exit(1);
+    }
+    recorder->metric("tones", toneCalls.size());
+}
+
+// Every RTTTL file in data/ringtones played on the global player, once with
+// a clean loop and once with the loop stalled like audio_busy_loop. Each
+// run is rendered to a WAV next to the report (audio/<file>.wav and
+// <file>_stalled.wav) with its note timeline as CSV, and compared with the
+// RTTTL spec: onset, note length, song length and tempo error, pitch in
+// cents. stallShiftMaxUs is how far the stalls moved any note against the
+// clean run. Any wrong pitch, or a timing error of a ms or more, fails
+static const uint32_t RENDER_SAMPLE_RATE = 22050;
+static const int RENDER_STALL_MS = 250;
+static const uint64_t RENDER_ERR_MAX_US = 1000;
+static const uint32_t RENDER_CENTS_MAX = 10;     // Whole-Hz table, C3 and up
+static std::vector<AudioRender::Change> renderChanges;
+
+static void renderTone(uint8_t pin, unsigned int frequency, unsigned long durationMs) {
+    renderChanges.push_back({HostClock::nowUs(), (uint16_t)frequency});
+}
+
+static uint64_t renderSong(int song, int stallMs) {
+    renderChanges.clear();
+    uint64_t startUs = HostClock::nowUs();
+    ringtonePlayer.playRingtoneByIndex(song);
+    uint64_t nextStallUs = startUs + 50000;
+    while (ringtonePlayer.isPlaying()) {
+        recorder->pass(loop);
+        HostClock::advanceUs(LOOP_STEP_US);
+        if (stallMs && HostClock::nowUs() >= nextStallUs) {
+            HostClock::advanceMs(stallMs);
+            nextStallUs = HostClock::nowUs() + 50000;
+        }
+    }
+    return startUs;
+}
+
+static bool writeRender(const std::string& base, uint64_t startUs, uint64_t endUs, const AudioRender::Analysis& analysis) {
+    std::vector<uint8_t> pcm = AudioRender::render(renderChanges, startUs, endUs, RENDER_SAMPLE_RATE);
+    return WavWriter::write((base + ".wav").c_str(), pcm.data(), pcm.size(), RENDER_SAMPLE_RATE) &&
+           AudioRender::writeTimeline((base + ".csv").c_str(), analysis);
+}
+
+static uint64_t absDiff(int64_t a, int64_t b) {
+    return a > b ? (uint64_t)(a - b) : (uint64_t)(b - a);
+}
+
+static void scenarioRingtoneRender() {
+    boot();
+    HostHooks::toneHook = renderTone;
+    std::vector<std::string> files;
+    if (DIR* dir = opendir(RINGTONE_DIR)) {
+        while (dirent* e = readdir(dir)) {
+            std::string file = e->d_name;
+            if (file.size() > 4 && file.compare(file.size() - 4, 4, ".txt") == 0) files.push_back(file);
+        }
+        closedir(dir);
+    }
+    std::sort(files.begin(), files.end());
+    std::string audioDir = recorder->getOutDir() + "/audio";
+    mkdir(audioDir.c_str(), 0755);
+    FILE* summary = fopen((audioDir + "/summary.csv").c_str(), "w");
+    if (files.empty() || !summary) {
+        fprintf(stderr, "ringtone_render: no ringtones in %s or no %s\n", RINGTONE_DIR, audioDir.c_str());
+        _exit(1);
+    }
+    fprintf(summary, "file,bpm,notes,missing,wrong_pitch,max_cents,onset_err_max_us,note_len_err_max_us,"
+                     "song_len_err_us,tempo_err_ppm,stalled_onset_err_max_us,stall_shift_max_us\n");
+
+    uint32_t notes = 0, missing = 0, wrongPitch = 0, maxCents = 0;
+    uint64_t onsetMax = 0, noteLenMax = 0, songLenMax = 0, stalledOnsetMax = 0, stallShiftMax = 0;
+    uint32_t tempoMaxPpm = 0;
+    for (const std::string& file : files) {
+        std::string text;
+        if (FILE* f = fopen((std::string(RINGTONE_DIR) + "/" + file).c_str(), "r")) {
+            char buf[512];
+            size_t n;
+            while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+            fclose(f);
+        }
+        // The generator names each entry after its file: mario.rtttl.txt is mario_rtttl
+        std::string id = file.substr(0, file.size() - 4);
+        for (char& ch : id) {
+            if (!isalnum((unsigned char)ch)) ch = '_';
+        }
+        int song = -1;
+        for (int i = 0; i < RINGTONE_COUNT; i++) {
+            if (id == getRingtoneEntry(i)->filename) song = i;
+        }
+        AudioRender::Spec spec;
+        if (song < 0 || !AudioRender::parseRtttl(text, spec)) {
+            fprintf(stderr, "ringtone_render: %s is not in ringtone_data.h or does not parse\n", file.c_str());
+            _exit(1);
+        }
+
+        uint64_t startUs = renderSong(song, 0);
+        AudioRender::Analysis clean = AudioRender::analyze(renderChanges, startUs, spec);
+        std::string base = audioDir + "/" + id;
+        bool written = writeRender(base, startUs, HostClock::nowUs(), clean);
+        startUs = renderSong(song, RENDER_STALL_MS);
+        AudioRender::Analysis stalled = AudioRender::analyze(renderChanges, startUs, spec);
+        written = written && writeRender(base + "_stalled", startUs, HostClock::nowUs(), stalled);
+        if (!written) {
+            fprintf(stderr, "ringtone_render: cannot write %s\n", base.c_str());
+            _exit(1);
+        }
+
+        uint64_t stallShift = 0;
+        for (size_t i = 0; i < clean.onsets.size() && i < stalled.onsets.size(); i++) {
+            stallShift = std::max(stallShift, absDiff(stalled.onsets[i].errorUs, clean.onsets[i].errorUs));
+        }
+        stallShift = std::max(stallShift, absDiff(stalled.songLenErrUs, clean.songLenErrUs));
+        uint64_t songLen = absDiff(clean.songLenErrUs, 0);
+        uint32_t tempoPpm = (uint32_t)absDiff(clean.tempoErrPpm, 0);
+        fprintf(summary, "%s,%u,%zu,%u,%u,%u,%llu,%llu,%lld,%d,%llu,%llu\n", id.c_str(), (unsigned)spec.bpm,
+                clean.onsets.size(), (unsigned)(clean.missing + stalled.missing), (unsigned)clean.wrongPitch,
+                (unsigned)clean.maxCents, (unsigned long long)clean.onsetErrMaxUs,
+                (unsigned long long)clean.noteLenErrMaxUs, (long long)clean.songLenErrUs, (int)clean.tempoErrPpm,
+                (unsigned long long)stalled.onsetErrMaxUs, (unsigned long long)stallShift);
+
+        notes += clean.onsets.size();
+        missing += clean.missing + stalled.missing;
+        wrongPitch += clean.wrongPitch;
+        maxCents = std::max(maxCents, clean.maxCents);
+        onsetMax = std::max(onsetMax, clean.onsetErrMaxUs);
+        noteLenMax = std::max(noteLenMax, clean.noteLenErrMaxUs);
+        songLenMax = std::max(songLenMax, songLen);
+        tempoMaxPpm = std::max(tempoMaxPpm, tempoPpm);
+        stalledOnsetMax = std::max(stalledOnsetMax, stalled.onsetErrMaxUs);
+        stallShiftMax = std::max(stallShiftMax, stallShift);
+    }
+    fclose(summary);
+
+    if (missing) {
+        fprintf(stderr, "ringtone_render: %u notes missing or extra, see %s/summary.csv\n", (unsigned)missing,
+                audioDir.c_str());
+        _exit(1);
+    }
+    uint64_t errMax = std::max({onsetMax, noteLenMax, songLenMax, stalledOnsetMax, stallShiftMax});
+    if (wrongPitch || maxCents > RENDER_CENTS_MAX || errMax >= RENDER_ERR_MAX_US) {
+        fprintf(stderr, "ringtone_render: %u wrong pitches, max %u cents, timing off by up to %llu us, see %s/summary.csv\n",
+                (unsigned)wrongPitch, (unsigned)maxCents, (unsigned long long)errMax, audioDir.c_str());
+        _exit(1);
+    }
+    recorder->metric("songs", files.size());
+    recorder->metric("notes", notes);
+    recorder->metric("wrongPitch", wrongPitch);
+    recorder->metric("maxCents", maxCents);
+    recorder->metric("onsetErrMaxUs", onsetMax);
+    recorder->metric("noteLenErrMaxUs", noteLenMax);
+    recorder->metric("songLenErrMaxUs", songLenMax);
+    recorder->metric("tempoErrMaxPpm", tempoMaxPpm);
+    recorder->metric("stalledOnsetErrMaxUs", stalledOnsetMax);
+    recorder->metric("stallShiftMaxUs", stallShiftMax);
+}
+
+struct Scenario {
+    const char* name;
+    void (*run)();
+};
+
+static const Scenario SCENARIOS[] = {
+    {"boot", scenarioBoot},
+    {"menu_alerts_detail", scenarioMenuAlertsDetail},
+    {"theme_switch", scenarioThemeSwitch},
+    {"beeperhero", scenarioBeeperHero},
+    {"alert_burst", scenarioAlertBurst},
+    {"alert_burst_wire", scenarioAlertBurstWire},
+    {"alert_storm", scenarioAlertStorm},
+    {"alert_flood", scenarioAlertFlood},
+    {"alert_log_reboot", scenarioAlertLogReboot},
+    {"mqtt_wake_drain", scenarioMqttWakeDrain},
+    {"mqtt_cut_payload", scenarioMqttCutPayload},
+    {"wifi_fast_reconnect", scenarioWifiFastReconnect},
+    {"periodic_wake", scenarioPeriodicWake},
+    {"wake_no_log", scenarioWakeNoLog},
+    {"telemetry", scenarioTelemetry},
+    {"alert_priority", scenarioAlertPriority},
+    {"ringtone_timeline", scenarioRingtoneTimeline},
+    {"audio_busy_loop", scenarioAudioBusyLoop},
+    {"audio_preempt", scenarioAudioPreempt},
+    {"game_popup_hold", scenarioGamePopupHold},
+    {"buzzer_rebegin", scenarioBuzzerRebegin},
+    {"ringtone_render", scenarioRingtoneRender},
+};
+static const size_t SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+// Runs one scenario in a child process. `json` gets the full report entry,
+// `gated` the deterministic part kept in the baseline.
+static bool runScenario(const Scenario& scenario, const std::string& outDir, std::string& json, std::string& gated) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return false;
+
+    if (pid == 0) {
+        close(fds[0]);
+        HostHooks::serialEcho = false;
+        BenchRecorder rec(&tft, scenario.name, outDir);
+        recorder = &rec;
+        scenario.run();
+        rec.overdrawMap("overdraw");
+        std::string out = rec.toJson(true);
+        out += '\0';
+        out += rec.toJson(false);
+        size_t done = 0;
+        while (done < out.size()) {
+            ssize_t n = write(fds[1], out.data() + done, out.size() - done);
+            if (n <= 0) _exit(1);
+            done += (size_t)n;
+        }
+        _exit(0);
+    }
+
+    close(fds[1]);
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0) json.append(buf, (size_t)n);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    size_t split = json.find('\0');
+    if (split == std::string::npos) return false;
+    gated = json.substr(split + 1);
+    json.resize(split);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static bool writeFile(const std::string& path, const std::string& text) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+    return (fclose(f) == 0) && ok;
+}
+
+static bool readFile(const std::string& path, std::string& text) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+static std::string wrapReport(const std::vector<std::string>& scenarios) {
+    std::string json = "{\n  \"version\": 1,\n  \"scenarios\": [\n";
+    for (size_t i = 0; i < scenarios.size(); i++) {
+        json += scenarios[i];
+        json += (i + 1 < scenarios.size()) ? ",\n" : "\n";
+    }
+    json += "  ]\n}\n";
+    return json;
+}
+
+// Baseline gate
+
+static const char* const GATED[] = {"pixels", "windows", "transactions", "fillCalls", "pixelCalls", "textChars"};
+
+static JsonVariantConst findScenario(const JsonDocument& doc, const char* name) {
+    JsonVariantConst list = doc["scenarios"];
+    for (size_t i = 0; i < list.size(); i++) {
+        if (strcmp(list[(int)i]["name"] | "", name) == 0) return list[(int)i];
+    }
+    return JsonVariantConst();
+}
+
+static int compareScenario(JsonVariantConst base, JsonVariantConst now, double tolerance) {
+    const char* name = now["name"] | "?";
+    if (base.isNull()) {
+        printf("  %-20s new scenario (no baseline)\n", name);
+        return 0;
+    }
+    int failures = 0;
+    for (const char* key : GATED) {
+        unsigned long was = base[key] | 0UL;
+        unsigned long is = now[key] | 0UL;
+        double limit = was * (1.0 + tolerance / 100.0);
+        const char* verdict = "ok";
+        if (is > limit) {
+            verdict = "REGRESSION";
+            failures++;
+        } else if (is < was) {
+            verdict = "improved";
+        }
+        printf("  %-20s %-13s %10lu -> %10lu  %s\n", name, key, was, is, verdict);
+    }
+
+    JsonVariantConst baseMetrics = base["metrics"];
+    JsonVariantConst metrics = now["metrics"];
+    for (size_t i = 0; i < metrics.size(); i++) {
+        const char* metric = metrics[(int)i]["name"] | "";
+        unsigned long is = metrics[(int)i]["value"] | 0UL;
+        for (size_t j = 0; j < baseMetrics.size(); j++) {
+            if (strcmp(baseMetrics[(int)j]["name"] | "", metric) != 0) continue;
+            unsigned long was = baseMetrics[(int)j]["value"] | 0UL;
+            const char* verdict = "ok";
+            if (is > was * (1.0 + tolerance / 100.0)) {
+                verdict = "REGRESSION";
+                failures++;
+            } else if (is < was) {
+                verdict = "improved";
+            }
+            printf("  %-20s %-13s %10lu -> %10lu  %s\n", name, metric, was, is, verdict);
+        }
+    }
+
+    JsonVariantConst baseSnaps = base["snapshots"];
+    JsonVariantConst snaps = now["snapshots"];
+    for (size_t i = 0; i < snaps.size(); i++) {
+        const char* snap = snaps[(int)i]["name"] | "";
+        const char* hash = snaps[(int)i]["hash"] | "";
+        const char* expected = nullptr;
+        for (size_t j = 0; j < baseSnaps.size(); j++) {
+            if (strcmp(baseSnaps[(int)j]["name"] | "", snap) == 0) expected = baseSnaps[(int)j]["hash"] | "";
+        }
+        if (expected && strcmp(expected, hash) != 0) {
+            printf("  %-20s snapshot %s changed (%s -> %s, see %s)\n", name, snap, expected, hash,
+                   snaps[(int)i]["file"] | "");
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static void usage() {
+    printf("usage: bench [--out DIR] [--baseline FILE] [--update] [--tolerance PCT] [scenario...]\n");
+    printf("scenarios:");
+    for (const Scenario& s : SCENARIOS) printf(" %s", s.name);
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    std::string outDir = "build/bench";
+    std::string baselinePath;
+    bool update = false;
+    double tolerance = 2.0;
+    std::vector<const Scenario*> selected;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--update") {
+            update = true;
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (arg == "--help" || arg == "-h") {
+            usage();
+            return 0;
+        } else {
+            const Scenario* found = nullptr;
+            for (const Scenario& s : SCENARIOS) {
+                if (arg == s.name) found = &s;
+            }
+            if (!found) {
+                usage();
+                return 2;
+            }
+            selected.push_back(found);
+        }
+    }
+    if (selected.empty()) {
+        for (const Scenario& s : SCENARIOS) selected.push_back(&s);
+    }
+    if (mkdir(outDir.c_str(), 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "bench: cannot create %s\n", outDir.c_str());
+        return 2;
+    }
+
+    std::vector<std::string> report;
+    std::vector<std::string> baseline;
+    for (const Scenario* s : selected) {
+        std::string json, gated;
+        if (!runScenario(*s, outDir, json, gated)) {
+            fprintf(stderr, "bench: scenario %s failed\n", s->name);
+            return 2;
+        }
+        report.push_back(json);
+        baseline.push_back(gated);
+    }
+
+    std::string reportPath = outDir + "/report.json";
+    if (!writeFile(reportPath, wrapReport(report))) {
+        fprintf(stderr, "bench: cannot write %s\n", reportPath.c_str());
+        return 2;
+    }
+    printf("bench: %zu scenarios, report in %s\n", report.size(), reportPath.c_str());
+
+    if (baselinePath.empty()) return 0;
+    if (update) {
+        if (!writeFile(baselinePath, wrapReport(baseline))) {
+            fprintf(stderr, "bench: cannot write %s\n", baselinePath.c_str());
+            return 2;
+        }
+        printf("bench: baseline updated (%s)\n", baselinePath.c_str());
+        return 0;
+    }
+
+    std::string baselineText;
+    if (!readFile(baselinePath, baselineText)) {
+        fprintf(stderr, "bench: no baseline at %s (run with --update)\n", baselinePath.c_str());
+        return 2;
+    }
+    DynamicJsonDocument base(0);
+    DeserializationError err = deserializeJson(base, baselineText.c_str());
+    if (err) {
+        fprintf(stderr, "bench: bad baseline %s: %s\n", baselinePath.c_str(), err.c_str());
+        return 2;
+    }
+
+    int failures = 0;
+    printf("bench: comparing against %s (tolerance %.1f%%)\n", baselinePath.c_str(), tolerance);
+    for (const std::string& json : report) {
+        DynamicJsonDocument now(0);
+        if (deserializeJson(now, json.c_str())) {
+            failures++;
+            continue;
+        }
+        failures += compareScenario(findScenario(base, now["name"] | ""), now.as(), tolerance);
+    }
+    printf(failures ? "bench: FAILED (%d regressions)\n" : "bench: ok\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+#include "BenchRecorder.h"
+#include "PngWriter.h"
+#include "src/ui/core/FrameScheduler.h"
+#include "src/ui/core/OverdrawAnalyzer.h"
+#include "src/ui/core/RenderProfiler.h"
+#include <algorithm>
+#include <chrono>
+
+BenchRecorder::BenchRecorder(Adafruit_ST7789* panel, const std::string& scenario, const std::string& outDir)
+    : panel(panel), scenario(scenario), outDir(outDir) {
+    lastPanel = panel->hostStats();
+    lastCounters = readCounters();
+    lastFramesPresented = FrameScheduler::getFramesPresented();
+}
+
+void BenchRecorder::pass(void (*loopFn)()) {
+    auto start = std::chrono::steady_clock::now();
+    loopFn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const HostPanelStats& now = panel->hostStats();
+    Frame counters = readCounters();
+    pending.pixels += (uint32_t)(now.pixelsWritten - lastPanel.pixelsWritten);
+    pending.windows += now.addrWindows - lastPanel.addrWindows;
+    pending.transactions += now.transactions - lastPanel.transactions;
+    pending.fillCalls += counters.fillCalls - lastCounters.fillCalls;
+    pending.pixelCalls += counters.pixelCalls - lastCounters.pixelCalls;
+    pending.textChars += counters.textChars - lastCounters.textChars;
+    pending.wallUs += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    lastPanel = now;
+    lastCounters = counters;
+
+    unsigned long presented = FrameScheduler::getFramesPresented();
+    if (presented != lastFramesPresented) {
+        lastFramesPresented = presented;
+        frames.push_back(pending);
+        pending = Frame();
+    } else {
+        // Idle passes only count towards wall time of work that drew something
+        pending.wallUs = 0;
+    }
+}
+
+void BenchRecorder::metric(const char* name, uint32_t value) {
+    metrics.push_back({name, value});
+}
+
+void BenchRecorder::snapshot(const char* name) {
+    const int w = panel->width();
+    const int h = panel->height();
+    std::vector<uint16_t> glass((size_t)w * h);
+    uint32_t hash = 2166136261u;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint16_t c = panel->getPixel(x, y);
+            glass[(size_t)y * w + x] = c;
+            hash = (hash ^ (c & 0xFF)) * 16777619u;
+            hash = (hash ^ (c >> 8)) * 16777619u;
+        }
+    }
+
+    Snapshot snap;
+    snap.name = name;
+    char hex[9];
+    snprintf(hex, sizeof(hex), "%08x", hash);
+    snap.hash = hex;
+    snap.file = scenario + "_" + name + ".png";
+    if (!PngWriter::write((outDir + "/" + snap.file).c_str(), glass.data(), w, h)) {
+        fprintf(stderr, "bench: cannot write %s/%s\n", outDir.c_str(), snap.file.c_str());
+    }
+    snapshots.push_back(snap);
+}
+
+void BenchRecorder::overdrawMap(const char* name) {
+    if (!OverdrawAnalyzer::isEnabled()) return;
+    const int w = panel->width();
+    const int h = panel->height();
+    uint8_t maxHeat = OverdrawAnalyzer::getMaxHeat();
+    std::vector<uint16_t> map((size_t)w * h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            // Black (never overdrawn) through red and yellow to white
+            uint8_t heat = OverdrawAnalyzer::getHeat(x, y);
+            unsigned v = maxHeat ? (unsigned)heat * 765 / maxHeat : 0;
+            unsigned r = v > 255 ? 255 : v;
+            unsigned g = v > 510 ? 255 : (v > 255 ? v - 255 : 0);
+            unsigned b = v > 510 ? v - 510 : 0;
+            map[(size_t)y * w + x] = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+        }
+    }
+    overdrawFile = scenario + "_" + name + ".png";
+    if (!PngWriter::write((outDir + "/" + overdrawFile).c_str(), map.data(), w, h)) {
+        fprintf(stderr, "bench: cannot write %s/%s\n", outDir.c_str(), overdrawFile.c_str());
+    }
+}
+
+BenchRecorder::Frame BenchRecorder::getTotals() const {
+    Frame total;
+    for (const Frame& f : frames) {
+        total.pixels += f.pixels;
+        total.windows += f.windows;
+        total.transactions += f.transactions;
+        total.fillCalls += f.fillCalls;
+        total.pixelCalls += f.pixelCalls;
+        total.textChars += f.textChars;
+        total.wallUs += f.wallUs;
+    }
+    return total;
+}
+
+std::string BenchRecorder::toJson(bool perFrame) const {
+    Frame total = getTotals();
+    uint32_t maxPixels = 0;
+    std::vector<uint32_t> wall;
+    for (const Frame& f : frames) {
+        maxPixels = std::max(maxPixels, f.pixels);
+        wall.push_back(f.wallUs);
+    }
+    std::sort(wall.begin(), wall.end());
+    uint32_t wallP95 = wall.empty() ? 0 : wall[(wall.size() * 95 + 99) / 100 - 1];
+
+    char buf[512];
+    std::string json = "    {\n";
+    snprintf(buf, sizeof(buf),
+             "      \"name\": \"%s\",\n      \"frames\": %u,\n      \"pixels\": %u,\n      \"maxFramePixels\": %u,\n"
+             "      \"windows\": %u,\n      \"transactions\": %u,\n      \"fillCalls\": %u,\n"
+             "      \"pixelCalls\": %u,\n      \"textChars\": %u,\n",
+             scenario.c_str(), (unsigned)frames.size(), total.pixels, maxPixels, total.windows,
+             total.transactions, total.fillCalls, total.pixelCalls, total.textChars);
+    json += buf;
+    if (perFrame) {
+        snprintf(buf, sizeof(buf), "      \"wallUs\": %u,\n      \"wallUsP95\": %u,\n", total.wallUs, wallP95);
+        json += buf;
+    }
+
+    if (!metrics.empty()) {
+        json += "      \"metrics\": [";
+        for (size_t i = 0; i < metrics.size(); i++) {
+            snprintf(buf, sizeof(buf), "%s\n        {\"name\": \"%s\", \"value\": %u}", i ? "," : "",
+                     metrics[i].first.c_str(), metrics[i].second);
+            json += buf;
+        }
+        json += "\n      ],\n";
+    }
+
+    json += "      \"snapshots\": [";
+    for (size_t i = 0; i < snapshots.size(); i++) {
+        snprintf(buf, sizeof(buf), "%s\n        {\"name\": \"%s\", \"hash\": \"%s\", \"file\": \"%s\"}",
+                 i ? "," : "", snapshots[i].name.c_str(), snapshots[i].hash.c_str(), snapshots[i].file.c_str());
+        json += buf;
+    }
+    json += snapshots.empty() ? "]" : "\n      ]";
+
+    if (perFrame && OverdrawAnalyzer::isEnabled()) {
+        snprintf(buf, sizeof(buf),
+                 ",\n      \"overdraw\": {\"ratio\": %.3f, \"worstFrameRatio\": %.3f, \"map\": \"%s\", \"sites\": [",
+                 OverdrawAnalyzer::getRatio(), OverdrawAnalyzer::getWorstRatio(), overdrawFile.c_str());
+        json += buf;
+        bool first = true;
+        for (uint8_t i = 0; i < OverdrawAnalyzer::getSiteCount(); i++) {
+            const OverdrawAnalyzer::SiteStats* site = OverdrawAnalyzer::getSite(i);
+            if (site->pixels == 0) continue;
+            snprintf(buf, sizeof(buf), "%s\n        {\"name\": \"%s\", \"pixels\": %u, \"overdrawn\": %u, \"wasted\": %u}",
+                     first ? "" : ",", site->name, site->pixels, site->overdrawn, site->wasted);
+            json += buf;
+            first = false;
+        }
+        json += first ? "]}" : "\n      ]}";
+    }
+
+    if (perFrame) {
+        // [pixels, windows, transactions, fillCalls, pixelCalls, textChars, wallUs]
+        json += ",\n      \"frameLog\": [";
+        for (size_t i = 0; i < frames.size(); i++) {
+            const Frame& f = frames[i];
+            snprintf(buf, sizeof(buf), "%s[%u,%u,%u,%u,%u,%u,%u]", i ? "," : "", f.pixels, f.windows,
+                     f.transactions, f.fillCalls, f.pixelCalls, f.textChars, f.wallUs);
+            json += buf;
+        }
+        json += "]";
+    }
+    json += "\n    }";
+    return json;
+}
+
+// Private helpers
+
+BenchRecorder::Frame BenchRecorder::readCounters() const {
+    Frame sum;
+    auto add = [&sum](const RenderProfiler::Counters& c) {
+        sum.fillCalls += c.fillCalls;
+        sum.pixelCalls += c.pixelCalls;
+        sum.textChars += c.textChars;
+    };
+    add(RenderProfiler::getOutsideFrame());
+    for (uint8_t i = 0; i < RenderProfiler::getScreenCount(); i++) {
+        add(RenderProfiler::getScreen(i)->counters);
+    }
+    return sum;
+}
@@ -0,0 +1,76 @@
+#ifndef HOST_BENCH_RECORDER_H
+#define HOST_BENCH_RECORDER_H
+
+#include <Adafruit_ST7789.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * BenchRecorder
+ *
+ * Collects per-frame render cost for one benchmark scenario. Every loop
+ * pass goes through pass(); when the pass presented a frame, everything the
+ * panel saw since the previous frame is booked against it.
+ *
+ * Per frame: pixels written, address windows, SPI transactions, fill and
+ * pixel calls, characters drawn (RenderProfiler), and host wall time of the
+ * loop pass. Snapshots hash the glass and write a PNG.
+ *
+ * With OverdrawAnalyzer running, the report also carries the overdraw
+ * ratio and per-call-site table, and overdrawMap() writes the heatmap.
+ *
+ * Scenarios can add their own named metrics (e.g. simulated connect times);
+ * they are gated like the counters.
+ *
+ * Everything except wall time is deterministic (the clock is simulated), so
+ * those numbers and the snapshot hashes can be compared against a baseline.
+ */
+class BenchRecorder {
+public:
+    struct Frame {
+        uint32_t pixels = 0;
+        uint32_t windows = 0;
+        uint32_t transactions = 0;
+        uint32_t fillCalls = 0;
+        uint32_t pixelCalls = 0;
+        uint32_t textChars = 0;
+        uint32_t wallUs = 0;
+    };
+
+    struct Snapshot {
+        std::string name;
+        std::string hash;    // FNV-1a of the RGB565 glass
+        std::string file;
+    };
+
+    BenchRecorder(Adafruit_ST7789* panel, const std::string& scenario, const std::string& outDir);
+
+    // Run one main-loop pass and book its cost
+    void pass(void (*loopFn)());
+    void snapshot(const char* name);
+    void metric(const char* name, uint32_t value);
+    void overdrawMap(const char* name);
+
+    const std::string& getScenario() const { return scenario; }
+    const std::string& getOutDir() const { return outDir; }
+    Frame getTotals() const;
+    std::string toJson(bool perFrame) const;
+
+private:
+    Adafruit_ST7789* panel;
+    std::string scenario;
+    std::string outDir;
+    std::vector<Frame> frames;
+    std::vector<Snapshot> snapshots;
+    std::vector<std::pair<std::string, uint32_t>> metrics;
+    std::string overdrawFile;
+    Frame pending;                  // cost since the last presented frame
+    HostPanelStats lastPanel;
+    Frame lastCounters;
+    unsigned long lastFramesPresented;
+
+    Frame readCounters() const;
+};
+
+#endif // HOST_BENCH_RECORDER_H
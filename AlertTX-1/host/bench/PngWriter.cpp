@@ -0,0 +1,94 @@
+#include "PngWriter.h"
+#include <stdio.h>
+#include <vector>
+
+static uint32_t crcTable[256];
+
+static void initCrc() {
+    if (crcTable[1]) return;
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crcTable[n] = c;
+    }
+}
+
+static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    while (len--) crc = crcTable[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void put32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+static void chunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    put32(out, (uint32_t)data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    put32(out, crc32(0, out.data() + start, out.size() - start));
+}
+
+bool PngWriter::write(const char* path, const uint16_t* pixels, int width, int height) {
+    initCrc();
+
+    // Scanlines: filter byte 0 + RGB888 expanded from RGB565
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)height * (width * 3 + 1));
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        for (int x = 0; x < width; x++) {
+            uint16_t c = pixels[y * width + x];
+            uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+            raw.push_back((uint8_t)((r << 3) | (r >> 2)));
+            raw.push_back((uint8_t)((g << 2) | (g >> 4)));
+            raw.push_back((uint8_t)((b << 3) | (b >> 2)));
+        }
+    }
+
+    // zlib stream of stored blocks (max 65535 bytes each) + Adler-32
+    std::vector<uint8_t> z = {0x78, 0x01};
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    size_t pos = 0;
+    do {
+        size_t n = raw.size() - pos;
+        if (n > 65535) n = 65535;
+        bool last = (pos + n == raw.size());
+        z.push_back(last ? 1 : 0);
+        z.push_back((uint8_t)n);
+        z.push_back((uint8_t)(n >> 8));
+        z.push_back((uint8_t)~n);
+        z.push_back((uint8_t)(~n >> 8));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+    } while (pos < raw.size());
+    put32(z, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    put32(header, (uint32_t)width);
+    put32(header, (uint32_t)height);
+    header.push_back(8);   // bit depth
+    header.push_back(2);   // truecolor
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(0);
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    chunk(png, "IHDR", header);
+    chunk(png, "IDAT", z);
+    chunk(png, "IEND", std::vector<uint8_t>());
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(png.data(), 1, png.size(), f) == png.size();
+    return (fclose(f) == 0) && ok;
+}
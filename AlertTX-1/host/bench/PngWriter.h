@@ -0,0 +1,19 @@
+#ifndef HOST_PNG_WRITER_H
+#define HOST_PNG_WRITER_H
+
+#include <stdint.h>
+
+/**
+ * PngWriter
+ *
+ * Writes RGB565 frames as 8-bit RGB PNGs with no external dependencies.
+ * Image data goes out in stored (uncompressed) deflate blocks, so files are
+ * large (~100 KB for the panel) but any viewer or diff tool can open them.
+ */
+class PngWriter {
+public:
+    // pixels: width * height RGB565 values, row-major. Returns false on I/O error.
+    static bool write(const char* path, const uint16_t* pixels, int width, int height);
+};
+
+#endif // HOST_PNG_WRITER_H
@@ -0,0 +1,35 @@
+#include "WavWriter.h"
+#include <stdio.h>
+#include <vector>
+
+static void put16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+}
+
+static void put32(std::vector<uint8_t>& out, uint32_t v) {
+    put16(out, (uint16_t)v);
+    put16(out, (uint16_t)(v >> 16));
+}
+
+bool WavWriter::write(const char* path, const uint8_t* samples, size_t count, uint32_t sampleRate) {
+    std::vector<uint8_t> header;
+    header.insert(header.end(), {'R', 'I', 'F', 'F'});
+    put32(header, (uint32_t)(36 + count));
+    header.insert(header.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put32(header, 16);
+    put16(header, 1);              // PCM
+    put16(header, 1);              // mono
+    put32(header, sampleRate);
+    put32(header, sampleRate);     // bytes per second
+    put16(header, 1);              // block align
+    put16(header, 8);              // bits per sample
+    header.insert(header.end(), {'d', 'a', 't', 'a'});
+    put32(header, (uint32_t)count);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(header.data(), 1, header.size(), f) == header.size() &&
+              fwrite(samples, 1, count, f) == count;
+    return (fclose(f) == 0) && ok;
+}
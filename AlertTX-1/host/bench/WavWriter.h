@@ -0,0 +1,19 @@
+#ifndef HOST_WAV_WRITER_H
+#define HOST_WAV_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * WavWriter
+ *
+ * Writes 8-bit unsigned mono PCM as a RIFF/WAVE file (128 = silence), the
+ * plainest format any player or audio editor opens.
+ */
+class WavWriter {
+public:
+    // Returns false on I/O error
+    static bool write(const char* path, const uint8_t* samples, size_t count, uint32_t sampleRate);
+};
+
+#endif // HOST_WAV_WRITER_H
@@ -0,0 +1,131 @@
+#ifndef HOST_ADAFRUIT_ST7789_H
+#define HOST_ADAFRUIT_ST7789_H
+
+// Host stand-in for Adafruit_SPITFT/ST77xx/ST7789 backed by an emulated
+// controller RAM (240x320, RGB565) including the vertical scroll registers.
+
+#include "Adafruit_GFX.h"
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+#define ST77XX_CASET 0x2A
+#define ST77XX_RASET 0x2B
+#define ST77XX_RAMWR 0x2C
+#define ST77XX_MADCTL 0x36
+
+class Adafruit_SPITFT : public Adafruit_GFX {
+public:
+    Adafruit_SPITFT(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {}
+
+    void startWrite(void) override;
+    void endWrite(void) override;
+    virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
+
+    void writePixel(int16_t x, int16_t y, uint16_t color) override;
+    void writePixels(uint16_t* colors, uint32_t len, bool block = true, bool bigEndian = false);
+    void writeColor(uint16_t color, uint32_t len);
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    inline void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        setAddrWindow(x, y, w, h);
+        writeColor(color, (uint32_t)w * h);
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void drawRGBBitmap(int16_t x, int16_t y, uint16_t* pcolors, int16_t w, int16_t h);
+    void drawRGBBitmap(int16_t x, int16_t y, const uint16_t* pcolors, int16_t w, int16_t h) {
+        drawRGBBitmap(x, y, (uint16_t*)pcolors, w, h);
+    }
+
+    void sendCommand(uint8_t commandByte, const uint8_t* dataBytes = nullptr, uint8_t numDataBytes = 0);
+    void invertDisplay(bool) override {}
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+
+    // Host-only: push pixels into the emulated RAM window
+    virtual void hostWriteRam(uint16_t color) = 0;
+    virtual void hostCommand(uint8_t cmd, const uint8_t* data, uint8_t n) = 0;
+
+protected:
+    int transactionDepth = 0;
+    void fillClipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+};
+
+class Adafruit_ST77xx : public Adafruit_SPITFT {
+public:
+    Adafruit_ST77xx(uint16_t w, uint16_t h) : Adafruit_SPITFT(w, h) {}
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override;
+    void enableDisplay(bool) {}
+    void enableSleep(bool) {}
+    void enableTearing(bool) {}
+
+protected:
+    uint8_t _colstart = 0, _rowstart = 0, _colstart2 = 0, _rowstart2 = 0;
+    int16_t _xstart = 0, _ystart = 0;
+};
+
+/**
+ * Host counters exposed by the emulated panel. Benchmarks read these to
+ * report pixels pushed and bus transactions per frame.
+ */
+struct HostPanelStats {
+    uint64_t pixelsWritten = 0;
+    uint32_t transactions = 0;   // outermost startWrite/endWrite pairs
+    uint32_t addrWindows = 0;    // CASET/RASET pairs
+    uint32_t commands = 0;       // other commands (scroll, madctl, ...)
+    void reset() { *this = HostPanelStats(); }
+};
+
+class Adafruit_ST7789 : public Adafruit_ST77xx {
+public:
+    static const int RAM_COLS = 240;
+    static const int RAM_ROWS = 320;
+
+    Adafruit_ST7789(int8_t cs, int8_t dc, int8_t rst);
+    Adafruit_ST7789(uint16_t w = 135, uint16_t h = 240);
+
+    void init(uint16_t width = 240, uint16_t height = 240, uint8_t spiMode = 0);
+    void setRotation(uint8_t m) override;
+
+    void hostWriteRam(uint16_t color) override;
+    void hostCommand(uint8_t cmd, const uint8_t* data, uint8_t n) override;
+
+    // Host-only inspection
+    uint16_t getPixel(int16_t x, int16_t y) const;   // as seen on the glass (scroll applied)
+    const HostPanelStats& hostStats() const { return stats; }
+    void resetHostStats() { stats.reset(); }
+    uint16_t scrollStart() const { return vscsad; }
+
+    // Hook invoked for every pixel stored (overdraw analysis on host)
+    typedef void (*PixelHook)(int16_t x, int16_t y);
+    void setPixelHook(PixelHook hook) { pixelHook = hook; }
+
+    HostPanelStats stats;
+
+private:
+    uint16_t ram[RAM_ROWS][RAM_COLS];
+    // Current RAM write window in controller coordinates
+    uint16_t winRow0 = 0, winRow1 = 0, winCol0 = 0, winCol1 = 0;
+    uint16_t curRow = 0, curCol = 0;
+    uint16_t tfa = 0, vsa = RAM_ROWS, bfa = 0, vscsad = 0;
+    PixelHook pixelHook = nullptr;
+
+    friend class Adafruit_ST77xx;
+    void setRamWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    int16_t physicalLineToRamRow(int16_t line) const;
+};
+
+#endif // HOST_ADAFRUIT_ST7789_H
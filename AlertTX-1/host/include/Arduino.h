@@ -0,0 +1,115 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Minimal Arduino core for the headless host build. Only what src/ needs.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <string>
+#include "HostClock.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+
+#define PROGMEM
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+
+// Board variant pins (Adafruit Feather ESP32-S3 Reverse TFT)
+#define TFT_CS 42
+#define TFT_DC 40
+#define TFT_RST 41
+#define TFT_BACKLITE 45
+#define TFT_I2C_POWER 7
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+using std::min;
+using std::max;
+template <typename T, typename L, typename H>
+inline T constrain(T v, L lo, H hi) { return v < (T)lo ? (T)lo : (v > (T)hi ? (T)hi : v); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+inline unsigned long millis() { return (unsigned long)(HostClock::nowUs() / 1000ULL); }
+inline unsigned long micros() { return (unsigned long)HostClock::nowUs(); }
+inline void delay(unsigned long ms) { HostClock::sleepUs((uint64_t)ms * 1000ULL); }
+inline void delayMicroseconds(unsigned int us) { HostClock::sleepUs(us); }
+inline void yield() {}
+
+long random(long maxv);
+long random(long minv, long maxv);
+void randomSeed(unsigned long seed);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+// LEDC (Arduino-ESP32 3.x, pin based); tone changes go to HostHooks::toneHook
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution);
+uint32_t ledcWriteTone(uint8_t pin, uint32_t freq);
+bool ledcDetach(uint8_t pin);
+
+// FreeRTOS spinlocks: the host runs everything on one thread
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    int available();
+    int read();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return 240000; }
+    uint32_t getMinFreeHeap() { return 200000; }
+    uint32_t getMaxAllocHeap() { return 110000; }
+    uint32_t getHeapSize() { return 320000; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    uint32_t getSketchSize() { return 1024 * 1024; }
+    uint32_t getFreeSketchSpace() { return 2 * 1024 * 1024; }
+    uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+    void restart() {}
+};
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,175 @@
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+// Host stand-in for the subset of ArduinoJson 6 the sketch uses: parse a
+// document, walk it with operator[], read values with `| default` or as<T>().
+// Values are copied into the document, so the input may be reused.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory };
+    DeserializationError(Code c = Ok) : code(c) {}
+    explicit operator bool() const { return code != Ok; }
+    bool operator==(Code c) const { return code == c; }
+    const char* c_str() const {
+        switch (code) {
+        case Ok: return "Ok";
+        case EmptyInput: return "EmptyInput";
+        case IncompleteInput: return "IncompleteInput";
+        case InvalidInput: return "InvalidInput";
+        default: return "NoMemory";
+        }
+    }
+private:
+    Code code;
+};
+
+namespace HostJson {
+
+struct Node {
+    enum Type { Null, Bool, Number, String, Array, Object } type = Null;
+    bool boolean = false;
+    double number = 0;
+    std::string text;
+    std::vector<std::pair<std::string, int>> children;   // key (objects only), node index
+};
+
+class Tree {
+public:
+    std::vector<Node> nodes;
+    void clear() { nodes.clear(); }
+    DeserializationError parse(const char* input, size_t length);
+
+private:
+    const char* p = nullptr;
+    const char* end = nullptr;
+    int depth = 0;
+    void skipSpace() { while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++; }
+    DeserializationError::Code parseValue(int& index);
+    DeserializationError::Code parseString(std::string& out);
+};
+
+}
+
+class JsonVariantConst {
+public:
+    JsonVariantConst() {}
+    JsonVariantConst(const HostJson::Tree* tree, int index) : tree(tree), index(index) {}
+
+    JsonVariantConst operator[](const char* key) const {
+        const HostJson::Node* n = node();
+        if (!n || n->type != HostJson::Node::Object || !key) return JsonVariantConst();
+        for (const auto& child : n->children) {
+            if (child.first == key) return JsonVariantConst(tree, child.second);
+        }
+        return JsonVariantConst();
+    }
+    JsonVariantConst operator[](int i) const {
+        const HostJson::Node* n = node();
+        if (!n || n->type != HostJson::Node::Array || i < 0 || i >= (int)n->children.size()) return JsonVariantConst();
+        return JsonVariantConst(tree, n->children[i].second);
+    }
+
+    bool isNull() const { const HostJson::Node* n = node(); return !n || n->type == HostJson::Node::Null; }
+    bool containsKey(const char* key) const { return !(*this)[key].isNull(); }
+    size_t size() const { const HostJson::Node* n = node(); return n ? n->children.size() : 0; }
+
+    template <typename T> bool is() const;
+    template <typename T> T as() const;
+
+    const char* operator|(const char* fallback) const {
+        const HostJson::Node* n = node();
+        return (n && n->type == HostJson::Node::String) ? n->text.c_str() : fallback;
+    }
+    int operator|(int fallback) const { return numberOr(fallback); }
+    long operator|(long fallback) const { return numberOr(fallback); }
+    unsigned int operator|(unsigned int fallback) const { return numberOr(fallback); }
+    unsigned long operator|(unsigned long fallback) const { return numberOr(fallback); }
+    float operator|(float fallback) const { return numberOr(fallback); }
+    double operator|(double fallback) const { return numberOr(fallback); }
+    bool operator|(bool fallback) const {
+        const HostJson::Node* n = node();
+        return (n && n->type == HostJson::Node::Bool) ? n->boolean : fallback;
+    }
+
+private:
+    const HostJson::Tree* tree = nullptr;
+    int index = -1;
+    const HostJson::Node* node() const { return (tree && index >= 0) ? &tree->nodes[index] : nullptr; }
+    template <typename T> T numberOr(T fallback) const {
+        const HostJson::Node* n = node();
+        return (n && n->type == HostJson::Node::Number) ? (T)n->number : fallback;
+    }
+};
+
+template <> inline bool JsonVariantConst::is<const char*>() const { const HostJson::Node* n = node(); return n && n->type == HostJson::Node::String; }
+template <> inline bool JsonVariantConst::is<int>() const { const HostJson::Node* n = node(); return n && n->type == HostJson::Node::Number; }
+template <> inline bool JsonVariantConst::is<long>() const { return is<int>(); }
+template <> inline bool JsonVariantConst::is<float>() const { return is<int>(); }
+template <> inline bool JsonVariantConst::is<bool>() const { const HostJson::Node* n = node(); return n && n->type == HostJson::Node::Bool; }
+template <> inline const char* JsonVariantConst::as<const char*>() const { return *this | (const char*)nullptr; }
+template <> inline int JsonVariantConst::as<int>() const { return *this | 0; }
+template <> inline long JsonVariantConst::as<long>() const { return *this | 0L; }
+template <> inline unsigned long JsonVariantConst::as<unsigned long>() const { return *this | 0UL; }
+template <> inline float JsonVariantConst::as<float>() const { return *this | 0.0f; }
+template <> inline bool JsonVariantConst::as<bool>() const { return *this | false; }
+
+typedef JsonVariantConst JsonVariant;
+typedef JsonVariantConst JsonObjectConst;
+
+class JsonDocument {
+public:
+    explicit JsonDocument(size_t capacity = 0) : capacity(capacity) {}
+    JsonVariantConst operator[](const char* key) const { return root()[key]; }
+    JsonVariantConst operator[](int i) const { return root()[i]; }
+    JsonVariantConst as() const { return root(); }
+    bool isNull() const { return root().isNull(); }
+    bool containsKey(const char* key) const { return root().containsKey(key); }
+    size_t size() const { return root().size(); }
+    void clear() { tree.clear(); }
+    size_t memoryUsage() const { return tree.nodes.size() * 16; }   // rough ArduinoJson slot size
+
+    HostJson::Tree tree;
+    size_t capacity;
+
+private:
+    JsonVariantConst root() const { return tree.nodes.empty() ? JsonVariantConst() : JsonVariantConst(&tree, 0); }
+};
+
+template <size_t N>
+class StaticJsonDocument : public JsonDocument {
+public:
+    StaticJsonDocument() : JsonDocument(N) {}
+};
+
+class DynamicJsonDocument : public JsonDocument {
+public:
+    explicit DynamicJsonDocument(size_t capacity) : JsonDocument(capacity) {}
+};
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t length) {
+    DeserializationError err = doc.tree.parse(input, length);
+    // ArduinoJson stores every value in a 16-byte slot (plus copied strings)
+    if (!err && doc.capacity && doc.memoryUsage() > doc.capacity) {
+        doc.clear();
+        return DeserializationError::NoMemory;
+    }
+    return err;
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input) {
+    return deserializeJson(doc, input, input ? strlen(input) : 0);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, char* input) {
+    return deserializeJson(doc, (const char*)input);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* input, size_t length) {
+    return deserializeJson(doc, (const char*)input, length);
+}
+
+#endif // HOST_ARDUINOJSON_H
@@ -0,0 +1,53 @@
+#ifndef HOST_BROKER_H
+#define HOST_BROKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// In-process stand-in for the Mosquitto broker in Beeper-Service, behind the
+// host PubSubClient. Models what matters to the firmware's delivery path:
+// - Sessions by client id; a clean-session connect wipes the old one
+// - Subscriptions with + and # wildcards, QoS = min(publish, subscribe)
+// - A persistent session queues QoS 1 messages while its client is offline
+//   (QoS 0 ones are dropped, as with queue_qos0_messages false), up to
+//   QUEUE_LIMIT like max_queued_messages in mosquitto.conf
+// - A QoS 1 message stays queued until acked; after a reconnect it is sent
+//   again with the DUP flag
+namespace HostBroker {
+    static const size_t QUEUE_LIMIT = 100;
+
+    struct Message {
+        std::string topic;
+        std::string payload;
+        uint8_t qos;
+        bool dup;
+        size_t cutAt;             // The link dies after this many payload bytes
+    };
+
+    struct Stats {
+        uint32_t published;
+        uint32_t delivered;
+        uint32_t redelivered;     // Deliveries with DUP set
+        uint32_t dropped;         // QoS 0 while offline, or over QUEUE_LIMIT
+    };
+
+    // Driven by the harness
+    void setOnline(bool online);  // Broker reachable; going down drops every connection
+    void publish(const char* topic, const std::string& payload, uint8_t qos);
+    void loseNextAck();           // The link dies between the next delivery and its PUBACK
+    void cutNextDelivery(size_t bytes);   // ...or partway through the next payload
+    size_t queued(const char* clientId);
+    const Stats& stats();
+
+    // Used by the host PubSubClient
+    bool connect(const char* clientId, bool cleanSession);
+    void disconnect(const char* clientId);
+    bool connected(const char* clientId);
+    bool subscribe(const char* clientId, const char* filter, uint8_t qos);
+    // Next message for the client, if any; ack() once it has been handled
+    bool next(const char* clientId, Message& out);
+    void ack(const char* clientId);
+}
+
+#endif
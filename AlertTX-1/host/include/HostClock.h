@@ -0,0 +1,40 @@
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * HostClock
+ *
+ * Controllable time source behind millis()/micros()/delay() for the headless
+ * build. Time only moves when the harness (or delay()) advances it, so runs
+ * are deterministic regardless of host speed.
+ */
+class HostClock {
+public:
+    static uint64_t nowUs() { return now; }
+    static void advanceUs(uint64_t us) { setUs(now + us); }
+    static void advanceMs(uint64_t ms) { advanceUs(ms * 1000ULL); }
+    static void setUs(uint64_t us);
+    // delay()/light sleep go through here so the harness can account idle time
+    static void sleepUs(uint64_t us) { sleptUs += us; advanceUs(us); }
+    static uint64_t totalSleptUs() { return sleptUs; }
+    static void reset() { now = 0; sleptUs = 0; nextTimerUs = UINT64_MAX; }
+
+    // Simulated esp_timer: when time moves, setUs() stops at every timer
+    // deadline on the way and calls the hook there, so callbacks run at
+    // their own time however far the harness jumps. The hook fires what is
+    // due and returns the next deadline (UINT64_MAX for none); arming a
+    // timer reports its deadline through wakeAt()
+    typedef uint64_t (*TimerHook)(uint64_t nowUs);
+    static void setTimerHook(TimerHook hook) { timerHook = hook; }
+    static void wakeAt(uint64_t us) { if (us < nextTimerUs) nextTimerUs = us; }
+
+private:
+    static uint64_t now;
+    static uint64_t sleptUs;
+    static uint64_t nextTimerUs;
+    static TimerHook timerHook;
+};
+
+#endif // HOST_CLOCK_H
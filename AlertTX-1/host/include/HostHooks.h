@@ -0,0 +1,43 @@
+#ifndef HOST_HOOKS_H
+#define HOST_HOOKS_H
+
+#include <stdint.h>
+
+// Knobs the host harness uses to observe and drive the firmware
+namespace HostHooks {
+    extern bool serialEcho;
+    typedef void (*ToneHook)(uint8_t pin, unsigned int frequency, unsigned long durationMs);
+    extern ToneHook toneHook;     // tone()/noTone()/ledcWriteTone() calls (frequency 0 = silence)
+    extern uint8_t pinLevels[64]; // digitalRead() values; set to simulate buttons
+    // LEDC owns the pin: ledcAttach() and tone() set it; pinMode(), ledcDetach()
+    // and noTone() clear it, as on Arduino-ESP32 3.x. ledcWriteTone() on a
+    // pin without it is dropped (the core logs an error and returns 0)
+    extern bool ledcAttached[64];
+    void serialInput(const char* text);  // queue bytes for Serial.read()
+    extern bool wifiConnected;    // WiFi.status() reports WL_CONNECTED (MQTT goes to HostBroker)
+    extern uint8_t wifiApChannel; // Access point WiFi.begin() can join; 0 = none in range
+    extern uint8_t wifiApBssid[6];
+
+    // Deep sleep: esp_sleep_get_wakeup_cause() returns wakeCause (an
+    // esp_sleep_wakeup_cause_t, UNDEFINED = cold boot); esp_deep_sleep_start()
+    // calls deepSleepHook with the armed timer, or exits the process without
+    // one. A hook must not return (the bench throws out of the firmware)
+    extern int wakeCause;
+    typedef void (*DeepSleepHook)(uint64_t timerUs);
+    extern DeepSleepHook deepSleepHook;
+
+    // The "alertlog" flash partition: operation counts, and an image file
+    // so a scenario can carry flash contents across a simulated reboot
+    extern uint32_t flashWrites;
+    extern uint32_t flashErases;
+    extern bool alertLogPresent;  // false: the partition table has no "alertlog" (or "ffat")
+
+    // MAX17048 fuel gauge on I2C (0x36). Over 4 V PowerManager takes the
+    // device for USB-powered and never sleeps on its own, as on the bench
+    extern uint16_t batteryMv;
+    extern uint8_t batteryPercent;
+    bool saveFlash(const char* path);
+    bool loadFlash(const char* path);
+}
+
+#endif
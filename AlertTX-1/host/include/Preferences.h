@@ -0,0 +1,65 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+#include "Arduino.h"
+#include <map>
+#include <vector>
+
+// In-memory NVS stand-in shared by every Preferences instance.
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) { ns = name ? name : ""; (void)readOnly; return true; }
+    void end() {}
+    bool clear() { store()[ns].clear(); return true; }
+    bool remove(const char* key) { return store()[ns].erase(key) > 0; }
+    bool isKey(const char* key) { return store()[ns].count(key) > 0; }
+
+    size_t putInt(const char* k, int32_t v) { return putRaw(k, &v, sizeof(v)); }
+    size_t putUInt(const char* k, uint32_t v) { return putRaw(k, &v, sizeof(v)); }
+    size_t putUChar(const char* k, uint8_t v) { return putRaw(k, &v, sizeof(v)); }
+    size_t putUShort(const char* k, uint16_t v) { return putRaw(k, &v, sizeof(v)); }
+    size_t putULong(const char* k, uint32_t v) { return putRaw(k, &v, sizeof(v)); }
+    size_t putBool(const char* k, bool v) { uint8_t b = v; return putRaw(k, &b, 1); }
+    size_t putString(const char* k, const String& v) { return putRaw(k, v.c_str(), v.length() + 1); }
+    size_t putString(const char* k, const char* v) { return putRaw(k, v, strlen(v) + 1); }
+    size_t putBytes(const char* k, const void* v, size_t len) { return putRaw(k, v, len); }
+
+    int32_t getInt(const char* k, int32_t d = 0) { return get<int32_t>(k, d); }
+    uint32_t getUInt(const char* k, uint32_t d = 0) { return get<uint32_t>(k, d); }
+    uint8_t getUChar(const char* k, uint8_t d = 0) { return get<uint8_t>(k, d); }
+    uint16_t getUShort(const char* k, uint16_t d = 0) { return get<uint16_t>(k, d); }
+    uint32_t getULong(const char* k, uint32_t d = 0) { return get<uint32_t>(k, d); }
+    bool getBool(const char* k, bool d = false) { return get<uint8_t>(k, d) != 0; }
+    String getString(const char* k, const String& d = String()) {
+        auto& m = store()[ns];
+        auto it = m.find(k);
+        return it == m.end() ? d : String((const char*)it->second.data());
+    }
+    size_t getBytesLength(const char* k) { auto& m = store()[ns]; auto it = m.find(k); return it == m.end() ? 0 : it->second.size(); }
+    size_t getBytes(const char* k, void* buf, size_t max) {
+        auto& m = store()[ns];
+        auto it = m.find(k);
+        if (it == m.end()) return 0;
+        size_t n = std::min(max, it->second.size());
+        memcpy(buf, it->second.data(), n);
+        return n;
+    }
+
+private:
+    typedef std::map<std::string, std::map<std::string, std::vector<uint8_t>>> Store;
+    static Store& store() { static Store s; return s; }
+    size_t putRaw(const char* k, const void* v, size_t len) {
+        const uint8_t* p = (const uint8_t*)v;
+        store()[ns][k] = std::vector<uint8_t>(p, p + len);
+        return len;
+    }
+    template <typename T> T get(const char* k, T d) {
+        auto& m = store()[ns];
+        auto it = m.find(k);
+        if (it == m.end() || it->second.size() != sizeof(T)) return d;
+        T v;
+        memcpy(&v, it->second.data(), sizeof(T));
+        return v;
+    }
+    std::string ns;
+};
+#endif
@@ -0,0 +1,63 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+
+// Arduino Print base class (subset)
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v, int base = DEC) { return printNumber((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return printUnsigned((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) { return printNumber(v, base); }
+    size_t print(unsigned long v, int base = DEC) { return printUnsigned(v, base); }
+    size_t print(double v, int digits = 2) { char b[48]; snprintf(b, sizeof(b), "%.*f", digits, v); return write(b); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(T v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[512];
+        va_list ap;
+        va_start(ap, fmt);
+        int len = vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        if (len < 0) return 0;
+        if ((size_t)len >= sizeof(buf)) len = sizeof(buf) - 1;
+        return write((const uint8_t*)buf, (size_t)len);
+    }
+
+private:
+    size_t printNumber(long v, int base) {
+        char b[40];
+        if (base == HEX) snprintf(b, sizeof(b), "%lX", v); else snprintf(b, sizeof(b), "%ld", v);
+        return write(b);
+    }
+    size_t printUnsigned(unsigned long v, int base) {
+        char b[40];
+        if (base == HEX) snprintf(b, sizeof(b), "%lX", v); else snprintf(b, sizeof(b), "%lu", v);
+        return write(b);
+    }
+};
+
+#endif // HOST_PRINT_H
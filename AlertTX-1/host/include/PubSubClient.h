@@ -0,0 +1,112 @@
+#ifndef HOST_PUBSUBCLIENT_H
+#define HOST_PUBSUBCLIENT_H
+#include "Arduino.h"
+#include "WiFi.h"
+#include <functional>
+#include <string>
+#include "HostBroker.h"
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+#define MQTTQOS0 (0 << 1)
+#define MQTTQOS1 (1 << 1)
+
+class WiFiClient {
+public:
+    int connect(IPAddress, uint16_t) { return 0; }
+    int connect(const char*, uint16_t) { return 0; }
+    void stop() {}
+    uint8_t connected() { return 0; }
+};
+
+// PubSubClient against the in-process broker (HostBroker.h). Like the real
+// client: loop() handles one message, whose payload goes to the setStream()
+// target in full before the callback gets at most one receive buffer of it;
+// a QoS 1 message is acked after the callback returns. A link that dies
+// mid-payload leaves the bytes read so far in the stream, with no callback.
+class PubSubClient {
+public:
+    PubSubClient() {}
+    PubSubClient(WiFiClient&) {}
+    PubSubClient& setServer(const char* domain, uint16_t) { serverByName = domain != nullptr; return *this; }
+    PubSubClient& setServer(IPAddress, uint16_t) { serverByName = false; return *this; }
+    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE) { this->callback = callback; return *this; }
+    PubSubClient& setClient(WiFiClient&) { return *this; }
+    PubSubClient& setKeepAlive(uint16_t) { return *this; }
+    PubSubClient& setSocketTimeout(uint16_t) { return *this; }
+    PubSubClient& setStream(Stream& stream) { this->stream = &stream; return *this; }
+    bool setBufferSize(uint16_t size) { bufferSize = size; return true; }
+    uint16_t getBufferSize() { return bufferSize; }
+    bool connect(const char* id) { return connect(id, nullptr, nullptr, nullptr, 0, false, nullptr, true); }
+    bool connect(const char* id, const char* user, const char* pass) {
+        return connect(id, user, pass, nullptr, 0, false, nullptr, true);
+    }
+    bool connect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos,
+                 bool willRetain, const char* willMessage) {
+        return connect(id, user, pass, willTopic, willQos, willRetain, willMessage, true);
+    }
+    bool connect(const char* id, const char*, const char*, const char*, uint8_t, bool, const char*, bool cleanSession) {
+        // WiFiClient::connect(host) resolves the name on every connect
+        IPAddress ip;
+        if (WiFi.status() != WL_CONNECTED || (serverByName && WiFi.hostByName("broker", ip) != 1)) {
+            connectState = -2;   // MQTT_CONNECT_FAILED
+            return false;
+        }
+        delay(CONNECT_MS);
+        if (!HostBroker::connect(id, cleanSession)) {
+            connectState = -2;
+            return false;
+        }
+        clientId = id;
+        connectState = 0;
+        return true;
+    }
+    void disconnect() { HostBroker::disconnect(clientId.c_str()); }
+    bool publish(const char* topic, const char* payload) { return publish(topic, payload, false); }
+    bool publish(const char* topic, const char* payload, bool) {
+        return publish(topic, (const uint8_t*)payload, payload ? (unsigned)strlen(payload) : 0);
+    }
+    // QoS 0 into HostBroker; like the library, the whole packet (5-byte
+    // header, topic, payload) has to fit the buffer
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length) {
+        if (!connected() || !topic || 5 + 2 + strlen(topic) + length > bufferSize) return false;
+        HostBroker::publish(topic, std::string((const char*)payload, length), 0);
+        return true;
+    }
+    bool subscribe(const char* topic) { return subscribe(topic, 0); }
+    bool subscribe(const char* topic, uint8_t qos) {
+        return connected() && qos <= 1 && HostBroker::subscribe(clientId.c_str(), topic, qos);
+    }
+    bool unsubscribe(const char*) { return false; }
+    bool loop() {
+        if (!connected()) return false;
+        HostBroker::Message message;
+        if (!HostBroker::next(clientId.c_str(), message)) return true;
+        if (message.cutAt < message.payload.size()) {
+            if (stream) stream->write((const uint8_t*)message.payload.data(), message.cutAt);
+            HostBroker::disconnect(clientId.c_str());
+            return false;
+        }
+        if (stream) stream->write((const uint8_t*)message.payload.data(), message.payload.size());
+        if (callback) {
+            unsigned length = message.payload.size() < bufferSize ? (unsigned)message.payload.size() : bufferSize;
+            callback(&message.topic[0], (uint8_t*)&message.payload[0], length);
+        }
+        if (message.qos == 1) HostBroker::ack(clientId.c_str());
+        return connected();
+    }
+    bool connected() {
+        bool up = !clientId.empty() && HostBroker::connected(clientId.c_str());
+        if (!up && connectState == 0) connectState = -3;   // MQTT_CONNECTION_LOST
+        return up;
+    }
+    int state() { return connectState; }
+    MQTT_CALLBACK_SIGNATURE;
+private:
+    static const unsigned long CONNECT_MS = 30;   // TCP handshake plus CONNECT/CONNACK on the LAN
+    uint16_t bufferSize = 256;
+    bool serverByName = false;
+    Stream* stream = nullptr;
+    std::string clientId;
+    int connectState = -1;   // MQTT_DISCONNECTED
+};
+#endif
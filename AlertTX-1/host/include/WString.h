@@ -0,0 +1,62 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <string>
+#include <stdio.h>
+
+// Subset of the Arduino String class backed by std::string
+class String {
+public:
+    String() {}
+    String(const char* s) : s(s ? s : "") {}
+    String(const std::string& str) : s(str) {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned int v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(float v, unsigned int decimals = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", decimals, v); s = b; }
+    String(double v, unsigned int decimals = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", decimals, v); s = b; }
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.size(); }
+    bool isEmpty() const { return s.empty(); }
+    char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+    int indexOf(char c) const { size_t p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const char* str) const { size_t p = s.find(str); return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned int from) const { return from >= s.size() ? String() : String(s.substr(from)); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from >= s.size() || to <= from) return String();
+        return String(s.substr(from, to - from));
+    }
+    bool startsWith(const String& p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+    bool endsWith(const String& p) const { return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0; }
+    void trim() {
+        size_t a = s.find_first_not_of(" \t\r\n");
+        size_t b = s.find_last_not_of(" \t\r\n");
+        s = (a == std::string::npos) ? std::string() : s.substr(a, b - a + 1);
+    }
+    int toInt() const { return atoi(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+    void reserve(unsigned int n) { s.reserve(n); }
+
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o) { s += (o ? o : ""); return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    String& operator+=(int v) { s += std::to_string(v); return *this; }
+    friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+    friend String operator+(const String& a, const char* b) { return String(a.s + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String(std::string(a ? a : "") + b.s); }
+    friend String operator+(const String& a, char c) { return String(a.s + c); }
+    friend String operator+(const String& a, int v) { return String(a.s + std::to_string(v)); }
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator==(const char* o) const { return s == (o ? o : ""); }
+    bool operator!=(const String& o) const { return s != o.s; }
+    bool equals(const String& o) const { return s == o.s; }
+
+private:
+    std::string s;
+};
+
+#endif // HOST_WSTRING_H
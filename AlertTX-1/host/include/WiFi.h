@@ -0,0 +1,65 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+#include "Arduino.h"
+#include "HostHooks.h"
+
+// The host build has no radio. WiFi.begin() associates with a simulated
+// access point (HostHooks::wifiApChannel / wifiApBssid) after the time a
+// full scan, a direct association and DHCP would take (src/HostWiFi.cpp);
+// HostHooks::wifiConnected forces the link up immediately.
+typedef enum { WL_NO_SHIELD = 255, WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_SCAN_COMPLETED = 2, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4, WL_CONNECTION_LOST = 5, WL_DISCONNECTED = 6 } wl_status_t;
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+class IPAddress {
+public:
+    IPAddress() : v(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : v((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t raw) : v(raw) {}
+    operator uint32_t() const { return v; }
+    uint8_t operator[](int i) const { return (uint8_t)(v >> (8 * i)); }
+    String toString() const {
+        char b[16];
+        snprintf(b, sizeof(b), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+        return String(b);
+    }
+    bool fromString(const char* s) {
+        unsigned a, b, c, d;
+        if (sscanf(s, "%u.%u.%u.%u", &a, &b, &c, &d) != 4) return false;
+        *this = IPAddress((uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d);
+        return true;
+    }
+private:
+    uint32_t v;
+};
+
+class WiFiClass {
+public:
+    wl_status_t status();
+    wifi_mode_t getMode() { return currentMode; }
+    bool mode(wifi_mode_t m) { currentMode = m; return true; }
+    bool setSleep(bool) { return true; }
+    bool setAutoReconnect(bool) { return true; }
+    bool persistent(bool) { return true; }
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress localIp, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(),
+                IPAddress dns2 = IPAddress());
+    bool disconnect(bool = false, bool = false);
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t = 0);
+    String SSID() { return String(); }
+    uint8_t* BSSID();
+    int32_t channel();
+    int8_t RSSI() { return status() == WL_CONNECTED ? -55 : 0; }
+    int hostByName(const char* host, IPAddress& result);
+private:
+    wifi_mode_t currentMode = WIFI_OFF;
+    bool started = false;
+    bool joins = false;             // The attempt will succeed
+    unsigned long readyAtMs = 0;    // When it succeeds or fails
+    IPAddress staticIp, staticGateway, staticSubnet, staticDns;
+};
+extern WiFiClass WiFi;
+#endif
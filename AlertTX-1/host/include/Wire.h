@@ -0,0 +1,43 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+#include "Arduino.h"
+#include "HostHooks.h"
+// The only I2C device on the host is the MAX17048 fuel gauge (0x36), read
+// from HostHooks; every other address NACKs.
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t freq = 0) { (void)sda; (void)scl; (void)freq; return true; }
+    void beginTransmission(uint8_t address) { this->address = address; reg = -1; }
+    uint8_t endTransmission(bool stop = true) { (void)stop; return address == FUEL_GAUGE ? 0 : 2; }
+    size_t write(uint8_t value) {
+        if (reg < 0) reg = value;
+        return 1;
+    }
+    uint8_t requestFrom(uint8_t address, uint8_t count) {
+        rxPos = rxLen = 0;
+        if (address != FUEL_GAUGE || count != 2) return 0;
+        uint16_t value;
+        if (reg == 0x02) {
+            value = (uint16_t)(HostHooks::batteryMv * 64UL / 5);   // VCELL: 78.125 uV per LSB
+        } else if (reg == 0x04) {
+            value = (uint16_t)(HostHooks::batteryPercent << 8);   // SOC: 1/256 % per LSB
+        } else {
+            return 0;
+        }
+        rx[0] = value >> 8;
+        rx[1] = value & 0xFF;
+        rxLen = 2;
+        return 2;
+    }
+    int available() { return rxLen - rxPos; }
+    int read() { return rxPos < rxLen ? rx[rxPos++] : -1; }
+private:
+    static const uint8_t FUEL_GAUGE = 0x36;
+    uint8_t address = 0;
+    int reg = -1;
+    uint8_t rx[2] = {0, 0};
+    uint8_t rxLen = 0;
+    uint8_t rxPos = 0;
+};
+extern TwoWire Wire;
+#endif
@@ -0,0 +1,25 @@
+#ifndef HOST_ESP_SLEEP_H
+#define HOST_ESP_SLEEP_H
+#include "Arduino.h"
+#include "esp_err.h"
+
+typedef enum { GPIO_NUM_0 = 0, GPIO_NUM_1 = 1, GPIO_NUM_2 = 2, GPIO_NUM_14 = 14, GPIO_NUM_18 = 18 } gpio_num_t;
+typedef enum { GPIO_INTR_LOW_LEVEL = 4, GPIO_INTR_HIGH_LEVEL = 5 } gpio_int_type_t;
+typedef enum { ESP_EXT1_WAKEUP_ALL_LOW = 0, ESP_EXT1_WAKEUP_ANY_HIGH = 1 } esp_sleep_ext1_wakeup_mode_t;
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED = 0, ESP_SLEEP_WAKEUP_ALL, ESP_SLEEP_WAKEUP_EXT0, ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER, ESP_SLEEP_WAKEUP_TOUCHPAD, ESP_SLEEP_WAKEUP_ULP, ESP_SLEEP_WAKEUP_GPIO
+} esp_sleep_wakeup_cause_t;
+
+inline esp_err_t esp_sleep_enable_ext0_wakeup(gpio_num_t, int) { return ESP_OK; }
+inline esp_err_t esp_sleep_enable_ext1_wakeup(uint64_t, esp_sleep_ext1_wakeup_mode_t) { return ESP_OK; }
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeUs);
+inline esp_err_t esp_sleep_enable_gpio_wakeup() { return ESP_OK; }
+inline esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) { return ESP_OK; }
+inline esp_err_t esp_sleep_disable_wakeup_source(int) { return ESP_OK; }
+#define ESP_SLEEP_WAKEUP_ALL_SOURCES ESP_SLEEP_WAKEUP_ALL
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause();
+// Light sleep on the host simply lets simulated time pass to the timer deadline
+esp_err_t esp_light_sleep_start();
+void esp_deep_sleep_start();
+#endif
@@ -0,0 +1,4 @@
+#ifndef HOST_PGMSPACE_H
+#define HOST_PGMSPACE_H
+#include "Arduino.h"
+#endif
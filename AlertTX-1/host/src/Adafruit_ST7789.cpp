@@ -0,0 +1,211 @@
+#include "Adafruit_ST7789.h"
+
+void Adafruit_SPITFT::startWrite(void) {
+    if (transactionDepth++ == 0) {
+        static_cast<Adafruit_ST7789*>(this)->stats.transactions++;
+    }
+}
+
+void Adafruit_SPITFT::endWrite(void) {
+    if (transactionDepth > 0) transactionDepth--;
+}
+
+void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
+    if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+        setAddrWindow(x, y, 1, 1);
+        hostWriteRam(color);
+    }
+}
+
+void Adafruit_SPITFT::writePixels(uint16_t* colors, uint32_t len, bool, bool bigEndian) {
+    while (len--) {
+        uint16_t c = *colors++;
+        if (bigEndian) c = (uint16_t)((c >> 8) | (c << 8));
+        hostWriteRam(c);
+    }
+}
+
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
+    while (len--) hostWriteRam(color);
+}
+
+// Like the real library, the public fills clip and then go straight to the
+// preclipped path; they never call back into the virtual writeFillRect.
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    fillClipped(x, y, w, h, color);
+}
+
+void Adafruit_SPITFT::fillClipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w && h) {
+        if (w < 0) { x += w + 1; w = -w; }
+        if (x < _width) {
+            if (h < 0) { y += h + 1; h = -h; }
+            if (y < _height) {
+                int16_t x2 = x + w - 1;
+                if (x2 >= 0) {
+                    int16_t y2 = y + h - 1;
+                    if (y2 >= 0) {
+                        if (x < 0) { x = 0; w = x2 + 1; }
+                        if (y < 0) { y = 0; h = y2 + 1; }
+                        if (x2 >= _width) w = _width - x;
+                        if (y2 >= _height) h = _height - y;
+                        writeFillRectPreclipped(x, y, w, h, color);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    fillClipped(x, y, w, 1, color);
+}
+
+void Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    fillClipped(x, y, 1, h, color);
+}
+
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+        startWrite();
+        setAddrWindow(x, y, 1, 1);
+        hostWriteRam(color);
+        endWrite();
+    }
+}
+
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    fillClipped(x, y, w, h, color);
+    endWrite();
+}
+
+void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    startWrite();
+    fillClipped(x, y, w, 1, color);
+    endWrite();
+}
+
+void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    startWrite();
+    fillClipped(x, y, 1, h, color);
+    endWrite();
+}
+
+void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t* pcolors, int16_t w, int16_t h) {
+    int16_t x2, y2;
+    if ((x >= _width) || (y >= _height) || ((x2 = (x + w - 1)) < 0) || ((y2 = (y + h - 1)) < 0)) return;
+    int16_t bx1 = 0, by1 = 0, saveW = w;
+    if (x < 0) { w += x; bx1 = -x; x = 0; }
+    if (y < 0) { h += y; by1 = -y; y = 0; }
+    if (x2 >= _width) w = _width - x;
+    if (y2 >= _height) h = _height - y;
+    pcolors += by1 * saveW + bx1;
+    startWrite();
+    setAddrWindow(x, y, w, h);
+    while (h--) {
+        writePixels(pcolors, w);
+        pcolors += saveW;
+    }
+    endWrite();
+}
+
+void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t* dataBytes, uint8_t numDataBytes) {
+    startWrite();
+    hostCommand(commandByte, dataBytes, numDataBytes);
+    endWrite();
+}
+
+void Adafruit_ST77xx::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    Adafruit_ST7789* self = static_cast<Adafruit_ST7789*>(this);
+    self->setRamWindow((uint16_t)(x + _xstart), (uint16_t)(y + _ystart), w, h);
+}
+
+Adafruit_ST7789::Adafruit_ST7789(int8_t, int8_t, int8_t) : Adafruit_ST77xx(240, 320) {
+    memset(ram, 0, sizeof(ram));
+}
+
+Adafruit_ST7789::Adafruit_ST7789(uint16_t w, uint16_t h) : Adafruit_ST77xx(w, h) {
+    memset(ram, 0, sizeof(ram));
+}
+
+void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t) {
+    WIDTH = width;
+    HEIGHT = height;
+    _rowstart = _rowstart2 = (uint8_t)((320 - height) / 2);
+    _colstart = (uint8_t)((240 - width + 1) / 2);
+    _colstart2 = (uint8_t)((240 - width) / 2);
+    tfa = 0; vsa = RAM_ROWS; bfa = 0; vscsad = 0;
+    setRotation(0);
+}
+
+void Adafruit_ST7789::setRotation(uint8_t m) {
+    Adafruit_GFX::setRotation(m);
+    switch (rotation) {
+    case 0: _xstart = _colstart; _ystart = _rowstart; break;
+    case 1: _xstart = _rowstart; _ystart = _colstart2; break;
+    case 2: _xstart = _colstart2; _ystart = _rowstart2; break;
+    case 3: _xstart = _rowstart2; _ystart = _colstart; break;
+    }
+}
+
+// In landscape (rotation 1/3, MADCTL MV set) logical x walks controller rows,
+// which is the axis the vertical scroll registers act on.
+void Adafruit_ST7789::setRamWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    stats.addrWindows++;
+    if (rotation & 1) {
+        winRow0 = x; winRow1 = x + w - 1;
+        winCol0 = y; winCol1 = y + h - 1;
+    } else {
+        winRow0 = y; winRow1 = y + h - 1;
+        winCol0 = x; winCol1 = x + w - 1;
+    }
+    curRow = winRow0;
+    curCol = winCol0;
+}
+
+void Adafruit_ST7789::hostWriteRam(uint16_t color) {
+    stats.pixelsWritten++;
+    if (curRow < RAM_ROWS && curCol < RAM_COLS) {
+        ram[curRow][curCol] = color;
+        if (pixelHook) {
+            if (rotation & 1) pixelHook((int16_t)(curRow - _xstart), (int16_t)(curCol - _ystart));
+            else pixelHook((int16_t)(curCol - _xstart), (int16_t)(curRow - _ystart));
+        }
+    }
+    // Memory write order follows the logical x axis first
+    if (rotation & 1) {
+        if (++curRow > winRow1) { curRow = winRow0; if (++curCol > winCol1) curCol = winCol0; }
+    } else {
+        if (++curCol > winCol1) { curCol = winCol0; if (++curRow > winRow1) curRow = winRow0; }
+    }
+}
+
+void Adafruit_ST7789::hostCommand(uint8_t cmd, const uint8_t* data, uint8_t n) {
+    stats.commands++;
+    if (cmd == 0x33 && n >= 6) {          // VSCRDEF
+        tfa = (uint16_t)((data[0] << 8) | data[1]);
+        vsa = (uint16_t)((data[2] << 8) | data[3]);
+        bfa = (uint16_t)((data[4] << 8) | data[5]);
+    } else if (cmd == 0x37 && n >= 2) {   // VSCSAD
+        vscsad = (uint16_t)((data[0] << 8) | data[1]);
+    }
+}
+
+int16_t Adafruit_ST7789::physicalLineToRamRow(int16_t line) const {
+    if (vsa == 0 || line < tfa || line >= tfa + vsa) return line;
+    int offset = (int)vscsad - (int)tfa;
+    int rel = ((line - tfa) + offset) % (int)vsa;
+    if (rel < 0) rel += vsa;
+    return (int16_t)(tfa + rel);
+}
+
+uint16_t Adafruit_ST7789::getPixel(int16_t x, int16_t y) const {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+    int16_t row, col;
+    if (rotation & 1) { row = x + _xstart; col = y + _ystart; }
+    else { row = y + _ystart; col = x + _xstart; }
+    row = physicalLineToRamRow(row);
+    if (row < 0 || row >= RAM_ROWS || col < 0 || col >= RAM_COLS) return 0;
+    return ram[row][col];
+}
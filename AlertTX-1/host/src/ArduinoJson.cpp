@@ -0,0 +1,145 @@
+#include "ArduinoJson.h"
+
+// Recursive-descent parser for the host ArduinoJson stand-in. Same nesting
+// limit as ArduinoJson's default.
+
+namespace HostJson {
+
+static const int MAX_DEPTH = 10;
+
+DeserializationError Tree::parse(const char* input, size_t length) {
+    clear();
+    if (!input || length == 0) return DeserializationError::EmptyInput;
+    p = input;
+    end = input + length;
+    depth = 0;
+    skipSpace();
+    if (p >= end || *p == '\0') return DeserializationError::EmptyInput;
+    int root;
+    DeserializationError::Code code = parseValue(root);
+    if (code != DeserializationError::Ok) clear();
+    return code;
+}
+
+DeserializationError::Code Tree::parseString(std::string& out) {
+    p++;   // opening quote
+    while (p < end && *p != '"') {
+        char c = *p++;
+        if (c == '\0') return DeserializationError::IncompleteInput;
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+        if (p >= end) return DeserializationError::IncompleteInput;
+        char e = *p++;
+        switch (e) {
+        case 'n': out += '\n'; break;
+        case 't': out += '\t'; break;
+        case 'r': out += '\r'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'u': {
+            if (end - p < 4) return DeserializationError::IncompleteInput;
+            unsigned cp = (unsigned)strtoul(std::string(p, 4).c_str(), nullptr, 16);
+            p += 4;
+            // UTF-8 encode (BMP only, like the classic font cares anyway)
+            if (cp < 0x80) {
+                out += (char)cp;
+            } else if (cp < 0x800) {
+                out += (char)(0xC0 | (cp >> 6));
+                out += (char)(0x80 | (cp & 0x3F));
+            } else {
+                out += (char)(0xE0 | (cp >> 12));
+                out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                out += (char)(0x80 | (cp & 0x3F));
+            }
+            break;
+        }
+        default: out += e; break;
+        }
+    }
+    if (p >= end) return DeserializationError::IncompleteInput;
+    p++;   // closing quote
+    return DeserializationError::Ok;
+}
+
+DeserializationError::Code Tree::parseValue(int& index) {
+    skipSpace();
+    if (p >= end || *p == '\0') return DeserializationError::IncompleteInput;
+
+    index = (int)nodes.size();
+    nodes.push_back(Node());
+    char c = *p;
+
+    if (c == '{' || c == '[') {
+        bool object = (c == '{');
+        if (++depth > MAX_DEPTH) return DeserializationError::InvalidInput;
+        nodes[index].type = object ? Node::Object : Node::Array;
+        p++;
+        skipSpace();
+        if (p < end && *p == (object ? '}' : ']')) {
+            p++;
+            depth--;
+            return DeserializationError::Ok;
+        }
+        while (true) {
+            std::string key;
+            if (object) {
+                skipSpace();
+                if (p >= end) return DeserializationError::IncompleteInput;
+                if (*p != '"') return DeserializationError::InvalidInput;
+                DeserializationError::Code code = parseString(key);
+                if (code != DeserializationError::Ok) return code;
+                skipSpace();
+                if (p >= end) return DeserializationError::IncompleteInput;
+                if (*p++ != ':') return DeserializationError::InvalidInput;
+            }
+            int child;
+            DeserializationError::Code code = parseValue(child);
+            if (code != DeserializationError::Ok) return code;
+            nodes[index].children.push_back(std::make_pair(key, child));
+            skipSpace();
+            if (p >= end) return DeserializationError::IncompleteInput;
+            if (*p == ',') { p++; continue; }
+            if (*p == (object ? '}' : ']')) { p++; break; }
+            return DeserializationError::InvalidInput;
+        }
+        depth--;
+        return DeserializationError::Ok;
+    }
+
+    if (c == '"') {
+        nodes[index].type = Node::String;
+        std::string text;
+        DeserializationError::Code code = parseString(text);
+        nodes[index].text = text;
+        return code;
+    }
+
+    if (c == '-' || (c >= '0' && c <= '9')) {
+        char* after = nullptr;
+        std::string digits(p, (size_t)(end - p) < 64 ? (size_t)(end - p) : 64);
+        double v = strtod(digits.c_str(), &after);
+        if (after == digits.c_str()) return DeserializationError::InvalidInput;
+        p += after - digits.c_str();
+        nodes[index].type = Node::Number;
+        nodes[index].number = v;
+        return DeserializationError::Ok;
+    }
+
+    static const struct { const char* word; Node::Type type; bool value; } literals[] = {
+        {"true", Node::Bool, true}, {"false", Node::Bool, false}, {"null", Node::Null, false},
+    };
+    for (const auto& literal : literals) {
+        size_t n = strlen(literal.word);
+        if ((size_t)(end - p) >= n && strncmp(p, literal.word, n) == 0) {
+            p += n;
+            nodes[index].type = literal.type;
+            nodes[index].boolean = literal.value;
+            return DeserializationError::Ok;
+        }
+    }
+    return (size_t)(end - p) < 5 ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+}
+
+}
@@ -0,0 +1,155 @@
+// In-process MQTT broker stand-in for the host build (see HostBroker.h)
+#include <deque>
+#include <map>
+#include <vector>
+#include "HostBroker.h"
+
+namespace {
+    struct Session {
+        bool connected = false;
+        bool cleanSession = true;
+        bool inflight = false;    // Front of the queue delivered, not yet acked
+        std::vector<std::pair<std::string, uint8_t>> subscriptions;
+        std::deque<HostBroker::Message> queue;
+    };
+
+    std::map<std::string, Session> sessions;
+    HostBroker::Stats counters = {};
+    bool online = true;
+    bool dropNextAck = false;
+    size_t cutNext = SIZE_MAX;
+
+    // MQTT topic filter match, level by level: + is one level, # the rest
+    // (including none, so "alerts/#" matches "alerts")
+    bool matches(const std::string& filter, const std::string& topic) {
+        size_t f = 0, t = 0;
+        while (true) {
+            size_t fEnd = filter.find('/', f);
+            std::string level = filter.substr(f, fEnd == std::string::npos ? std::string::npos : fEnd - f);
+            if (level == "#") return true;
+            if (t > topic.size()) return false;
+            size_t tEnd = topic.find('/', t);
+            if (level != "+" && level != topic.substr(t, tEnd == std::string::npos ? std::string::npos : tEnd - t)) {
+                return false;
+            }
+            if (fEnd == std::string::npos) return tEnd == std::string::npos;
+            f = fEnd + 1;
+            t = (tEnd == std::string::npos) ? topic.size() + 1 : tEnd + 1;
+        }
+    }
+
+    // The connection is gone: unacked messages will be sent again, and a
+    // clean session ends with it
+    void dropConnection(std::map<std::string, Session>::iterator it) {
+        Session& s = it->second;
+        s.connected = false;
+        if (s.inflight) {
+            s.queue.front().dup = true;
+            s.inflight = false;
+        }
+        if (s.cleanSession) sessions.erase(it);
+    }
+}
+
+void HostBroker::setOnline(bool up) {
+    online = up;
+    if (up) return;
+    for (auto it = sessions.begin(); it != sessions.end(); ) {
+        auto current = it++;
+        if (current->second.connected) dropConnection(current);
+    }
+}
+
+void HostBroker::publish(const char* topic, const std::string& payload, uint8_t qos) {
+    counters.published++;
+    for (auto& entry : sessions) {
+        Session& s = entry.second;
+        uint8_t granted = 0xFF;
+        for (const auto& sub : s.subscriptions) {
+            if (matches(sub.first, topic) && (granted == 0xFF || sub.second > granted)) granted = sub.second;
+        }
+        if (granted == 0xFF) continue;
+        uint8_t effective = qos < granted ? qos : granted;
+        if ((!s.connected && effective == 0) || s.queue.size() >= QUEUE_LIMIT) {
+            counters.dropped++;
+            continue;
+        }
+        s.queue.push_back({topic, payload, effective, false, SIZE_MAX});
+    }
+}
+
+void HostBroker::loseNextAck() { dropNextAck = true; }
+void HostBroker::cutNextDelivery(size_t bytes) { cutNext = bytes; }
+
+size_t HostBroker::queued(const char* clientId) {
+    auto it = sessions.find(clientId);
+    return it == sessions.end() ? 0 : it->second.queue.size();
+}
+
+const HostBroker::Stats& HostBroker::stats() { return counters; }
+
+bool HostBroker::connect(const char* clientId, bool cleanSession) {
+    if (!online || !clientId || !clientId[0]) return false;
+    auto it = sessions.find(clientId);
+    if (it != sessions.end() && (cleanSession || it->second.cleanSession)) {
+        sessions.erase(it);
+        it = sessions.end();
+    }
+    Session& s = (it == sessions.end()) ? sessions[clientId] : it->second;
+    s.connected = true;
+    s.cleanSession = cleanSession;
+    return true;
+}
+
+void HostBroker::disconnect(const char* clientId) {
+    auto it = sessions.find(clientId);
+    if (it != sessions.end() && it->second.connected) dropConnection(it);
+}
+
+bool HostBroker::connected(const char* clientId) {
+    auto it = sessions.find(clientId);
+    return it != sessions.end() && it->second.connected;
+}
+
+bool HostBroker::subscribe(const char* clientId, const char* filter, uint8_t qos) {
+    auto it = sessions.find(clientId);
+    if (it == sessions.end() || !it->second.connected) return false;
+    for (auto& sub : it->second.subscriptions) {
+        if (sub.first == filter) {
+            sub.second = qos;
+            return true;
+        }
+    }
+    it->second.subscriptions.push_back({filter, qos});
+    return true;
+}
+
+bool HostBroker::next(const char* clientId, Message& out) {
+    auto it = sessions.find(clientId);
+    if (it == sessions.end()) return false;
+    Session& s = it->second;
+    if (!s.connected || s.inflight || s.queue.empty()) return false;
+    out = s.queue.front();
+    out.cutAt = cutNext;
+    cutNext = SIZE_MAX;
+    counters.delivered++;
+    if (out.dup) counters.redelivered++;
+    if (out.qos == 0) {
+        s.queue.pop_front();
+    } else {
+        s.inflight = true;
+    }
+    return true;
+}
+
+void HostBroker::ack(const char* clientId) {
+    auto it = sessions.find(clientId);
+    if (it == sessions.end() || !it->second.inflight) return;
+    if (dropNextAck) {
+        dropNextAck = false;
+        dropConnection(it);
+        return;
+    }
+    it->second.queue.pop_front();
+    it->second.inflight = false;
+}
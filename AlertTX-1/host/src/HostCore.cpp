@@ -0,0 +1,120 @@
+// Host implementations of the Arduino/ESP-IDF globals used by src/
+#include <string>
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+#include "WiFi.h"
+#include "esp_sleep.h"
+#include "HostHooks.h"
+
+uint64_t HostClock::now = 0;
+uint64_t HostClock::sleptUs = 0;
+uint64_t HostClock::nextTimerUs = UINT64_MAX;
+HostClock::TimerHook HostClock::timerHook = nullptr;
+
+void HostClock::setUs(uint64_t us) {
+    if (us < now) return;
+    while (timerHook && nextTimerUs <= us) {
+        if (nextTimerUs > now) now = nextTimerUs;
+        nextTimerUs = UINT64_MAX;
+        wakeAt(timerHook(now));
+    }
+    now = us;
+}
+
+HardwareSerial Serial;
+EspClass ESP;
+SPIClass SPI;
+TwoWire Wire;
+WiFiClass WiFi;
+
+namespace HostHooks {
+    bool serialEcho = true;
+    ToneHook toneHook = nullptr;
+    uint8_t pinLevels[64] = {0};
+    bool ledcAttached[64] = {false};
+    bool wifiConnected = false;
+    int wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    DeepSleepHook deepSleepHook = nullptr;
+    uint16_t batteryMv = 4150;
+    uint8_t batteryPercent = 95;
+}
+
+static std::string serialRx;
+void HostHooks::serialInput(const char* text) { serialRx += text; }
+int HardwareSerial::available() { return (int)serialRx.size(); }
+int HardwareSerial::read() {
+    if (serialRx.empty()) return -1;
+    int c = (unsigned char)serialRx[0];
+    serialRx.erase(0, 1);
+    return c;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (HostHooks::serialEcho) fputc(c, stdout);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (HostHooks::serialEcho) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+static uint32_t randState = 12345;
+void randomSeed(unsigned long seed) { randState = seed ? (uint32_t)seed : 12345; }
+static uint32_t nextRand() {
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+long random(long maxv) { return maxv > 0 ? (long)(nextRand() % (uint32_t)maxv) : 0; }
+long random(long minv, long maxv) { return maxv > minv ? minv + random(maxv - minv) : minv; }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    // Mirror pull resistors so idle buttons read as released
+    if (pin < 64) {
+        HostHooks::ledcAttached[pin] = false;
+        if (mode == INPUT_PULLUP) HostHooks::pinLevels[pin] = HIGH;
+        else if (mode == INPUT_PULLDOWN) HostHooks::pinLevels[pin] = LOW;
+    }
+}
+void digitalWrite(uint8_t pin, uint8_t val) { if (pin < 64) HostHooks::pinLevels[pin] = val; }
+int digitalRead(uint8_t pin) { return pin < 64 ? HostHooks::pinLevels[pin] : LOW; }
+int analogRead(uint8_t) { return 0; }
+void analogWrite(uint8_t, int) {}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+    if (pin < 64) HostHooks::ledcAttached[pin] = true;
+    if (HostHooks::toneHook) HostHooks::toneHook(pin, frequency, duration);
+}
+void noTone(uint8_t pin) {
+    if (HostHooks::toneHook) HostHooks::toneHook(pin, 0, 0);
+    if (pin < 64) HostHooks::ledcAttached[pin] = false;
+}
+bool ledcAttach(uint8_t pin, uint32_t, uint8_t) {
+    if (pin < 64) HostHooks::ledcAttached[pin] = true;
+    return pin < 64;
+}
+uint32_t ledcWriteTone(uint8_t pin, uint32_t freq) {
+    if (pin >= 64 || !HostHooks::ledcAttached[pin]) return 0;
+    if (HostHooks::toneHook) HostHooks::toneHook(pin, freq, 0);
+    return freq;
+}
+bool ledcDetach(uint8_t pin) {
+    if (pin < 64) HostHooks::ledcAttached[pin] = false;
+    return pin < 64;
+}
+
+static uint64_t lightSleepTimerUs = 0;
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeUs) { lightSleepTimerUs = timeUs; return ESP_OK; }
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() { return (esp_sleep_wakeup_cause_t)HostHooks::wakeCause; }
+esp_err_t esp_light_sleep_start() {
+    HostClock::sleepUs(lightSleepTimerUs);
+    return ESP_OK;
+}
+void esp_deep_sleep_start() {
+    if (HostHooks::deepSleepHook) HostHooks::deepSleepHook(lightSleepTimerUs);
+    fprintf(stderr, "host: esp_deep_sleep_start() reached\n");
+    exit(0);
+}
@@ -0,0 +1,82 @@
+// RAM-backed flash partition for the host build (see esp_partition.h)
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "esp_partition.h"
+#include "HostHooks.h"
+
+static const uint32_t SECTOR = 4096;
+static const esp_partition_t alertLogPartition = {
+    ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_FAT, 0x310000, 512 * 1024, SECTOR, "alertlog", false
+};
+static std::vector<uint8_t> flash(alertLogPartition.size, 0xFF);
+
+namespace HostHooks {
+    uint32_t flashWrites = 0;
+    uint32_t flashErases = 0;
+    bool alertLogPresent = true;
+}
+
+static bool inRange(const esp_partition_t* partition, size_t offset, size_t size) {
+    return partition == &alertLogPartition && offset + size <= partition->size && offset + size >= offset;
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    if (!HostHooks::alertLogPresent || type != alertLogPartition.type) return nullptr;
+    if (subtype != ESP_PARTITION_SUBTYPE_ANY && subtype != alertLogPartition.subtype) return nullptr;
+    if (label && strcmp(label, alertLogPartition.label) != 0) return nullptr;
+    return &alertLogPartition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* dst, size_t size) {
+    if (!inRange(partition, offset, size)) return ESP_ERR_INVALID_SIZE;
+    memcpy(dst, &flash[offset], size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* src, size_t size) {
+    if (!inRange(partition, offset, size)) return ESP_ERR_INVALID_SIZE;
+    const uint8_t* in = (const uint8_t*)src;
+    bool dirty = false;
+    for (size_t i = 0; i < size; i++) {
+        if ((flash[offset + i] & in[i]) != in[i]) dirty = true;
+        flash[offset + i] &= in[i];   // Programming only clears bits
+    }
+    if (dirty) fprintf(stderr, "host: flash write at 0x%zx over unerased bytes\n", offset);
+    HostHooks::flashWrites++;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size) {
+    if (!inRange(partition, offset, size) || offset % SECTOR || size % SECTOR) return ESP_ERR_INVALID_ARG;
+    memset(&flash[offset], 0xFF, size);
+    HostHooks::flashErases += size / SECTOR;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t, const void** out_ptr,
+                             esp_partition_mmap_handle_t* out_handle) {
+    if (!inRange(partition, offset, size)) return ESP_ERR_INVALID_SIZE;
+    *out_ptr = &flash[offset];
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t) {}
+
+bool HostHooks::saveFlash(const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(flash.data(), 1, flash.size(), f) == flash.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool HostHooks::loadFlash(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    bool ok = fread(flash.data(), 1, flash.size(), f) == flash.size();
+    fclose(f);
+    return ok;
+}
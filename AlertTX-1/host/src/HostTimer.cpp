@@ -0,0 +1,65 @@
+// Simulated esp_timer: one-shot timers fired by HostClock at their deadline
+#include <stddef.h>
+#include <vector>
+#include "HostClock.h"
+#include "esp_timer.h"
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void* arg;
+    uint64_t deadlineUs;
+    bool active;
+};
+
+static std::vector<esp_timer*> timers;
+
+// Runs every timer due at nowUs (callbacks may re-arm); returns the next deadline
+static uint64_t fireDue(uint64_t nowUs) {
+    for (size_t i = 0; i < timers.size(); i++) {
+        esp_timer* t = timers[i];
+        if (t->active && t->deadlineUs <= nowUs) {
+            t->active = false;
+            t->callback(t->arg);
+        }
+    }
+    uint64_t next = UINT64_MAX;
+    for (esp_timer* t : timers) {
+        if (t->active && t->deadlineUs < next) next = t->deadlineUs;
+    }
+    return next;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+    if (!args || !args->callback || !out) return ESP_ERR_INVALID_ARG;
+    *out = new esp_timer{args->callback, args->arg, 0, false};
+    timers.push_back(*out);
+    HostClock::setTimerHook(fireDue);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+    if (timer->active) return ESP_ERR_INVALID_STATE;
+    timer->deadlineUs = HostClock::nowUs() + timeoutUs;
+    timer->active = true;
+    HostClock::wakeAt(timer->deadlineUs);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer->active) return ESP_ERR_INVALID_STATE;
+    timer->active = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (timer->active) return ESP_ERR_INVALID_STATE;
+    for (size_t i = 0; i < timers.size(); i++) {
+        if (timers[i] == timer) timers.erase(timers.begin() + i);
+    }
+    delete timer;
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) { return timer->active; }
+
+int64_t esp_timer_get_time() { return (int64_t)HostClock::nowUs(); }
@@ -0,0 +1,90 @@
+// Simulated access point behind the host WiFi (see WiFi.h). The latencies are
+// typical ESP32-S3 figures: an active scan of all 13 channels, the
+// auth/assoc/4-way handshake, and a DHCP exchange.
+#include <string.h>
+#include "WiFi.h"
+#include "HostHooks.h"
+
+static const unsigned long SCAN_MS = 2100;
+static const unsigned long ASSOC_MS = 90;
+static const unsigned long DHCP_MS = 600;
+static const unsigned long DNS_MS = 40;
+
+static const IPAddress LEASE_IP(192, 168, 1, 77);
+static const IPAddress ROUTER_IP(192, 168, 1, 1);
+static const IPAddress SUBNET(255, 255, 255, 0);
+static const IPAddress BROKER_IP(192, 168, 1, 10);
+
+namespace HostHooks {
+    uint8_t wifiApChannel = 0;
+    uint8_t wifiApBssid[6] = {0x24, 0x5A, 0x4C, 0x01, 0x02, 0x03};
+}
+
+wl_status_t WiFiClass::status() {
+    if (HostHooks::wifiConnected) return WL_CONNECTED;
+    if (!started || millis() < readyAtMs) return WL_DISCONNECTED;
+    return joins ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+}
+
+// A channel and BSSID skip the scan but only find the AP if it is still
+// there; a static IP skips DHCP
+wl_status_t WiFiClass::begin(const char*, const char*, int32_t channel, const uint8_t* bssid, bool) {
+    bool direct = channel != 0 && bssid;
+    bool apHere = HostHooks::wifiApChannel != 0;
+    if (direct) {
+        apHere = apHere && channel == HostHooks::wifiApChannel && memcmp(bssid, HostHooks::wifiApBssid, 6) == 0;
+    }
+    started = true;
+    joins = apHere;
+    readyAtMs = millis() + (direct ? 0 : SCAN_MS) + ASSOC_MS + (apHere && (uint32_t)staticIp == 0 ? DHCP_MS : 0);
+    return WL_DISCONNECTED;
+}
+
+bool WiFiClass::config(IPAddress localIp, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress) {
+    staticIp = localIp;
+    staticGateway = gateway;
+    staticSubnet = subnet;
+    staticDns = dns1;
+    return true;
+}
+
+bool WiFiClass::disconnect(bool, bool) {
+    started = false;
+    return true;
+}
+
+IPAddress WiFiClass::localIP() {
+    if (status() != WL_CONNECTED) return IPAddress();
+    return (uint32_t)staticIp ? staticIp : LEASE_IP;
+}
+
+IPAddress WiFiClass::gatewayIP() {
+    if (status() != WL_CONNECTED) return IPAddress();
+    return (uint32_t)staticIp ? staticGateway : ROUTER_IP;
+}
+
+IPAddress WiFiClass::subnetMask() {
+    if (status() != WL_CONNECTED) return IPAddress();
+    return (uint32_t)staticIp ? staticSubnet : SUBNET;
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t) {
+    if (status() != WL_CONNECTED) return IPAddress();
+    return (uint32_t)staticIp ? staticDns : ROUTER_IP;
+}
+
+uint8_t* WiFiClass::BSSID() {
+    return (status() == WL_CONNECTED && HostHooks::wifiApChannel) ? HostHooks::wifiApBssid : nullptr;
+}
+
+int32_t WiFiClass::channel() {
+    return status() == WL_CONNECTED ? HostHooks::wifiApChannel : 0;
+}
+
+// Every name resolves to the broker, one round trip to the router later
+int WiFiClass::hostByName(const char* host, IPAddress& result) {
+    if (status() != WL_CONNECTED || !host || !host[0]) return 0;
+    delay(DNS_MS);
+    result = BROKER_IP;
+    return 1;
+}
@@ -1,4 +1,5 @@
 #include "SettingsManager.h"
+#include "settings.h"
 #if defined(__has_include)
 #  if __has_include("generated_secrets.h")
 #    include "generated_secrets.h"
@@ -31,6 +32,8 @@ const char* SettingsManager::MQTT_PUB_TOPIC_KEY = "mqtt_pub";
 const char* SettingsManager::PWR_INACT_MS_KEY = "pwr_inact_ms";
 const char* SettingsManager::PWR_DIM_GRACE_MS_KEY = "pwr_dim_ms";
 const char* SettingsManager::PWR_SLEEP_MS_KEY = "pwr_sleep_ms";
+const char* SettingsManager::ALERT_DEDUPE_MS_KEY = "alert_dedup_ms";
+const char* SettingsManager::TELEMETRY_MS_KEY = "telem_ms";
 
 void SettingsManager::begin() {
     Serial.println("SettingsManager: Initializing NVS...");
@@ -320,3 +323,17 @@ uint32_t SettingsManager::getDeepSleepIntervalMs() {
     }
     return v;
 }
+
+uint32_t SettingsManager::getAlertDedupeWindowMs() {
+    // Unlike the power timeouts, a stored 0 is meaningful (dedupe off)
+    return (uint32_t)prefs.getULong(ALERT_DEDUPE_MS_KEY, ALERT_DEDUPE_WINDOW_MS);
+}
+
+void SettingsManager::setAlertDedupeWindowMs(uint32_t ms) { prefs.putULong(ALERT_DEDUPE_MS_KEY, ms); }
+
+uint32_t SettingsManager::getTelemetryIntervalMs() {
+    // A stored 0 turns telemetry off
+    return (uint32_t)prefs.getULong(TELEMETRY_MS_KEY, TELEMETRY_INTERVAL_MS);
+}
+
+void SettingsManager::setTelemetryIntervalMs(uint32_t ms) { prefs.putULong(TELEMETRY_MS_KEY, ms); }
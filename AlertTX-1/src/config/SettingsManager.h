@@ -45,6 +45,8 @@ private:
     static const char* PWR_INACT_MS_KEY;     // "pwr_inact_ms"
     static const char* PWR_DIM_GRACE_MS_KEY; // "pwr_dim_ms"
     static const char* PWR_SLEEP_MS_KEY;     // "pwr_sleep_ms"
+    static const char* ALERT_DEDUPE_MS_KEY;  // "alert_dedup_ms"
+    static const char* TELEMETRY_MS_KEY;     // "telem_ms"
     
     // Validation constants
     static const int MIN_THEME_INDEX = 0;
@@ -145,6 +147,14 @@ public:
     static uint32_t getInactivityTimeoutMs();
     static uint32_t getDimGraceMs();
     static uint32_t getDeepSleepIntervalMs();
+
+    // Alert dedupe window (0 = every alert gets its own row)
+    static uint32_t getAlertDedupeWindowMs();
+    static void setAlertDedupeWindowMs(uint32_t ms);
+
+    // Telemetry publish interval (0 = off)
+    static uint32_t getTelemetryIntervalMs();
+    static void setTelemetryIntervalMs(uint32_t ms);
 };
 
 #endif // SETTINGSMANAGER_H
@@ -11,6 +11,9 @@ extern const int MQTT_PORT;
 extern const char* MQTT_CLIENT_ID;
 extern const char* MQTT_TOPIC_SUBSCRIBE; // Topic to receive messages
 extern const char* MQTT_TOPIC_PUBLISH;    // Topic to publish status (optional)
+const bool MQTT_PERSISTENT_SESSION = true; // Broker keeps subscriptions and queues QoS 1 alerts while asleep
+const int MQTT_SUBSCRIBE_QOS = 1;          // PubSubClient subscribes at QoS 0 or 1
+const unsigned long TELEMETRY_INTERVAL_MS = 900000; // Device health to the publish topic every 15 minutes (0 = off)
 
 // Hardware Pin Definitions - Adafruit ESP32-S3 Reverse TFT Feather
 // Using built-in buttons only
@@ -60,6 +63,12 @@ const int LED_PIN = 18;             // GPIO18 (A0) - External LED via 220Ω resi
 // Power Management Settings
 const unsigned long INACTIVITY_TIMEOUT_MS = 60000; // 60 seconds before entering low power mode
 const unsigned long LONG_PRESS_THRESHOLD_MS = 1000; // 1 second for long press detection
+const unsigned long BACKGROUND_WAKE_BUDGET_MS = 4000; // Timer wake: hard limit for connecting and draining alerts
+const unsigned long BACKGROUND_DRAIN_QUIET_MS = 300;  // Timer wake: the queue counts as drained after this long without an alert
+
+// Alert Settings
+const unsigned long ALERT_DEDUPE_WINDOW_MS = 300000; // Repeats of one issue within 5 minutes merge into its row
+const unsigned long STORM_LIST_REFRESH_MS = 250;     // Alert list repaint interval during an alert storm
 
 // Game Settings
 const int GAME_SPEED_LEVEL = 1; // Initial game speed
@@ -151,6 +151,15 @@ bool ButtonManager::isLongPressed(int buttonIndex) {
     return result;
 }
 
+bool ButtonManager::needsPolling() {
+    for (int i = 0; i < 3; i++) {
+        if (buttons[i].currentState || readButtonState(i) != buttons[i].currentState) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void ButtonManager::provideFeedback(int buttonId) {
     if (buzzer) {
         buzzer->playTone(800, 50);  // Short beep
@@ -56,6 +56,10 @@ public:
     bool wasShortClick(int buttonIndex);
     bool isLongPressed(int buttonIndex);
     
+    // True while any button is held or a state change is still debouncing.
+    // The frame scheduler uses this to avoid idling through input.
+    bool needsPolling();
+    
     // Feedback
     void provideFeedback(int buttonId);
     
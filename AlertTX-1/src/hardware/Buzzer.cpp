@@ -1,20 +1,23 @@
 #include "Buzzer.h"
+#include "../ringtones/ToneSequencer.h"
 
 Buzzer::Buzzer() : _pin(-1) {}
 
 void Buzzer::begin(int pin) {
   _pin = pin;
-  pinMode(_pin, OUTPUT);
+  ToneSequencer::begin(_pin);
 }
 
+// UI clicks go out on the sequencer's lowest channel: silent while a
+// ringtone, preview or game song has the buzzer
 void Buzzer::playTone(unsigned int frequency, unsigned long duration) {
   if (_pin != -1) {
-    tone(_pin, frequency, duration);
+    ToneSequencer::beep(frequency, duration);
   }
 }
 
 void Buzzer::noTone() {
   if (_pin != -1) {
-    ::noTone(_pin);
+    ToneSequencer::stopBeep();
   }
 }
@@ -3,16 +3,32 @@
 
 #include <Arduino.h>
 
-// Simple icon descriptor for RGB565 PROGMEM bitmaps
-// Field names (w/h) match existing code usage in DisplayUtils and screens
+// Pixel storage of an Icon
+enum IconFormat : uint8_t {
+	ICON_FORMAT_RGB565 = 0,   // data: w*h RGB565 pixels (transparent = black)
+	ICON_FORMAT_INDEXED = 1   // indices: 1/2/4-bpp indices, packed or RLE
+};
+
+// Flags for ICON_FORMAT_INDEXED
+enum IconFlags : uint8_t {
+	ICON_FLAG_RLE = 0x01,     // indices is a run stream: ((run - 1) << bpp) | index
+	ICON_FLAG_TINT = 0x02     // indices are coverage levels blended bg -> fg at draw time
+};
+
+// Icon descriptor for PROGMEM bitmaps, generated by tools/png_to_header.py
+// Field names (w/h) match existing code usage in DisplayUtils and screens.
+// Plain { x, y, w, h, data } initializers still describe an RGB565 icon.
 struct Icon {
 	int16_t x;
 	int16_t y;
 	uint16_t w;
 	uint16_t h;
-	const uint16_t* data; // PROGMEM pointer to pixel data
+	const uint16_t* data;     // PROGMEM RGB565 pixels (ICON_FORMAT_RGB565)
+	uint8_t format;           // IconFormat
+	uint8_t bpp;              // bits per index: 1, 2 or 4 (ICON_FORMAT_INDEXED)
+	uint8_t flags;            // IconFlags
+	const uint8_t* indices;   // PROGMEM index data; rows are byte-aligned unless RLE
+	const uint16_t* palette;  // PROGMEM RGB565 palette, index 0 transparent (untinted only)
 };
 
 #endif // ICON_H
-
-
@@ -4,7 +4,8 @@
 // AUTO-GENERATED FILE - DO NOT MODIFY
 // Generated from: alert_16.png
 // Size: 16x16 pixels (validated from filename)
-// Pixel format: RGB565
+// Pixel format: 4bpp coverage mask (tinted at draw time), RLE
+// Storage: 101 bytes (RGB565 would be 512 bytes)
 
 #include <Arduino.h>
 #include "Icon.h"
@@ -13,44 +14,20 @@
 #define ALERT_WIDTH 16
 #define ALERT_HEIGHT 16
 
-// Icon data in RGB565 format (256 pixels)
-const uint16_t alert_data[] PROGMEM = {
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+// Pixel indices (101 bytes)
+const uint8_t alert_pixels[] PROGMEM = {
+    0x60, 0x14, 0xD0, 0x19, 0xC0, 0x0F, 0x16, 0x0F, 0x90, 0x04, 0x09, 0x06,
+    0x12, 0x06, 0x09, 0x04, 0x60, 0x04, 0x08, 0x09, 0x00, 0x14, 0x00, 0x09,
+    0x08, 0x04, 0x50, 0x19, 0x10, 0x19, 0x10, 0x19, 0x40, 0x0F, 0x06, 0x20,
+    0x19, 0x20, 0x06, 0x0F, 0x10, 0x04, 0x09, 0x06, 0x02, 0x20, 0x19, 0x20,
+    0x02, 0x06, 0x09, 0x14, 0x09, 0x06, 0x02, 0x20, 0x16, 0x20, 0x02, 0x06,
+    0x09, 0x04, 0x10, 0x0F, 0x06, 0x70, 0x06, 0x0F, 0x40, 0x19, 0x10, 0x19,
+    0x10, 0x19, 0x50, 0x04, 0x08, 0x09, 0x00, 0x14, 0x00, 0x09, 0x08, 0x04,
+    0x60, 0x04, 0x09, 0x06, 0x12, 0x06, 0x09, 0x04, 0x90, 0x0F, 0x16, 0x0F,
+    0xC0, 0x19, 0xD0, 0x14, 0x60
 };
 
-// Icon struct instance
-extern const Icon alert;
-extern const uint16_t* alert_data_ptr;
+// Icon struct instance (const, so each including file gets its own copy)
+const Icon alert = { 0, 0, ALERT_WIDTH, ALERT_HEIGHT, nullptr, ICON_FORMAT_INDEXED, 4, ICON_FLAG_TINT | ICON_FLAG_RLE, alert_pixels, nullptr };
 
 #endif // ALERT_H
@@ -4,7 +4,8 @@
 // AUTO-GENERATED FILE - DO NOT MODIFY
 // Generated from: battery-1_16.png
 // Size: 16x16 pixels (validated from filename)
-// Pixel format: RGB565
+// Pixel format: 4bpp coverage mask (tinted at draw time), RLE
+// Storage: 69 bytes (RGB565 would be 512 bytes)
 
 #include <Arduino.h>
 #include "Icon.h"
@@ -13,44 +14,17 @@
 #define BATTERY_1_WIDTH 16
 #define BATTERY_1_HEIGHT 16
 
-// Icon data in RGB565 format (256 pixels)
-const uint16_t battery_1_data[] PROGMEM = {
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+// Pixel indices (69 bytes)
+const uint8_t battery_1_pixels[] PROGMEM = {
+    0xF0, 0xF0, 0xF0, 0x00, 0x06, 0xA9, 0x04, 0x20, 0x09, 0x0D, 0x89, 0x0F,
+    0x06, 0x20, 0x19, 0x80, 0x0F, 0x06, 0x20, 0x19, 0x00, 0x0F, 0x06, 0x50,
+    0x1F, 0x09, 0x10, 0x19, 0x00, 0x0F, 0x06, 0x50, 0x1F, 0x09, 0x10, 0x19,
+    0x00, 0x0F, 0x06, 0x50, 0x1F, 0x09, 0x10, 0x19, 0x00, 0x0F, 0x06, 0x50,
+    0x1F, 0x09, 0x10, 0x19, 0x80, 0x0F, 0x06, 0x20, 0x09, 0x0D, 0x89, 0x0F,
+    0x06, 0x20, 0x06, 0xA9, 0x04, 0xF0, 0xF0, 0xF0, 0x10
 };
 
-// Icon struct instance
-extern const Icon battery_1;
-extern const uint16_t* battery_1_data_ptr;
+// Icon struct instance (const, so each including file gets its own copy)
+const Icon battery_1 = { 0, 0, BATTERY_1_WIDTH, BATTERY_1_HEIGHT, nullptr, ICON_FORMAT_INDEXED, 4, ICON_FLAG_TINT | ICON_FLAG_RLE, battery_1_pixels, nullptr };
 
 #endif // BATTERY_1_H
@@ -4,7 +4,8 @@
 // AUTO-GENERATED FILE - DO NOT MODIFY
 // Generated from: battery-charging_16.png
 // Size: 16x16 pixels (validated from filename)
-// Pixel format: RGB565
+// Pixel format: 4bpp coverage mask (tinted at draw time), RLE
+// Storage: 102 bytes (RGB565 would be 512 bytes)
 
 #include <Arduino.h>
 #include "Icon.h"
@@ -13,44 +14,20 @@
 #define BATTERY_CHARGING_WIDTH 16
 #define BATTERY_CHARGING_HEIGHT 16
 
-// Icon data in RGB565 format (256 pixels)
-const uint16_t battery_charging_data[] PROGMEM = {
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+// Pixel indices (102 bytes)
+const uint8_t battery_charging_pixels[] PROGMEM = {
+    0xF0, 0xF0, 0xF0, 0x00, 0x06, 0x29, 0x04, 0x20, 0x06, 0x29, 0x04, 0x20,
+    0x09, 0x0D, 0x19, 0x04, 0x02, 0x06, 0x00, 0x06, 0x19, 0x0F, 0x06, 0x20,
+    0x19, 0x20, 0x06, 0x0F, 0x30, 0x0F, 0x06, 0x20, 0x19, 0x10, 0x09, 0x1F,
+    0x30, 0x1F, 0x09, 0x10, 0x19, 0x00, 0x09, 0x0D, 0x1F, 0x19, 0x06, 0x00,
+    0x1F, 0x09, 0x10, 0x19, 0x00, 0x19, 0x0B, 0x1F, 0x0B, 0x06, 0x00, 0x1F,
+    0x09, 0x10, 0x19, 0x20, 0x06, 0x1F, 0x06, 0x10, 0x1F, 0x09, 0x10, 0x19,
+    0x20, 0x06, 0x0F, 0x30, 0x0F, 0x06, 0x20, 0x09, 0x0D, 0x19, 0x04, 0x02,
+    0x06, 0x00, 0x06, 0x19, 0x0F, 0x06, 0x20, 0x06, 0x29, 0x04, 0x20, 0x06,
+    0x29, 0x04, 0xF0, 0xF0, 0xF0, 0x10
 };
 
-// Icon struct instance
-extern const Icon battery_charging;
-extern const uint16_t* battery_charging_data_ptr;
+// Icon struct instance (const, so each including file gets its own copy)
+const Icon battery_charging = { 0, 0, BATTERY_CHARGING_WIDTH, BATTERY_CHARGING_HEIGHT, nullptr, ICON_FORMAT_INDEXED, 4, ICON_FLAG_TINT | ICON_FLAG_RLE, battery_charging_pixels, nullptr };
 
 #endif // BATTERY_CHARGING_H
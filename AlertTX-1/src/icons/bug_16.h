@@ -4,7 +4,8 @@
 // AUTO-GENERATED FILE - DO NOT MODIFY
 // Generated from: bug_16.png
 // Size: 16x16 pixels (validated from filename)
-// Pixel format: RGB565
+// Pixel format: 4bpp coverage mask (tinted at draw time), RLE
+// Storage: 119 bytes (RGB565 would be 512 bytes)
 
 #include <Arduino.h>
 #include "Icon.h"
@@ -13,44 +14,21 @@
 #define BUG_WIDTH 16
 #define BUG_HEIGHT 16
 
-// Icon data in RGB565 format (256 pixels)
-const uint16_t bug_data[] PROGMEM = {
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+// Pixel indices (119 bytes)
+const uint8_t bug_pixels[] PROGMEM = {
+    0xF0, 0x40, 0x16, 0x10, 0x16, 0x90, 0x19, 0x10, 0x19, 0x90, 0x19, 0x10,
+    0x19, 0x50, 0x14, 0x00, 0x7F, 0x00, 0x14, 0x10, 0x19, 0x00, 0x0F, 0x09,
+    0x36, 0x09, 0x0F, 0x00, 0x19, 0x20, 0x06, 0x1F, 0x06, 0x30, 0x06, 0x1F,
+    0x06, 0x30, 0x02, 0x06, 0x0F, 0x0B, 0x39, 0x0B, 0x0F, 0x06, 0x02, 0x20,
+    0x04, 0x16, 0x0F, 0x0B, 0x09, 0x1D, 0x09, 0x0B, 0x0F, 0x16, 0x04, 0x10,
+    0x09, 0x2F, 0x06, 0x00, 0x19, 0x00, 0x06, 0x2F, 0x09, 0x40, 0x0F, 0x06,
+    0x00, 0x19, 0x00, 0x06, 0x0F, 0x50, 0x04, 0x09, 0x0F, 0x06, 0x00, 0x19,
+    0x00, 0x06, 0x0F, 0x09, 0x04, 0x20, 0x04, 0x08, 0x09, 0x0F, 0x06, 0x00,
+    0x19, 0x00, 0x06, 0x0F, 0x09, 0x08, 0x04, 0x10, 0x19, 0x00, 0x0F, 0x0B,
+    0x09, 0x1D, 0x09, 0x0B, 0x0F, 0x00, 0x19, 0x40, 0x79, 0xF0, 0x30
 };
 
-// Icon struct instance
-extern const Icon bug;
-extern const uint16_t* bug_data_ptr;
+// Icon struct instance (const, so each including file gets its own copy)
+const Icon bug = { 0, 0, BUG_WIDTH, BUG_HEIGHT, nullptr, ICON_FORMAT_INDEXED, 4, ICON_FLAG_TINT | ICON_FLAG_RLE, bug_pixels, nullptr };
 
 #endif // BUG_H
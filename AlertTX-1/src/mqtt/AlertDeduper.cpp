@@ -0,0 +1,100 @@
+#include "AlertDeduper.h"
+#include "Fnv1a.h"
+
+AlertDeduper::Slot AlertDeduper::slots[AlertDeduper::TABLE_SIZE] = {};
+uint32_t AlertDeduper::windowMs = 0;
+uint32_t AlertDeduper::merged = 0;
+
+uint32_t AlertDeduper::fingerprint(const char* project, const char* title, const char* level) {
+  static const char SEPARATOR = 0x1F;   // So ("ab", "c") and ("a", "bc") differ
+  uint32_t hash = FNV1A_OFFSET_BASIS;
+  const char* parts[] = { project, title, level };
+  for (const char* part : parts) {
+    if (part) hash = fnv1a(part, strlen(part), hash);
+    hash = fnv1a(&SEPARATOR, 1, hash);
+  }
+  return hash ? hash : 1;   // 0 marks an empty slot
+}
+
+bool AlertDeduper::find(uint32_t fingerprint, uint32_t now, uint32_t& rowId) {
+  if (windowMs == 0) return false;
+  uint8_t i = home(fingerprint);
+  for (uint8_t probes = 0; probes < TABLE_SIZE; probes++) {
+    Slot& slot = slots[i];
+    if (slot.fingerprint == 0) return false;
+    if (expired(slot, now)) {
+      removeAt(i);   // Slot i now holds the next entry of the chain, if any
+      continue;
+    }
+    if (slot.fingerprint == fingerprint) {
+      rowId = slot.rowId;
+      return true;
+    }
+    i = (i + 1) & (TABLE_SIZE - 1);
+  }
+  return false;
+}
+
+void AlertDeduper::remember(uint32_t fingerprint, uint32_t rowId, uint32_t now) {
+  if (windowMs == 0) return;
+  uint8_t i = home(fingerprint);
+  for (uint8_t probes = 0; probes < TABLE_SIZE; probes++) {
+    Slot& slot = slots[i];
+    if (slot.fingerprint != 0 && slot.fingerprint != fingerprint && expired(slot, now)) {
+      removeAt(i);
+      continue;
+    }
+    if (slot.fingerprint == 0 || slot.fingerprint == fingerprint) {
+      slot.fingerprint = fingerprint;
+      slot.rowId = rowId;
+      slot.lastSeen = now;
+      return;
+    }
+    i = (i + 1) & (TABLE_SIZE - 1);
+  }
+
+  // Every slot holds a live issue: drop the one seen longest ago and retry
+  uint8_t oldest = 0;
+  for (uint8_t j = 1; j < TABLE_SIZE; j++) {
+    if (now - slots[j].lastSeen > now - slots[oldest].lastSeen) oldest = j;
+  }
+  removeAt(oldest);
+  remember(fingerprint, rowId, now);
+}
+
+void AlertDeduper::clear() {
+  memset(slots, 0, sizeof(slots));
+  merged = 0;
+}
+
+void AlertDeduper::printStatus(uint32_t now) {
+  uint8_t live = 0;
+  for (uint8_t i = 0; i < TABLE_SIZE; i++) {
+    if (slots[i].fingerprint != 0 && !expired(slots[i], now)) live++;
+  }
+  Serial.printf("AlertDeduper: window %lus, %u/%u issues tracked, %lu repeats merged\n",
+                (unsigned long)(windowMs / 1000), live, TABLE_SIZE, (unsigned long)merged);
+}
+
+// Private helpers
+
+// Backward-shift deletion: pull later entries of the probe chain into the
+// hole so lookups can keep stopping at the first empty slot
+void AlertDeduper::removeAt(uint8_t index) {
+  const uint8_t mask = TABLE_SIZE - 1;
+  uint8_t hole = index;
+  uint8_t j = index;
+  while (true) {
+    slots[hole].fingerprint = 0;
+    while (true) {
+      j = (j + 1) & mask;
+      if (slots[j].fingerprint == 0) return;
+      uint8_t k = home(slots[j].fingerprint);
+      // Entry j may stay when its home lies cyclically in (hole, j]
+      bool stays = (hole <= j) ? (hole < k && k <= j) : (hole < k || k <= j);
+      if (!stays) break;
+    }
+    slots[hole] = slots[j];
+    hole = j;
+  }
+}
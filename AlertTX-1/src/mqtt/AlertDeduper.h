@@ -0,0 +1,63 @@
+#ifndef ALERT_DEDUPER_H
+#define ALERT_DEDUPER_H
+
+#include <Arduino.h>
+
+/**
+ * AlertDeduper
+ *
+ * Ingestion-side memory of recent alerts, so a burst of the same issue
+ * becomes one alert row with an occurrence count instead of a row, a popup
+ * and a ringtone each.
+ *
+ * Features:
+ * - Fingerprint: FNV-1a of project, title and level
+ * - Fixed open-addressing table (linear probing, backward-shift deletion);
+ *   lookups and updates are O(1), no allocation
+ * - Sliding window: an alert repeats if its fingerprint was last seen less
+ *   than the window ago; every repeat extends it. Window 0 turns dedupe off
+ * - Expired entries are dropped as probes pass over them; a table full of
+ *   live entries evicts the least recently seen one
+ * - Stores the row id the caller got for the first occurrence
+ *   (AlertsScreen::addMessage), so a repeat goes straight to that row
+ */
+
+class AlertDeduper {
+public:
+  static const uint8_t TABLE_SIZE = 32;   // Power of two, above the alert history length
+
+  static void setWindow(uint32_t ms) { windowMs = ms; }
+  static uint32_t getWindow() { return windowMs; }
+
+  static uint32_t fingerprint(const char* project, const char* title, const char* level);
+
+  // Row id of a live earlier occurrence; false when the alert is new
+  static bool find(uint32_t fingerprint, uint32_t now, uint32_t& rowId);
+  // Insert or refresh: the alert was shown (or merged) in row rowId at now
+  static void remember(uint32_t fingerprint, uint32_t rowId, uint32_t now);
+  static void clear();
+
+  // Counters for the serial console
+  static void noteMerged() { merged++; }
+  static uint32_t getMerged() { return merged; }
+  static void printStatus(uint32_t now);
+
+private:
+  struct Slot {
+    uint32_t fingerprint;   // 0 = empty
+    uint32_t rowId;
+    uint32_t lastSeen;
+  };
+
+  static Slot slots[TABLE_SIZE];
+  static uint32_t windowMs;
+  static uint32_t merged;
+
+  static uint8_t home(uint32_t fingerprint) {
+    return (uint8_t)((fingerprint ^ (fingerprint >> 16)) & (TABLE_SIZE - 1));
+  }
+  static bool expired(const Slot& slot, uint32_t now) { return now - slot.lastSeen >= windowMs; }
+  static void removeAt(uint8_t index);
+};
+
+#endif // ALERT_DEDUPER_H
@@ -0,0 +1,124 @@
+#include "AlertQueue.h"
+#include "AlertWire.h"
+
+AlertQueue::Entry AlertQueue::slots[CAPACITY];
+bool AlertQueue::used[CAPACITY] = {};
+uint8_t AlertQueue::count = 0;
+uint32_t AlertQueue::nextSeq = 1;
+uint32_t AlertQueue::lowReleaseSeq = 0;
+AlertQueue::Latency AlertQueue::latency[PRIORITIES] = {};
+unsigned long AlertQueue::maxCallbackUs = 0;
+uint32_t AlertQueue::dropped = 0;
+uint32_t AlertQueue::preempted = 0;
+uint32_t AlertQueue::lowBatches = 0;
+
+bool AlertQueue::push(uint8_t priority, const char* project, const char* level, const char* title,
+                      const char* message, const char* time) {
+  if (priority >= PRIORITIES) priority = AlertWire::PRIORITY_HIGH;
+
+  int slot = -1;
+  for (uint8_t i = 0; i < CAPACITY && slot < 0; i++) {
+    if (!used[i]) slot = i;
+  }
+  if (slot < 0) {
+    // Full: the oldest of the lowest priority goes, unless this one ranks lower
+    int victim = 0;
+    for (uint8_t i = 1; i < CAPACITY; i++) {
+      if (slots[i].priority < slots[victim].priority ||
+          (slots[i].priority == slots[victim].priority && slots[i].seq < slots[victim].seq)) {
+        victim = i;
+      }
+    }
+    dropped++;
+    if (slots[victim].priority > priority) return false;
+    Serial.printf("AlertQueue: full, dropped '%s'\n", slots[victim].title);
+    used[victim] = false;
+    count--;
+    slot = victim;
+  }
+
+  Entry& e = slots[slot];
+  e.priority = priority;
+  e.seq = nextSeq++;
+  e.arrivalUs = micros();
+  copy(e.project, sizeof(e.project), project);
+  copy(e.level, sizeof(e.level), level);
+  copy(e.title, sizeof(e.title), title);
+  copy(e.message, sizeof(e.message), message);
+  copy(e.time, sizeof(e.time), time);
+  used[slot] = true;
+  count++;
+  return true;
+}
+
+bool AlertQueue::pop(Entry& out) {
+  int best = -1, oldest = -1, oldestLow = -1;
+  for (uint8_t i = 0; i < CAPACITY; i++) {
+    if (!used[i]) continue;
+    const Entry& e = slots[i];
+    if (oldest < 0 || e.seq < slots[oldest].seq) oldest = i;
+    if (e.priority == AlertWire::PRIORITY_LOW) {
+      if (oldestLow < 0 || e.seq < slots[oldestLow].seq) oldestLow = i;
+    } else if (best < 0 || e.priority > slots[best].priority ||
+               (e.priority == slots[best].priority && e.seq < slots[best].seq)) {
+      best = i;
+    }
+  }
+
+  if (best < 0 && oldestLow >= 0) {
+    // Low ones go as a batch: everything queued once the oldest has waited
+    if (slots[oldestLow].seq > lowReleaseSeq) {
+      bool waited = micros() - slots[oldestLow].arrivalUs >= LOW_BATCH_MS * 1000UL;
+      if (!waited && count < CAPACITY / 2) return false;
+      lowReleaseSeq = nextSeq - 1;
+      lowBatches++;
+    }
+    best = oldestLow;
+  }
+  if (best < 0) return false;
+
+  if (best != oldest) preempted++;
+  out = slots[best];
+  used[best] = false;
+  count--;
+  return true;
+}
+
+void AlertQueue::noteCallback(unsigned long us) {
+  if (us > maxCallbackUs) maxCallbackUs = us;
+}
+
+void AlertQueue::noteShown(uint8_t priority, unsigned long latencyUs) {
+  if (priority >= PRIORITIES) return;
+  Latency& l = latency[priority];
+  l.shown++;
+  l.totalUs += latencyUs;
+  if (latencyUs > l.maxUs) l.maxUs = latencyUs;
+}
+
+unsigned long AlertQueue::getMaxLatencyUs(uint8_t priority) {
+  return priority < PRIORITIES ? latency[priority].maxUs : 0;
+}
+
+uint32_t AlertQueue::getShown(uint8_t priority) {
+  return priority < PRIORITIES ? latency[priority].shown : 0;
+}
+
+void AlertQueue::printStatus() {
+  Serial.printf("AlertQueue: %u/%u queued, %lu dropped, %lu preempted, %lu low batches, callback max %lu us\n",
+                count, CAPACITY, (unsigned long)dropped, (unsigned long)preempted, (unsigned long)lowBatches,
+                maxCallbackUs);
+  for (uint8_t p = 0; p < PRIORITIES; p++) {
+    const Latency& l = latency[p];
+    if (l.shown == 0) continue;
+    Serial.printf("  %-8s %lu shown, to screen avg %lu ms, max %lu ms\n", AlertWire::priorityName(p),
+                  (unsigned long)l.shown, (unsigned long)(l.totalUs / l.shown / 1000), l.maxUs / 1000);
+  }
+}
+
+// Private helpers
+
+void AlertQueue::copy(char* out, size_t size, const char* text) {
+  strncpy(out, text ? text : "", size - 1);
+  out[size - 1] = '\0';
+}
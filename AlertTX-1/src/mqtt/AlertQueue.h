@@ -0,0 +1,82 @@
+#ifndef ALERT_QUEUE_H
+#define ALERT_QUEUE_H
+
+#include <Arduino.h>
+
+/**
+ * AlertQueue
+ *
+ * Bounded priority queue between the MQTT callback and the UI. The callback
+ * only copies the alert in; the main loop takes alerts out once per pass,
+ * right after the MQTT client ran, and shows them.
+ *
+ * Features:
+ * - Fixed CAPACITY slots, no allocation; pushing is a few short copies
+ * - Highest priority first (Beeper-Service low / medium / high / critical,
+ *   AlertWire::Priority), arrival order within one priority
+ * - Low-priority alerts wait until the oldest has been queued for
+ *   LOW_BATCH_MS (or half the queue is taken) and then all go out in one
+ *   pass, so a trickle of them costs one list repaint instead of many
+ * - Full queue: the oldest alert of the lowest priority makes room, unless
+ *   the new one ranks lower still (then it is the one dropped)
+ * - Arrival-to-screen latency per priority (the sketch reports the first
+ *   frame presented after an alert was taken out), plus callback time,
+ *   drops and preemptions for the serial console
+ */
+
+class AlertQueue {
+public:
+  static const uint8_t CAPACITY = 16;
+  static const unsigned long LOW_BATCH_MS = 1000;
+  static const uint8_t PRIORITIES = 4;
+
+  struct Entry {
+    uint8_t priority;
+    uint32_t seq;
+    unsigned long arrivalUs;
+    char project[24];
+    char level[12];
+    char title[64];
+    char message[96];
+    char time[24];
+  };
+
+  // False if the alert was dropped (queue full of higher priorities)
+  static bool push(uint8_t priority, const char* project, const char* level, const char* title,
+                   const char* message, const char* time);
+  // Next alert due now, if any
+  static bool pop(Entry& out);
+  static uint8_t size() { return count; }
+
+  // Statistics
+  static void noteCallback(unsigned long us);
+  static void noteShown(uint8_t priority, unsigned long latencyUs);
+  static unsigned long getMaxLatencyUs(uint8_t priority);
+  static uint32_t getShown(uint8_t priority);
+  static uint32_t getDropped() { return dropped; }
+  static uint32_t getPreempted() { return preempted; }
+  static uint32_t getLowBatches() { return lowBatches; }
+  static void printStatus();
+
+private:
+  struct Latency {
+    uint32_t shown;
+    unsigned long maxUs;
+    uint64_t totalUs;
+  };
+
+  static Entry slots[CAPACITY];
+  static bool used[CAPACITY];
+  static uint8_t count;
+  static uint32_t nextSeq;
+  static uint32_t lowReleaseSeq;       // Low alerts up to this seq are released
+  static Latency latency[PRIORITIES];
+  static unsigned long maxCallbackUs;
+  static uint32_t dropped;
+  static uint32_t preempted;
+  static uint32_t lowBatches;
+
+  static void copy(char* out, size_t size, const char* text);
+};
+
+#endif // ALERT_QUEUE_H
@@ -0,0 +1,93 @@
+#include "AlertStorm.h"
+
+uint16_t AlertStorm::buckets[AlertStorm::BUCKETS] = {};
+uint32_t AlertStorm::bucketStart = 0;
+bool AlertStorm::active = false;
+uint32_t AlertStorm::stormStart = 0;
+uint32_t AlertStorm::enteredAt = 0;
+uint32_t AlertStorm::stormEnd = 0;
+uint32_t AlertStorm::stormCount = 0;
+uint32_t AlertStorm::storms = 0;
+
+bool AlertStorm::noteArrival(uint32_t now) {
+  advance(now);
+  if (buckets[0] < 0xFFFF) buckets[0]++;
+
+  if (active) {
+    stormCount++;
+    return true;
+  }
+  uint16_t count = getWindowCount(now);
+  if (count < ENTER_COUNT) return false;
+
+  // The alerts that tipped the rate over belong to the storm: count them and
+  // date it from the oldest bucket holding one
+  uint8_t oldest = BUCKETS - 1;
+  while (oldest > 0 && buckets[oldest] == 0) oldest--;
+  active = true;
+  enteredAt = now;
+  stormStart = bucketStart - oldest * BUCKET_MS;
+  stormCount = count;
+  storms++;
+  Serial.printf("AlertStorm: storm started, %u alerts in %lus\n", count,
+                (unsigned long)getStormSeconds(now));
+  return true;
+}
+
+bool AlertStorm::update(uint32_t now) {
+  if (!active) return false;
+  advance(now);
+  if (now - enteredAt < MIN_STORM_MS || getWindowCount(now) > EXIT_COUNT) return false;
+
+  active = false;
+  stormEnd = now;
+  Serial.printf("AlertStorm: storm over, %lu alerts in %lus\n",
+                (unsigned long)stormCount, (unsigned long)getStormSeconds(now));
+  return true;
+}
+
+uint16_t AlertStorm::getWindowCount(uint32_t now) {
+  advance(now);
+  uint16_t total = 0;
+  for (uint8_t i = 0; i < BUCKETS; i++) total += buckets[i];
+  return total;
+}
+
+uint32_t AlertStorm::getStormSeconds(uint32_t now) {
+  if (stormCount == 0) return 0;
+  uint32_t seconds = ((active ? now : stormEnd) - stormStart + 999) / 1000;
+  return seconds ? seconds : 1;
+}
+
+void AlertStorm::printStatus(uint32_t now) {
+  Serial.printf("AlertStorm: %s, %u alerts in the last %us (enter at %u, leave at %u), %lu storms\n",
+                active ? "STORM" : "calm", getWindowCount(now), (unsigned)(BUCKETS * BUCKET_MS / 1000),
+                ENTER_COUNT, EXIT_COUNT, (unsigned long)storms);
+  if (stormCount) {
+    Serial.printf("  %s storm: %lu alerts in %lus\n", active ? "Current" : "Last",
+                  (unsigned long)stormCount, (unsigned long)getStormSeconds(now));
+  }
+}
+
+void AlertStorm::reset() {
+  memset(buckets, 0, sizeof(buckets));
+  bucketStart = 0;
+  active = false;
+  stormCount = 0;
+}
+
+// Private helpers
+
+// Shift the window so buckets[0] covers `now`
+void AlertStorm::advance(uint32_t now) {
+  uint32_t elapsed = (now - bucketStart) / BUCKET_MS;
+  if (elapsed == 0) return;
+  if (elapsed >= BUCKETS) {
+    memset(buckets, 0, sizeof(buckets));
+  } else {
+    for (int8_t i = BUCKETS - 1; i >= 0; i--) {
+      buckets[i] = (i >= (int8_t)elapsed) ? buckets[i - elapsed] : 0;
+    }
+  }
+  bucketStart += elapsed * BUCKET_MS;
+}
@@ -0,0 +1,60 @@
+#ifndef ALERT_STORM_H
+#define ALERT_STORM_H
+
+#include <Arduino.h>
+
+/**
+ * AlertStorm
+ *
+ * Arrival-rate detector for incoming alerts. While a storm is on, the
+ * alert path stops treating every alert as an event: no ringtone restarts,
+ * no popup per alert, one summary instead, and the alert list repaints on
+ * a timer rather than per insert.
+ *
+ * Features:
+ * - Sliding window of BUCKETS one-second buckets (O(1) per arrival)
+ * - Hysteresis: enters at ENTER_COUNT arrivals in the window, leaves only
+ *   once the window has dropped to EXIT_COUNT and the storm has lasted at
+ *   least MIN_STORM_MS, so a bursty incident does not flap in and out
+ * - Per-storm totals for the summary ("N new alerts in last M s")
+ *
+ * Usage: noteArrival() for every alert, update() once per loop pass.
+ */
+
+class AlertStorm {
+public:
+  static const uint8_t BUCKETS = 10;            // Window: 10 x 1 s
+  static const uint16_t BUCKET_MS = 1000;
+  static const uint8_t ENTER_COUNT = 8;         // Alerts in the window to enter
+  static const uint8_t EXIT_COUNT = 2;          // At most this many to leave
+  static const uint32_t MIN_STORM_MS = 10000;
+
+  // Records one alert; true when it is part of a storm (possibly the one
+  // that started it)
+  static bool noteArrival(uint32_t now);
+  // Ages the window; true on the pass a storm ends
+  static bool update(uint32_t now);
+
+  static bool isActive() { return active; }
+  static uint16_t getWindowCount(uint32_t now);
+  static uint32_t getStormCount() { return stormCount; }   // Alerts in the current/last storm
+  static uint32_t getStormSeconds(uint32_t now);          // Its length so far, at least 1
+  static uint32_t getStorms() { return storms; }
+  static void printStatus(uint32_t now);
+
+  static void reset();
+
+private:
+  static uint16_t buckets[BUCKETS];
+  static uint32_t bucketStart;    // Start of the newest bucket
+  static bool active;
+  static uint32_t stormStart;     // Oldest alert of the storm (bucket resolution)
+  static uint32_t enteredAt;
+  static uint32_t stormEnd;
+  static uint32_t stormCount;
+  static uint32_t storms;
+
+  static void advance(uint32_t now);
+};
+
+#endif // ALERT_STORM_H
@@ -0,0 +1,78 @@
+#include "AlertWire.h"
+
+AlertWire::Result AlertWire::decode(const uint8_t* payload, size_t length, AlertFrame& frame) {
+  if (!isFrame(payload, length)) return NOT_A_FRAME;
+  if (length < HEADER_SIZE) return TRUNCATED;
+
+  frame.version = payload[1];
+  frame.flags = payload[2];
+  // Newer layouts and the reserved flag bits (compression) are not understood
+  if (frame.version != VERSION || frame.flags != 0) return UNSUPPORTED;
+
+  frame.priority = payload[3];
+  frame.level = payload[4];
+  if (frame.priority > PRIORITY_CRITICAL || frame.level > LEVEL_FATAL) return INVALID;
+  frame.id = readU32(payload + 5);
+  frame.timestamp = readU32(payload + 9);
+  frame.urlHash = readU32(payload + 13);
+
+  size_t offset = HEADER_SIZE;
+  const char** strings[] = { &frame.title, &frame.message, &frame.project, &frame.environment };
+  for (const char** s : strings) {
+    Result result = readString(payload, length, offset, *s);
+    if (result != OK) return result;
+  }
+  return OK;
+}
+
+void AlertWire::formatTime(uint32_t timestamp, char* out) {
+  uint32_t minutes = timestamp / 60;
+  uint8_t hh = (minutes / 60) % 24;
+  uint8_t mm = minutes % 60;
+  out[0] = '0' + hh / 10;
+  out[1] = '0' + hh % 10;
+  out[2] = ':';
+  out[3] = '0' + mm / 10;
+  out[4] = '0' + mm % 10;
+  out[5] = '\0';
+}
+
+const char* AlertWire::resultName(Result result) {
+  switch (result) {
+    case OK: return "ok";
+    case NOT_A_FRAME: return "not a frame";
+    case TRUNCATED: return "truncated";
+    case UNSUPPORTED: return "unsupported version";
+    default: return "invalid";
+  }
+}
+
+const char* AlertWire::priorityName(uint8_t priority) {
+  static const char* const names[] = { "low", "medium", "high", "critical" };
+  return priority <= PRIORITY_CRITICAL ? names[priority] : "?";
+}
+
+uint8_t AlertWire::priorityFromName(const char* name, uint8_t fallback) {
+  if (!name) return fallback;
+  for (uint8_t p = PRIORITY_LOW; p <= PRIORITY_CRITICAL; p++) {
+    if (strcmp(name, priorityName(p)) == 0) return p;
+  }
+  return fallback;
+}
+
+const char* AlertWire::levelName(uint8_t level) {
+  static const char* const names[] = { "debug", "info", "warning", "error", "fatal" };
+  return level <= LEVEL_FATAL ? names[level] : "?";
+}
+
+// Private helpers
+
+AlertWire::Result AlertWire::readString(const uint8_t* payload, size_t length, size_t& offset, const char*& out) {
+  if (offset >= length) return TRUNCATED;
+  size_t n = payload[offset];
+  if (offset + 1 + n >= length) return TRUNCATED;   // Bytes plus terminator
+  if (payload[offset + 1 + n] != 0) return INVALID;
+  out = (const char*)payload + offset + 1;
+  offset += n + 2;
+  return OK;
+}
@@ -0,0 +1,68 @@
+#ifndef ALERT_WIRE_H
+#define ALERT_WIRE_H
+
+#include <Arduino.h>
+
+/**
+ * AlertWire
+ *
+ * Decoder for the compact binary alert frame Beeper-Service publishes on
+ * alerts-bin/<priority> (encoder and byte layout:
+ * Beeper-Service/src/services/alertWire.ts).
+ *
+ * Features:
+ * - No copies, no allocation: the strings in AlertFrame point into the
+ *   payload, which the encoder NUL-terminates for exactly this
+ * - Recognised by its first byte (0xA7), so one subscription callback can
+ *   take both JSON and binary payloads
+ * - Bounds-checked: a frame cut short by the receive buffer is rejected,
+ *   not read past
+ * - Forward compatible within a version: trailing fields are ignored
+ */
+
+struct AlertFrame {
+  uint8_t version;
+  uint8_t flags;
+  uint8_t priority;        // AlertWire::PRIORITY_*
+  uint8_t level;           // AlertWire::LEVEL_*
+  uint32_t id;             // FNV-1a of the service's message id
+  uint32_t timestamp;      // Unix seconds (UTC)
+  uint32_t urlHash;        // FNV-1a of the issue URL, 0 when none
+  const char* title;       // NUL-terminated, inside the payload
+  const char* message;
+  const char* project;
+  const char* environment;
+};
+
+class AlertWire {
+public:
+  static const uint8_t MAGIC = 0xA7;
+  static const uint8_t VERSION = 1;
+  static const uint8_t HEADER_SIZE = 17;
+
+  enum Priority { PRIORITY_LOW, PRIORITY_MEDIUM, PRIORITY_HIGH, PRIORITY_CRITICAL };
+  enum Level { LEVEL_DEBUG, LEVEL_INFO, LEVEL_WARNING, LEVEL_ERROR, LEVEL_FATAL };
+  enum Result { OK, NOT_A_FRAME, TRUNCATED, UNSUPPORTED, INVALID };
+
+  static bool isFrame(const uint8_t* payload, size_t length) {
+    return payload && length > 0 && payload[0] == MAGIC;
+  }
+  static Result decode(const uint8_t* payload, size_t length, AlertFrame& frame);
+
+  // "HH:MM" (UTC) from the frame timestamp; out must hold 6 bytes
+  static void formatTime(uint32_t timestamp, char* out);
+
+  static const char* resultName(Result result);
+  static const char* priorityName(uint8_t priority);
+  // Beeper-Service priority name ("low" .. "critical"); fallback if unknown
+  static uint8_t priorityFromName(const char* name, uint8_t fallback);
+  static const char* levelName(uint8_t level);
+
+private:
+  static uint32_t readU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+  }
+  static Result readString(const uint8_t* payload, size_t length, size_t& offset, const char*& out);
+};
+
+#endif // ALERT_WIRE_H
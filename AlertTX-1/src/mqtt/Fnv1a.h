@@ -0,0 +1,21 @@
+#ifndef FNV1A_H
+#define FNV1A_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+const uint32_t FNV1A_OFFSET_BASIS = 0x811C9DC5UL;
+
+// 32-bit FNV-1a, the hash Beeper-Service uses for alert ids (alertWire.ts).
+// Pass a previous result as seed to hash several pieces as one
+inline uint32_t fnv1a(const void* data, size_t length, uint32_t seed = FNV1A_OFFSET_BASIS) {
+  const uint8_t* p = (const uint8_t*)data;
+  uint32_t hash = seed;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= p[i];
+    hash *= 0x01000193UL;
+  }
+  return hash;
+}
+
+#endif // FNV1A_H
@@ -0,0 +1,367 @@
+#include "JsonFieldExtractor.h"
+
+static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+int JsonFieldExtractor::addField(const char* path, char* buffer, size_t size) {
+  if (!path || !buffer || size == 0 || fieldCount >= MAX_FIELDS) return -1;
+  Field& f = fields[fieldCount];
+  f = Field();
+  f.path = path;
+  f.buffer = buffer;
+  f.size = size;
+  buffer[0] = '\0';
+  return fieldCount++;
+}
+
+void JsonFieldExtractor::reset() {
+  state = EXPECT_VALUE;
+  error = PENDING;
+  depth = 0;
+  objectMask = 0;
+  stringIsKey = false;
+  valueField = -1;
+  descendMask = 0;
+  literal = nullptr;
+  literalPos = 0;
+  highSurrogate = 0;
+  bytesFed = 0;
+  for (uint8_t i = 0; i < fieldCount; i++) {
+    Field& f = fields[i];
+    f.length = 0;
+    f.buffer[0] = '\0';
+    f.matched = 0;
+    f.keyMatch = false;
+    f.found = false;
+    f.truncated = false;
+  }
+}
+
+size_t JsonFieldExtractor::feed(const char* data, size_t length) {
+  if (!data) return 0;
+  for (size_t i = 0; i < length; i++) {
+    bytesFed++;
+    // Anything after the top-level value is ignored, as ArduinoJson does
+    if (state == DONE || state == FAILED) continue;
+    step(data[i]);
+  }
+  return length;
+}
+
+size_t JsonFieldExtractor::write(uint8_t c) {
+  char ch = (char)c;
+  return feed(&ch, 1);
+}
+
+JsonFieldExtractor::Result JsonFieldExtractor::finish() {
+  // A bare top-level number or literal ends with the input
+  if (state == IN_LITERAL && depth == 0 && (!literal || literal[literalPos] == '\0')) endValue();
+  if (state == DONE) return OK;
+  if (state == FAILED) return error;
+  return INCOMPLETE;
+}
+
+const char* JsonFieldExtractor::resultName(Result result) {
+  switch (result) {
+    case OK: return "Ok";
+    case INCOMPLETE: return "IncompleteInput";
+    case INVALID: return "InvalidInput";
+    case TOO_DEEP: return "TooDeep";
+    default: return "Pending";
+  }
+}
+
+// Private helpers
+
+void JsonFieldExtractor::step(char c) {
+  switch (state) {
+    case EXPECT_VALUE:
+      if (!isSpace(c)) beginValue(c);
+      break;
+
+    case EXPECT_VALUE_OR_END:
+      if (isSpace(c)) break;
+      if (c == ']') closeContainer();
+      else beginValue(c);
+      break;
+
+    case EXPECT_KEY_OR_END:
+    case EXPECT_KEY:
+      if (isSpace(c)) break;
+      if (c == '}' && state == EXPECT_KEY_OR_END) {
+        closeContainer();
+      } else if (c == '"') {
+        // Fields whose outer segments all matched compare this key
+        for (uint8_t i = 0; i < fieldCount; i++) {
+          Field& f = fields[i];
+          f.keyMatch = (f.matched == depth - 1);
+          if (f.keyMatch) f.keyCursor = segment(f.path, f.matched);
+        }
+        stringIsKey = true;
+        state = IN_STRING;
+      } else {
+        fail(INVALID);
+      }
+      break;
+
+    case EXPECT_COLON:
+      if (isSpace(c)) break;
+      if (c == ':') state = EXPECT_VALUE;
+      else fail(INVALID);
+      break;
+
+    case AFTER_VALUE:
+      if (isSpace(c)) break;
+      if (c == ',') {
+        state = inObject() ? EXPECT_KEY : EXPECT_VALUE;
+      } else if (c == '}' && inObject()) {
+        closeContainer();
+      } else if (c == ']' && depth > 0 && !inObject()) {
+        closeContainer();
+      } else {
+        fail(INVALID);
+      }
+      break;
+
+    case IN_STRING:
+      if (c == '"') {
+        highSurrogate = 0;
+        if (stringIsKey) {
+          keyDone();
+          state = EXPECT_COLON;
+        } else {
+          endValue();
+        }
+      } else if (c == '\\') {
+        state = IN_ESCAPE;
+      } else if ((uint8_t)c < 0x20) {
+        fail(INVALID);
+      } else if (stringIsKey) {
+        keyChar(c);
+      } else {
+        valueChar(c);
+      }
+      break;
+
+    case IN_ESCAPE: {
+      char out;
+      switch (c) {
+        case '"': case '\\': case '/': out = c; break;
+        case 'b': out = '\b'; break;
+        case 'f': out = '\f'; break;
+        case 'n': out = '\n'; break;
+        case 'r': out = '\r'; break;
+        case 't': out = '\t'; break;
+        case 'u':
+          unicode = 0;
+          unicodeDigits = 0;
+          state = IN_UNICODE;
+          return;
+        default:
+          fail(INVALID);
+          return;
+      }
+      state = IN_STRING;
+      if (stringIsKey) keyChar(out);
+      else valueChar(out);
+      break;
+    }
+
+    case IN_UNICODE: {
+      int v = hexValue(c);
+      if (v < 0) {
+        fail(INVALID);
+        break;
+      }
+      unicode = (uint16_t)((unicode << 4) | v);
+      if (++unicodeDigits < 4) break;
+      state = IN_STRING;
+      if (unicode >= 0xD800 && unicode <= 0xDBFF) {
+        highSurrogate = unicode;   // Wait for the low half
+      } else if (unicode >= 0xDC00 && unicode <= 0xDFFF && highSurrogate) {
+        emitCodepoint(0x10000UL + ((uint32_t)(highSurrogate - 0xD800) << 10) + (unicode - 0xDC00));
+        highSurrogate = 0;
+      } else {
+        emitCodepoint(unicode);
+      }
+      break;
+    }
+
+    case IN_LITERAL:
+      if (literal) {
+        // true / false / null must be spelled out exactly
+        if (literal[literalPos] != '\0') {
+          if (c != literal[literalPos++]) fail(INVALID);
+          else valueChar(c);
+          break;
+        }
+      } else if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+        valueChar(c);
+        break;
+      }
+      // Delimiter: the literal is complete, the character belongs to what follows
+      endValue();
+      if (state != DONE) step(c);
+      break;
+
+    case DONE:
+    case FAILED:
+      break;
+  }
+}
+
+void JsonFieldExtractor::fail(Result result) {
+  error = result;
+  state = FAILED;
+}
+
+void JsonFieldExtractor::beginValue(char c) {
+  if (c == '{' || c == '[') {
+    openContainer(c == '{');
+    return;
+  }
+  descendMask = 0;   // A scalar has no keys to descend into
+  if (c == '"') {
+    stringIsKey = false;
+    state = IN_STRING;
+    return;
+  }
+  if (c == '-' || (c >= '0' && c <= '9')) {
+    literal = nullptr;
+  } else if (c == 't') {
+    literal = "true";
+  } else if (c == 'f') {
+    literal = "false";
+  } else if (c == 'n') {
+    literal = "null";
+  } else {
+    fail(INVALID);
+    return;
+  }
+  literalPos = 1;
+  state = IN_LITERAL;
+  valueChar(c);
+}
+
+void JsonFieldExtractor::endValue() {
+  if (valueField >= 0) {
+    Field& f = fields[valueField];
+    if (state == IN_LITERAL && literal && literal[0] == 'n') {
+      // null reads as absent, so get() falls back as with a missing key
+      f.length = 0;
+      f.buffer[0] = '\0';
+    } else {
+      f.found = true;
+    }
+    valueField = -1;
+  }
+  state = (depth == 0) ? DONE : AFTER_VALUE;
+}
+
+void JsonFieldExtractor::openContainer(bool object) {
+  if (depth >= MAX_DEPTH) {
+    fail(TOO_DEEP);
+    return;
+  }
+  // Objects and arrays are not captured, even at a field's full path
+  valueField = -1;
+  if (object) {
+    for (uint8_t i = 0; i < fieldCount; i++) {
+      if (descendMask & (1 << i)) fields[i].matched = depth;
+    }
+    objectMask |= (1UL << depth);
+  } else {
+    objectMask &= ~(1UL << depth);
+  }
+  descendMask = 0;
+  depth++;
+  state = object ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+}
+
+void JsonFieldExtractor::closeContainer() {
+  depth--;
+  // Back in container `depth`, whose keys are segment depth - 1
+  for (uint8_t i = 0; i < fieldCount; i++) {
+    Field& f = fields[i];
+    uint8_t limit = depth > 0 ? depth - 1 : 0;
+    if (f.matched > limit) f.matched = limit;
+  }
+  endValue();
+}
+
+void JsonFieldExtractor::keyChar(char c) {
+  for (uint8_t i = 0; i < fieldCount; i++) {
+    Field& f = fields[i];
+    if (!f.keyMatch) continue;
+    char expected = *f.keyCursor;
+    if (expected == '\0' || expected == '.' || expected != c) f.keyMatch = false;
+    else f.keyCursor++;
+  }
+}
+
+void JsonFieldExtractor::keyDone() {
+  descendMask = 0;
+  valueField = -1;
+  for (uint8_t i = 0; i < fieldCount; i++) {
+    Field& f = fields[i];
+    if (!f.keyMatch) continue;
+    f.keyMatch = false;
+    if (*f.keyCursor == '.') {
+      descendMask |= (1 << i);
+    } else if (*f.keyCursor == '\0' && !f.found && valueField < 0) {
+      valueField = i;
+    }
+  }
+}
+
+void JsonFieldExtractor::valueChar(char c) {
+  if (valueField < 0) return;
+  Field& f = fields[valueField];
+  if (f.length + 1 < f.size) {
+    f.buffer[f.length++] = c;
+    f.buffer[f.length] = '\0';
+  } else {
+    f.truncated = true;
+  }
+}
+
+void JsonFieldExtractor::emitCodepoint(uint32_t cp) {
+  char utf8[4];
+  uint8_t n;
+  if (cp < 0x80) {
+    utf8[0] = (char)cp;
+    n = 1;
+  } else if (cp < 0x800) {
+    utf8[0] = (char)(0xC0 | (cp >> 6));
+    utf8[1] = (char)(0x80 | (cp & 0x3F));
+    n = 2;
+  } else if (cp < 0x10000) {
+    utf8[0] = (char)(0xE0 | (cp >> 12));
+    utf8[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    utf8[2] = (char)(0x80 | (cp & 0x3F));
+    n = 3;
+  } else {
+    utf8[0] = (char)(0xF0 | (cp >> 18));
+    utf8[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    utf8[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    utf8[3] = (char)(0x80 | (cp & 0x3F));
+    n = 4;
+  }
+  for (uint8_t i = 0; i < n; i++) {
+    if (stringIsKey) keyChar(utf8[i]);
+    else valueChar(utf8[i]);
+  }
+}
+
+const char* JsonFieldExtractor::segment(const char* path, uint8_t index) {
+  while (index > 0 && *path) {
+    if (*path++ == '.') index--;
+  }
+  return path;
+}
@@ -0,0 +1,120 @@
+#ifndef JSON_FIELD_EXTRACTOR_H
+#define JSON_FIELD_EXTRACTOR_H
+
+#include <Arduino.h>
+
+/**
+ * JsonFieldExtractor
+ *
+ * Streaming (SAX-style) JSON reader that copies a declared set of fields
+ * into caller-owned buffers and skips everything else without storing it.
+ * Memory use is fixed no matter how large the document is.
+ *
+ * Features:
+ * - Fields are dot paths of object keys ("data.title", "timestamp")
+ * - Input in place (feed(payload, length)) or byte by byte as a Stream:
+ *   PubSubClient::setStream() hands over every payload byte while it is
+ *   still being received, including payloads larger than its buffer
+ * - Strings are unescaped (\n, \", \uXXXX to UTF-8); numbers, true and
+ *   false are copied as written; null counts as absent; objects and arrays
+ *   are never captured
+ * - Values longer than their buffer are cut and flagged, not rejected
+ * - The first occurrence of a path wins
+ * - Up to MAX_DEPTH nested containers, MAX_FIELDS fields
+ *
+ * Usage: addField() once, then per document: reset(), feed(), finish().
+ */
+
+class JsonFieldExtractor : public Stream {
+public:
+  static const uint8_t MAX_FIELDS = 8;
+  static const uint8_t MAX_DEPTH = 32;
+
+  enum Result { PENDING, OK, INCOMPLETE, INVALID, TOO_DEEP };
+
+  // Field setup; returns the field index or -1 when the table is full
+  int addField(const char* path, char* buffer, size_t size);
+  void clearFields() { fieldCount = 0; }
+
+  // Document
+  void reset();
+  size_t feed(const char* data, size_t length);
+  Result finish();   // OK once a complete top-level value was read
+
+  // Results (valid after finish(), cleared by reset())
+  bool has(int field) const { return field >= 0 && field < fieldCount && fields[field].found; }
+  bool isTruncated(int field) const { return field >= 0 && field < fieldCount && fields[field].truncated; }
+  const char* get(int field, const char* fallback) const {
+    return has(field) ? fields[field].buffer : fallback;
+  }
+  uint32_t getBytesFed() const { return bytesFed; }
+  static const char* resultName(Result result);
+
+  // Stream: PubSubClient writes payload bytes here
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* data, size_t length) override { return feed((const char*)data, length); }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  void flush() override {}
+
+private:
+  enum State : uint8_t {
+    EXPECT_VALUE,        // Value (top level, after ':' or ',' in an array)
+    EXPECT_VALUE_OR_END, // Right after '['
+    EXPECT_KEY_OR_END,   // Right after '{'
+    EXPECT_KEY,          // After ',' in an object
+    EXPECT_COLON,
+    AFTER_VALUE,         // ',' or the closing bracket
+    IN_STRING,
+    IN_ESCAPE,
+    IN_UNICODE,
+    IN_LITERAL,          // Number, true, false, null
+    DONE,
+    FAILED
+  };
+
+  struct Field {
+    const char* path = nullptr;
+    char* buffer = nullptr;
+    size_t size = 0;
+    size_t length = 0;
+    uint8_t matched = 0;              // Leading path segments matched by the open containers
+    const char* keyCursor = nullptr;  // Next path character while a key streams in
+    bool keyMatch = false;
+    bool found = false;
+    bool truncated = false;
+  };
+
+  Field fields[MAX_FIELDS];
+  uint8_t fieldCount = 0;
+
+  State state = EXPECT_VALUE;
+  Result error = PENDING;
+  uint8_t depth = 0;
+  uint32_t objectMask = 0;   // Bit n set: container n is an object
+  bool stringIsKey = false;
+  int8_t valueField = -1;    // Field receiving the current value
+  uint8_t descendMask = 0;   // Fields whose inner segment the last key matched
+  const char* literal = nullptr;   // "true"/"false"/"null" being matched, or null for numbers
+  uint8_t literalPos = 0;
+  uint16_t unicode = 0;
+  uint8_t unicodeDigits = 0;
+  uint16_t highSurrogate = 0;
+  uint32_t bytesFed = 0;
+
+  void step(char c);
+  void fail(Result result);
+  void beginValue(char c);
+  void endValue();
+  void openContainer(bool object);
+  void closeContainer();
+  void keyChar(char c);
+  void keyDone();
+  void valueChar(char c);
+  void emitCodepoint(uint32_t cp);
+  bool inObject() const { return depth > 0 && (objectMask & (1UL << (depth - 1))); }
+  static const char* segment(const char* path, uint8_t index);
+};
+
+#endif // JSON_FIELD_EXTRACTOR_H
@@ -1,4 +1,6 @@
 #include "MQTTClient.h"
+#include "../config/settings.h"
+#include "WifiCache.h"
 #if defined(__has_include)
 #  if __has_include("../config/generated_secrets.h")
 #    include "../config/generated_secrets.h"
@@ -8,15 +10,20 @@
 #endif
 
 // Default constructor for simple usage
-MQTTClient::MQTTClient() : _client(_espClient) {
+MQTTClient::MQTTClient()
+  : _client(_espClient), _cleanSession(!MQTT_PERSISTENT_SESSION), _subscribeQos(MQTT_SUBSCRIBE_QOS) {
   _client.setCallback(nullptr);
   _ssid = _password = _mqttBroker = _clientId = String();
   _mqttUsername = _mqttPassword = nullptr;
   _mqttPort = 0;
 }
 
-MQTTClient::MQTTClient(void (*callback)(char*, uint8_t*, unsigned int)) : _client(_espClient) {
-  _client.setCallback(callback);
+MQTTClient::MQTTClient(void (*callback)(char*, uint8_t*, unsigned int))
+  : _client(_espClient), _callback(callback), _cleanSession(!MQTT_PERSISTENT_SESSION), _subscribeQos(MQTT_SUBSCRIBE_QOS) {
+  // Counted on the way through, so loop() can tell when the queue is drained
+  _client.setCallback([this](char* topic, uint8_t* payload, unsigned int length) {
+    onMessage(topic, payload, length);
+  });
   _ssid = _password = _mqttBroker = _clientId = String();
   _mqttUsername = _mqttPassword = nullptr;
   _mqttPort = 0;
@@ -43,8 +50,10 @@ void MQTTClient::begin(const char* ssid, const char* password, const char* mqttB
   _lastWifiCheckMs = 0;
   _mqttTriedOnce = false;
   _lastMqttAttemptMs = 0;
+  _timingNoted = false;
 
   _client.setServer(_mqttBroker.c_str(), _mqttPort);
+  _brokerByIp = false;
 }
 
 // Simple begin method using build-time generated values from .env
@@ -88,11 +97,28 @@ bool MQTTClient::hasWifiCreds() const { return _ssid.length() > 0; }
 
 bool MQTTClient::hasMqttConfig() const { return _mqttBroker.length() > 0 && _mqttPort > 0 && _clientId.length() > 0; }
 
+// With a cached link: straight to the known AP on its channel with the last
+// lease as static IP, no scan and no DHCP. Otherwise the full scan-and-DHCP
 void MQTTClient::tryWifiConnect() {
   if (_wifiStarted || !hasWifiCreds()) return;
   WiFi.mode(WIFI_STA);
-  Serial.printf("WiFi: attempting connection to SSID '%s'\n", _ssid.c_str());
-  WiFi.begin(_ssid.c_str(), _password.c_str());
+  _fastWifi = WifiCache::takeLink(_ssid.c_str());
+  if (_fastWifi) {
+    const uint8_t* bssid = WifiCache::getBssid();
+    Serial.printf("WiFi: fast reconnect to '%s' via %02X:%02X:%02X:%02X:%02X:%02X ch %u, IP %s\n", _ssid.c_str(),
+                  bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], WifiCache::getChannel(),
+                  WifiCache::getIp().toString().c_str());
+    WiFi.config(WifiCache::getIp(), WifiCache::getGateway(), WifiCache::getSubnet(), WifiCache::getDns());
+    _staticIp = true;
+    WiFi.begin(_ssid.c_str(), _password.c_str(), WifiCache::getChannel(), bssid);
+  } else {
+    Serial.printf("WiFi: attempting connection to SSID '%s'\n", _ssid.c_str());
+    if (_staticIp) {
+      WiFi.config(IPAddress(), IPAddress(), IPAddress());   // Back to DHCP
+      _staticIp = false;
+    }
+    WiFi.begin(_ssid.c_str(), _password.c_str());
+  }
   _wifiStarted = true;
   _wifiStartMs = millis();
   _lastWifiStatusLogMs = 0;
@@ -107,22 +133,31 @@ void MQTTClient::tryMqttConnect() {
   if (_mqttTriedOnce && (now - _lastMqttAttemptMs) < _mqttRetryDelayMs) return;
   _lastMqttAttemptMs = now;
   _mqttTriedOnce = true;
-  Serial.printf("MQTT: attempting connect to %s:%d as '%s'\n", _mqttBroker.c_str(), _mqttPort, _clientId.c_str());
-  bool connected = false;
-  if (_mqttUsername && _mqttUsername[0] != '\0') {
-    connected = _client.connect(_clientId.c_str(), _mqttUsername, (_mqttPassword ? _mqttPassword : ""));
-  } else {
-    connected = _client.connect(_clientId.c_str());
-  }
+  if (!_brokerByIp) useCachedBroker();
+  Serial.printf("MQTT: attempting connect to %s:%d as '%s' (%s session)\n", _mqttBroker.c_str(), _mqttPort,
+                _clientId.c_str(), _cleanSession ? "clean" : "persistent");
+  bool hasUser = _mqttUsername && _mqttUsername[0] != '\0';
+  bool connected = _client.connect(_clientId.c_str(), hasUser ? _mqttUsername : nullptr,
+                                   hasUser ? (_mqttPassword ? _mqttPassword : "") : nullptr,
+                                   nullptr, 0, false, nullptr, _cleanSession);
   if (connected) {
     Serial.println("MQTT: connected");
-    if (_lastSubscribeTopic.length() > 0) {
-      bool ok = _client.subscribe(_lastSubscribeTopic.c_str());
-      Serial.printf("MQTT: subscribe '%s' %s\n", _lastSubscribeTopic.c_str(), ok ? "ok" : "failed");
+    discardPartialPayload();   // What the old link was cut off in the middle of comes again
+    if (!_timingNoted) {
+      _timingNoted = true;
+      WifiCache::noteConnect(_fastWifi, _wifiConnectedMs - _wifiStartMs, now - _wifiStartMs);
     }
+    // A resumed session still has the subscription; renewing it is harmless
+    subscribeNow();
   } else {
     int st = _client.state();
     Serial.printf("MQTT: connect failed (state=%d) (will retry)\n", st);
+    if (_brokerByIp) {
+      // The cached address may be stale: resolve the name again next time
+      WifiCache::clearBroker();
+      _client.setServer(_mqttBroker.c_str(), _mqttPort);
+      _brokerByIp = false;
+    }
   }
 }
 
@@ -153,11 +188,21 @@ void MQTTClient::loop() {
           (st == WL_DISCONNECTED) ? "DISCONNECTED" : "UNKNOWN";
         Serial.printf("WiFi: status=%d (%s)\n", (int)st, s);
       }
+      if (_fastWifi && _wifiStarted) {
+        if (st == WL_NO_SSID_AVAIL || st == WL_CONNECT_FAILED) {
+          fallBackToFullConnect("cached AP not found");
+        } else if (now - _wifiStartMs > FAST_CONNECT_TIMEOUT_MS) {
+          fallBackToFullConnect("cached AP timed out");
+        }
+      }
     } else if (!_wifiAnnouncedConnected) {
       _wifiAnnouncedConnected = true;
+      _wifiConnectedMs = now;
       IPAddress ip = WiFi.localIP();
       long rssi = WiFi.RSSI();
-      Serial.printf("WiFi: connected, IP=%s, RSSI=%ld dBm\n", ip.toString().c_str(), rssi);
+      Serial.printf("WiFi: connected in %lu ms (%s), IP=%s, RSSI=%ld dBm\n", now - _wifiStartMs,
+                    _fastWifi ? "fast" : "full", ip.toString().c_str(), rssi);
+      WifiCache::saveLink(_ssid.c_str(), _fastWifi);
     }
   }
 
@@ -165,9 +210,92 @@ void MQTTClient::loop() {
     tryMqttConnect();
   }
 
+  // PubSubClient handles one packet per loop(). After a wake the broker
+  // sends the queued alerts back to back: keep going while they come
   if (_client.connected()) {
-    _client.loop();
+    uint8_t handled = 0;
+    uint32_t before;
+    do {
+      before = _messagesReceived;
+      discardPartialPayload();
+      _client.loop();
+    } while (_messagesReceived != before && ++handled < DRAIN_BURST && _client.connected());
+  }
+}
+
+void MQTTClient::fallBackToFullConnect(const char* reason) {
+  Serial.printf("WiFi: %s after %lu ms, falling back to a full scan\n", reason, millis() - _wifiStartMs);
+  WifiCache::clearLink();
+  WifiCache::noteFallback();
+  WiFi.disconnect();
+  unsigned long started = _wifiStartMs;
+  _wifiStarted = false;
+  tryWifiConnect();
+  _wifiStartMs = started;   // Timings count from the first attempt
+}
+
+// Connect by address when the broker's name was resolved on an earlier
+// wake; resolve it now (once) otherwise
+void MQTTClient::useCachedBroker() {
+  IPAddress ip;
+  if (ip.fromString(_mqttBroker.c_str())) return;   // Already an address
+  bool cached = WifiCache::getBroker(_mqttBroker.c_str(), ip);
+  if (!cached) {
+    if (WiFi.hostByName(_mqttBroker.c_str(), ip) != 1) return;   // PubSubClient will try again itself
+    WifiCache::saveBroker(_mqttBroker.c_str(), ip);
+  }
+  Serial.printf("MQTT: broker %s at %s%s\n", _mqttBroker.c_str(), ip.toString().c_str(), cached ? " (cached)" : "");
+  _client.setServer(ip, _mqttPort);
+  _brokerByIp = true;
+}
+
+void MQTTClient::setSession(bool persistent, uint8_t subscribeQos) {
+  _cleanSession = !persistent;
+  _subscribeQos = subscribeQos > 1 ? 1 : subscribeQos;   // PubSubClient subscribes at QoS 0 or 1
+}
+
+uint16_t MQTTClient::drain(unsigned long quietMs, unsigned long timeoutMs) {
+  uint32_t first = _messagesReceived;
+  uint32_t seen = first;
+  unsigned long start = millis();
+  unsigned long lastMessageMs = start;
+  while (millis() - start < timeoutMs && millis() - lastMessageMs < quietMs) {
+    loop();
+    if (_messagesReceived != seen) {
+      seen = _messagesReceived;
+      lastMessageMs = millis();
+    }
+    delay(1);
   }
+  uint16_t count = (uint16_t)(_messagesReceived - first);
+  Serial.printf("MQTT: drained %u messages in %lu ms\n", count, millis() - start);
+  return count;
+}
+
+void MQTTClient::setPayloadStream(JsonFieldExtractor& stream) {
+  _payloadStream = &stream;
+  _client.setStream(stream);
+}
+
+// Each _client.loop() reads a whole packet and the callback resets the
+// extractor, so anything still in it here is the start of a packet that never
+// completed (socket timeout, lost link): it would corrupt the next alert
+void MQTTClient::discardPartialPayload() {
+  if (!_payloadStream || _payloadStream->getBytesFed() == 0) return;
+  Serial.printf("MQTT: dropped %u bytes of an incomplete message\n", (unsigned)_payloadStream->getBytesFed());
+  _payloadStream->reset();
+}
+
+void MQTTClient::onMessage(char* topic, uint8_t* payload, unsigned int length) {
+  _messagesReceived++;
+  if (_callback) _callback(topic, payload, length);
+}
+
+bool MQTTClient::subscribeNow() {
+  if (_lastSubscribeTopic.length() == 0) return false;
+  bool ok = _client.subscribe(_lastSubscribeTopic.c_str(), _subscribeQos);
+  Serial.printf("MQTT: subscribe '%s' (QoS %u) %s\n", _lastSubscribeTopic.c_str(), _subscribeQos, ok ? "ok" : "failed");
+  return ok;
 }
 
 bool MQTTClient::publish(const char* topic, const char* payload) {
@@ -177,10 +305,7 @@ bool MQTTClient::publish(const char* topic, const char* payload) {
 
 void MQTTClient::subscribe(const char* topic) {
   _lastSubscribeTopic = (topic ? topic : "");
-  if (_client.connected() && _lastSubscribeTopic.length() > 0) {
-    bool ok = _client.subscribe(_lastSubscribeTopic.c_str());
-    Serial.printf("MQTT: subscribe '%s' %s\n", _lastSubscribeTopic.c_str(), ok ? "ok" : "failed");
-  }
+  if (_client.connected()) subscribeNow();
 }
 
 // Alias for loop() for consistency with other managers
@@ -206,7 +331,8 @@ void MQTTClient::printDebugStatus() {
   Serial.printf("DBG: WiFi ssid='%s' status=%d(%s) ip=%s\n",
                 _ssid.c_str(), (int)st, s,
                 (st == WL_CONNECTED ? WiFi.localIP().toString().c_str() : "-"));
-  Serial.printf("DBG: MQTT %s to %s:%d as '%s'\n",
+  Serial.printf("DBG: MQTT %s to %s:%d as '%s', %s session, QoS %u, %lu messages\n",
                 (_client.connected() ? "connected" : "disconnected"),
-                _mqttBroker.c_str(), _mqttPort, _clientId.c_str());
+                _mqttBroker.c_str(), _mqttPort, _clientId.c_str(),
+                _cleanSession ? "clean" : "persistent", _subscribeQos, (unsigned long)_messagesReceived);
 }
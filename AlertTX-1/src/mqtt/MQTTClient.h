@@ -2,6 +2,7 @@
 #define MQTTCLIENT_H
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include "JsonFieldExtractor.h"
 
 class MQTTClient {
 public:
@@ -13,9 +14,24 @@ public:
   void update(); // Alias for loop() for consistency with other managers
   bool publish(const char* topic, const char* payload);
   void subscribe(const char* topic);
+  // Every incoming payload is also written here byte by byte as it arrives,
+  // so messages larger than the receive buffer still reach the extractor
+  // intact. Bytes left by a packet abandoned mid-payload are dropped on every
+  // (re)connect and before the next packet is read
+  void setPayloadStream(JsonFieldExtractor& stream);
+  // Persistent session (clean session off) keeps the subscription and the
+  // QoS 1 alerts published while the device sleeps; the client id must stay
+  // the same across boots. Defaults: MQTT_PERSISTENT_SESSION, MQTT_SUBSCRIBE_QOS
+  void setSession(bool persistent, uint8_t subscribeQos);
+  // Blocking drain for a background wake: process messages until none has
+  // arrived for quietMs (or timeoutMs passed). Returns how many were handled
+  uint16_t drain(unsigned long quietMs, unsigned long timeoutMs);
   bool isMqttConnected() { return _client.connected(); }
   void printDebugStatus();
 private:
+  static const uint8_t DRAIN_BURST = 16;   // Queued messages handled per loop() pass
+  static const unsigned long FAST_CONNECT_TIMEOUT_MS = 1500;   // Then fall back to a full scan
+
   WiFiClient _espClient;
   PubSubClient _client;
   String _ssid;
@@ -26,6 +42,11 @@ private:
   const char* _mqttUsername = nullptr;
   const char* _mqttPassword = nullptr;
   String _lastSubscribeTopic;
+  void (*_callback)(char*, uint8_t*, unsigned int) = nullptr;
+  bool _cleanSession;
+  uint8_t _subscribeQos;
+  uint32_t _messagesReceived = 0;
+  JsonFieldExtractor* _payloadStream = nullptr;
 
   // Non-blocking connection state
   bool _wifiStarted = false;
@@ -36,11 +57,21 @@ private:
   unsigned long _wifiStartMs = 0;
   unsigned long _lastWifiStatusLogMs = 0;
   bool _wifiAnnouncedConnected = false;
+  bool _fastWifi = false;          // Current attempt uses the WifiCache link
+  bool _staticIp = false;          // WiFi.config() holds a cached lease
+  bool _brokerByIp = false;        // setServer() got the cached broker address
+  unsigned long _wifiConnectedMs = 0;
+  bool _timingNoted = false;
 
   void reconnect(); // retained for compatibility (now non-blocking attempt)
   void tryWifiConnect();
+  void fallBackToFullConnect(const char* reason);
+  void useCachedBroker();
   void tryMqttConnect();
   bool hasWifiCreds() const;
   bool hasMqttConfig() const;
+  void onMessage(char* topic, uint8_t* payload, unsigned int length);
+  bool subscribeNow();
+  void discardPartialPayload();
 };
 #endif // MQTTCLIENT_H
@@ -0,0 +1,34 @@
+#include "RedeliveryFilter.h"
+#include "Fnv1a.h"
+
+// RTC slow memory: kept through deep sleep
+RTC_DATA_ATTR uint32_t RedeliveryFilter::recent[RedeliveryFilter::RING_SIZE] = {};
+RTC_DATA_ATTR uint8_t RedeliveryFilter::next = 0;
+RTC_DATA_ATTR uint32_t RedeliveryFilter::dropped = 0;
+
+uint32_t RedeliveryFilter::hashId(const char* id) {
+  if (!id || !id[0]) return 0;
+  return fnv1a(id, strlen(id));
+}
+
+bool RedeliveryFilter::isDuplicate(uint32_t alertId) {
+  if (alertId == 0) return false;
+  for (uint8_t i = 0; i < RING_SIZE; i++) {
+    if (recent[i] == alertId) {
+      dropped++;
+      return true;
+    }
+  }
+  recent[next] = alertId;
+  next = (next + 1) % RING_SIZE;
+  return false;
+}
+
+void RedeliveryFilter::printStatus() {
+  uint8_t used = 0;
+  for (uint8_t i = 0; i < RING_SIZE; i++) {
+    if (recent[i] != 0) used++;
+  }
+  Serial.printf("RedeliveryFilter: %u/%u recent ids, %lu redeliveries dropped\n",
+                used, RING_SIZE, (unsigned long)dropped);
+}
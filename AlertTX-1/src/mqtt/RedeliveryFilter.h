@@ -0,0 +1,38 @@
+#ifndef REDELIVERY_FILTER_H
+#define REDELIVERY_FILTER_H
+
+#include <Arduino.h>
+
+/**
+ * RedeliveryFilter
+ *
+ * Drops alerts the device has already handled when the broker delivers them
+ * again. With a persistent session and QoS 1, a message whose PUBACK never
+ * made it out (deep sleep or a dropped link right after handling it) comes
+ * back on the next connect.
+ *
+ * Features:
+ * - Ring of the last RING_SIZE alert ids. An id is the FNV-1a hash of the
+ *   Beeper-Service message id, the same value binary frames carry
+ * - Lives in RTC memory: survives deep sleep, starts empty on power-on
+ * - Alerts without an id (0) are never filtered
+ */
+
+class RedeliveryFilter {
+public:
+  static const uint8_t RING_SIZE = 16;   // Above the broker's in-flight window
+
+  static uint32_t hashId(const char* id);
+  // True if this alert was handled before; otherwise remembers it
+  static bool isDuplicate(uint32_t alertId);
+
+  static uint32_t getDropped() { return dropped; }
+  static void printStatus();
+
+private:
+  static uint32_t recent[RING_SIZE];
+  static uint8_t next;
+  static uint32_t dropped;
+};
+
+#endif // REDELIVERY_FILTER_H
@@ -0,0 +1,153 @@
+#include "Telemetry.h"
+#include <stdarg.h>
+#include <WiFi.h>
+#include "MQTTClient.h"
+#include "../config/SettingsManager.h"
+#include "../power/PowerManager.h"
+
+// RTC slow memory: the window survives deep sleep
+RTC_DATA_ATTR Telemetry::Window Telemetry::window = {};
+RTC_DATA_ATTR uint32_t Telemetry::published = 0;
+
+uint32_t Telemetry::intervalMs = 0;
+char Telemetry::topic[48] = "";
+unsigned long Telemetry::lastUpdateMs = 0;
+unsigned long Telemetry::lastSampleMs = 0;
+unsigned long Telemetry::lastAttemptMs = 0;
+bool Telemetry::attempted = false;
+
+void Telemetry::Aggregate::add(int32_t value) {
+  if (count == 0 || value < min) min = value;
+  if (count == 0 || value > max) max = value;
+  sum += value;
+  count++;
+}
+
+void Telemetry::begin() {
+  intervalMs = SettingsManager::getTelemetryIntervalMs();
+  String t = SettingsManager::getMqttPublishTopic();
+  strncpy(topic, t.c_str(), sizeof(topic) - 1);
+  topic[sizeof(topic) - 1] = '\0';
+  lastUpdateMs = millis();
+  lastSampleMs = 0;
+  attempted = false;
+}
+
+void Telemetry::noteFrame(uint32_t drawUs) {
+  window.frameUs.add((int32_t)drawUs);
+  uint8_t bucket = 0;
+  for (uint32_t limitUs = 2000; bucket < FRAME_BUCKETS - 1 && drawUs >= limitUs; limitUs <<= 1) bucket++;
+  window.frameHistogram[bucket]++;
+}
+
+void Telemetry::noteLoop(uint32_t workUs) {
+  window.loopUs.add((int32_t)workUs);
+}
+
+bool Telemetry::update(unsigned long nowMs, MQTTClient& mqtt) {
+  window.elapsedMs += nowMs - lastUpdateMs;
+  lastUpdateMs = nowMs;
+  if (lastSampleMs == 0 || nowMs - lastSampleMs >= SAMPLE_INTERVAL_MS) {
+    lastSampleMs = nowMs;
+    sample();
+  }
+
+  // Rides on a connection someone else opened; never connects by itself
+  if (intervalMs == 0 || window.elapsedMs < intervalMs || topic[0] == '\0') return false;
+  if (!mqtt.isMqttConnected()) return false;
+  if (attempted && nowMs - lastAttemptMs < RETRY_MS) return false;
+
+  // Payload plus NUL, next to the topic in one packet
+  char message[PACKET_SIZE - PUBLISH_OVERHEAD + 1];
+  size_t length = format(message, sizeof(message) - strlen(topic));
+  if (length == 0) {
+    Serial.printf("Telemetry: window does not fit next to topic '%s', dropped\n", topic);
+    clearWindow();
+    return false;
+  }
+  attempted = true;
+  lastAttemptMs = nowMs;
+  if (!mqtt.publish(topic, message)) {
+    Serial.println("Telemetry: publish failed, keeping the window");
+    return false;
+  }
+  Serial.printf("Telemetry: published %u bytes covering %lu s\n", (unsigned)length,
+                (unsigned long)(window.elapsedMs / 1000));
+  published++;
+  attempted = false;
+  clearWindow();
+  return true;
+}
+
+size_t Telemetry::format(char* out, size_t size) {
+  size_t length = formatWindow(out, size, true);
+  return length ? length : formatWindow(out, size, false);
+}
+
+void Telemetry::printStatus() {
+  char message[PACKET_SIZE - PUBLISH_OVERHEAD + 1];
+  Serial.printf("Telemetry: every %lu s to '%s', %lu published; window %lu s\n",
+                (unsigned long)(intervalMs / 1000), topic, (unsigned long)published,
+                (unsigned long)(window.elapsedMs / 1000));
+  if (format(message, sizeof(message) - strlen(topic))) Serial.printf("  %s\n", message);
+}
+
+// Private helpers
+
+size_t Telemetry::formatWindow(char* out, size_t size, bool histogram) {
+  size_t used = 0;
+  bool ok = true;
+  append(out, size, used, ok, "{\"s\":%lu", (unsigned long)(window.elapsedMs / 1000));
+  const Aggregate& f = window.frameUs;
+  if (f.count) {
+    append(out, size, used, ok, ",\"f\":[%lu,%ld,%ld]", (unsigned long)f.count, (long)f.avg(), (long)f.max);
+    if (histogram) {
+      for (uint8_t i = 0; i < FRAME_BUCKETS; i++) {
+        append(out, size, used, ok, i ? ",%lu" : ",\"fh\":[%lu", (unsigned long)window.frameHistogram[i]);
+      }
+      append(out, size, used, ok, "]");
+    }
+  }
+  if (window.loopUs.count) append(out, size, used, ok, ",\"l\":[%ld,%ld]", (long)window.loopUs.avg(), (long)window.loopUs.max);
+  if (window.freeHeap.count) append(out, size, used, ok, ",\"h\":[%ld,%ld]", (long)window.freeHeap.min, (long)window.freeHeap.avg());
+  if (window.fragmentation.count) {
+    append(out, size, used, ok, ",\"fg\":[%ld,%ld]", (long)window.fragmentation.max, (long)window.fragmentation.avg());
+  }
+  const Aggregate& r = window.rssi;
+  if (r.count) append(out, size, used, ok, ",\"r\":[%ld,%ld,%ld]", (long)r.min, (long)r.avg(), (long)r.max);
+  if (window.batteryMv.count) append(out, size, used, ok, ",\"b\":[%ld,%ld]", (long)window.batteryMv.min, (long)window.batteryMv.max);
+  const Aggregate& w = window.wake;
+  if (w.count) append(out, size, used, ok, ",\"w\":[%lu,%ld,%ld]", (unsigned long)w.count, (long)w.avg(), (long)w.max);
+  append(out, size, used, ok, ",\"a\":%lu}", (unsigned long)window.alerts);
+  return ok ? used : 0;
+}
+
+// Appends one piece of the message; one that does not fit is not sent at all
+void Telemetry::append(char* out, size_t size, size_t& used, bool& ok, const char* fmt, ...) {
+  if (!ok) return;
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(out + used, size - used, fmt, args);
+  va_end(args);
+  if (n < 0 || (size_t)n >= size - used) {
+    ok = false;
+    return;
+  }
+  used += (size_t)n;
+}
+
+void Telemetry::sample() {
+  uint32_t freeHeap = ESP.getFreeHeap();
+  window.freeHeap.add((int32_t)freeHeap);
+  if (freeHeap > 0) {
+    uint32_t largest = ESP.getMaxAllocHeap();
+    window.fragmentation.add(largest >= freeHeap ? 0 : (int32_t)(100 - largest * 100ULL / freeHeap));
+  }
+  if (WiFi.status() == WL_CONNECTED) window.rssi.add(WiFi.RSSI());
+  float volts = PowerManager::getBatteryVoltage();
+  if (volts > 0.0f) window.batteryMv.add((int32_t)(volts * 1000.0f));
+}
+
+void Telemetry::clearWindow() {
+  memset(&window, 0, sizeof(window));
+}
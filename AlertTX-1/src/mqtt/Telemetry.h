@@ -0,0 +1,108 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+class MQTTClient;
+
+/**
+ * Telemetry
+ *
+ * Device health for the fleet: counters are folded into fixed-size
+ * aggregates as they happen and go out as one compact JSON message on the
+ * status topic every interval.
+ *
+ * Features:
+ * - Frame draw time (count, average, max and a log2 histogram), loop work
+ *   time, free heap, heap fragmentation (largest free block vs free heap),
+ *   Wi-Fi RSSI, battery, background wake active time and alerts received
+ * - Fixed memory: a window is a handful of min/max/sum aggregates, whatever
+ *   its length
+ * - Piggy-backed: only published while MQTT is already connected (normal
+ *   use or a background wake); never starts Wi-Fi or MQTT on its own. While
+ *   offline the window keeps growing and goes out as one message later
+ * - Kept in RTC memory, so the short background wakes between two
+ *   publishes all land in the same window
+ * - Interval from SettingsManager (0 = off); the window length counts both
+ *   awake time and deep sleep
+ * - Sized to the topic: the message shares PubSubClient's 256-byte packet
+ *   buffer with it. The frame histogram is left out when the rest would not
+ *   fit otherwise; a window that still does not fit is dropped, not retried
+ *
+ * Message (values in us, bytes, dBm, mV and ms; keys left out when there
+ * were no samples):
+ *   {"s":300,"f":[n,avg,max],"fh":[<2ms,<4,<8,<16,<32,<64,>=64],"l":[avg,max],
+ *    "h":[min,avg],"fg":[max,avg],"r":[min,avg,max],"b":[min,max],
+ *    "w":[n,avg,max],"a":n}
+ */
+
+class Telemetry {
+public:
+  static const uint8_t FRAME_BUCKETS = 7;                  // 2 ms .. 64 ms, log2
+  static const unsigned long SAMPLE_INTERVAL_MS = 1000;    // Heap, RSSI, battery
+  static const unsigned long RETRY_MS = 30000;             // After a failed publish
+  static const size_t PACKET_SIZE = 256;                   // PubSubClient's buffer
+  static const size_t PUBLISH_OVERHEAD = 5 + 2;            // Fixed header, topic length
+
+  // Once per boot, before the first update(): interval and topic from
+  // SettingsManager
+  static void begin();
+  static void setInterval(uint32_t ms) { intervalMs = ms; }
+  static uint32_t getInterval() { return intervalMs; }
+
+  // Event hooks
+  static void noteFrame(uint32_t drawUs);
+  static void noteLoop(uint32_t workUs);
+  static void noteAlert() { window.alerts++; }
+  static void noteWake(uint32_t activeMs) { window.wake.add((int32_t)activeMs); }
+  static void noteSleep(uint32_t sleepMs) { window.elapsedMs += sleepMs; }
+
+  // Samples the slow counters; publishes the window if it is due and MQTT
+  // is up. Returns true when a message went out
+  static bool update(unsigned long nowMs, MQTTClient& mqtt);
+
+  // The message for the current window (what update() would send), without
+  // the frame histogram if it does not fit in size otherwise; 0 if it still
+  // does not
+  static size_t format(char* out, size_t size);
+  static uint32_t getPublished() { return published; }
+  static void printStatus();
+
+private:
+  struct Aggregate {
+    int32_t min, max;
+    int64_t sum;
+    uint32_t count;
+    void add(int32_t value);
+    int32_t avg() const { return count ? (int32_t)(sum / (int64_t)count) : 0; }
+  };
+
+  struct Window {
+    uint32_t elapsedMs;          // Awake plus asleep
+    Aggregate frameUs;
+    uint32_t frameHistogram[FRAME_BUCKETS];
+    Aggregate loopUs;
+    Aggregate freeHeap;
+    Aggregate fragmentation;     // Percent of free heap not in the largest block
+    Aggregate rssi;
+    Aggregate batteryMv;
+    Aggregate wake;
+    uint32_t alerts;
+  };
+
+  static Window window;
+  static uint32_t published;
+  static uint32_t intervalMs;
+  static char topic[48];
+  static unsigned long lastUpdateMs;
+  static unsigned long lastSampleMs;
+  static unsigned long lastAttemptMs;
+  static bool attempted;
+
+  static void sample();
+  static size_t formatWindow(char* out, size_t size, bool histogram);
+  static void append(char* out, size_t size, size_t& used, bool& ok, const char* fmt, ...);
+  static void clearWindow();
+};
+
+#endif // TELEMETRY_H
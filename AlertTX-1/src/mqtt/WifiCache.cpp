@@ -0,0 +1,93 @@
+#include "WifiCache.h"
+#include "Fnv1a.h"
+
+// RTC slow memory: kept through deep sleep
+RTC_DATA_ATTR WifiCache::Link WifiCache::link = {};
+RTC_DATA_ATTR WifiCache::Broker WifiCache::broker = {};
+RTC_DATA_ATTR WifiCache::Timings WifiCache::timings = {};
+
+bool WifiCache::takeLink(const char* ssid) {
+  if (link.magic != MAGIC || link.ssidHash != hash(ssid)) return false;
+  if (link.reuses >= MAX_REUSES) {
+    Serial.println("WifiCache: link reused too often, renewing the lease with a full connect");
+    clearLink();
+    return false;
+  }
+  link.reuses++;
+  return true;
+}
+
+void WifiCache::saveLink(const char* ssid, bool fast) {
+  const uint8_t* bssid = WiFi.BSSID();
+  uint8_t channel = (uint8_t)WiFi.channel();
+  if (!bssid || channel == 0) return;
+  // Only a full connect (with DHCP) renews the lease
+  uint8_t reuses = fast ? link.reuses : 0;
+  link.magic = MAGIC;
+  link.ssidHash = hash(ssid);
+  memcpy(link.bssid, bssid, sizeof(link.bssid));
+  link.channel = channel;
+  link.reuses = reuses;
+  link.ip = (uint32_t)WiFi.localIP();
+  link.gateway = (uint32_t)WiFi.gatewayIP();
+  link.subnet = (uint32_t)WiFi.subnetMask();
+  link.dns = (uint32_t)WiFi.dnsIP();
+}
+
+void WifiCache::clearLink() {
+  link.magic = 0;
+}
+
+bool WifiCache::getBroker(const char* host, IPAddress& ip) {
+  if (broker.magic != MAGIC || broker.hostHash != hash(host)) return false;
+  ip = IPAddress(broker.ip);
+  return true;
+}
+
+void WifiCache::saveBroker(const char* host, IPAddress ip) {
+  broker.magic = MAGIC;
+  broker.hostHash = hash(host);
+  broker.ip = (uint32_t)ip;
+}
+
+void WifiCache::clearBroker() {
+  broker.magic = 0;
+}
+
+void WifiCache::noteConnect(bool fast, uint32_t wifiMs, uint32_t mqttMs) {
+  if (fast) {
+    timings.fastWifiMs = wifiMs;
+    timings.fastMqttMs = mqttMs;
+    timings.fastConnects++;
+  } else {
+    timings.fullWifiMs = wifiMs;
+    timings.fullMqttMs = mqttMs;
+    timings.fullConnects++;
+  }
+  Serial.printf("WifiCache: %s connect, WiFi %lu ms, MQTT %lu ms\n", fast ? "fast" : "full",
+                (unsigned long)wifiMs, (unsigned long)mqttMs);
+}
+
+void WifiCache::printStatus() {
+  if (link.magic == MAGIC) {
+    Serial.printf("WifiCache: link %02X:%02X:%02X:%02X:%02X:%02X ch %u, IP %s, used %u/%u\n",
+                  link.bssid[0], link.bssid[1], link.bssid[2], link.bssid[3], link.bssid[4], link.bssid[5],
+                  link.channel, getIp().toString().c_str(), link.reuses, MAX_REUSES);
+  } else {
+    Serial.println("WifiCache: no link cached");
+  }
+  if (broker.magic == MAGIC) {
+    Serial.printf("  broker %s\n", IPAddress(broker.ip).toString().c_str());
+  }
+  Serial.printf("  fast: %lu connects, last WiFi %lu ms / MQTT %lu ms\n", (unsigned long)timings.fastConnects,
+                (unsigned long)timings.fastWifiMs, (unsigned long)timings.fastMqttMs);
+  Serial.printf("  full: %lu connects, last WiFi %lu ms / MQTT %lu ms; %lu fallbacks\n",
+                (unsigned long)timings.fullConnects, (unsigned long)timings.fullWifiMs,
+                (unsigned long)timings.fullMqttMs, (unsigned long)timings.fallbacks);
+}
+
+// Private helpers
+
+uint32_t WifiCache::hash(const char* text) {
+  return text ? fnv1a(text, strlen(text)) : FNV1A_OFFSET_BASIS;
+}
@@ -0,0 +1,81 @@
+#ifndef WIFI_CACHE_H
+#define WIFI_CACHE_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+/**
+ * WifiCache
+ *
+ * What the last successful connection learned, kept for the next wake so
+ * MQTTClient can skip the slow parts of getting online: the channel scan,
+ * DHCP and the broker's DNS lookup.
+ *
+ * Features:
+ * - Access point BSSID and channel, for a direct association without a scan
+ * - IP, gateway, subnet and DNS of the last lease, applied as a static
+ *   config (no DHCP round trips)
+ * - Broker address resolved once per host name
+ * - Lives in RTC memory: survives deep sleep, starts empty on power-on.
+ *   Entries are tied to the SSID / broker host they were learned for
+ * - After MAX_REUSES fast connects in a row the link entry expires, so a
+ *   full connect renews the DHCP lease now and then
+ * - Connect timings per path (fast / full) for the serial console
+ */
+
+class WifiCache {
+public:
+  static const uint8_t MAX_REUSES = 24;
+
+  // Cached link for this SSID (counts as one reuse)
+  static bool takeLink(const char* ssid);
+  // From the WiFi state once connected; fast = over the cached link
+  static void saveLink(const char* ssid, bool fast);
+  static void clearLink();
+  static const uint8_t* getBssid() { return link.bssid; }
+  static uint8_t getChannel() { return link.channel; }
+  static IPAddress getIp() { return IPAddress(link.ip); }
+  static IPAddress getGateway() { return IPAddress(link.gateway); }
+  static IPAddress getSubnet() { return IPAddress(link.subnet); }
+  static IPAddress getDns() { return IPAddress(link.dns); }
+
+  static bool getBroker(const char* host, IPAddress& ip);
+  static void saveBroker(const char* host, IPAddress ip);
+  static void clearBroker();
+
+  // Milliseconds from WiFi.begin() to WiFi / MQTT connected
+  static void noteConnect(bool fast, uint32_t wifiMs, uint32_t mqttMs);
+  static void noteFallback() { timings.fallbacks++; }
+  static uint32_t getLastWifiMs(bool fast) { return fast ? timings.fastWifiMs : timings.fullWifiMs; }
+  static uint32_t getLastMqttMs(bool fast) { return fast ? timings.fastMqttMs : timings.fullMqttMs; }
+  static void printStatus();
+
+private:
+  struct Link {
+    uint32_t magic;
+    uint32_t ssidHash;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reuses;
+    uint32_t ip, gateway, subnet, dns;
+  };
+  struct Broker {
+    uint32_t magic;
+    uint32_t hostHash;
+    uint32_t ip;
+  };
+  struct Timings {
+    uint32_t fastWifiMs, fastMqttMs, fullWifiMs, fullMqttMs;
+    uint32_t fastConnects, fullConnects, fallbacks;
+  };
+
+  static const uint32_t MAGIC = 0x57F1CAC4UL;
+
+  static Link link;
+  static Broker broker;
+  static Timings timings;
+
+  static uint32_t hash(const char* text);
+};
+
+#endif // WIFI_CACHE_H
@@ -1,7 +1,8 @@
 #include "PowerManager.h"
-#include <WiFi.h>
 #include "../config/SettingsManager.h"
 #include "../config/settings.h"
+#include "../storage/AlertLog.h"
+#include "../mqtt/Telemetry.h"
 
 // Some cores use TFT_BACKLIGHT, others expose TFT_BACKLITE. Prefer TFT_BACKLIGHT if defined.
 #if defined(TFT_BACKLIGHT)
@@ -26,12 +27,19 @@ volatile bool PowerManager::backlightEnabled = true;
 float PowerManager::batteryVoltage = 0.0f;
 int PowerManager::batteryPercent = 0;
 float PowerManager::voltageEMA = 0.0f;
+unsigned long PowerManager::lastUpdateMs = 0;
 
 bool PowerManager::usbPowered = false;
 
 
 bool PowerManager::s_lastWakeWasFromSleep = false;
 bool PowerManager::s_hasNewMessagesOnWake = false;
+unsigned long PowerManager::s_wakeStartMs = 0;
+PowerManager::BackgroundWakeHandler PowerManager::s_backgroundWakeHandler = nullptr;
+uint32_t PowerManager::s_sleepTimerMs = 0;
+
+// RTC slow memory: kept through deep sleep
+RTC_DATA_ATTR PowerManager::WakeStats PowerManager::wakeStats = {};
 
 void PowerManager::begin() {
     pinMode(ALERTTX_BACKLIGHT_PIN, OUTPUT);
@@ -45,7 +53,12 @@ void PowerManager::begin() {
     currentState = ACTIVE;
 }
 
+void PowerManager::setBackgroundWakeHandler(BackgroundWakeHandler handler) {
+    s_backgroundWakeHandler = handler;
+}
+
 bool PowerManager::onWake() {
+    s_wakeStartMs = millis();
     esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
 
     switch (wakeup_reason) {
@@ -74,6 +87,8 @@ bool PowerManager::onWake() {
 }
 
 void PowerManager::update(unsigned long nowMs) {
+    if (lastUpdateMs != 0 && nowMs - lastUpdateMs < UPDATE_INTERVAL_MS) return;
+    lastUpdateMs = nowMs;
     updateBattery();
     updateChargingStatus();
 
@@ -149,6 +164,17 @@ bool PowerManager::isUsbPowered() { return usbPowered; }
 PowerManager::PowerState PowerManager::getCurrentState() { return currentState; }
 bool PowerManager::lastWakeWasFromSleep() { return s_lastWakeWasFromSleep; }
 bool PowerManager::hasNewMessagesOnWake() { return s_hasNewMessagesOnWake; }
+uint32_t PowerManager::getLastWakeActiveMs() { return wakeStats.lastActiveMs; }
+
+void PowerManager::printWakeStats() {
+    Serial.printf("PowerManager: %lu background wakes, %lu with alerts\n",
+                  (unsigned long)wakeStats.backgroundWakes, (unsigned long)wakeStats.alertWakes);
+    if (wakeStats.backgroundWakes > 0) {
+        Serial.printf("  active ms: last %lu, max %lu, average %lu\n", (unsigned long)wakeStats.lastActiveMs,
+                      (unsigned long)wakeStats.maxActiveMs,
+                      (unsigned long)(wakeStats.totalActiveMs / wakeStats.backgroundWakes));
+    }
+}
 
 void PowerManager::setBacklight(bool enabled) {
     digitalWrite(ALERTTX_BACKLIGHT_PIN, enabled ? HIGH : LOW);
@@ -163,14 +189,19 @@ void PowerManager::configureSleepWakeSources(bool enableTimerWake) {
     uint64_t ext1_mask = (1ULL << GPIO_NUM_1) | (1ULL << GPIO_NUM_2);
     esp_sleep_enable_ext1_wakeup(ext1_mask, ESP_EXT1_WAKEUP_ANY_HIGH);
 
+    s_sleepTimerMs = enableTimerWake ? SettingsManager::getDeepSleepIntervalMs() : 0;
     if (enableTimerWake) {
-        esp_sleep_enable_timer_wakeup((uint64_t)SettingsManager::getDeepSleepIntervalMs() * 1000ULL);
+        esp_sleep_enable_timer_wakeup((uint64_t)s_sleepTimerMs * 1000ULL);
     }
 }
 
 void PowerManager::enterDeepSleep() {
     // Ensure backlight off before sleeping
     setBacklight(false);
+    // RAM is lost in deep sleep: write out alerts still waiting in the log buffer
+    AlertLog::flush();
+    // The telemetry window spans the sleep too
+    Telemetry::noteSleep(s_sleepTimerMs);
     Serial.println("PowerManager: Entering deep sleep...");
     delay(50);
     esp_deep_sleep_start();
@@ -248,16 +279,22 @@ void PowerManager::updateChargingStatus() {
 }
 
 void PowerManager::handlePeriodicWakeBackground() {
-    // Keep screen OFF; do minimal work
-    // Attempt brief WiFi connect if not already connected
-    if (WiFi.status() != WL_CONNECTED) {
-        // Credentials expected via generated_secrets / SettingsManager; skip for now
-        // Keep a tight timeout to save power (placeholder)
-        // In current phase, we do not attempt connection.
+    // Screen stays off; the handler gets online, drains pending alerts into
+    // the log and says whether there is anything to show
+    bool hasNewMessages = false;
+    if (s_backgroundWakeHandler) {
+        hasNewMessages = s_backgroundWakeHandler(BACKGROUND_WAKE_BUDGET_MS);
     }
 
-    // Placeholder: no MQTT check yet
-    bool hasNewMessages = false;
+    uint32_t activeMs = millis() - s_wakeStartMs;
+    wakeStats.backgroundWakes++;
+    wakeStats.lastActiveMs = activeMs;
+    wakeStats.totalActiveMs += activeMs;
+    if (activeMs > wakeStats.maxActiveMs) wakeStats.maxActiveMs = activeMs;
+    if (hasNewMessages) wakeStats.alertWakes++;
+    Telemetry::noteWake(activeMs);
+    Serial.printf("PowerManager: background wake active %lu ms, %s\n", (unsigned long)activeMs,
+                  hasNewMessages ? "new alerts, screen on" : "nothing new, back to sleep");
 
     if (hasNewMessages) {
         setBacklight(true);
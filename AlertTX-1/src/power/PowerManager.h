@@ -12,8 +12,14 @@ public:
         DEEP_SLEEP_CYCLE
     };
 
+    // Timer wake work, run before any display / UI init: gets the time
+    // budget, returns true if the user should see something (screen on and
+    // the normal boot continues) or false to go straight back to sleep
+    typedef bool (*BackgroundWakeHandler)(unsigned long budgetMs);
+
     // Lifecycle
     static void begin();
+    static void setBackgroundWakeHandler(BackgroundWakeHandler handler);
     // Returns true if we should skip splash (wake from deep sleep or user button wake)
     static bool onWake();
     static void update(unsigned long nowMs);
@@ -39,6 +45,10 @@ public:
     static bool lastWakeWasFromSleep();
     static bool hasNewMessagesOnWake();
 
+    // Background wake cost: ms from onWake() to the sleep / screen-on decision
+    static uint32_t getLastWakeActiveMs();
+    static void printWakeStats();
+
 private:
     // State
     static volatile PowerState currentState;
@@ -50,6 +60,8 @@ private:
     static int batteryPercent;
     static float voltageEMA;
     static constexpr float EMA_ALPHA = 0.2f;
+    static const unsigned long UPDATE_INTERVAL_MS = 1000;   // I2C reads and NVS lookups, not every loop pass
+    static unsigned long lastUpdateMs;
 
     // USB power
     static bool usbPowered;
@@ -58,6 +70,19 @@ private:
     // Wake flags
     static bool s_lastWakeWasFromSleep;
     static bool s_hasNewMessagesOnWake;
+    static unsigned long s_wakeStartMs;
+    static BackgroundWakeHandler s_backgroundWakeHandler;
+    static uint32_t s_sleepTimerMs;     // Armed timer wake, 0 = buttons only
+
+    // Timer wake counters, kept in RTC memory across deep sleep
+    struct WakeStats {
+        uint32_t backgroundWakes;
+        uint32_t alertWakes;        // Background wakes that turned the screen on
+        uint32_t lastActiveMs;
+        uint32_t maxActiveMs;
+        uint32_t totalActiveMs;
+    };
+    static WakeStats wakeStats;
 
     // Internals
     static void initMAX17048();
@@ -4,16 +4,34 @@
 
 // RingtonePlayer implementation
 
-RingtonePlayer::RingtonePlayer() {
+// Event pitch 1..60 = C3..B7
+static const uint16_t NOTE_FREQUENCIES[60] PROGMEM = {
+    131, 139, 147, 156, 165, 175, 185, 196, 208, 220, 233, 247,
+    262, 277, 294, 311, 330, 349, 370, 392, 415, 440, 466, 494,
+    523, 554, 587, 622, 659, 698, 740, 784, 831, 880, 932, 988,
+    1047, 1109, 1175, 1245, 1319, 1397, 1480, 1568, 1661, 1760, 1865, 1976,
+    2093, 2217, 2349, 2489, 2637, 2794, 2960, 3136, 3322, 3520, 3729, 3951,
+};
+
+RingtonePlayer::RingtonePlayer(ToneSequencer::Channel channel) {
     isPlayingFlag = false;
-    playbackStartTime = 0;
-    currentMelody = nullptr;
+    pausedFlag = false;
+    current = nullptr;
+    eventIndex = 0;
+    nextEventTicks = 0;
+    pausedAtUs = 0;
+    startUs = 0;
+    feedIndex = 0;
+    feedTicks = 0;
+    this->channel = channel;
+    held = false;
     volume = 100;
     muted = false;
     buzzerPin = BUZZER_PIN;
     noteInfoValid = false;
     
     // Initialize note info
+    currentNoteInfo.index = 0;
     currentNoteInfo.frequency = 0;
     currentNoteInfo.startTime = 0;
     currentNoteInfo.duration = 0;
@@ -26,20 +44,21 @@ RingtonePlayer::RingtonePlayer() {
 
 void RingtonePlayer::begin(int buzzerPin) {
     this->buzzerPin = buzzerPin;
-    pinMode(buzzerPin, OUTPUT);
+    ToneSequencer::begin(buzzerPin);
     
-    Serial.println("RingtonePlayer initialized with AnyRtttl");
+    Serial.println("RingtonePlayer initialized");
 }
 
 void RingtonePlayer::setVolume(uint8_t vol) {
+    bool wasSilent = (volume == 0);
     volume = constrain(vol, 0, 100);
+    if ((volume == 0) != wasSilent) restartOutput();
 }
 
 void RingtonePlayer::setMuted(bool mute) {
+    if (mute == muted) return;
     muted = mute;
-    if (muted && isPlaying()) {
-        stopTone();
-    }
+    restartOutput();
 }
 
 void RingtonePlayer::attachLed(LED* led) {
@@ -50,54 +69,53 @@ void RingtonePlayer::setLedSyncEnabled(bool enabled) {
     ledSyncEnabled = enabled;
 }
 
-void RingtonePlayer::playRingtone(const char* rtttl) {
-    if (!rtttl) return;
-    
-    currentMelody = rtttl;
-    isPlayingFlag = true;
-    playbackStartTime = millis();
-    noteInfoValid = false;
-    
-    // Start AnyRtttl playback using non-blocking API
-    anyrtttl::nonblocking::begin(buzzerPin, rtttl);
-    
-    Serial.printf("Playing ringtone: %s\n", rtttl);
-}
-
 void RingtonePlayer::playRingtoneByName(const char* name) {
     if (!name) return;
-    const char* text = getTextRTTTL(name);
-    if (!text) {
+    int index = ::findRingtoneIndex(name);
+    if (index < 0) {
         Serial.printf("Ringtone not found: %s\n", name);
         return;
     }
-    playRingtone(text);
+    playRingtoneByIndex(index);
 }
 
 void RingtonePlayer::playRingtoneByIndex(int index) {
-    const char* text = getTextRTTTL(index);
-    if (!text) {
+    const RingtoneEntry* entry = getRingtoneEntry(index);
+    if (!entry || !entry->events || entry->event_count == 0) {
         Serial.printf("Ringtone index not found: %d\n", index);
         return;
     }
-    playRingtone(text);
-}
-
-
-
-void RingtonePlayer::playRingtoneFromMemory(const char* rtttl) {
-    // Same as playRingtone for now - AnyRtttl handles memory management
-    playRingtone(rtttl);
+    
+    current = entry;
+    eventIndex = 0;
+    nextEventTicks = 0;
+    isPlayingFlag = true;
+    pausedFlag = false;
+    startUs = esp_timer_get_time();
+    feedIndex = 0;
+    feedTicks = 0;
+    noteInfoValid = false;
+    held = false;
+    
+    Serial.printf("Playing ringtone: %s (%u notes, %lu ms) on %s\n", entry->name,
+                  (unsigned)entry->event_count, (unsigned long)entry->length_ms,
+                  ToneSequencer::channelName(channel));
+    if (!ToneSequencer::open(channel, this)) {
+        // A higher channel is playing: start from the top once it is done
+        pausedAtUs = 0;
+        held = true;
+        return;
+    }
+    update();  // Queue the first notes
 }
 
 void RingtonePlayer::stop() {
     isPlayingFlag = false;
-    currentMelody = nullptr;
+    pausedFlag = false;
+    held = false;
+    current = nullptr;
     noteInfoValid = false;
-    stopTone();
-    
-    // Stop AnyRtttl playback
-    anyrtttl::nonblocking::stop();
+    ToneSequencer::close(this);
     
     // Ensure LED off
     if (syncedLed && ledSyncEnabled) {
@@ -109,45 +127,58 @@ void RingtonePlayer::stop() {
 
 void RingtonePlayer::pause() {
     if (isPlayingFlag) {
+        pausedAtUs = getPlaybackTimeUs();
         isPlayingFlag = false;
-        stopTone();
-        
-        // Pause AnyRtttl playback (stop and remember state)
-        anyrtttl::nonblocking::stop();
+        pausedFlag = true;
+        if (ToneSequencer::isOwner(this)) ToneSequencer::flush();
     }
 }
 
 void RingtonePlayer::resume() {
-    if (currentMelody && !isPlayingFlag) {
+    if (current && pausedFlag) {
         isPlayingFlag = true;
-        playbackStartTime = millis() - getPlaybackTime();
-        
-        // Resume AnyRtttl playback by restarting
-        anyrtttl::nonblocking::begin(buzzerPin, currentMelody);
+        pausedFlag = false;
+        if (held) return;   // Carries on when the buzzer comes back
+        startUs = esp_timer_get_time() - pausedAtUs;
+        restartOutput();
     }
 }
 
 bool RingtonePlayer::isPlaying() const {
-    return isPlayingFlag && anyrtttl::nonblocking::isPlaying();
+    return isPlayingFlag;
 }
 
 bool RingtonePlayer::isPaused() const {
-    return currentMelody != nullptr && !isPlayingFlag;
+    return current != nullptr && pausedFlag;
 }
 
 unsigned long RingtonePlayer::getPlaybackTime() const {
+    return (unsigned long)(getPlaybackTimeUs() / 1000);
+}
+
+int64_t RingtonePlayer::getPlaybackTimeUs() const {
+    if (pausedFlag || held) return pausedAtUs;
     if (!isPlayingFlag) return 0;
-    return millis() - playbackStartTime;
+    return esp_timer_get_time() - startUs;
+}
+
+unsigned long RingtonePlayer::getLength() const {
+    return current ? current->length_ms : 0;
+}
+
+unsigned long RingtonePlayer::getTimeToNextNote() const {
+    if (!isPlayingFlag || held) return 0;
+    // Rounded up: waking at the deadline's ms would be up to 1 ms early
+    int64_t t = getPlaybackTimeUs();
+    int64_t next = ticksToUs(nextEventTicks);
+    return next > t ? (unsigned long)((next - t + 999) / 1000) : 0;
 }
 
 float RingtonePlayer::getProgress() const {
-    // AnyRtttl doesn't provide progress directly, so we'll estimate
-    if (anyrtttl::nonblocking::isPlaying()) {
-        // Estimate progress based on time elapsed
-        // This is a rough approximation
-        return 0.5f; // Placeholder - would need to parse RTTTL for actual duration
-    }
-    return 0.0f;
+    if (!current || current->length_ms == 0) return 0.0f;
+    unsigned long t = getPlaybackTime();
+    if (t >= current->length_ms) return 1.0f;
+    return (float)t / (float)current->length_ms;
 }
 
 NoteInfo RingtonePlayer::getCurrentNote() const {
@@ -170,62 +201,103 @@ unsigned long RingtonePlayer::getNoteDuration() const {
     return currentNoteInfo.duration;
 }
 
+uint16_t RingtonePlayer::getNoteIndex() const {
+    return currentNoteInfo.index;
+}
+
+NoteCursor RingtonePlayer::getLookahead() const {
+    NoteCursor cursor;
+    cursor.index = current ? eventIndex : 0;
+    cursor.ticks = current ? nextEventTicks : 0;
+    cursor.startTime = current ? (unsigned long)(ticksToUs(cursor.ticks) / 1000) : 0;
+    return cursor;
+}
+
+bool RingtonePlayer::readNote(NoteCursor& cursor, NoteInfo& out) const {
+    if (!current || cursor.index >= current->event_count) return false;
+    decodeEvent(cursor.index, cursor.ticks, out);
+    cursor.ticks += eventTicks(cursor.index);
+    cursor.index++;
+    cursor.startTime = (unsigned long)(ticksToUs(cursor.ticks) / 1000);
+    return true;
+}
+
 void RingtonePlayer::update() {
-    if (!isPlayingFlag) return;
-    
-    // Update AnyRtttl player
-    anyrtttl::nonblocking::play();
+    if (!isPlayingFlag || held) return;
+    feed();
     
-    // Update note info for BeeperHero game
-    updateNoteInfo();
+    int64_t t = getPlaybackTimeUs();
+    if (t < ticksToUs(nextEventTicks)) return;
     
-    // Check if playback finished
-    if (anyrtttl::nonblocking::done()) {
-        stop();
+    // The sequencer already started the note due now; the note info catches
+    // up, past any notes that ended while the loop was away. The song ends
+    // once its last note has, to the µs, so its final silence is already out
+    while (eventIndex < current->event_count) {
+        uint8_t ticks = eventTicks(eventIndex);
+        if (ticksToUs(nextEventTicks + ticks) > t) break;
+        nextEventTicks += ticks;
+        eventIndex++;
     }
-}
-
-void RingtonePlayer::updateNoteInfo() {
-    if (!isPlayingFlag || !anyrtttl::nonblocking::isPlaying()) {
-        noteInfoValid = false;
+    if (eventIndex >= current->event_count) {
+        stop();  // Song finished
         return;
     }
+    startEvent();
+}
+
+uint8_t RingtonePlayer::eventTicks(uint16_t index) const {
+    return pgm_read_byte(&current->events[index * 2 + 1]);
+}
+
+// Song time of a point `ticks` into the song: one multiply from the start,
+// so rounding never adds up from note to note
+int64_t RingtonePlayer::ticksToUs(uint32_t ticks) const {
+    return (int64_t)ticks * current->whole_note_us / RINGTONE_TICKS_PER_WHOLE;
+}
+
+void RingtonePlayer::decodeEvent(uint16_t index, uint32_t startTicks, NoteInfo& out) const {
+    uint8_t pitch = pgm_read_byte(&current->events[index * 2]);
+    uint8_t ticks = pgm_read_byte(&current->events[index * 2 + 1]);
     
-    unsigned long currentTime = getPlaybackTime();
-    
-    // Simulate note changes every 200ms
-    unsigned long noteTime = (currentTime / 200) * 200;
-    
-    if (noteTime != currentNoteInfo.startTime) {
-        // New note started
-        currentNoteInfo.startTime = noteTime;
-        currentNoteInfo.duration = 200; // 200ms notes
-        currentNoteInfo.frequency = 440 + (noteTime / 200) % 880; // A4 to A5
-        currentNoteInfo.octave = 5;
-        currentNoteInfo.durationIndex = 4; // Quarter notes
-        currentNoteInfo.isRest = false;
-        currentNoteInfo.isDotted = false;
-        currentNoteInfo.isSharp = false;
-        noteInfoValid = true;
-        onNewNote();
+    out.index = index;
+    out.startTime = (unsigned long)(ticksToUs(startTicks) / 1000);
+    out.duration = (unsigned long)(ticksToUs(startTicks + ticks) / 1000) - out.startTime;
+    out.isRest = (pitch == 0);
+    // Dotted lengths are 1.5x a power of two
+    out.isDotted = (ticks & (ticks - 1)) != 0;
+    uint8_t plainTicks = out.isDotted ? ticks * 2 / 3 : ticks;
+    out.durationIndex = plainTicks ? RINGTONE_TICKS_PER_WHOLE / plainTicks : 0;
+    if (pitch) {
+        uint8_t semitone = (pitch - 1) % 12;   // 0 = C
+        out.frequency = pgm_read_word(&NOTE_FREQUENCIES[pitch - 1]);
+        out.octave = 3 + (pitch - 1) / 12;
+        out.isSharp = (semitone == 1 || semitone == 3 || semitone == 6 || semitone == 8 || semitone == 10);
+    } else {
+        out.frequency = 0;
+        out.octave = 0;
+        out.isSharp = false;
     }
 }
 
-void RingtonePlayer::calculateNoteInfo() {
-    // Calculate note info from AnyRtttl data
-    updateNoteInfo();
+void RingtonePlayer::startEvent() {
+    decodeEvent(eventIndex, nextEventTicks, currentNoteInfo);
+    noteInfoValid = true;
+    if (!currentNoteInfo.isRest) onNewNote();
+    
+    nextEventTicks += eventTicks(eventIndex);
+    eventIndex++;
 }
 
 void RingtonePlayer::onNewNote() {
     if (!ledSyncEnabled || !syncedLed) return;
-    // Blink briefly per note; half of simulated note duration
+    // Blink briefly per note; half its duration
     unsigned long blinkMs = currentNoteInfo.duration > 0 ? (currentNoteInfo.duration / 2) : 100;
     syncedLed->blink(blinkMs);
 }
 
 void RingtonePlayer::setBuzzerPin(int pin) {
     buzzerPin = pin;
-    pinMode(buzzerPin, OUTPUT);
+    ToneSequencer::begin(buzzerPin);
 }
 
 int RingtonePlayer::getBuzzerPin() const {
@@ -245,19 +317,53 @@ int RingtonePlayer::findRingtoneIndex(const char* name) const {
     return ::findRingtoneIndex(name);
 }
 
-void RingtonePlayer::playTone(uint16_t frequency, unsigned long duration) {
-    if (muted || volume == 0) return;
-    
-    // Use AnyRtttl tone generation
-    if (frequency > 0) {
-        // AnyRtttl handles tone generation internally
-        // This method is mainly for compatibility
+// Queue the events after the last one queued while the sequencer has room;
+// after the last event, silence at the song's end
+void RingtonePlayer::feed() {
+    if (!current || !ToneSequencer::isOwner(this)) return;
+    while (feedIndex <= current->event_count && ToneSequencer::space() > 0) {
+        uint16_t frequency = 0;
+        uint8_t ticks = 0;
+        if (feedIndex < current->event_count) {
+            uint8_t pitch = pgm_read_byte(&current->events[feedIndex * 2]);
+            if (pitch && !muted && volume > 0) frequency = pgm_read_word(&NOTE_FREQUENCIES[pitch - 1]);
+            ticks = eventTicks(feedIndex);
+        }
+        ToneSequencer::push(startUs + ticksToUs(feedTicks), frequency);
+        feedTicks += ticks;
+        feedIndex++;
     }
 }
 
-void RingtonePlayer::stopTone() {
-    // AnyRtttl handles tone stopping internally
-    noTone(buzzerPin);
+// Requeue from now on (resume, mute): the note under way goes on for the
+// rest of its length, then the notes after it
+void RingtonePlayer::restartOutput() {
+    if (!isPlayingFlag || !ToneSequencer::isOwner(this)) return;
+    ToneSequencer::flush();
+    if (noteInfoValid && !currentNoteInfo.isRest && !muted && volume > 0 &&
+        ticksToUs(nextEventTicks) > getPlaybackTimeUs()) {
+        ToneSequencer::push(esp_timer_get_time(), currentNoteInfo.frequency);
+    }
+    feedIndex = eventIndex;
+    feedTicks = nextEventTicks;
+    feed();
+}
+
+void RingtonePlayer::holdOutput() {
+    if (!current || held) return;
+    pausedAtUs = getPlaybackTimeUs();   // Also right when paused
+    held = true;
+    Serial.printf("Ringtone held at %lu ms: %s\n", (unsigned long)(pausedAtUs / 1000), current ? current->name : "");
+}
+
+void RingtonePlayer::resumeOutput() {
+    if (held) {
+        held = false;
+        startUs = esp_timer_get_time() - pausedAtUs;
+        Serial.printf("Ringtone resumed at %lu ms: %s\n", (unsigned long)(pausedAtUs / 1000), current ? current->name : "");
+    }
+    restartOutput();
 }
 
-RingtonePlayer ringtonePlayer;
+RingtonePlayer ringtonePlayer(ToneSequencer::CHANNEL_ALERT);
+RingtonePlayer previewPlayer(ToneSequencer::CHANNEL_PREVIEW);
@@ -2,14 +2,16 @@
 #define RINGTONE_PLAYER_H
 
 #include <Arduino.h>
-#include <anyrtttl.h>
 #include "ringtone_data.h"  // Auto-generated ringtone data
+#include "ToneSequencer.h"
 
 class LED; // forward decl
 
-// Note information structure for BeeperHero game integration
+// Note information structure for BeeperHero game integration. Times are
+// song time (ms since the song started, pauses excluded)
 struct NoteInfo {
-    uint16_t frequency;     // Note frequency in Hz
+    uint16_t index;         // Event index in the song
+    uint16_t frequency;     // Note frequency in Hz (0 for a rest)
     unsigned long startTime; // When the note starts (milliseconds)
     unsigned long duration;  // Note duration (milliseconds)
     uint8_t octave;         // Note octave
@@ -19,12 +21,51 @@ struct NoteInfo {
     bool isSharp;          // True if note is sharp (#)
 };
 
+// Position in the song for reading notes ahead of playback
+struct NoteCursor {
+    uint16_t index;          // Next event to read
+    unsigned long startTime; // Its song time
+    uint32_t ticks;          // Its start in ticks from the first event
+};
+
+/**
+ * RingtonePlayer
+ *
+ * Plays the note events tools/generate_ringtone_data.py compiles from the
+ * RTTTL files: no text is parsed at runtime.
+ *
+ * Features:
+ * - O(1) per note: one (pitch, ticks) pair read from flash, one table
+ *   lookup and one multiply
+ * - The buzzer is driven by ToneSequencer from a timer: update() only keeps
+ *   its queue filled with upcoming notes, so a busy loop does not stretch
+ *   or delay notes. Each deadline comes from the ticks since the first
+ *   event and the whole note in µs, never from adding up rounded note
+ *   lengths, so timing never drifts
+ * - Exact song length from the generator: real progress and time to the
+ *   next note (the main loop wakes then for LED sync and the refill)
+ * - The note playing now and a lookahead cursor over the next ones, for
+ *   LED sync and games, read from the same events the buzzer plays
+ * - Each instance has its own state and a ToneSequencer channel: the alert
+ *   player (ringtonePlayer), the preview player (previewPlayer) and
+ *   BeeperHero's game player. A player that loses the buzzer to a higher
+ *   channel is held: its song time stops and it picks up from the same
+ *   note, with the rest of that note, when the buzzer comes back
+ */
 class RingtonePlayer {
 private:
     // Current playback state
     bool isPlayingFlag;
-    unsigned long playbackStartTime;
-    const char* currentMelody;
+    bool pausedFlag;
+    const RingtoneEntry* current;       // nullptr when idle
+    uint16_t eventIndex;                // Next event to start
+    uint32_t nextEventTicks;            // Its start, ticks from the first event
+    int64_t pausedAtUs;                 // Song time when paused
+    int64_t startUs;                    // esp_timer_get_time() at song time 0
+    uint16_t feedIndex;                 // Next event to queue on the sequencer
+    uint32_t feedTicks;                 // Its start
+    ToneSequencer::Channel channel;
+    bool held;                          // Preempted: song time stopped at pausedAtUs
     
     // BeeperHero game integration
     NoteInfo currentNoteInfo;
@@ -40,23 +81,24 @@ private:
     bool ledSyncEnabled = false;
 
 public:
-    RingtonePlayer();
+    explicit RingtonePlayer(ToneSequencer::Channel channel = ToneSequencer::CHANNEL_ALERT);
     ~RingtonePlayer() = default;
     
     // Initialization
     void begin(int buzzerPin);
     void setVolume(uint8_t vol); // 0-100
     void setMuted(bool mute);
+    // Takes effect with the next song
+    void setChannel(ToneSequencer::Channel channel) { this->channel = channel; }
+    ToneSequencer::Channel getChannel() const { return channel; }
 
     // LED sync
     void attachLed(LED* led); // optional
     void setLedSyncEnabled(bool enabled);
     
     // Playback control
-    void playRingtone(const char* rtttl);  // Legacy text format support
-    void playRingtoneByName(const char* name);  // Play by ringtone name (binary format)
-    void playRingtoneByIndex(int index);        // Play by index (binary format)
-    void playRingtoneFromMemory(const char* rtttl);  // Play from program memory
+    void playRingtoneByName(const char* name);
+    void playRingtoneByIndex(int index);
     void stop();
     void pause();
     void resume();
@@ -64,12 +106,22 @@ public:
     // Status queries
     bool isPlaying() const;
     bool isPaused() const;
-    unsigned long getPlaybackTime() const;
+    bool isHeld() const { return held; }    // Playing, but a higher channel has the buzzer
+    unsigned long getPlaybackTime() const;  // Song time, ms
+    int64_t getPlaybackTimeUs() const;
+    unsigned long getLength() const;        // Song length in ms
+    unsigned long getTimeToNextNote() const; // ms until the next note starts
     float getProgress() const; // 0.0 to 1.0
     
-    // BeeperHero game integration
+    // BeeperHero game integration: the note the buzzer is playing now (rests
+    // included) and the notes after it, from the same events
     NoteInfo getCurrentNote() const;
     bool hasNoteInfo() const;
+    uint16_t getNoteIndex() const;
+    // Cursor at the next note to start; readNote() fills `out` and steps
+    // the cursor, O(1) each. False at the end of the song
+    NoteCursor getLookahead() const;
+    bool readNote(NoteCursor& cursor, NoteInfo& out) const;
     uint16_t getCurrentFrequency() const;
     unsigned long getNoteStartTime() const;
     unsigned long getNoteDuration() const;
@@ -88,16 +140,25 @@ public:
     
 private:
     // Internal methods
-    void updateNoteInfo();
-    void calculateNoteInfo();
+    void startEvent();
+    uint8_t eventTicks(uint16_t index) const;
+    int64_t ticksToUs(uint32_t ticks) const;
+    void decodeEvent(uint16_t index, uint32_t startTicks, NoteInfo& out) const;
     void onNewNote();
     
-    // Hardware interface
-    void playTone(uint16_t frequency, unsigned long duration);
-    void stopTone();
+    // Sequencer feed
+    void feed();
+    void restartOutput();
+    
+    // Called by ToneSequencer when the buzzer goes to a higher channel and
+    // when it comes back
+    friend class ToneSequencer;
+    void holdOutput();
+    void resumeOutput();
 };
 
-// Global ringtone player instance
+// Global players: alert ringtones, and previews (settings, ringtone list)
 extern RingtonePlayer ringtonePlayer;
+extern RingtonePlayer previewPlayer;
 
 #endif // RINGTONE_PLAYER_H
@@ -0,0 +1,253 @@
+#include "ToneSequencer.h"
+#include "RingtonePlayer.h"
+#include "esp_idf_version.h"
+
+// Arduino-ESP32 2.x (IDF 4.4) addresses LEDC by channel; 3.x by pin. Channel
+// 0 is left to tone()
+#if ESP_IDF_VERSION_MAJOR < 5
+static const uint8_t LEDC_CHANNEL = 2;
+#endif
+static const uint8_t LEDC_RESOLUTION = 10;
+static const int64_t NOT_ARMED = INT64_MAX;
+
+ToneSequencer::Change ToneSequencer::queue[QUEUE_SIZE];
+uint8_t ToneSequencer::head = 0;
+uint8_t ToneSequencer::tail = 0;
+int64_t ToneSequencer::armedAtUs = NOT_ARMED;
+uint32_t ToneSequencer::armSeq = 0;
+portMUX_TYPE ToneSequencer::lock = portMUX_INITIALIZER_UNLOCKED;
+esp_timer_handle_t ToneSequencer::timer = nullptr;
+int ToneSequencer::pin = -1;
+RingtonePlayer* ToneSequencer::players[CHANNEL_COUNT] = {};
+uint8_t ToneSequencer::active = NO_CHANNEL;
+uint32_t ToneSequencer::onsets = 0;
+uint32_t ToneSequencer::skipped = 0;
+uint32_t ToneSequencer::maxLateUs = 0;
+uint64_t ToneSequencer::totalLateUs = 0;
+uint32_t ToneSequencer::preemptions = 0;
+
+static const char* const CHANNEL_NAMES[ToneSequencer::CHANNEL_COUNT] = { "click", "preview", "game", "alert" };
+
+void ToneSequencer::begin(int buzzerPin) {
+    if (!timer) {
+        esp_timer_create_args_t args = {};
+        args.callback = onTimer;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "tones";
+        if (esp_timer_create(&args, &timer) != ESP_OK) {
+            Serial.println("ToneSequencer: timer create failed");
+            timer = nullptr;
+            return;
+        }
+    }
+    if (buzzerPin == pin) return;
+    pin = buzzerPin;
+#if ESP_IDF_VERSION_MAJOR < 5
+    ledcSetup(LEDC_CHANNEL, 1000, LEDC_RESOLUTION);
+    ledcAttachPin(pin, LEDC_CHANNEL);
+#else
+    ledcAttach(pin, 1000, LEDC_RESOLUTION);
+#endif
+    write(0);
+}
+
+bool ToneSequencer::open(Channel channel, RingtonePlayer* player) {
+    if (channel >= CHANNEL_COUNT || !player) return false;
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        if (c != channel && players[c] == player) players[c] = nullptr;
+    }
+    RingtonePlayer* replaced = players[channel];
+    players[channel] = player;
+    if (replaced && replaced != player) {
+        Serial.printf("ToneSequencer: new %s replaces the old one\n", channelName(channel));
+        replaced->stop();   // No longer on any channel: its close() is a no-op
+    }
+    if (isOwner(player)) {
+        flush();            // Next song, same owner
+        return true;
+    }
+    arbitrate(player);
+    return isOwner(player);
+}
+
+void ToneSequencer::close(RingtonePlayer* player) {
+    bool found = false;
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        if (players[c] == player) {
+            players[c] = nullptr;
+            found = true;
+        }
+    }
+    if (found) arbitrate(nullptr);
+}
+
+const char* ToneSequencer::channelName(uint8_t channel) {
+    return channel < CHANNEL_COUNT ? CHANNEL_NAMES[channel] : "none";
+}
+
+bool ToneSequencer::beep(uint16_t frequency, unsigned long durationMs) {
+    if (!timer || active != NO_CHANNEL) return false;
+    int64_t now = esp_timer_get_time();
+    flush();                // Cuts off a beep still sounding
+    push(now, frequency);
+    if (durationMs > 0) push(now + (int64_t)durationMs * 1000, 0);
+    return true;
+}
+
+void ToneSequencer::stopBeep() {
+    if (active == NO_CHANNEL) flush();
+}
+
+bool ToneSequencer::push(int64_t atUs, uint16_t frequency) {
+    if (!timer) return false;
+    portENTER_CRITICAL(&lock);
+    bool full = (uint8_t)((tail + 1) % QUEUE_SIZE) == head;
+    if (!full) pushLocked(atUs, frequency);
+    portEXIT_CRITICAL(&lock);
+    if (!full) arm();
+    return !full;
+}
+
+uint8_t ToneSequencer::space() {
+    if (!timer) return 0;
+    portENTER_CRITICAL(&lock);
+    uint8_t used = (uint8_t)((tail + QUEUE_SIZE - head) % QUEUE_SIZE);
+    portEXIT_CRITICAL(&lock);
+    return QUEUE_SIZE - 1 - used;
+}
+
+void ToneSequencer::flush() {
+    if (!timer) return;
+    portENTER_CRITICAL(&lock);
+    head = tail;
+    pushLocked(esp_timer_get_time(), 0);
+    portEXIT_CRITICAL(&lock);
+    arm();
+}
+
+uint32_t ToneSequencer::getAvgLateUs() {
+    return onsets ? (uint32_t)(totalLateUs / onsets) : 0;
+}
+
+void ToneSequencer::resetStats() {
+    portENTER_CRITICAL(&lock);
+    onsets = 0;
+    skipped = 0;
+    maxLateUs = 0;
+    totalLateUs = 0;
+    portEXIT_CRITICAL(&lock);
+}
+
+void ToneSequencer::printStatus() {
+    Serial.printf("ToneSequencer: %u/%u queued, %lu onsets, late avg %lu us, max %lu us, %lu skipped\n",
+                  (unsigned)(QUEUE_SIZE - 1 - space()), (unsigned)(QUEUE_SIZE - 1), (unsigned long)onsets,
+                  (unsigned long)getAvgLateUs(), (unsigned long)maxLateUs, (unsigned long)skipped);
+    Serial.printf("  buzzer: %s, %lu preemptions, held:", channelName(active), (unsigned long)preemptions);
+    bool any = false;
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        if (players[c] && c != active) {
+            Serial.printf(" %s", channelName(c));
+            any = true;
+        }
+    }
+    Serial.println(any ? "" : " none");
+}
+
+// Timer task: play the latest change that is due, then arm for the next
+void ToneSequencer::onTimer(void* arg) {
+    bool play = false;
+    uint16_t frequency = 0;
+    portENTER_CRITICAL(&lock);
+    armedAtUs = NOT_ARMED;
+    int64_t now = esp_timer_get_time();
+    int64_t lateUs = 0;
+    while (head != tail && queue[head].atUs <= now) {
+        // A change replaced at the same instant (a flush, then the first
+        // note) was never due on its own
+        if (play && now - queue[head].atUs < lateUs) skipped++;
+        play = true;
+        frequency = queue[head].frequency;
+        lateUs = now - queue[head].atUs;
+        head = (head + 1) % QUEUE_SIZE;
+    }
+    if (play) {
+        onsets++;
+        totalLateUs += (uint64_t)lateUs;
+        if ((uint32_t)lateUs > maxLateUs) maxLateUs = (uint32_t)lateUs;
+    }
+    portEXIT_CRITICAL(&lock);
+    if (play) write(frequency);
+    arm();
+}
+
+// Private helpers
+
+// Main loop: hand the buzzer to the highest channel with a player. The one
+// losing it holds its position; the one gaining it requeues from its own
+// (`opener` feeds itself on its next update)
+void ToneSequencer::arbitrate(RingtonePlayer* opener) {
+    uint8_t top = NO_CHANNEL;
+    for (int c = CHANNEL_COUNT - 1; c >= 0 && top == NO_CHANNEL; c--) {
+        if (players[c]) top = (uint8_t)c;
+    }
+    if (top == active) return;
+
+    RingtonePlayer* previous = (active != NO_CHANNEL) ? players[active] : nullptr;
+    if (previous) {
+        preemptions++;
+        Serial.printf("ToneSequencer: %s preempts %s\n", channelName(top), channelName(active));
+    }
+    active = top;
+    flush();
+    if (previous) previous->holdOutput();
+    if (top != NO_CHANNEL && players[top] != opener) players[top]->resumeOutput();
+}
+
+// Point the timer at the head of the queue. The deadline is decided under
+// the lock; esp_timer_stop()/start_once() take the esp_timer lock and may
+// block, so they run after it is released. The main loop and the timer
+// task can both get here: whoever re-armed with a stale deadline (armSeq
+// moved on meanwhile) goes round again, so the last to finish sets it
+void ToneSequencer::arm() {
+    portENTER_CRITICAL(&lock);
+    int64_t atUs = head != tail ? queue[head].atUs : NOT_ARMED;
+    if (atUs == armedAtUs) {
+        portEXIT_CRITICAL(&lock);
+        return;
+    }
+    armedAtUs = atUs;
+    uint32_t seq = ++armSeq;
+    portEXIT_CRITICAL(&lock);
+
+    while (true) {
+        // Stopping a timer that is not running is harmless
+        esp_timer_stop(timer);
+        if (atUs != NOT_ARMED) {
+            int64_t nowUs = esp_timer_get_time();
+            esp_timer_start_once(timer, atUs > nowUs ? (uint64_t)(atUs - nowUs) : 0);
+        }
+        portENTER_CRITICAL(&lock);
+        if (seq == armSeq) {
+            portEXIT_CRITICAL(&lock);
+            return;
+        }
+        atUs = head != tail ? queue[head].atUs : NOT_ARMED;
+        armedAtUs = atUs;
+        seq = ++armSeq;
+        portEXIT_CRITICAL(&lock);
+    }
+}
+
+void ToneSequencer::pushLocked(int64_t atUs, uint16_t frequency) {
+    queue[tail].atUs = atUs;
+    queue[tail].frequency = frequency;
+    tail = (tail + 1) % QUEUE_SIZE;
+}
+
+void ToneSequencer::write(uint16_t frequency) {
+#if ESP_IDF_VERSION_MAJOR < 5
+    ledcWriteTone(LEDC_CHANNEL, frequency);
+#else
+    ledcWriteTone(pin, frequency);
+#endif
+}
@@ -0,0 +1,121 @@
+#ifndef TONE_SEQUENCER_H
+#define TONE_SEQUENCER_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+
+class RingtonePlayer;
+
+/**
+ * ToneSequencer
+ *
+ * Plays tone changes on the buzzer from an esp_timer callback, so a note
+ * starts on time however long the main loop is busy (a slow draw, an I2C
+ * read, an MQTT reconnect). The loop only keeps a small queue of upcoming
+ * changes filled; RingtonePlayer does that from update().
+ *
+ * Features:
+ * - Fixed queue of QUEUE_SIZE (time, frequency) changes, no allocation
+ * - One-shot timer armed for the head of the queue; the callback writes the
+ *   LEDC tone and re-arms for the next change, so there is no polling
+ * - Changes that are overdue when the callback runs (the loop refilled too
+ *   late) collapse into the latest one instead of playing back to back
+ * - Onset jitter: how late each change was written against its schedule,
+ *   average and max, plus changes skipped
+ * - Logical channels with fixed priorities (alert > game > preview > UI
+ *   click): the highest channel with a player has the buzzer. A player
+ *   that loses it is held at its song position and carries on from there
+ *   once the higher channels are done; a new player on a busy channel
+ *   replaces the old one
+ *
+ * The queue and the timer are shared with the timer task under one lock;
+ * the esp_timer calls that re-arm it are made after the lock is released.
+ * Silencing (flush) is queued like any other change so only the timer
+ * callback ever writes the tone. On the host build the timer runs on the
+ * simulated clock and fires exactly at its deadline.
+ */
+class ToneSequencer {
+public:
+    static const uint8_t QUEUE_SIZE = 32;
+
+    // Lowest priority first
+    enum Channel : uint8_t {
+        CHANNEL_CLICK,      // UI feedback beeps, see beep()
+        CHANNEL_PREVIEW,    // Ringtone previews
+        CHANNEL_GAME,       // BeeperHero
+        CHANNEL_ALERT,      // Alert ringtone
+        CHANNEL_COUNT
+    };
+    static const uint8_t NO_CHANNEL = 0xFF;
+
+    // Once per pin: creates the timer and attaches the pin to LEDC, which
+    // makes it an output. A pinMode() on the pin afterwards detaches LEDC
+    // and silences the buzzer, so callers must leave the pin alone
+    static void begin(int pin);
+
+    // `player` starts a song on `channel`, stopping any other player there.
+    // True when it has the buzzer now (queue flushed, the player feeds it);
+    // otherwise it stays held until the higher channels close. Never calls
+    // back into `player`
+    static bool open(Channel channel, RingtonePlayer* player);
+    // `player` is done; the highest held player gets the buzzer back
+    static void close(RingtonePlayer* player);
+    static bool isOwner(const RingtonePlayer* player) {
+        return active != NO_CHANNEL && players[active] == player;
+    }
+    static uint8_t getActiveChannel() { return active; }
+    static const char* channelName(uint8_t channel);
+
+    // A beep on the click channel (0 ms: until stopBeep()); dropped while
+    // any player has the buzzer
+    static bool beep(uint16_t frequency, unsigned long durationMs);
+    static void stopBeep();
+
+    // Main loop only. Change to `frequency` Hz (0 = silence) at atUs on the
+    // esp_timer_get_time() clock; changes must come in time order. False
+    // when the queue is full
+    static bool push(int64_t atUs, uint16_t frequency);
+    static uint8_t space();
+    // Drop everything queued and go silent now
+    static void flush();
+
+    // Statistics
+    static uint32_t getOnsets() { return onsets; }
+    static uint32_t getSkipped() { return skipped; }
+    static uint32_t getMaxLateUs() { return maxLateUs; }
+    static uint32_t getPreemptions() { return preemptions; }
+    static uint32_t getAvgLateUs();
+    static void resetStats();
+    static void printStatus();
+
+private:
+    struct Change {
+        int64_t atUs;
+        uint16_t frequency;
+    };
+
+    static Change queue[QUEUE_SIZE];
+    static uint8_t head;                // Next change to play
+    static uint8_t tail;                // Next free slot
+    static int64_t armedAtUs;           // Deadline the timer is armed for
+    static uint32_t armSeq;             // Bumped by every arm() that re-arms
+    static portMUX_TYPE lock;
+    static esp_timer_handle_t timer;
+    static int pin;
+    static RingtonePlayer* players[CHANNEL_COUNT];
+    static uint8_t active;              // Channel with the buzzer
+
+    static uint32_t onsets;
+    static uint32_t skipped;
+    static uint32_t maxLateUs;
+    static uint64_t totalLateUs;
+    static uint32_t preemptions;
+
+    static void arbitrate(RingtonePlayer* opener);
+    static void onTimer(void* arg);
+    static void arm();
+    static void pushLocked(int64_t atUs, uint16_t frequency);
+    static void write(uint16_t frequency);
+};
+
+#endif // TONE_SEQUENCER_H
@@ -0,0 +1,230 @@
+#include "AlertLog.h"
+#include <stddef.h>
+#include "esp_idf_version.h"
+#include "../mqtt/Fnv1a.h"
+
+// Arduino-ESP32 2.x (IDF 4.4) names for the partition mmap types
+#if ESP_IDF_VERSION_MAJOR < 5
+typedef spi_flash_mmap_handle_t esp_partition_mmap_handle_t;
+#define ESP_PARTITION_MMAP_DATA SPI_FLASH_MMAP_DATA
+#endif
+
+static_assert(sizeof(AlertRecord) == AlertLog::RECORD_SIZE, "AlertRecord must fill one record slot");
+
+const esp_partition_t* AlertLog::partition = nullptr;
+const uint8_t* AlertLog::mapped = nullptr;
+uint32_t AlertLog::capacity = 0;
+uint32_t AlertLog::headSeq = 0;
+uint32_t AlertLog::flushedSeq = 0;
+uint32_t AlertLog::oldestSeq = 0;
+uint32_t AlertLog::newestId = 0;
+uint32_t AlertLog::index[AlertLog::INDEX_SIZE];
+AlertRecord AlertLog::batch[AlertLog::BATCH_RECORDS];
+unsigned long AlertLog::batchStartMs = 0;
+uint32_t AlertLog::flashWrites = 0;
+uint32_t AlertLog::sectorErases = 0;
+uint32_t AlertLog::scanUs = 0;
+
+bool AlertLog::begin() {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "alertlog");
+    if (!partition) {
+        // Default Feather layout: the FAT partition is not used by the firmware
+        partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_FAT, "ffat");
+    }
+    capacity = partition ? (partition->size / SECTOR_SIZE) * RECORDS_PER_SECTOR : 0;
+    if (capacity < 2 * RECORDS_PER_SECTOR) {
+        Serial.println("AlertLog: no alertlog partition, alert history will not persist");
+        partition = nullptr;
+        return false;
+    }
+
+    const void* ptr = nullptr;
+    esp_partition_mmap_handle_t handle;
+    if (esp_partition_mmap(partition, 0, capacity * RECORD_SIZE, ESP_PARTITION_MMAP_DATA, &ptr, &handle) != ESP_OK) {
+        Serial.println("AlertLog: cannot map partition, alert history will not persist");
+        partition = nullptr;
+        return false;
+    }
+    mapped = (const uint8_t*)ptr;
+
+    unsigned long start = micros();
+    scan();
+    rebuildIndex();
+    scanUs = micros() - start;
+
+    Serial.printf("AlertLog: '%s', %lu of %lu records, newest id %lu, boot scan %lu us\n",
+                  partition->label, (unsigned long)getRecordCount(), (unsigned long)capacity,
+                  (unsigned long)newestId, (unsigned long)scanUs);
+    return true;
+}
+
+void AlertLog::append(const AlertRecord& record) {
+    if (!partition) return;
+    if (headSeq == flushedSeq) batchStartMs = millis();
+
+    AlertRecord& r = batch[headSeq - flushedSeq];
+    r = record;
+    r.footerId = r.id;
+    r.seq = headSeq;
+    r.magic = MAGIC;
+    r.crc = checksum(r);
+    indexRecord(r.id, headSeq);
+    headSeq++;
+
+    if (headSeq - flushedSeq == BATCH_RECORDS) flush();
+}
+
+uint32_t AlertLog::appendNew(const char* title, const char* message, const char* timestamp) {
+    AlertRecord record;
+    memset(&record, 0, sizeof(record));
+    record.id = newestId + 1;
+    record.count = 1;
+    record.flags = AlertRecord::FLAG_UNREAD;
+    strncpy(record.title, title ? title : "(No title)", sizeof(record.title) - 1);
+    strncpy(record.message, message ? message : "", sizeof(record.message) - 1);
+    strncpy(record.timestamp, timestamp ? timestamp : "", sizeof(record.timestamp) - 1);
+    append(record);
+    return record.id;
+}
+
+void AlertLog::update(unsigned long nowMs) {
+    if (headSeq != flushedSeq && nowMs - batchStartMs >= FLUSH_DELAY_MS) flush();
+}
+
+void AlertLog::flush() {
+    if (!partition || headSeq == flushedSeq) return;
+
+    // One write per contiguous run: two only when the batch wraps the ring
+    uint32_t first = flushedSeq;
+    while (first < headSeq) {
+        uint32_t slot = first % capacity;
+        uint32_t run = headSeq - first;
+        if (slot + run > capacity) run = capacity - slot;
+        if (!writeRun(first, run)) {
+            Serial.printf("AlertLog: flash write failed, %lu records lost\n", (unsigned long)(headSeq - first));
+            break;
+        }
+        first += run;
+    }
+    flushedSeq = headSeq;
+}
+
+bool AlertLog::readLatest(uint32_t id, AlertRecord& out) {
+    if (id > newestId || newestId - id >= INDEX_SIZE) return false;
+    uint32_t seq = index[newestId - id];
+    return seq != NO_SEQ && read(seq, out);
+}
+
+bool AlertLog::read(uint32_t seq, AlertRecord& out) {
+    if (!partition || seq >= headSeq || seq < oldestSeq) return false;
+    if (seq >= flushedSeq) {
+        out = batch[seq - flushedSeq];
+        return true;
+    }
+    if (esp_partition_read(partition, (seq % capacity) * RECORD_SIZE, &out, sizeof(out)) != ESP_OK) return false;
+    return out.magic == MAGIC && out.seq == seq && out.crc == checksum(out);
+}
+
+void AlertLog::printStatus() {
+    if (!partition) {
+        Serial.println("AlertLog: not persistent (no partition)");
+        return;
+    }
+    Serial.printf("AlertLog: '%s', %lu of %lu records, newest id %lu, %lu buffered\n",
+                  partition->label, (unsigned long)getRecordCount(), (unsigned long)capacity,
+                  (unsigned long)newestId, (unsigned long)(headSeq - flushedSeq));
+    Serial.printf("  %lu flash writes, %lu sector erases, boot scan %lu us\n",
+                  (unsigned long)flashWrites, (unsigned long)sectorErases, (unsigned long)scanUs);
+}
+
+// Private helpers
+
+uint32_t AlertLog::checksum(const AlertRecord& record) {
+    return fnv1a(&record, offsetof(AlertRecord, crc));
+}
+
+const AlertRecord* AlertLog::mappedRecord(uint32_t slot) {
+    return (const AlertRecord*)(mapped + slot * RECORD_SIZE);
+}
+
+bool AlertLog::footerValid(const AlertRecord* record) {
+    return record->magic == MAGIC && record->seq != NO_SEQ &&
+           record->seq % capacity == (uint32_t)(((const uint8_t*)record - mapped) / RECORD_SIZE);
+}
+
+// One pass over every footer: newest and oldest seq, newest id
+void AlertLog::scan() {
+    bool found = false;
+    uint32_t newestSeq = 0;
+    oldestSeq = 0;
+    newestId = 0;
+    for (uint32_t slot = 0; slot < capacity; slot++) {
+        const AlertRecord* r = mappedRecord(slot);
+        if (!footerValid(r)) continue;
+        if (!found || r->seq > newestSeq) newestSeq = r->seq;
+        if (!found || r->seq < oldestSeq) oldestSeq = r->seq;
+        if (r->footerId > newestId) newestId = r->footerId;
+        found = true;
+    }
+    headSeq = found ? newestSeq + 1 : 0;
+
+    // A write cut short leaves the next slot programmed but footerless; it
+    // cannot be written again before an erase, so start at the next sector
+    if (headSeq % RECORDS_PER_SECTOR != 0) {
+        const uint8_t* p = (const uint8_t*)mappedRecord(headSeq % capacity);
+        for (size_t i = 0; i < RECORD_SIZE; i++) {
+            if (p[i] != 0xFF) {
+                headSeq += RECORDS_PER_SECTOR - headSeq % RECORDS_PER_SECTOR;
+                break;
+            }
+        }
+    }
+    flushedSeq = headSeq;
+}
+
+// Walk back from the head until every indexed id has its latest record
+void AlertLog::rebuildIndex() {
+    for (uint8_t i = 0; i < INDEX_SIZE; i++) index[i] = NO_SEQ;
+    uint32_t missing = newestId < INDEX_SIZE ? newestId : INDEX_SIZE;
+    for (uint32_t seq = headSeq; seq > oldestSeq && missing > 0; ) {
+        seq--;
+        const AlertRecord* r = mappedRecord(seq % capacity);
+        if (!footerValid(r) || r->seq != seq) continue;
+        uint32_t age = newestId - r->footerId;
+        if (age < INDEX_SIZE && index[age] == NO_SEQ) {
+            index[age] = seq;
+            missing--;
+        }
+    }
+}
+
+void AlertLog::indexRecord(uint32_t id, uint32_t seq) {
+    if (id > newestId) {
+        uint32_t shift = id - newestId;
+        for (int i = INDEX_SIZE - 1; i >= 0; i--) {
+            index[i] = ((uint32_t)i >= shift) ? index[i - shift] : NO_SEQ;
+        }
+        newestId = id;
+    }
+    uint32_t age = newestId - id;
+    if (age < INDEX_SIZE) index[age] = seq;
+}
+
+// Records firstSeq .. firstSeq + count - 1, contiguous in flash. A sector is
+// erased when the ring enters it, dropping the oldest records it held.
+bool AlertLog::writeRun(uint32_t firstSeq, uint32_t count) {
+    for (uint32_t seq = firstSeq; seq < firstSeq + count; seq++) {
+        if (seq % RECORDS_PER_SECTOR != 0) continue;
+        if (esp_partition_erase_range(partition, (seq % capacity) * RECORD_SIZE, SECTOR_SIZE) != ESP_OK) return false;
+        sectorErases++;
+        if (seq + RECORDS_PER_SECTOR > capacity && oldestSeq < seq + RECORDS_PER_SECTOR - capacity) {
+            oldestSeq = seq + RECORDS_PER_SECTOR - capacity;
+        }
+    }
+    const AlertRecord* records = &batch[firstSeq - flushedSeq];
+    if (esp_partition_write(partition, (firstSeq % capacity) * RECORD_SIZE, records, count * RECORD_SIZE) != ESP_OK) {
+        return false;
+    }
+    flashWrites++;
+    return true;
+}
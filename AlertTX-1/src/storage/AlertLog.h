@@ -0,0 +1,123 @@
+#ifndef ALERT_LOG_H
+#define ALERT_LOG_H
+
+#include <Arduino.h>
+#include "esp_partition.h"
+
+/**
+ * AlertRecord
+ *
+ * One alert row as stored in flash: 256 bytes, 16 per 4 KB sector. The
+ * footer is the last thing programmed, so a record with a valid footer was
+ * written completely (the CRC still catches anything else).
+ */
+struct AlertRecord {
+    static const uint8_t FLAG_UNREAD = 0x01;
+
+    uint32_t id;            // AlertsScreen row id; later snapshots of a row reuse it
+    uint16_t count;         // Occurrences merged into the row
+    uint8_t flags;
+    uint8_t reserved0;
+    char title[64];
+    char message[96];
+    char timestamp[24];
+    uint8_t reserved[48];
+
+    // Footer
+    uint32_t footerId;      // Copy of id, so the boot scan never reads the body
+    uint32_t seq;           // Position in the log; slot = seq % capacity
+    uint32_t magic;
+    uint32_t crc;           // FNV-1a over everything above
+};
+
+/**
+ * AlertLog
+ *
+ * Append-only alert history in a raw flash partition, so alerts survive
+ * deep sleep and reboots. Every change to a row (new alert, merged repeat,
+ * read) appends a snapshot; the newest snapshot of an id wins.
+ *
+ * Features:
+ * - Fixed-size records in a ring over the whole partition (thousands of
+ *   alerts); each sector is erased just before the ring re-enters it, so
+ *   wear is spread evenly and no byte is programmed twice between erases
+ * - Boot: one sequential pass over the memory-mapped record footers finds
+ *   the head, then a short backward walk fills the id index. No record
+ *   bodies are read, so it takes a few milliseconds
+ * - In-RAM index of the latest record for the INDEX_SIZE newest ids;
+ *   reading an alert is one seek straight to its slot
+ * - Writes are batched: appends wait in a RAM buffer and go out as one
+ *   contiguous flash write when it fills or FLUSH_DELAY_MS after the first
+ * - Torn writes (power loss mid-batch) are detected by footer and CRC and
+ *   skipped; the head moves on to the next erased sector
+ * - Without a partition nothing is logged: append() drops the record, read()
+ *   finds nothing and the alert list starts empty after each boot
+ *
+ * Partition: data partition labelled "alertlog" (any subtype); if there is
+ * none, the unused FAT partition of the default Feather layout is used.
+ */
+class AlertLog {
+public:
+    static const size_t RECORD_SIZE = 256;
+    static const size_t SECTOR_SIZE = 4096;
+    static const uint32_t RECORDS_PER_SECTOR = SECTOR_SIZE / RECORD_SIZE;
+    static const uint8_t BATCH_RECORDS = 8;       // Write buffer (2 KB)
+    static const unsigned long FLUSH_DELAY_MS = 2000;
+    static const uint8_t INDEX_SIZE = 32;         // Newest ids with a direct slot
+
+    static bool begin();
+    static bool isPersistent() { return partition != nullptr; }
+
+    // Appends a snapshot of row record.id (seq, footer and CRC are filled in)
+    static void append(const AlertRecord& record);
+    // New unread row after the newest id, for alerts received while no
+    // AlertsScreen exists (background wake); returns its id
+    static uint32_t appendNew(const char* title, const char* message, const char* timestamp);
+    // Writes buffered records once the flush delay has passed
+    static void update(unsigned long nowMs);
+    // Writes everything buffered now (before deep sleep)
+    static void flush();
+
+    // Latest snapshot of row `id`; false if it is not among the indexed ids
+    // or its record is gone
+    static bool readLatest(uint32_t id, AlertRecord& out);
+    // Record at log position `seq`
+    static bool read(uint32_t seq, AlertRecord& out);
+
+    static uint32_t getNewestId() { return newestId; }
+    static uint32_t getRecordCount() { return headSeq - oldestSeq; }
+    static uint32_t getCapacity() { return capacity; }
+    static void printStatus();
+
+private:
+    static const uint32_t MAGIC = 0xA1E47106UL;
+    static const uint32_t NO_SEQ = 0xFFFFFFFFUL;
+
+    static const esp_partition_t* partition;
+    static const uint8_t* mapped;                 // Partition contents, for the boot scan
+    static uint32_t capacity;                     // Records
+
+    static uint32_t headSeq;                      // Next seq to assign
+    static uint32_t flushedSeq;                   // Records below this are in flash
+    static uint32_t oldestSeq;
+    static uint32_t newestId;
+    static uint32_t index[INDEX_SIZE];            // index[newestId - id] = seq of id's latest snapshot
+
+    static AlertRecord batch[BATCH_RECORDS];      // Seqs flushedSeq .. headSeq - 1
+    static unsigned long batchStartMs;
+
+    // Counters for the serial console
+    static uint32_t flashWrites;
+    static uint32_t sectorErases;
+    static uint32_t scanUs;
+
+    static uint32_t checksum(const AlertRecord& record);
+    static const AlertRecord* mappedRecord(uint32_t slot);
+    static bool footerValid(const AlertRecord* record);
+    static void scan();
+    static void rebuildIndex();
+    static void indexRecord(uint32_t id, uint32_t seq);
+    static bool writeRun(uint32_t firstSeq, uint32_t count);
+};
+
+#endif // ALERT_LOG_H
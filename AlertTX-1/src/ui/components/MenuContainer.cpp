@@ -1,4 +1,5 @@
 #include "MenuContainer.h"
+#include "../core/OverdrawAnalyzer.h"
 
 MenuContainer::MenuContainer(Adafruit_ST7789* display, int x, int y)
     : Component(display, "MenuContainer") {
@@ -29,18 +30,40 @@ MenuContainer::~MenuContainer() {
 void MenuContainer::draw() {
     if (!display || !visible) return;
     
+    int startIndex = scrollOffset;
+    int endIndex = std::min(scrollOffset + visibleItemCount, itemCount);
+    
+    // Selection moves only damage the two items involved; repaint just those
+    // and leave the background and other rows on the panel.
+    if (!isFullyDamaged()) {
+        for (int i = startIndex; i < endIndex; i++) {
+            MenuItem* item = menuItems[i];
+            if (item && item->isVisible() && (item->isDirty() || item->isDamaged())) {
+                item->draw();
+                item->clearDirty();
+            }
+        }
+        
+        if (needsScrolling()) {
+            drawScrollIndicators();
+        }
+        return;
+    }
+    
     // Draw background
+    OverdrawAnalyzer::beginSite("menu background");
     drawBackground();
+    OverdrawAnalyzer::endSite();
     
     // Draw visible menu items
-    int startIndex = scrollOffset;
-    int endIndex = std::min(scrollOffset + visibleItemCount, itemCount);
-    
+    OverdrawAnalyzer::beginSite("menu items");
     for (int i = startIndex; i < endIndex; i++) {
         if (menuItems[i] && menuItems[i]->isVisible()) {
             menuItems[i]->draw();
+            menuItems[i]->clearDirty();
         }
     }
+    OverdrawAnalyzer::endSite();
     
     // Draw scroll indicators if needed
     if (needsScrolling()) {
@@ -174,9 +197,8 @@ void MenuContainer::moveUp() {
     int oldIndex = selectedIndex;
     selectedIndex = (selectedIndex - 1 + itemCount) % itemCount;
     
-    updateSelection();
-    scrollToSelected();
-    markDirty();  // Force screen redraw
+    updateSelection();   // Damages the old and new items only
+    scrollToSelected();  // Full repaint if the view scrolled
     
     if (selectionChangedCallback && oldIndex != selectedIndex) {
         selectionChangedCallback(selectedIndex);
@@ -192,9 +214,8 @@ void MenuContainer::moveDown() {
     int oldIndex = selectedIndex;
     selectedIndex = (selectedIndex + 1) % itemCount;
     
-    updateSelection();
-    scrollToSelected();
-    markDirty();  // Force screen redraw
+    updateSelection();   // Damages the old and new items only
+    scrollToSelected();  // Full repaint if the view scrolled
     
     if (selectionChangedCallback && oldIndex != selectedIndex) {
         selectionChangedCallback(selectedIndex);
@@ -419,6 +440,7 @@ void MenuContainer::scrollToSelected() {
     // If scroll offset changed, reposition visible items
     if (oldScrollOffset != scrollOffset) {
         layoutVisibleItems();
+        markDirty();
         Serial.printf("MenuContainer: Scrolled from %d to %d (selected: %d)\n", 
                      oldScrollOffset, scrollOffset, selectedIndex);
     }
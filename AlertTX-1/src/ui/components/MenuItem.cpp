@@ -1,4 +1,5 @@
 #include "MenuItem.h"
+#include "../core/GlyphCache.h"
 
 MenuItem::MenuItem(Adafruit_ST7789* display, const char* label, int id)
     : Component(display, "MenuItem"), label(label), id(id) {
@@ -128,7 +129,7 @@ void MenuItem::drawBackground() {
 void MenuItem::drawSelectionIndicator() {
     // Draw the ">" arrow indicator
     uint16_t textColor = getTextColor();
-    Component::drawText(">", x + TEXT_PADDING, y + (height - 8) / 2, textColor, 1);
+    Component::drawText(">", x + TEXT_PADDING, y + (height - 8) / 2, textColor, getBackgroundColor(), 1);
 }
 
 void MenuItem::drawText() {
@@ -143,7 +144,7 @@ void MenuItem::drawText() {
     }
     
     int textY = y + (height - 8) / 2;  // Center vertically (8px text height)
-    Component::drawText(label, textX, textY, textColor, 1);
+    Component::drawText(label, textX, textY, textColor, getBackgroundColor(), 1);
 }
 
 void MenuItem::drawPressedState() {
@@ -183,9 +184,7 @@ uint16_t MenuItem::getBorderColor() const {
 }
 
 int MenuItem::getTextWidth() const {
-    // Approximate text width calculation
-    // Each character is roughly 6 pixels wide at size 1
-    return strlen(label) * 6;
+    return GlyphCache::getTextWidth(label, 1);
 }
 
 // MenuItemFactory implementation
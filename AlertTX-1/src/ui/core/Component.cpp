@@ -1,5 +1,7 @@
 #include "Component.h"
 #include "../../config/DisplayConfig.h"
+#include "RenderManager.h"
+#include "DisplayUtils.h"
 
 Component::Component(Adafruit_ST7789* display, const char* name)
     : display(display), x(0), y(0), width(0), height(0), componentName(name) {
@@ -10,6 +12,11 @@ Component::Component(Adafruit_ST7789* display, const char* name)
 }
 
 void Component::setBounds(int x, int y, int w, int h) {
+    if (x == this->x && y == this->y && w == this->width && h == this->height) {
+        markDirty();
+        return;
+    }
+    reportDamage();  // Old area is exposed
     this->x = x;
     this->y = y;
     this->width = w;
@@ -24,12 +31,14 @@ void Component::setBounds(int x, int y, int w, int h) {
 }
 
 void Component::setPosition(int x, int y) {
+    reportDamage();
     this->x = x;
     this->y = y;
     markDirty();
 }
 
 void Component::setSize(int w, int h) {
+    reportDamage();
     this->width = w;
     this->height = h;
     markDirty();
@@ -37,11 +46,18 @@ void Component::setSize(int w, int h) {
 
 void Component::setVisible(bool visible) {
     if (this->visible != visible) {
+        reportDamage();  // Area being hidden
         this->visible = visible;
         markDirty();
     }
 }
 
+void Component::markDirty() {
+    needsRedraw = true;
+    reportDamage();
+    FrameScheduler::requestFrame();
+}
+
 bool Component::containsPoint(int px, int py) const {
     return (px >= x && px < x + width && py >= y && py < y + height);
 }
@@ -117,6 +133,28 @@ void Component::drawText(const char* text, int x, int y, uint16_t color, int siz
     }
 }
 
+void Component::drawText(const char* text, int x, int y, uint16_t color, uint16_t bg, int size) {
+    if (display && visible && text) {
+        DisplayUtils::drawText(display, text, x, y, size, color, bg);
+    }
+}
+
+void Component::reportDamage() const {
+    if (visible && width > 0 && height > 0) {
+        GlobalRenderManager::reportDamage(x, y, width, height);
+    }
+}
+
+bool Component::isDamaged() const {
+    RenderManager* renderManager = GlobalRenderManager::getInstance();
+    return !renderManager || renderManager->isDamaged(x, y, width, height);
+}
+
+bool Component::isFullyDamaged() const {
+    RenderManager* renderManager = GlobalRenderManager::getInstance();
+    return !renderManager || renderManager->isFullyDamaged(x, y, width, height);
+}
+
 // Private validation helpers
 bool Component::isOnScreen() const {
     // Check if component is at least partially on screen
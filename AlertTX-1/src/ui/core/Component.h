@@ -5,6 +5,7 @@
 #include <Adafruit_ST7789.h>
 #include <Arduino.h>
 #include "Theme.h"
+#include "FrameScheduler.h"
 
 /**
  * Base Component Class
@@ -13,6 +14,10 @@
  * Provides common functionality for layout management, theme integration,
  * dirty tracking for efficient rendering, and basic component lifecycle.
  * 
+ * Invalidations (markDirty, moves, resizes, visibility changes) report the
+ * affected bounds to the global RenderManager damage tracker so the frame
+ * pass only repaints what changed.
+ * 
  * Memory Efficient Design:
  * - Uses references to avoid copying large objects
  * - Minimal memory footprint per component
@@ -57,8 +62,11 @@ public:
     bool intersects(int rx, int ry, int rw, int rh) const;
     
     // Dirty tracking for efficient rendering
-    void markDirty() { needsRedraw = true; }
+    void markDirty();         // Redraw and report our bounds as damaged
+    void markNeedsRepaint() { needsRedraw = true; FrameScheduler::requestFrame(); }
     bool isDirty() const { return needsRedraw; }
+    bool isDamaged() const;       // Bounds intersect this frame's damage
+    bool isFullyDamaged() const;  // Bounds lie entirely inside one damage rect
     void clearDirty() { needsRedraw = false; }
     
     // Theme access (uses global ThemeManager)
@@ -76,6 +84,10 @@ protected:
     void drawRect(int x, int y, int w, int h, uint16_t color);
     void fillRect(int x, int y, int w, int h, uint16_t color);
     void drawText(const char* text, int x, int y, uint16_t color, int size = 1);
+    void drawText(const char* text, int x, int y, uint16_t color, uint16_t bg, int size);  // Opaque, glyph cache
+    
+    // Damage reporting (current bounds, only while visible)
+    void reportDamage() const;
     
     // Layout validation helpers
     bool isOnScreen() const;
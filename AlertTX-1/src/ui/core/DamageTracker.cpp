@@ -0,0 +1,133 @@
+#include "DamageTracker.h"
+
+DamageTracker::Rect DamageTracker::Rect::unionWith(const Rect& r) const {
+    int16_t nx = (x < r.x) ? x : r.x;
+    int16_t ny = (y < r.y) ? y : r.y;
+    int16_t nr = (right() > r.right()) ? right() : r.right();
+    int16_t nb = (bottom() > r.bottom()) ? bottom() : r.bottom();
+    return Rect{nx, ny, (int16_t)(nr - nx), (int16_t)(nb - ny)};
+}
+
+DamageTracker::DamageTracker(int16_t screenWidth, int16_t screenHeight)
+    : screenWidth(screenWidth), screenHeight(screenHeight) {
+    clear();
+}
+
+void DamageTracker::add(int x, int y, int w, int h) {
+    rectsReported++;
+    if (fullScreen) return;
+
+    Rect r{(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+    if (!clip(r)) return;
+
+    // Fold the new rect into the list until nothing else is worth merging
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < rectCount; i++) {
+            if (rects[i].contains(r)) return;
+            if (r.contains(rects[i]) || shouldMerge(rects[i], r)) {
+                r = r.unionWith(rects[i]);
+                removeAt(i);
+                mergeCount++;
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (r.x == 0 && r.y == 0 && r.w == screenWidth && r.h == screenHeight) {
+        addFullScreen();
+        return;
+    }
+
+    if (rectCount >= MAX_RECTS) {
+        mergeCheapestPair();
+    }
+    rects[rectCount++] = r;
+}
+
+void DamageTracker::addFullScreen() {
+    rects[0] = Rect{0, 0, screenWidth, screenHeight};
+    rectCount = 1;
+    fullScreen = true;
+}
+
+void DamageTracker::clear() {
+    rectCount = 0;
+    fullScreen = false;
+}
+
+bool DamageTracker::intersects(int x, int y, int w, int h) const {
+    Rect r{(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+    if (r.isEmpty()) return false;
+    for (int i = 0; i < rectCount; i++) {
+        if (rects[i].intersects(r)) return true;
+    }
+    return false;
+}
+
+bool DamageTracker::covers(int x, int y, int w, int h) const {
+    Rect r{(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+    if (!clip(r)) return false;
+    for (int i = 0; i < rectCount; i++) {
+        if (rects[i].contains(r)) return true;
+    }
+    return false;
+}
+
+uint32_t DamageTracker::getPixelCount() const {
+    uint32_t total = 0;
+    for (int i = 0; i < rectCount; i++) {
+        total += rects[i].area();
+    }
+    return total;
+}
+
+// Private helpers
+
+bool DamageTracker::shouldMerge(const Rect& a, const Rect& b) {
+    // Separate windows push area(a) + area(b) pixels (overlap twice) plus one
+    // extra window setup; the union pushes its own area once.
+    Rect u = a.unionWith(b);
+    return u.area() <= a.area() + b.area() + RECT_OVERHEAD_PX;
+}
+
+bool DamageTracker::clip(Rect& r) const {
+    int16_t left = (r.x > 0) ? r.x : 0;
+    int16_t top = (r.y > 0) ? r.y : 0;
+    int16_t right = (r.right() < screenWidth) ? r.right() : screenWidth;
+    int16_t bottom = (r.bottom() < screenHeight) ? r.bottom() : screenHeight;
+    if (right <= left || bottom <= top) return false;
+    r = Rect{left, top, (int16_t)(right - left), (int16_t)(bottom - top)};
+    return true;
+}
+
+void DamageTracker::removeAt(int index) {
+    for (int i = index; i < rectCount - 1; i++) {
+        rects[i] = rects[i + 1];
+    }
+    rectCount--;
+}
+
+void DamageTracker::mergeCheapestPair() {
+    int bestA = 0, bestB = 1;
+    uint32_t bestWaste = UINT32_MAX;
+
+    for (int a = 0; a < rectCount; a++) {
+        for (int b = a + 1; b < rectCount; b++) {
+            uint32_t unionArea = rects[a].unionWith(rects[b]).area();
+            uint32_t pairArea = rects[a].area() + rects[b].area();
+            uint32_t waste = (unionArea > pairArea) ? unionArea - pairArea : 0;
+            if (waste < bestWaste) {
+                bestWaste = waste;
+                bestA = a;
+                bestB = b;
+            }
+        }
+    }
+
+    rects[bestA] = rects[bestA].unionWith(rects[bestB]);
+    removeAt(bestB);
+    mergeCount++;
+}
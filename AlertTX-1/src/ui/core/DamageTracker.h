@@ -0,0 +1,88 @@
+#ifndef DAMAGE_TRACKER_H
+#define DAMAGE_TRACKER_H
+
+#include <Arduino.h>
+
+/**
+ * DamageTracker
+ *
+ * Collects the screen areas that changed since the last presented frame and
+ * keeps them as a short list of rectangles that is cheap to push over SPI.
+ *
+ * Features:
+ * - Fixed rect list (no dynamic allocation)
+ * - Rects are clipped to the panel and duplicates/contained rects dropped
+ * - Overlapping and adjacent rects are merged when one larger window costs
+ *   fewer pixel clocks than two separate ones (pixel-cost model below)
+ * - On overflow the cheapest pair is merged instead of falling back to a
+ *   full-screen redraw
+ * - Per-frame statistics (rects reported, merges, damaged pixels)
+ *
+ * Cost model:
+ *   cost(rect) = width * height + RECT_OVERHEAD_PX
+ *   Two rects are merged when cost(union) <= cost(a) + cost(b), i.e. when the
+ *   extra pixels swept up by the union are fewer than the setup cost of a
+ *   second address window (CASET/RASET/RAMWR plus the CS/DC toggles).
+ */
+
+class DamageTracker {
+public:
+    struct Rect {
+        int16_t x, y, w, h;
+
+        int16_t right() const { return x + w; }
+        int16_t bottom() const { return y + h; }
+        uint32_t area() const { return (uint32_t)w * (uint32_t)h; }
+        bool isEmpty() const { return w <= 0 || h <= 0; }
+        bool contains(const Rect& r) const {
+            return r.x >= x && r.y >= y && r.right() <= right() && r.bottom() <= bottom();
+        }
+        bool intersects(const Rect& r) const {
+            return x < r.right() && r.x < right() && y < r.bottom() && r.y < bottom();
+        }
+        Rect unionWith(const Rect& r) const;
+    };
+
+    static const int MAX_RECTS = 16;
+    // One extra address window costs roughly this many pixel writes
+    static const uint32_t RECT_OVERHEAD_PX = 64;
+
+    DamageTracker(int16_t screenWidth, int16_t screenHeight);
+
+    // Reporting
+    void add(int x, int y, int w, int h);
+    void addFullScreen();
+    void clear();
+
+    // Queries
+    bool isEmpty() const { return rectCount == 0; }
+    bool isFullScreen() const { return fullScreen; }
+    int getRectCount() const { return rectCount; }
+    const Rect& getRect(int index) const { return rects[index]; }
+    bool intersects(int x, int y, int w, int h) const;
+    bool covers(int x, int y, int w, int h) const;
+    uint32_t getPixelCount() const;
+
+    // Statistics (since last resetStats)
+    uint32_t getRectsReported() const { return rectsReported; }
+    uint32_t getMergeCount() const { return mergeCount; }
+    void resetStats() { rectsReported = 0; mergeCount = 0; }
+
+private:
+    Rect rects[MAX_RECTS];
+    int rectCount = 0;
+    bool fullScreen = false;
+
+    int16_t screenWidth;
+    int16_t screenHeight;
+
+    uint32_t rectsReported = 0;
+    uint32_t mergeCount = 0;
+
+    static bool shouldMerge(const Rect& a, const Rect& b);
+    bool clip(Rect& r) const;
+    void removeAt(int index);
+    void mergeCheapestPair();
+};
+
+#endif // DAMAGE_TRACKER_H
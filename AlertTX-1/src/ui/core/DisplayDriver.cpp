@@ -0,0 +1,167 @@
+#include "DisplayDriver.h"
+#include "OverdrawAnalyzer.h"
+#include "RenderProfiler.h"
+
+// ST7789 controller: 320 gate lines, of which the panel shows a window
+static const uint16_t CONTROLLER_LINES = 320;
+static const uint8_t CMD_VSCRDEF = 0x33;   // Vertical scroll definition
+static const uint8_t CMD_VSCSAD = 0x37;    // Vertical scroll start address
+
+// Static member initialization
+bool DisplayDriver::clipActive = false;
+int16_t DisplayDriver::clipX0 = 0;
+int16_t DisplayDriver::clipY0 = 0;
+int16_t DisplayDriver::clipX1 = 0;
+int16_t DisplayDriver::clipY1 = 0;
+
+void DisplayDriver::setClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    clipX0 = x;
+    clipY0 = y;
+    clipX1 = x + (w > 0 ? w : 0);
+    clipY1 = y + (h > 0 ? h : 0);
+    clipActive = true;
+}
+
+bool DisplayDriver::clipWindow(int& x0, int& y0, int& x1, int& y1) {
+    if (clipActive) {
+        if (x0 < clipX0) x0 = clipX0;
+        if (y0 < clipY0) y0 = clipY0;
+        if (x1 > clipX1) x1 = clipX1;
+        if (y1 > clipY1) y1 = clipY1;
+    }
+    return x0 < x1 && y0 < y1;
+}
+
+bool DisplayDriver::clipRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) {
+    if (!clipActive) return true;
+    // Adafruit_GFX allows negative sizes (drawn back from x/y)
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    int x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (!clipWindow(x0, y0, x1, y1)) return false;
+    x = x0;
+    y = y0;
+    w = x1 - x0;
+    h = y1 - y0;
+    return true;
+}
+
+// =============================================================================
+// HARDWARE SCROLL
+// =============================================================================
+
+bool DisplayDriver::beginScroll() {
+    // The scroll registers act on controller lines, which only run along
+    // logical x when MADCTL swaps the axes (landscape)
+    if (!canScroll()) return false;
+
+    scrollFirstLine = _xstart;
+    scrollLength = width();
+    setScrollArea(scrollFirstLine, scrollLength, CONTROLLER_LINES - scrollFirstLine - scrollLength);
+    setScrollStart(scrollFirstLine);
+    scrolling = true;
+    return true;
+}
+
+void DisplayDriver::setScrollOffset(int16_t offset) {
+    if (!scrolling) return;
+    int16_t wrapped = offset % scrollLength;
+    if (wrapped < 0) wrapped += scrollLength;
+    setScrollStart(scrollFirstLine + wrapped);
+}
+
+void DisplayDriver::endScroll() {
+    if (!scrolling) return;
+    // Back to the power-on mapping: whole controller, no offset
+    setScrollArea(0, CONTROLLER_LINES, 0);
+    setScrollStart(0);
+    scrolling = false;
+}
+
+void DisplayDriver::setScrollArea(uint16_t top, uint16_t height, uint16_t bottom) {
+    uint8_t data[6] = {
+        (uint8_t)(top >> 8), (uint8_t)top,
+        (uint8_t)(height >> 8), (uint8_t)height,
+        (uint8_t)(bottom >> 8), (uint8_t)bottom
+    };
+    sendCommand(CMD_VSCRDEF, data, 6);
+}
+
+void DisplayDriver::setScrollStart(uint16_t line) {
+    uint8_t data[2] = {(uint8_t)(line >> 8), (uint8_t)line};
+    sendCommand(CMD_VSCSAD, data, 2);
+}
+
+// =============================================================================
+// CLIPPED PRIMITIVES
+// =============================================================================
+
+void DisplayDriver::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    RenderProfiler::countPixelCall();
+    if (insideClip(x, y)) Adafruit_ST7789::drawPixel(x, y, color);
+}
+
+void DisplayDriver::writePixel(int16_t x, int16_t y, uint16_t color) {
+    RenderProfiler::countPixelCall();
+    if (insideClip(x, y)) Adafruit_ST7789::writePixel(x, y, color);
+}
+
+void DisplayDriver::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    RenderProfiler::countFill();
+    if (clipRect(x, y, w, h)) Adafruit_ST7789::writeFillRect(x, y, w, h, color);
+}
+
+void DisplayDriver::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    RenderProfiler::countFill();
+    int16_t h = 1;
+    if (clipRect(x, y, w, h)) Adafruit_ST7789::writeFastHLine(x, y, w, color);
+}
+
+void DisplayDriver::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    RenderProfiler::countFill();
+    int16_t w = 1;
+    if (clipRect(x, y, w, h)) Adafruit_ST7789::writeFastVLine(x, y, h, color);
+}
+
+void DisplayDriver::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    RenderProfiler::countFill();
+    if (clipRect(x, y, w, h)) Adafruit_ST7789::fillRect(x, y, w, h, color);
+}
+
+void DisplayDriver::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    RenderProfiler::countFill();
+    int16_t h = 1;
+    if (clipRect(x, y, w, h)) Adafruit_ST7789::drawFastHLine(x, y, w, color);
+}
+
+void DisplayDriver::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    RenderProfiler::countFill();
+    int16_t w = 1;
+    if (clipRect(x, y, w, h)) Adafruit_ST7789::drawFastVLine(x, y, h, color);
+}
+
+// =============================================================================
+// PROFILED BUS TRAFFIC
+// =============================================================================
+
+void DisplayDriver::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    // Every pixel on the bus goes through a window that it fills exactly
+    RenderProfiler::countWindow((uint32_t)w * h);
+    OverdrawAnalyzer::countWindow(x, y, w, h);
+    Adafruit_ST7789::setAddrWindow(x, y, w, h);
+}
+
+void DisplayDriver::startWrite(void) {
+    if (writeDepth++ == 0) RenderProfiler::countTransaction();
+    Adafruit_ST7789::startWrite();
+}
+
+void DisplayDriver::endWrite(void) {
+    if (writeDepth > 0) writeDepth--;
+    Adafruit_ST7789::endWrite();
+}
+
+size_t DisplayDriver::write(uint8_t c) {
+    if (c != '\n' && c != '\r') RenderProfiler::countText(1);
+    return Adafruit_ST7789::write(c);
+}
@@ -0,0 +1,87 @@
+#ifndef DISPLAY_DRIVER_H
+#define DISPLAY_DRIVER_H
+
+#include <Adafruit_ST7789.h>
+#include <Arduino.h>
+
+/**
+ * DisplayDriver
+ *
+ * The Alert TX-1 panel driver: an Adafruit_ST7789 with a software clip
+ * rect and access to the controller's vertical scroll registers. Everything
+ * else behaves exactly like the stock driver, so screens keep taking an
+ * Adafruit_ST7789*.
+ *
+ * Features:
+ * - Clip rect honoured by every Adafruit_GFX primitive (all of them end in
+ *   the pixel/fill/line calls overridden here) and by the direct-blit
+ *   paths (GlyphCache, DisplayUtils::drawIcon) through clipWindow()
+ * - Hardware scroll (VSCRDEF/VSCSAD): the visible lines form a ring that
+ *   can be rotated without pushing a single pixel
+ * - Scroll offsets are in logical pixels along the panel's long axis
+ *   (x in landscape); positive moves content towards x = 0
+ * - Feeds RenderProfiler: address windows (pixels pushed), transactions,
+ *   fill/pixel calls and printed characters
+ * - Feeds OverdrawAnalyzer: every address window, pixel by pixel
+ *
+ * Used by ScreenManager for slide transitions: the outgoing screen is
+ * scrolled off while the incoming one is drawn strip by strip, clipped to
+ * the columns that just wrapped into view.
+ */
+
+class DisplayDriver : public Adafruit_ST7789 {
+public:
+    DisplayDriver(int8_t cs, int8_t dc, int8_t rst) : Adafruit_ST7789(cs, dc, rst) {}
+
+    // Clip rect (logical coordinates); drawing outside it is dropped
+    static void setClip(int16_t x, int16_t y, int16_t w, int16_t h);
+    static void clearClip() { clipActive = false; }
+    static bool hasClip() { return clipActive; }
+
+    // Intersect [x0, x1) x [y0, y1) with the clip rect. Returns false when
+    // nothing is left. A no-op while no clip is set.
+    static bool clipWindow(int& x0, int& y0, int& x1, int& y1);
+
+    // Hardware scroll. beginScroll() turns the visible lines into the scroll
+    // area. Landscape only: in portrait the controller lines run along y.
+    bool canScroll() const { return getRotation() & 1; }
+    bool beginScroll();
+    void setScrollOffset(int16_t offset);
+    void endScroll();
+    bool isScrolling() const { return scrolling; }
+    int16_t getScrollLength() const { return scrollLength; }
+
+    // Clipped primitives
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void writePixel(int16_t x, int16_t y, uint16_t color) override;
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+
+    // Profiled bus traffic
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override;
+    void startWrite(void) override;
+    void endWrite(void) override;
+    size_t write(uint8_t c) override;
+
+private:
+    static bool clipActive;
+    static int16_t clipX0, clipY0, clipX1, clipY1;
+
+    bool scrolling = false;
+    int16_t scrollFirstLine = 0;   // first controller line of the ring
+    int16_t scrollLength = 0;      // lines in the ring
+    uint8_t writeDepth = 0;        // nested startWrite() calls
+
+    static bool clipRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h);
+    static bool insideClip(int16_t x, int16_t y) {
+        return !clipActive || (x >= clipX0 && x < clipX1 && y >= clipY0 && y < clipY1);
+    }
+    void setScrollArea(uint16_t top, uint16_t height, uint16_t bottom);
+    void setScrollStart(uint16_t line);
+};
+
+#endif // DISPLAY_DRIVER_H
@@ -1,4 +1,5 @@
 #include "DisplayUtils.h"
+#include "DisplayDriver.h"
 
 // =============================================================================
 // TEXT RENDERING UTILITIES
@@ -24,19 +25,31 @@ void DisplayUtils::centerTextWithColor(Adafruit_ST7789* display, const char* tex
 	centerText(display, text, textSize, y);
 }
 
-void DisplayUtils::drawTitle(Adafruit_ST7789* display, const char* title) {
-	display->setTextColor(ThemeManager::getPrimaryText());
-	centerText(display, title, TEXT_SIZE_TITLE, TITLE_Y);
+void DisplayUtils::centerTextWithColor(Adafruit_ST7789* display, const char* text, int textSize, int y, uint16_t color, uint16_t bg) {
+	int x = CENTER_X(GlyphCache::getTextWidth(text, textSize));
+	drawText(display, text, x, y, textSize, color, bg);
 }
 
-int DisplayUtils::getTextWidth(Adafruit_ST7789* display, const char* text, int textSize) {
-	int16_t x1, y1;
-	uint16_t w, h;
+int DisplayUtils::drawText(Adafruit_ST7789* display, const char* text, int x, int y, int textSize, uint16_t color, uint16_t bg) {
+	if (GlyphCache::supportsSize(textSize)) {
+		return GlyphCache::drawText(display, text, x, y, textSize, color, bg);
+	}
 	
+	display->setTextColor(color, bg);
 	display->setTextSize(textSize);
-	display->getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
-	
-	return w;
+	display->setCursor(x, y);
+	display->print(text);
+	return GlyphCache::getTextWidth(text, textSize);
+}
+
+void DisplayUtils::drawTitle(Adafruit_ST7789* display, const char* title) {
+	// Titles sit on the screen background
+	centerTextWithColor(display, title, TEXT_SIZE_TITLE, TITLE_Y,
+	                    ThemeManager::getPrimaryText(), ThemeManager::getBackground());
+}
+
+int DisplayUtils::getTextWidth(Adafruit_ST7789* display, const char* text, int textSize) {
+	return GlyphCache::getTextWidth(text, textSize);
 }
 
 // =============================================================================
@@ -122,29 +135,106 @@ void DisplayUtils::drawDebugOverlay(Adafruit_ST7789* display) {
 #if __has_include("../../icons/Icon.h")
 #include "../../icons/Icon.h"
 #include <pgmspace.h>
-static inline void drawIconLine(Adafruit_ST7789* display, const uint16_t* data, int x, int y, int w) {
-	display->drawRGBBitmap(x, y, data, w, 1);
+// Row buffer shared by all icon draws (icons are never wider than the panel)
+static uint16_t iconLine[DISPLAY_WIDTH];
+
+// Read position in an indexed icon's PROGMEM stream
+struct IconReader {
+	const uint8_t* src;
+	uint8_t bpp;
+	bool rle;
+	uint16_t runLeft;
+	uint8_t runIndex;
+};
+
+static uint16_t blend565(uint16_t bg, uint16_t fg, uint8_t level, uint8_t maxLevel) {
+	if (level == 0) return bg;
+	if (level >= maxLevel) return fg;
+	int r = (bg >> 11) + (((fg >> 11) - (bg >> 11)) * level) / maxLevel;
+	int g = ((bg >> 5) & 0x3F) + ((((fg >> 5) & 0x3F) - ((bg >> 5) & 0x3F)) * level) / maxLevel;
+	int b = (bg & 0x1F) + (((fg & 0x1F) - (bg & 0x1F)) * level) / maxLevel;
+	return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// Decode one row of indices straight into RGB565 through the color table
+static void readIconRow(IconReader& reader, int w, const uint16_t* colors, uint16_t* out) {
+	const uint8_t mask = (1 << reader.bpp) - 1;
+	if (reader.rle) {
+		for (int i = 0; i < w; i++) {
+			if (reader.runLeft == 0) {
+				uint8_t token = pgm_read_byte(reader.src++);
+				reader.runIndex = token & mask;
+				reader.runLeft = (token >> reader.bpp) + 1;
+			}
+			out[i] = colors[reader.runIndex];
+			reader.runLeft--;
+		}
+		return;
+	}
+
+	const uint8_t perByte = 8 / reader.bpp;
+	uint8_t bits = 0;
+	for (int i = 0; i < w; i++) {
+		uint8_t slot = i % perByte;
+		if (slot == 0) bits = pgm_read_byte(reader.src++);
+		out[i] = colors[(bits >> (8 - reader.bpp * (slot + 1))) & mask];
+	}
 }
 
-static void drawIconInternal(Adafruit_ST7789* display, const Icon& icon, int x, int y) {
+static void drawIconInternal(Adafruit_ST7789* display, const Icon& icon, int x, int y, uint16_t fg, uint16_t bg) {
 	if (!display) return;
-	if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
-	int drawWidth = icon.w;
-	int drawHeight = icon.h;
-	if (drawWidth <= 0 || drawHeight <= 0) return;
-
-	const int MAX_LINE = DISPLAY_WIDTH;
-	static uint16_t line[MAX_LINE];
-	int copyWidth = (drawWidth < MAX_LINE) ? drawWidth : MAX_LINE;
-	for (int row = 0; row < drawHeight; ++row) {
-		for (int col = 0; col < copyWidth; ++col) {
-			line[col] = pgm_read_word(&(icon.data[row * icon.w + col]));
+	int w = icon.w;
+	int h = icon.h;
+	if (w <= 0 || h <= 0 || w > DISPLAY_WIDTH) return;
+
+	// Clip to the panel and the driver clip rect; the window only covers the
+	// visible part
+	int x0 = (x > 0) ? x : 0;
+	int y0 = (y > 0) ? y : 0;
+	int x1 = (x + w < (int)display->width()) ? x + w : (int)display->width();
+	int y1 = (y + h < (int)display->height()) ? y + h : (int)display->height();
+	if (!DisplayDriver::clipWindow(x0, y0, x1, y1)) return;
+
+	bool indexed = icon.format == ICON_FORMAT_INDEXED;
+	if (indexed ? (!icon.indices || (icon.bpp != 1 && icon.bpp != 2 && icon.bpp != 4)) : !icon.data) return;
+
+	// Resolve indices to colors once per draw
+	uint16_t colors[16];
+	IconReader reader = {icon.indices, icon.bpp, (icon.flags & ICON_FLAG_RLE) != 0, 0, 0};
+	if (indexed) {
+		uint8_t levels = 1 << icon.bpp;
+		for (uint8_t i = 0; i < levels; i++) {
+			if (icon.flags & ICON_FLAG_TINT) {
+				colors[i] = blend565(bg, fg, i, levels - 1);
+			} else {
+				colors[i] = (i == 0 || !icon.palette) ? bg : pgm_read_word(&icon.palette[i]);
+			}
 		}
-		drawIconLine(display, line, x, y + row, copyWidth);
 	}
+
+	display->startWrite();
+	display->setAddrWindow(x0, y0, x1 - x0, y1 - y0);
+	for (int row = 0; row < y1 - y; row++) {
+		if (indexed) {
+			// Rows above the panel still have to be consumed from the stream
+			readIconRow(reader, w, colors, iconLine);
+		} else if (y + row >= y0) {
+			for (int col = x0 - x; col < x1 - x; col++) {
+				iconLine[col] = pgm_read_word(&icon.data[row * w + col]);
+			}
+		}
+		if (y + row >= y0) {
+			display->writePixels(iconLine + (x0 - x), x1 - x0);
+		}
+	}
+	display->endWrite();
 }
 
 void DisplayUtils::drawIcon(Adafruit_ST7789* display, const Icon& icon, int x, int y) {
-	drawIconInternal(display, icon, x, y);
+	drawIconInternal(display, icon, x, y, ThemeManager::getPrimaryText(), ThemeManager::getBackground());
+}
+
+void DisplayUtils::drawIcon(Adafruit_ST7789* display, const Icon& icon, int x, int y, uint16_t fg, uint16_t bg) {
+	drawIconInternal(display, icon, x, y, fg, bg);
 }
 #endif
@@ -4,6 +4,7 @@
 #include <Adafruit_ST7789.h>
 #include "../../config/DisplayConfig.h"
 #include "Theme.h"
+#include "GlyphCache.h"
 
 #if __has_include("../../icons/Icon.h")
 #include "../../icons/Icon.h"
@@ -44,6 +45,31 @@ public:
      */
     static void centerTextWithColor(Adafruit_ST7789* display, const char* text, int textSize, int y, uint16_t color);
     
+    /**
+     * Draw centered text over a known background (single address window)
+     * @param display Graphics display instance
+     * @param text Text to center
+     * @param textSize Text size (1-3)
+     * @param y Y position for text top
+     * @param color Text color (RGB565)
+     * @param bg Background color behind the text (RGB565)
+     */
+    static void centerTextWithColor(Adafruit_ST7789* display, const char* text, int textSize, int y, uint16_t color, uint16_t bg);
+    
+    /**
+     * Draw text over a known background using the glyph cache.
+     * Falls back to Adafruit_GFX print() for unsupported sizes.
+     * @param display Graphics display instance
+     * @param text Text to draw (single line)
+     * @param x X position
+     * @param y Y position for text top
+     * @param textSize Text size
+     * @param color Text color (RGB565)
+     * @param bg Background color behind the text (RGB565)
+     * @return Width in pixels
+     */
+    static int drawText(Adafruit_ST7789* display, const char* text, int x, int y, int textSize, uint16_t color, uint16_t bg);
+    
     /**
      * Draw title using standard positioning and theme colors
      * @param display Graphics display instance
@@ -52,7 +78,7 @@ public:
     static void drawTitle(Adafruit_ST7789* display, const char* title);
     
     /**
-     * Calculate text width for given string and size
+     * Calculate text width for given string and size (cached font metrics)
      * @param display Graphics display instance
      * @param text Text to measure
      * @param textSize Text size
@@ -141,9 +167,16 @@ public:
 
     #if __has_include("../../icons/Icon.h")
     /**
-     * Draw an Icon (RGB565 in PROGMEM) at the given coordinates
+     * Draw an Icon at the given coordinates in one address window.
+     * Tinted icons use the theme's primary text color on the background.
      */
     static void drawIcon(Adafruit_ST7789* display, const Icon& icon, int x, int y);
+    
+    /**
+     * Draw an Icon with explicit colors: tinted icons blend from bg to fg,
+     * transparent pixels of palette icons are filled with bg
+     */
+    static void drawIcon(Adafruit_ST7789* display, const Icon& icon, int x, int y, uint16_t fg, uint16_t bg);
     #endif
 };
 
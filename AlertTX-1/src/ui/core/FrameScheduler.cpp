@@ -0,0 +1,127 @@
+#include "FrameScheduler.h"
+#include <esp_sleep.h>
+
+// Static member initialization
+unsigned long FrameScheduler::frameIntervalMs = FrameScheduler::DEFAULT_FRAME_MS;
+FrameScheduler::WakeCheck FrameScheduler::wakeCheck = nullptr;
+bool FrameScheduler::lightSleepAllowed = false;
+
+bool FrameScheduler::frameRequested = true;
+bool FrameScheduler::hasDeadline = false;
+unsigned long FrameScheduler::nextDeadlineMs = 0;
+
+unsigned long FrameScheduler::statsStartUs = 0;
+unsigned long FrameScheduler::idleUs = 0;
+unsigned long FrameScheduler::lightSleepUs = 0;
+unsigned long FrameScheduler::drawUs = 0;
+unsigned long FrameScheduler::maxDrawUs = 0;
+unsigned long FrameScheduler::framesPresented = 0;
+unsigned long FrameScheduler::skippedPasses = 0;
+
+void FrameScheduler::begin(unsigned long frameMs) {
+    setFrameInterval(frameMs);
+    frameRequested = true;
+    hasDeadline = false;
+    resetStats();
+    Serial.printf("FrameScheduler initialized (%lu ms frames)\n", frameIntervalMs);
+}
+
+void FrameScheduler::setFrameInterval(unsigned long frameMs) {
+    frameIntervalMs = (frameMs > 0) ? frameMs : DEFAULT_FRAME_MS;
+}
+
+bool FrameScheduler::isDue(unsigned long& lastMs, unsigned long intervalMs) {
+    unsigned long now = millis();
+    if (now - lastMs < intervalMs) return false;
+    lastMs = now;
+    return true;
+}
+
+void FrameScheduler::requestFrame() {
+    frameRequested = true;
+}
+
+void FrameScheduler::wakeAt(unsigned long deadlineMs) {
+    if (!hasDeadline || (long)(deadlineMs - nextDeadlineMs) < 0) {
+        nextDeadlineMs = deadlineMs;
+        hasDeadline = true;
+    }
+}
+
+void FrameScheduler::framePresented(unsigned long frameDrawUs) {
+    framesPresented++;
+    drawUs += frameDrawUs;
+    if (frameDrawUs > maxDrawUs) maxDrawUs = frameDrawUs;
+    frameRequested = false;
+}
+
+void FrameScheduler::idle() {
+    // Dirty state or a button mid-debounce: go straight into the next pass
+    if (frameRequested || (wakeCheck && wakeCheck())) {
+        hasDeadline = false;
+        return;
+    }
+
+    unsigned long now = millis();
+    unsigned long deadline = now + MAX_IDLE_MS;
+    if (hasDeadline && (long)(nextDeadlineMs - deadline) < 0) {
+        deadline = nextDeadlineMs;
+    }
+    hasDeadline = false;
+
+    if ((long)(deadline - now) <= 0) return;
+
+    unsigned long startUs = micros();
+    sleepUntil(deadline);
+    idleUs += micros() - startUs;
+}
+
+void FrameScheduler::sleepUntil(unsigned long deadlineMs) {
+    unsigned long remaining = deadlineMs - millis();
+
+    // Light sleep drops the Wi-Fi association, so it is only used while the
+    // radio is off. Buttons are already ext0/ext1 wake sources (ButtonManager).
+    if (lightSleepAllowed && remaining >= MIN_LIGHT_SLEEP_MS) {
+        unsigned long sleepStartUs = micros();
+        esp_sleep_enable_timer_wakeup((uint64_t)remaining * 1000ULL);
+        esp_light_sleep_start();
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+        lightSleepUs += micros() - sleepStartUs;
+        return;
+    }
+
+    // Otherwise block in 1ms slices so the idle task runs (modem sleep keeps
+    // the radio associated) while still catching a press within a tick.
+    while ((long)(deadlineMs - millis()) > 0) {
+        if (frameRequested || (wakeCheck && wakeCheck())) break;
+        delay(1);
+    }
+}
+
+uint8_t FrameScheduler::getIdlePercent() {
+    unsigned long elapsed = micros() - statsStartUs;
+    if (elapsed == 0) return 0;
+    return (uint8_t)((uint64_t)idleUs * 100ULL / elapsed);
+}
+
+void FrameScheduler::printStats() {
+    unsigned long elapsedMs = (micros() - statsStartUs) / 1000;
+    Serial.printf("FrameScheduler stats (%lu ms window):\n", elapsedMs);
+    Serial.printf("  Frame interval: %lu ms\n", frameIntervalMs);
+    Serial.printf("  Frames presented: %lu, idle passes skipped: %lu\n", framesPresented, skippedPasses);
+    if (framesPresented > 0) {
+        Serial.printf("  Draw time: avg %lu us, max %lu us\n", drawUs / framesPresented, maxDrawUs);
+    }
+    Serial.printf("  Idle: %u%% (%lu ms, light sleep %lu ms)\n",
+                  getIdlePercent(), idleUs / 1000, lightSleepUs / 1000);
+}
+
+void FrameScheduler::resetStats() {
+    statsStartUs = micros();
+    idleUs = 0;
+    lightSleepUs = 0;
+    drawUs = 0;
+    maxDrawUs = 0;
+    framesPresented = 0;
+    skippedPasses = 0;
+}
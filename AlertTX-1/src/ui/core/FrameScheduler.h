@@ -0,0 +1,86 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <Arduino.h>
+
+/**
+ * FrameScheduler
+ *
+ * Single frame clock for the Alert TX-1 UI. ScreenManager, GameScreen and
+ * RenderManager all pace themselves off this clock instead of keeping their
+ * own 16ms timers.
+ *
+ * Features:
+ * - One shared frame interval (~60 FPS by default)
+ * - Frames are only presented when something is actually dirty
+ * - Wake deadlines so timers and game ticks are never overslept
+ * - Remaining frame budget is yielded to the idle task (or light sleep
+ *   when the radio is off) instead of spinning the main loop
+ * - Input-aware idling: returns immediately while a button needs polling
+ * - Busy/idle accounting for measuring idle CPU time
+ *
+ * Usage (main loop):
+ *   ... input, update, draw ...
+ *   FrameScheduler::idle();
+ */
+
+class FrameScheduler {
+public:
+    static const unsigned long DEFAULT_FRAME_MS = 16;   // ~60 FPS
+    static const unsigned long MAX_IDLE_MS = 50;        // Upper bound for one idle slice
+    static const unsigned long MIN_LIGHT_SLEEP_MS = 5;  // Shorter waits just yield
+
+    // Returns true while something needs tight polling (e.g. a held button)
+    typedef bool (*WakeCheck)();
+
+    // Configuration
+    static void begin(unsigned long frameMs = DEFAULT_FRAME_MS);
+    static void setFrameInterval(unsigned long frameMs);
+    static unsigned long getFrameInterval() { return frameIntervalMs; }
+    static void setWakeCheck(WakeCheck check) { wakeCheck = check; }
+    static void setLightSleepAllowed(bool allowed) { lightSleepAllowed = allowed; }
+
+    // Frame clock
+    static bool isDue(unsigned long& lastMs, unsigned long intervalMs);
+    static bool isFrameDue(unsigned long& lastMs) { return isDue(lastMs, frameIntervalMs); }
+
+    // Deadlines - the next idle() returns no later than the earliest one
+    static void requestFrame();                 // Present without waiting
+    static void wakeAt(unsigned long deadlineMs);
+    static void wakeWithin(unsigned long ms) { wakeAt(millis() + ms); }
+
+    // Presentation accounting (called by ScreenManager)
+    static void framePresented(unsigned long drawUs);
+    static void frameSkipped() { skippedPasses++; }
+
+    // Yield the rest of the frame budget
+    static void idle();
+
+    // Statistics
+    static uint8_t getIdlePercent();
+    static unsigned long getFramesPresented() { return framesPresented; }
+    static void printStats();
+    static void resetStats();
+
+private:
+    static unsigned long frameIntervalMs;
+    static WakeCheck wakeCheck;
+    static bool lightSleepAllowed;
+
+    static bool frameRequested;
+    static bool hasDeadline;
+    static unsigned long nextDeadlineMs;
+
+    // Accounting (microseconds)
+    static unsigned long statsStartUs;
+    static unsigned long idleUs;
+    static unsigned long lightSleepUs;
+    static unsigned long drawUs;
+    static unsigned long maxDrawUs;
+    static unsigned long framesPresented;
+    static unsigned long skippedPasses;
+
+    static void sleepUntil(unsigned long deadlineMs);
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -3,6 +3,7 @@
 
 #include <Adafruit_ST7789.h>
 #include <Arduino.h>
+#include "RenderManager.h"
 
 class GameObject {
 protected:
@@ -20,16 +21,27 @@ public:
 
     virtual ~GameObject() = default;
 
+    // Moves report both the vacated and the new bounds as damage
     void setPosition(int newX, int newY) {
         prevX = x; prevY = y;
         x = newX; y = newY;
         moved = (prevX != x || prevY != y);
+        if (moved && visible) {
+            GlobalRenderManager::reportDamage(prevX, prevY, width, height);
+            GlobalRenderManager::reportDamage(x, y, width, height);
+        }
     }
 
-    void setSize(int w, int h) { width = w; height = h; }
+    void setSize(int w, int h) {
+        if (visible) GlobalRenderManager::reportDamage(x, y, width, height);
+        width = w; height = h;
+    }
     void setColor(uint16_t c) { color = c; }
 
-    void setVisible(bool v) { visible = v; }
+    void setVisible(bool v) {
+        if (visible != v) GlobalRenderManager::reportDamage(x, y, width, height);
+        visible = v;
+    }
     bool isVisible() const { return visible; }
 
     void clearPrevious(Adafruit_ST7789* display, uint16_t bgColor) {
@@ -6,23 +6,41 @@
 
 class GameScreen : public Screen {
 protected:
-    // Shared timing system
+    // Shared timing system (game ticks run on the FrameScheduler clock)
     unsigned long lastUpdateMs = 0;
-    unsigned long targetFrameTime = 16; // 60 FPS default
+    unsigned long targetFrameTime = FrameScheduler::DEFAULT_FRAME_MS; // 60 FPS default
+    bool frameDirty = true;             // A game tick ran since the last draw
 
     // Game area management
     int gameLeft = 0, gameRight = 0, gameTop = 0, gameBottom = 0;
     bool staticBackgroundCached = false;
     unsigned long lastStaticRedraw = 0;
 
-    // Optional render batching (games may use directly)
+    // Per-frame fill batching: queue with renderBatch.addRect(), flushed in
+    // one SPI transaction after drawGame()
     RenderBatch renderBatch;
 
 public:
     GameScreen(Adafruit_ST7789* display, const char* name, int id = 0)
-        : Screen(display, name, id) {}
+        : Screen(display, name, id) {
+        renderBatch.setDisplay(display);
+    }
     virtual ~GameScreen() = default;
 
+    void exit() override {
+        renderBatch.flush();
+        renderBatch.printStats(getName());
+        renderBatch.resetStats();
+        Screen::exit();
+    }
+
+    // Games paint their court in enter() and keep per-frame state, so they
+    // always start with a cut instead of a slide
+    bool supportsSlideTransition() const override { return false; }
+
+    // Only critical alerts interrupt a game
+    bool holdsAlerts() const override { return true; }
+
     // Game hooks
     virtual void updateGame() = 0;    // Game-specific update logic
     virtual void drawGame() = 0;      // Game-specific rendering
@@ -30,32 +48,55 @@ public:
 
     // Shared utilities
     bool shouldUpdateFrame() {
-        unsigned long now = millis();
-        if (now - lastUpdateMs < targetFrameTime) return false;
-        lastUpdateMs = now;
-        return true;
+        // Keep the scheduler awake for the next tick while the game runs
+        bool due = FrameScheduler::isDue(lastUpdateMs, targetFrameTime);
+        FrameScheduler::wakeAt(lastUpdateMs + targetFrameTime);
+        return due;
     }
 
     void setTargetFPS(int fps) {
         if (fps <= 0) fps = 60;
-        targetFrameTime = (unsigned long)(1000UL / (unsigned long)fps);
+        // Never tick faster than the shared frame clock
+        unsigned long frameMs = (unsigned long)(1000UL / (unsigned long)fps);
+        targetFrameTime = max(frameMs, FrameScheduler::getFrameInterval());
     }
 
     void update() override {
         Screen::update();
         if (!shouldUpdateFrame()) return;
         updateGame();
+        frameDirty = true;
+    }
+
+    bool needsDraw() const override {
+        return isActive() && (frameDirty || !staticBackgroundCached || Screen::needsDraw());
     }
 
     void draw() override {
         if (!isActive()) return;
+        // Entering or markForFullRedraw(): start from a clean panel
+        if (needsFullRedraw) {
+            RenderProfiler::beginSection("clear");
+            clearScreen();
+            RenderProfiler::endSection();
+            needsFullRedraw = false;
+            staticBackgroundCached = false;
+            for (int i = 0; i < componentCount; i++) {
+                if (components[i]) components[i]->markDirty();
+            }
+        }
         if (!staticBackgroundCached) {
+            RenderProfiler::beginSection("static");
             drawStatic();
+            RenderProfiler::endSection();
             staticBackgroundCached = true;
             lastStaticRedraw = millis();
         }
+        RenderProfiler::beginSection("game");
         drawGame();
-        // Games may use renderBatch explicitly and flush themselves if needed
+        renderBatch.flush();
+        RenderProfiler::endSection();
+        frameDirty = false;
     }
 };
 
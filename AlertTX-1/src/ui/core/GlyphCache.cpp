@@ -0,0 +1,159 @@
+#include "GlyphCache.h"
+#include "DisplayDriver.h"
+#include "RenderProfiler.h"
+#include <string.h>
+
+// Static member initialization
+uint8_t GlyphCache::glyphRows[256][GlyphCache::GLYPH_HEIGHT];
+uint32_t GlyphCache::glyphDecoded[256 / 32] = {0};
+GlyphCache::RunSlot GlyphCache::slots[GlyphCache::RUN_SLOTS];
+uint32_t GlyphCache::useCounter = 0;
+uint32_t GlyphCache::runHits = 0;
+uint32_t GlyphCache::runMisses = 0;
+uint32_t GlyphCache::stringsDrawn = 0;
+
+// Captures one drawChar() into row masks (bit 5 = leftmost pixel). The
+// classic font table is static to Adafruit_GFX.cpp, so glyphs are read
+// through the library instead of compiling a second copy into flash
+class GlyphProbe : public Adafruit_GFX {
+public:
+    uint8_t* rows = nullptr;
+    GlyphProbe() : Adafruit_GFX(GlyphCache::GLYPH_WIDTH, GlyphCache::GLYPH_HEIGHT) {}
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (color && x >= 0 && x < GlyphCache::GLYPH_WIDTH && y >= 0 && y < GlyphCache::GLYPH_HEIGHT) {
+            rows[y] |= (0x20 >> x);
+        }
+    }
+};
+
+// One assembled pixel row: the widest visible span plus a partial glyph on
+// each side
+static uint16_t lineBuffer[320 + 2 * GlyphCache::GLYPH_WIDTH * GlyphCache::MAX_TEXT_SIZE];
+
+int GlyphCache::drawText(Adafruit_ST7789* display, const char* text, int x, int y,
+                         uint8_t size, uint16_t fg, uint16_t bg) {
+    if (!display || !text || !supportsSize(size)) return 0;
+
+    int len = 0;
+    while (text[len] && text[len] != '\n') len++;
+    if (len == 0) return 0;
+
+    const int cellW = GLYPH_WIDTH * size;
+    const int textW = len * cellW;
+    const int textH = GLYPH_HEIGHT * size;
+
+    // Clip the string box to the panel and the driver clip rect
+    int x0 = max(x, 0);
+    int y0 = max(y, 0);
+    int x1 = min(x + textW, (int)display->width());
+    int y1 = min(y + textH, (int)display->height());
+    if (!DisplayDriver::clipWindow(x0, y0, x1, y1)) return textW;
+
+    // Only assemble the glyphs that are at least partly visible
+    int firstChar = (x0 - x) / cellW;
+    int lastChar = (x1 - x + cellW - 1) / cellW;
+    int skip = (x0 - x) - firstChar * cellW;
+    int spanW = x1 - x0;
+
+    const uint8_t* glyphs[64];
+    int visibleChars = lastChar - firstChar;
+    if (visibleChars > 64) visibleChars = 64;
+    for (int i = 0; i < visibleChars; i++) {
+        glyphs[i] = getGlyph((unsigned char)text[firstChar + i]);
+    }
+
+    const uint16_t* runs = getRuns(size, fg, bg);
+    const size_t runBytes = cellW * sizeof(uint16_t);
+
+    display->startWrite();
+    display->setAddrWindow(x0, y0, spanW, y1 - y0);
+
+    int builtRow = -1;
+    for (int py = y0; py < y1; py++) {
+        int glyphRow = (py - y) / size;
+        if (glyphRow != builtRow) {
+            uint16_t* out = lineBuffer;
+            for (int i = 0; i < visibleChars; i++) {
+                memcpy(out, runs + glyphs[i][glyphRow] * cellW, runBytes);
+                out += cellW;
+            }
+            builtRow = glyphRow;
+        }
+        display->writePixels(lineBuffer + skip, spanW);
+    }
+
+    display->endWrite();
+    stringsDrawn++;
+    RenderProfiler::countText(visibleChars);
+    return textW;
+}
+
+int GlyphCache::getTextWidth(const char* text, uint8_t size) {
+    if (!text) return 0;
+    int widest = 0;
+    int current = 0;
+    for (const char* p = text; *p; p++) {
+        if (*p == '\n') {
+            current = 0;
+        } else if (*p != '\r') {
+            current++;
+            if (current > widest) widest = current;
+        }
+    }
+    return widest * GLYPH_WIDTH * size;
+}
+
+void GlyphCache::printStats() {
+    Serial.printf("GlyphCache: %lu strings, run cache %lu hits / %lu misses\n",
+                  (unsigned long)stringsDrawn, (unsigned long)runHits, (unsigned long)runMisses);
+}
+
+// Private helpers
+
+const uint8_t* GlyphCache::getGlyph(unsigned char c) {
+    uint8_t* rows = glyphRows[c];
+    if (glyphDecoded[c / 32] & (1UL << (c % 32))) return rows;
+
+    // Foreground only (bg == color); drawChar() applies the same cp437
+    // mapping as print()
+    static GlyphProbe probe;
+    memset(rows, 0, GLYPH_HEIGHT);
+    probe.rows = rows;
+    probe.drawChar(0, 0, c, 1, 1, 1);
+    glyphDecoded[c / 32] |= (1UL << (c % 32));
+    return rows;
+}
+
+const uint16_t* GlyphCache::getRuns(uint8_t size, uint16_t fg, uint16_t bg) {
+    useCounter++;
+
+    RunSlot* victim = &slots[0];
+    for (uint8_t i = 0; i < RUN_SLOTS; i++) {
+        RunSlot& slot = slots[i];
+        if (slot.valid && slot.size == size && slot.fg == fg && slot.bg == bg) {
+            slot.lastUsed = useCounter;
+            runHits++;
+            return slot.runs;
+        }
+        if (!slot.valid || (victim->valid && slot.lastUsed < victim->lastUsed)) {
+            victim = &slot;
+        }
+    }
+
+    // Expand every 6-pixel row pattern for this (size, fg, bg)
+    runMisses++;
+    const int cellW = GLYPH_WIDTH * size;
+    for (int mask = 0; mask < 64; mask++) {
+        uint16_t* out = victim->runs + mask * cellW;
+        for (int px = 0; px < GLYPH_WIDTH; px++) {
+            uint16_t color = (mask & (0x20 >> px)) ? fg : bg;
+            for (int s = 0; s < size; s++) *out++ = color;
+        }
+    }
+    victim->size = size;
+    victim->fg = fg;
+    victim->bg = bg;
+    victim->lastUsed = useCounter;
+    victim->valid = true;
+    return victim->runs;
+}
@@ -0,0 +1,70 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Adafruit_ST7789.h>
+#include <Arduino.h>
+
+/**
+ * GlyphCache
+ *
+ * Opaque text renderer for the built-in Adafruit_GFX 5x7 font.
+ *
+ * Adafruit_GFX draws the classic font one lit pixel (size 1) or one
+ * size x size rect (size 2+) at a time, each with its own address window.
+ * This renders a whole string as a single window instead: every pixel row
+ * is assembled from pre-rendered RGB565 runs and streamed with writePixels.
+ *
+ * Features:
+ * - Row masks for glyphs in use, decoded once through Adafruit_GFX::drawChar()
+ *   (no second copy of the font table in flash)
+ * - Pre-rendered RGB565 runs per (size, fg, bg) tuple: all 64 six-pixel row
+ *   patterns, kept in a small LRU of slots
+ * - One address window and one SPI transaction per string
+ * - Clipped to the panel; same glyph metrics as Adafruit_GFX (6x8 cells)
+ * - Hit/miss counters for the run cache
+ *
+ * Text must be drawn over a known background color. Transparent text and
+ * sizes above MAX_TEXT_SIZE still go through Adafruit_GFX print().
+ */
+
+class GlyphCache {
+public:
+    static const uint8_t GLYPH_WIDTH = 6;    // 5 columns + 1 spacing column
+    static const uint8_t GLYPH_HEIGHT = 8;
+    static const uint8_t MAX_TEXT_SIZE = 3;
+    static const uint8_t RUN_SLOTS = 4;
+
+    // Draw a single line (stops at '\n') with an opaque background.
+    // Returns the width in pixels that was covered.
+    static int drawText(Adafruit_ST7789* display, const char* text, int x, int y,
+                        uint8_t size, uint16_t fg, uint16_t bg);
+
+    // Metrics (match Adafruit_GFX getTextBounds for the classic font)
+    static int getTextWidth(const char* text, uint8_t size);
+    static int getTextHeight(uint8_t size) { return GLYPH_HEIGHT * size; }
+
+    static bool supportsSize(uint8_t size) { return size >= 1 && size <= MAX_TEXT_SIZE; }
+
+    // Statistics
+    static void printStats();
+
+private:
+    struct RunSlot {
+        uint8_t size;
+        uint16_t fg, bg;
+        uint32_t lastUsed;
+        bool valid;
+        uint16_t runs[64 * GLYPH_WIDTH * MAX_TEXT_SIZE];
+    };
+
+    static uint8_t glyphRows[256][GLYPH_HEIGHT];
+    static uint32_t glyphDecoded[256 / 32];
+    static RunSlot slots[RUN_SLOTS];
+    static uint32_t useCounter;
+    static uint32_t runHits, runMisses, stringsDrawn;
+
+    static const uint8_t* getGlyph(unsigned char c);
+    static const uint16_t* getRuns(uint8_t size, uint16_t fg, uint16_t bg);
+};
+
+#endif // GLYPH_CACHE_H
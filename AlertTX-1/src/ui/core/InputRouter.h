@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "ScreenManager.h"
 #include "../../hardware/ButtonManager.h"
+#include "../../power/PowerManager.h"
 
 class InputRouter {
 public:
@@ -27,11 +28,14 @@ public:
 			}
 		}
 
-		// Clear suppression once all released
+		// Clear suppression once all released; a held button is activity
+		// for the dim / sleep timer (and turns a dimmed screen back on)
 		if (!buttons->isPressed(ButtonManager::BUTTON_A) &&
 		    !buttons->isPressed(ButtonManager::BUTTON_B) &&
 		    !buttons->isPressed(ButtonManager::BUTTON_C)) {
 			suppressSelectUntilRelease = false;
+		} else {
+			PowerManager::notifyActivity();
 		}
 
 		// Route discrete presses to current screen
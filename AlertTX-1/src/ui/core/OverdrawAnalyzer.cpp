@@ -0,0 +1,233 @@
+#include "OverdrawAnalyzer.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Static member initialization
+uint8_t* OverdrawAnalyzer::counts = nullptr;
+uint8_t* OverdrawAnalyzer::lastSite = nullptr;
+uint8_t* OverdrawAnalyzer::heat = nullptr;
+int16_t OverdrawAnalyzer::width = 0;
+int16_t OverdrawAnalyzer::height = 0;
+OverdrawAnalyzer::SiteStats OverdrawAnalyzer::sites[OverdrawAnalyzer::MAX_SITES];
+uint8_t OverdrawAnalyzer::siteCount = 0;
+uint8_t OverdrawAnalyzer::siteStack[OverdrawAnalyzer::MAX_DEPTH];
+uint8_t OverdrawAnalyzer::depth = 0;
+int16_t OverdrawAnalyzer::dirtyX0 = 0;
+int16_t OverdrawAnalyzer::dirtyY0 = 0;
+int16_t OverdrawAnalyzer::dirtyX1 = 0;
+int16_t OverdrawAnalyzer::dirtyY1 = 0;
+uint32_t OverdrawAnalyzer::frames = 0;
+uint32_t OverdrawAnalyzer::totalPixels = 0;
+uint32_t OverdrawAnalyzer::totalUnique = 0;
+uint32_t OverdrawAnalyzer::framePixels = 0;
+float OverdrawAnalyzer::worstRatio = 0.0f;
+
+// Site 0 collects writes made outside any section or scope
+static const char* const UNATTRIBUTED = "(unattributed)";
+
+// Serial heatmap: one character per 4x5 pixel cell (60x27 at 240x135)
+static const uint8_t HEATMAP_CELL_W = 4;
+static const uint8_t HEATMAP_CELL_H = 5;
+static const char HEATMAP_RAMP[] = " .:-=+*#%@";
+
+bool OverdrawAnalyzer::begin(int16_t w, int16_t h) {
+    if (w <= 0 || h <= 0) return false;
+    end();
+    size_t size = (size_t)w * h;
+    counts = (uint8_t*)calloc(size, 1);
+    lastSite = (uint8_t*)calloc(size, 1);
+    heat = (uint8_t*)calloc(size, 1);
+    if (!counts || !lastSite || !heat) {
+        Serial.printf("OverdrawAnalyzer: cannot allocate %u bytes\n", (unsigned)(size * 3));
+        end();
+        return false;
+    }
+    width = w;
+    height = h;
+    reset();
+    Serial.printf("OverdrawAnalyzer: on (%dx%d, %u bytes)\n", w, h, (unsigned)(size * 3));
+    return true;
+}
+
+void OverdrawAnalyzer::end() {
+    free(counts);
+    free(lastSite);
+    free(heat);
+    counts = lastSite = heat = nullptr;
+    depth = 0;
+}
+
+void OverdrawAnalyzer::beginSite(const char* name) {
+    if (!counts) return;
+    if (depth < MAX_DEPTH) siteStack[depth] = findSite(name);
+    depth++;
+}
+
+void OverdrawAnalyzer::endSite() {
+    if (!counts || depth == 0) return;
+    depth--;
+}
+
+void OverdrawAnalyzer::endFrame() {
+    if (!counts) return;
+    if (framePixels == 0) return;   // Nothing pushed, nothing to close
+
+    uint32_t unique = 0;
+    for (int16_t y = dirtyY0; y < dirtyY1; y++) {
+        uint8_t* row = counts + (size_t)y * width;
+        uint8_t* heatRow = heat + (size_t)y * width;
+        for (int16_t x = dirtyX0; x < dirtyX1; x++) {
+            uint8_t c = row[x];
+            if (c == 0) continue;
+            unique++;
+            if (c > 1) {
+                unsigned h = heatRow[x] + (c - 1);
+                heatRow[x] = (h > 255) ? 255 : (uint8_t)h;
+            }
+            row[x] = 0;
+        }
+    }
+
+    frames++;
+    totalPixels += framePixels;
+    totalUnique += unique;
+    float ratio = unique ? (float)framePixels / unique : 0.0f;
+    if (ratio > worstRatio) worstRatio = ratio;
+    framePixels = 0;
+    dirtyX0 = width;
+    dirtyY0 = height;
+    dirtyX1 = 0;
+    dirtyY1 = 0;
+}
+
+uint8_t OverdrawAnalyzer::getHeat(int16_t x, int16_t y) {
+    if (!heat || x < 0 || y < 0 || x >= width || y >= height) return 0;
+    return heat[(size_t)y * width + x];
+}
+
+uint8_t OverdrawAnalyzer::getMaxHeat() {
+    if (!heat) return 0;
+    uint8_t maxHeat = 0;
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        if (heat[i] > maxHeat) maxHeat = heat[i];
+    }
+    return maxHeat;
+}
+
+void OverdrawAnalyzer::printReport() {
+    if (!counts) {
+        Serial.println("OverdrawAnalyzer: off (\"overdraw on\" to start)");
+        return;
+    }
+    Serial.printf("OverdrawAnalyzer (%lu frames): %lu px written, %lu unique, ratio %.2f, worst frame %.2f\n",
+                  (unsigned long)frames, (unsigned long)totalPixels, (unsigned long)totalUnique,
+                  getRatio(), worstRatio);
+    Serial.println("  site                    written   overdraw       wasted");
+    for (uint8_t i = 0; i < siteCount; i++) {
+        const SiteStats& s = sites[i];
+        if (s.pixels == 0) continue;
+        Serial.printf("  %-20s %10lu %10lu %3lu%% %8lu %3lu%%\n", s.name, (unsigned long)s.pixels,
+                      (unsigned long)s.overdrawn, (unsigned long)(s.overdrawn * 100ULL / s.pixels),
+                      (unsigned long)s.wasted, (unsigned long)(s.wasted * 100ULL / s.pixels));
+    }
+}
+
+void OverdrawAnalyzer::printHeatmap() {
+    if (!heat) {
+        Serial.println("OverdrawAnalyzer: off");
+        return;
+    }
+    uint8_t maxHeat = getMaxHeat();
+    const uint8_t levels = sizeof(HEATMAP_RAMP) - 2;   // Highest ramp index
+    Serial.printf("Overdraw heatmap (%dx%d px per char, '%c' = %u+ repeated writes)\n",
+                  HEATMAP_CELL_W, HEATMAP_CELL_H, HEATMAP_RAMP[levels], maxHeat);
+    char line[128];
+    for (int16_t cy = 0; cy < height; cy += HEATMAP_CELL_H) {
+        int n = 0;
+        for (int16_t cx = 0; cx < width && n < (int)sizeof(line) - 1; cx += HEATMAP_CELL_W) {
+            // Hottest pixel of the cell, so one-pixel-wide hot lines still show
+            uint8_t cell = 0;
+            for (int16_t y = cy; y < cy + HEATMAP_CELL_H && y < height; y++) {
+                for (int16_t x = cx; x < cx + HEATMAP_CELL_W && x < width; x++) {
+                    uint8_t h = heat[(size_t)y * width + x];
+                    if (h > cell) cell = h;
+                }
+            }
+            uint8_t level = (maxHeat && cell) ? (uint8_t)(1 + (uint32_t)(cell - 1) * (levels - 1) / maxHeat) : 0;
+            line[n++] = HEATMAP_RAMP[level];
+        }
+        line[n] = '\0';
+        Serial.printf("|%s|\n", line);
+    }
+}
+
+void OverdrawAnalyzer::reset() {
+    if (counts) {
+        memset(counts, 0, (size_t)width * height);
+        memset(lastSite, 0, (size_t)width * height);
+        memset(heat, 0, (size_t)width * height);
+    }
+    // Names are reloaded on demand; site 0 is always the catch-all
+    for (uint8_t i = 0; i < MAX_SITES; i++) sites[i] = SiteStats();
+    sites[0].name = UNATTRIBUTED;
+    siteCount = 1;
+    depth = 0;
+    frames = 0;
+    totalPixels = 0;
+    totalUnique = 0;
+    framePixels = 0;
+    worstRatio = 0.0f;
+    dirtyX0 = width;
+    dirtyY0 = height;
+    dirtyX1 = 0;
+    dirtyY1 = 0;
+}
+
+// Private helpers
+
+void OverdrawAnalyzer::record(int16_t x, int16_t y, int16_t w, int16_t h) {
+    // Windows come pre-clipped by the driver; stay safe anyway
+    int x0 = (x < 0) ? 0 : x;
+    int y0 = (y < 0) ? 0 : y;
+    int x1 = (x + w > width) ? width : x + w;
+    int y1 = (y + h > height) ? height : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    // Scopes nested deeper than the stack are charged to the deepest one kept
+    uint8_t site = (depth == 0) ? 0 : siteStack[((depth < MAX_DEPTH) ? depth : MAX_DEPTH) - 1];
+    SiteStats& current = sites[site];
+    uint32_t overdrawn = 0;
+    for (int py = y0; py < y1; py++) {
+        size_t row = (size_t)py * width;
+        for (int px = x0; px < x1; px++) {
+            size_t i = row + px;
+            if (counts[i]) {
+                overdrawn++;
+                sites[lastSite[i]].wasted++;
+                if (counts[i] < 255) counts[i]++;
+            } else {
+                counts[i] = 1;
+            }
+            lastSite[i] = site;
+        }
+    }
+
+    uint32_t area = (uint32_t)(x1 - x0) * (y1 - y0);
+    current.pixels += area;
+    current.overdrawn += overdrawn;
+    framePixels += area;
+    if (x0 < dirtyX0) dirtyX0 = x0;
+    if (y0 < dirtyY0) dirtyY0 = y0;
+    if (x1 > dirtyX1) dirtyX1 = x1;
+    if (y1 > dirtyY1) dirtyY1 = y1;
+}
+
+uint8_t OverdrawAnalyzer::findSite(const char* name) {
+    if (!name) return 0;
+    for (uint8_t i = 0; i < siteCount; i++) {
+        if (sites[i].name == name || strcmp(sites[i].name, name) == 0) return i;
+    }
+    if (siteCount >= MAX_SITES) return 0;
+    sites[siteCount].name = name;
+    return siteCount++;
+}
@@ -0,0 +1,98 @@
+#ifndef OVERDRAW_ANALYZER_H
+#define OVERDRAW_ANALYZER_H
+
+#include <Arduino.h>
+
+/**
+ * OverdrawAnalyzer
+ *
+ * Counts how often every panel pixel is written between two presented
+ * frames, and charges writes that land on an already-written pixel to the
+ * call site that made them. Fed by DisplayDriver (every address window is
+ * exactly the pixels about to be pushed) and closed by ScreenManager::draw.
+ *
+ * Features:
+ * - Off by default; begin() allocates the per-pixel tables (3 bytes per
+ *   pixel, ~95 KB at 240x135), end() frees them
+ * - Call sites: RenderProfiler sections plus finer beginSite()/endSite()
+ *   scopes (nestable); writes are charged to the innermost one
+ * - Per site: pixels written, pixels that were already written this frame
+ *   (overdraw) and pixels of its own that a later write covered (wasted)
+ * - Work done between frames (e.g. the clear on a screen change) counts
+ *   towards the next frame, which is where its pixels get painted over
+ * - Session heatmap of repeated writes, printable over serial or readable
+ *   per pixel (host benchmark PNGs)
+ *
+ * Serial: "overdraw on|off|reset|map", "overdraw" prints the report.
+ */
+
+class OverdrawAnalyzer {
+public:
+    static const uint8_t MAX_SITES = 32;
+    static const uint8_t MAX_DEPTH = 6;
+
+    struct SiteStats {
+        const char* name = nullptr;
+        uint32_t pixels = 0;       // Pixels written
+        uint32_t overdrawn = 0;    // Of those, already written this frame
+        uint32_t wasted = 0;       // Its pixels later written again this frame
+    };
+
+    // Mode
+    static bool begin(int16_t width, int16_t height);
+    static void end();
+    static bool isEnabled() { return counts != nullptr; }
+
+    // Call-site attribution
+    static void beginSite(const char* name);
+    static void endSite();
+
+    // Driver hook: a window of w*h pixels is about to be pushed
+    static void countWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+        if (counts) record(x, y, w, h);
+    }
+
+    // Frame boundary (ScreenManager::draw)
+    static void endFrame();
+
+    // Queries
+    static uint32_t getFrames() { return frames; }
+    static uint32_t getPixels() { return totalPixels; }
+    static uint32_t getUniquePixels() { return totalUnique; }
+    static float getRatio() { return totalUnique ? (float)totalPixels / totalUnique : 0.0f; }
+    static float getWorstRatio() { return worstRatio; }
+    static uint8_t getSiteCount() { return siteCount; }
+    static const SiteStats* getSite(uint8_t index) { return index < siteCount ? &sites[index] : nullptr; }
+    static uint8_t getHeat(int16_t x, int16_t y);   // 0 = never overdrawn
+    static uint8_t getMaxHeat();
+
+    // Reporting
+    static void printReport();
+    static void printHeatmap();
+    static void reset();
+
+private:
+    static uint8_t* counts;      // Writes this frame, per pixel (saturating)
+    static uint8_t* lastSite;    // Site that last wrote the pixel
+    static uint8_t* heat;        // Repeated writes over the session (saturating)
+    static int16_t width, height;
+
+    static SiteStats sites[MAX_SITES];
+    static uint8_t siteCount;
+    static uint8_t siteStack[MAX_DEPTH];
+    static uint8_t depth;
+
+    // Bounding box of this frame's writes, so endFrame() scans only that
+    static int16_t dirtyX0, dirtyY0, dirtyX1, dirtyY1;
+
+    static uint32_t frames;
+    static uint32_t totalPixels;
+    static uint32_t totalUnique;
+    static uint32_t framePixels;
+    static float worstRatio;
+
+    static void record(int16_t x, int16_t y, int16_t w, int16_t h);
+    static uint8_t findSite(const char* name);
+};
+
+#endif // OVERDRAW_ANALYZER_H
@@ -1,3 +1,89 @@
 #include "RenderBatch.h"
 
-// Implementation in header for simplicity.
+void RenderBatch::addRect(int x, int y, int w, int h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+    stats.rectsQueued++;
+
+    BatchedRect r = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, color};
+
+    // Walk back through the queue looking for a same-color span this rect
+    // extends. Stop at the first rect it overlaps: anything drawn after that
+    // one must stay after it.
+    for (int i = count - 1; i >= 0; i--) {
+        if (rects[i].color == color && tryExtend(rects[i], r)) {
+            stats.rectsMerged++;
+            return;
+        }
+        if (overlaps(rects[i], r)) break;
+    }
+
+    // Full: push what we have and keep going rather than dropping the draw
+    if (count >= MAX_BATCH_SIZE) {
+        stats.fullFlushes++;
+        flush();
+        if (count >= MAX_BATCH_SIZE) {
+            Serial.println("ERROR: RenderBatch full and no display set");
+            return;
+        }
+    }
+    rects[count++] = r;
+}
+
+void RenderBatch::flush(Adafruit_ST7789* target) {
+    if (!target || count == 0) return;
+
+    // One transaction for the whole frame; writeFillRect clips and sets the
+    // address window without touching CS or the SPI bus settings.
+    target->startWrite();
+    for (uint8_t i = 0; i < count; i++) {
+        target->writeFillRect(rects[i].x, rects[i].y, rects[i].w, rects[i].h, rects[i].color);
+    }
+    target->endWrite();
+
+    stats.windowsIssued += count;
+    stats.transactions++;
+    count = 0;
+}
+
+void RenderBatch::printStats(const char* label) const {
+    Serial.printf("RenderBatch [%s]: %lu rects -> %lu windows in %lu transactions "
+                  "(%lu merged, %lu full flushes; unbatched: %lu transactions)\n",
+                  label ? label : "",
+                  (unsigned long)stats.rectsQueued, (unsigned long)stats.windowsIssued,
+                  (unsigned long)stats.transactions, (unsigned long)stats.rectsMerged,
+                  (unsigned long)stats.fullFlushes, (unsigned long)stats.rectsQueued);
+}
+
+// Private helpers
+
+bool RenderBatch::overlaps(const BatchedRect& a, const BatchedRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+bool RenderBatch::tryExtend(BatchedRect& span, const BatchedRect& r) {
+    // Already covered
+    if (r.x >= span.x && r.y >= span.y &&
+        r.x + r.w <= span.x + span.w && r.y + r.h <= span.y + span.h) {
+        return true;
+    }
+
+    // Same columns, touching or overlapping rows: grow vertically
+    if (r.x == span.x && r.w == span.w && r.y <= span.y + span.h && span.y <= r.y + r.h) {
+        int16_t top = (r.y < span.y) ? r.y : span.y;
+        int16_t bottom = (r.y + r.h > span.y + span.h) ? r.y + r.h : span.y + span.h;
+        span.y = top;
+        span.h = bottom - top;
+        return true;
+    }
+
+    // Same rows, touching or overlapping columns: grow horizontally
+    if (r.y == span.y && r.h == span.h && r.x <= span.x + span.w && span.x <= r.x + r.w) {
+        int16_t left = (r.x < span.x) ? r.x : span.x;
+        int16_t right = (r.x + r.w > span.x + span.w) ? r.x + r.w : span.x + span.w;
+        span.x = left;
+        span.w = right - left;
+        return true;
+    }
+
+    return false;
+}
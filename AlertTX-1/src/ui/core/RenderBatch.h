@@ -4,41 +4,60 @@
 #include <Adafruit_ST7789.h>
 #include <Arduino.h>
 
+/**
+ * RenderBatch
+ *
+ * Queues solid rect fills for a frame and pushes them to the panel in a
+ * single SPI transaction.
+ *
+ * Features:
+ * - Painter's order is preserved (later rects still land on top)
+ * - Same-color rects that extend each other exactly (shared edge or
+ *   overlap along one axis) are merged into one span/window
+ * - One startWrite()/endWrite() pair per flush instead of one per rect
+ * - Flushes automatically when full instead of dropping draws
+ * - Before/after counters: rects queued vs. windows and transactions issued
+ */
+
 class RenderBatch {
+public:
+    struct Stats {
+        uint32_t rectsQueued = 0;     // fill calls the game made
+        uint32_t rectsMerged = 0;     // absorbed into an earlier span
+        uint32_t windowsIssued = 0;   // address windows actually sent
+        uint32_t transactions = 0;    // startWrite/endWrite pairs
+        uint32_t fullFlushes = 0;     // flushes forced by a full queue
+    };
+
+    static const uint8_t MAX_BATCH_SIZE = 32;
+
+    void setDisplay(Adafruit_ST7789* target) { display = target; }
+
+    void addRect(int x, int y, int w, int h, uint16_t color);
+    void addHLine(int x, int y, int w, uint16_t color) { addRect(x, y, w, 1, color); }
+    void addVLine(int x, int y, int h, uint16_t color) { addRect(x, y, 1, h, color); }
+
+    void flush() { flush(display); }
+    void flush(Adafruit_ST7789* target);
+
+    bool isEmpty() const { return count == 0; }
+    const Stats& getStats() const { return stats; }
+    void resetStats() { stats = Stats(); }
+    void printStats(const char* label) const;
+
 private:
     struct BatchedRect {
-        int x, y, width, height;
+        int16_t x, y, w, h;
         uint16_t color;
     };
 
-    static const uint8_t MAX_BATCH_SIZE = 32;
     BatchedRect rects[MAX_BATCH_SIZE];
     uint8_t count = 0;
+    Adafruit_ST7789* display = nullptr;
+    Stats stats;
 
-    static int compareColor(const void* a, const void* b) {
-        const BatchedRect* ra = static_cast<const BatchedRect*>(a);
-        const BatchedRect* rb = static_cast<const BatchedRect*>(b);
-        if (ra->color < rb->color) return -1;
-        if (ra->color > rb->color) return 1;
-        return 0;
-    }
-
-public:
-    void addRect(int x, int y, int w, int h, uint16_t color) {
-        if (count < MAX_BATCH_SIZE) {
-            rects[count] = {x, y, w, h, color};
-            count++;
-        }
-    }
-
-    void flush(Adafruit_ST7789* display) {
-        if (!display || count == 0) return;
-        qsort(rects, count, sizeof(BatchedRect), compareColor);
-        for (uint8_t i = 0; i < count; i++) {
-            display->fillRect(rects[i].x, rects[i].y, rects[i].width, rects[i].height, rects[i].color);
-        }
-        count = 0;
-    }
+    static bool overlaps(const BatchedRect& a, const BatchedRect& b);
+    static bool tryExtend(BatchedRect& span, const BatchedRect& r);
 };
 
 #endif // RENDER_BATCH_H
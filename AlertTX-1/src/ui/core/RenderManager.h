@@ -4,6 +4,8 @@
 #include <Adafruit_ST7789.h>
 #include "../../config/DisplayConfig.h"
 #include "Theme.h"
+#include "FrameScheduler.h"
+#include "DamageTracker.h"
 
 /**
  * RenderManager
@@ -13,36 +15,28 @@
  * and direct-drawing screens.
  * 
  * Features:
- * - Dirty rectangle tracking
+ * - Damage rectangle tracking (merged by DamageTracker)
  * - Batch rendering operations
- * - Frame rate limiting
+ * - Frame rate limiting (shared FrameScheduler clock)
  * - Render statistics for optimization
  */
 
 class RenderManager {
 public:
-    struct DirtyRect {
-        int x, y, width, height;
-        bool isDirty;
-        
-        void markDirty() { isDirty = true; }
-        void clear() { isDirty = false; }
-        void setBounds(int nx, int ny, int nw, int nh) {
-            x = nx; y = ny; width = nw; height = nh;
-            isDirty = true;
-        }
-    };
-    
     struct RenderStats {
         unsigned long lastFrameTime = 0;
         unsigned long frameCount = 0;
         unsigned long totalDrawTime = 0;
+        unsigned long damagedPixels = 0;   // Pixels inside damage rects this window
+        unsigned long damageRects = 0;     // Merged rects presented this window
         int fps = 0;
         
         void reset() {
             lastFrameTime = millis();
             frameCount = 0;
             totalDrawTime = 0;
+            damagedPixels = 0;
+            damageRects = 0;
             fps = 0;
         }
         
@@ -58,118 +52,98 @@ public:
     };
     
 private:
-    static const int MAX_DIRTY_RECTS = 16;
-    DirtyRect dirtyRects[MAX_DIRTY_RECTS];
-    int dirtyRectCount = 0;
+    DamageTracker damage;
     
     Adafruit_ST7789* display;
     RenderStats stats;
     
-    // Frame timing
-    unsigned long targetFrameTime = 16; // 60 FPS default
+    // Frame timing (interval owned by FrameScheduler)
     unsigned long lastRenderTime = 0;
     
-    // Full screen redraw tracking
-    bool needsFullRedraw = false;
     bool staticContentDrawn = false;
     
 public:
-    RenderManager(Adafruit_ST7789* display) : display(display) {
-        clearAllDirtyRects();
-    }
+    RenderManager(Adafruit_ST7789* display)
+        : damage(DISPLAY_WIDTH, DISPLAY_HEIGHT), display(display) {}
     
-    // Dirty rectangle management
+    // Damage management - rects are merged by DamageTracker's cost model
     void addDirtyRect(int x, int y, int width, int height) {
-        if (dirtyRectCount < MAX_DIRTY_RECTS) {
-            dirtyRects[dirtyRectCount].setBounds(x, y, width, height);
-            dirtyRectCount++;
-        } else {
-            // Too many dirty rects - force full redraw
-            markFullScreenDirty();
-        }
+        damage.add(x, y, width, height);
     }
     
     void markFullScreenDirty() {
-        needsFullRedraw = true;
         staticContentDrawn = false;
-        clearAllDirtyRects();
+        damage.addFullScreen();
     }
     
     void clearAllDirtyRects() {
-        for (int i = 0; i < MAX_DIRTY_RECTS; i++) {
-            dirtyRects[i].clear();
-        }
-        dirtyRectCount = 0;
+        damage.clear();
     }
     
-    // Redraw state queries
-    bool needsRedraw() const {
-        if (needsFullRedraw) return true;
-        for (int i = 0; i < dirtyRectCount; i++) {
-            if (dirtyRects[i].isDirty) return true;
-        }
-        return false;
+    const DamageTracker& getDamage() const { return damage; }
+    bool isDamaged(int x, int y, int width, int height) const {
+        return damage.intersects(x, y, width, height);
+    }
+    bool isFullyDamaged(int x, int y, int width, int height) const {
+        return damage.covers(x, y, width, height);
     }
     
+    // Redraw state queries
+    bool needsRedraw() const { return !damage.isEmpty(); }
+    
     bool isStaticContentDrawn() const { return staticContentDrawn; }
     void markStaticContentDrawn() { staticContentDrawn = true; }
     
     // Frame rate control
     bool shouldRenderFrame() {
-        unsigned long now = millis();
-        if (now - lastRenderTime >= targetFrameTime) {
-            lastRenderTime = now;
-            return true;
-        }
-        return false;
+        return FrameScheduler::isFrameDue(lastRenderTime);
     }
     
     void setTargetFPS(int fps) {
         if (fps <= 0) fps = 60;
-        targetFrameTime = 1000 / fps;
+        FrameScheduler::setFrameInterval(1000 / fps);
     }
     
-    // Rendering helpers
+    // Frame bracketing (called by ScreenManager around each presented frame).
+    // Screens do their own clearing; damage is consumed in endFrame().
     void beginFrame() {
         stats.frameCount++;
-        
-        if (needsFullRedraw) {
-            display->fillScreen(ThemeManager::getBackground());
-            needsFullRedraw = false;
-        }
+        stats.damagedPixels += damage.getPixelCount();
+        stats.damageRects += damage.getRectCount();
     }
     
     void endFrame() {
         stats.updateFPS();
-        clearAllDirtyRects();
+        damage.clear();
     }
     
-    // Clear specific dirty rectangles
+    // Clear the damaged regions to a solid color
     void clearDirtyRects(uint16_t color = 0) {
         if (color == 0) color = ThemeManager::getBackground();
         
-        for (int i = 0; i < dirtyRectCount; i++) {
-            if (dirtyRects[i].isDirty) {
-                display->fillRect(dirtyRects[i].x, dirtyRects[i].y,
-                                 dirtyRects[i].width, dirtyRects[i].height,
-                                 color);
-            }
+        for (int i = 0; i < damage.getRectCount(); i++) {
+            const DamageTracker::Rect& r = damage.getRect(i);
+            display->fillRect(r.x, r.y, r.w, r.h, color);
         }
     }
     
     // Statistics
     int getFPS() const { return stats.fps; }
-    void resetStats() { stats.reset(); }
+    const RenderStats& getStats() const { return stats; }
+    void resetStats() { stats.reset(); damage.resetStats(); }
+    void printStats() const {
+        Serial.printf("RenderManager: %lu damaged px in %lu rects (%lu reported, %lu merges)\n",
+                      stats.damagedPixels, stats.damageRects,
+                      (unsigned long)damage.getRectsReported(),
+                      (unsigned long)damage.getMergeCount());
+    }
     
     // Debug helpers
     void drawDirtyRects(uint16_t color = ST77XX_RED) {
         #ifdef DEBUG_RENDER
-        for (int i = 0; i < dirtyRectCount; i++) {
-            if (dirtyRects[i].isDirty) {
-                display->drawRect(dirtyRects[i].x, dirtyRects[i].y,
-                                 dirtyRects[i].width, dirtyRects[i].height,
-                                 color);
-            }
+        for (int i = 0; i < damage.getRectCount(); i++) {
+            const DamageTracker::Rect& r = damage.getRect(i);
+            display->drawRect(r.x, r.y, r.w, r.h, color);
         }
         #endif
     }
@@ -194,6 +168,13 @@ public:
         return instance;
     }
     
+    // Report a changed screen area; no-op before initialize()
+    static void reportDamage(int x, int y, int width, int height) {
+        if (instance) {
+            instance->addDirtyRect(x, y, width, height);
+        }
+    }
+    
     static void cleanup() {
         delete instance;
         instance = nullptr;
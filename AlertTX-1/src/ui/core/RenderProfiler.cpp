@@ -0,0 +1,200 @@
+#include "RenderProfiler.h"
+#include "FrameScheduler.h"
+#include "OverdrawAnalyzer.h"
+#include <string.h>
+
+// Static member initialization
+bool RenderProfiler::enabled = true;
+RenderProfiler::ScreenStats RenderProfiler::screens[RenderProfiler::MAX_SCREENS];
+uint8_t RenderProfiler::screenCount = 0;
+RenderProfiler::SectionStats RenderProfiler::sections[RenderProfiler::MAX_SECTIONS];
+uint8_t RenderProfiler::sectionCount = 0;
+RenderProfiler::Counters RenderProfiler::outsideFrame;
+RenderProfiler::Counters* RenderProfiler::active = &RenderProfiler::outsideFrame;
+
+int8_t RenderProfiler::frameScreen = -1;
+unsigned long RenderProfiler::frameStartUs = 0;
+int8_t RenderProfiler::sectionIndex = -1;
+unsigned long RenderProfiler::sectionStartUs = 0;
+uint32_t RenderProfiler::sectionStartPixels = 0;
+
+// Bucket i tops out at 250us * 2^(i/4): quarter-octave steps, about 19%
+static const uint32_t HISTOGRAM_BASE_US = 250;
+static const uint8_t QUARTER_OCTAVE[4] = {128, 152, 181, 215};   // 2^(n/4) * 128
+
+void RenderProfiler::beginFrame(const char* screenName) {
+    if (!enabled) return;
+    frameScreen = findScreen(screenName);
+    active = (frameScreen >= 0) ? &screens[frameScreen].counters : &outsideFrame;
+    frameStartUs = micros();
+}
+
+void RenderProfiler::endFrame() {
+    if (!enabled) return;
+    if (frameScreen >= 0) {
+        addSample(screens[frameScreen], micros() - frameStartUs);
+    }
+    frameScreen = -1;
+    sectionIndex = -1;
+    active = &outsideFrame;
+}
+
+void RenderProfiler::beginSection(const char* name) {
+    // Sections double as overdraw call sites
+    OverdrawAnalyzer::beginSite(name);
+    if (!enabled || frameScreen < 0) return;
+    sectionIndex = findSection(frameScreen, name);
+    sectionStartPixels = active->pixels;
+    sectionStartUs = micros();
+}
+
+void RenderProfiler::endSection() {
+    OverdrawAnalyzer::endSite();
+    if (!enabled || sectionIndex < 0) return;
+    uint32_t us = micros() - sectionStartUs;
+    SectionStats& section = sections[sectionIndex];
+    section.calls++;
+    section.totalUs += us;
+    if (us > section.maxUs) section.maxUs = us;
+    section.pixels += active->pixels - sectionStartPixels;
+    sectionIndex = -1;
+}
+
+uint32_t RenderProfiler::getPercentileUs(const ScreenStats& stats, uint8_t percentile) {
+    if (stats.histogramTotal == 0) return 0;
+    // Smallest bucket that holds at least `percentile` % of the samples
+    uint32_t needed = ((uint32_t)stats.histogramTotal * percentile + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += stats.histogram[i];
+        if (seen >= needed) {
+            uint32_t upper = bucketUpperUs(i);
+            // The open-ended bucket (and any bucket holding the slowest frame)
+            // is better described by the real maximum
+            return (upper < stats.maxUs) ? upper : stats.maxUs;
+        }
+    }
+    return stats.maxUs;
+}
+
+const RenderProfiler::ScreenStats* RenderProfiler::getWorstScreen(uint8_t percentile) {
+    const ScreenStats* worst = nullptr;
+    uint32_t worstUs = 0;
+    for (uint8_t i = 0; i < screenCount; i++) {
+        uint32_t us = getPercentileUs(screens[i], percentile);
+        if (us > worstUs) {
+            worstUs = us;
+            worst = &screens[i];
+        }
+    }
+    return worst;
+}
+
+void RenderProfiler::printSummary() {
+    unsigned long budgetUs = FrameScheduler::getFrameInterval() * 1000UL;
+    Serial.printf("RenderProfiler (%u screens, budget %lu us):\n", screenCount, budgetUs);
+    for (uint8_t i = 0; i < screenCount; i++) {
+        const ScreenStats& s = screens[i];
+        if (s.frames == 0) continue;
+        Serial.printf("  %-14s %5lu frames  p50 %5lu  p95 %5lu  p99 %5lu  max %6lu us  over %lu\n",
+                      s.name, (unsigned long)s.frames,
+                      (unsigned long)getPercentileUs(s, 50), (unsigned long)getPercentileUs(s, 95),
+                      (unsigned long)getPercentileUs(s, 99), (unsigned long)s.maxUs,
+                      (unsigned long)s.overBudget);
+    }
+}
+
+void RenderProfiler::printReport() {
+    printSummary();
+    for (uint8_t i = 0; i < screenCount; i++) {
+        const ScreenStats& s = screens[i];
+        if (s.frames == 0) continue;
+        const Counters& c = s.counters;
+        Serial.printf("  %s: avg %lu us, %lu px, %lu tx, %lu windows, %lu fills, %lu pixel calls, %lu chars\n",
+                      s.name, (unsigned long)(s.totalUs / s.frames), (unsigned long)c.pixels,
+                      (unsigned long)c.transactions, (unsigned long)c.windows, (unsigned long)c.fillCalls,
+                      (unsigned long)c.pixelCalls, (unsigned long)c.textChars);
+        for (uint8_t j = 0; j < sectionCount; j++) {
+            const SectionStats& section = sections[j];
+            if (section.screen != i || section.calls == 0) continue;
+            Serial.printf("    %-18s %5lu calls  avg %5lu us  max %6lu us  %7lu px\n",
+                          section.name, (unsigned long)section.calls,
+                          (unsigned long)(section.totalUs / section.calls), (unsigned long)section.maxUs,
+                          (unsigned long)section.pixels);
+        }
+    }
+    const Counters& o = outsideFrame;
+    Serial.printf("  Outside frames: %lu px, %lu tx, %lu windows\n",
+                  (unsigned long)o.pixels, (unsigned long)o.transactions, (unsigned long)o.windows);
+}
+
+void RenderProfiler::reset() {
+    // Names stay so table slots keep their screens
+    for (uint8_t i = 0; i < screenCount; i++) {
+        const char* name = screens[i].name;
+        screens[i] = ScreenStats();
+        screens[i].name = name;
+    }
+    for (uint8_t i = 0; i < sectionCount; i++) {
+        SectionStats& section = sections[i];
+        section.calls = 0;
+        section.totalUs = 0;
+        section.maxUs = 0;
+        section.pixels = 0;
+    }
+    outsideFrame = Counters();
+}
+
+// Private helpers
+
+int8_t RenderProfiler::findScreen(const char* name) {
+    if (!name) return -1;
+    for (uint8_t i = 0; i < screenCount; i++) {
+        if (screens[i].name == name || strcmp(screens[i].name, name) == 0) return i;
+    }
+    if (screenCount >= MAX_SCREENS) return -1;
+    screens[screenCount].name = name;
+    return screenCount++;
+}
+
+int8_t RenderProfiler::findSection(uint8_t screen, const char* name) {
+    if (!name) return -1;
+    for (uint8_t i = 0; i < sectionCount; i++) {
+        if (sections[i].screen == screen &&
+            (sections[i].name == name || strcmp(sections[i].name, name) == 0)) return i;
+    }
+    if (sectionCount >= MAX_SECTIONS) return -1;
+    sections[sectionCount].name = name;
+    sections[sectionCount].screen = screen;
+    return sectionCount++;
+}
+
+uint32_t RenderProfiler::bucketUpperUs(uint8_t bucket) {
+    return ((HISTOGRAM_BASE_US << (bucket / 4)) * QUARTER_OCTAVE[bucket % 4]) >> 7;
+}
+
+uint8_t RenderProfiler::bucketFor(uint32_t us) {
+    for (uint8_t i = 0; i < HISTOGRAM_BUCKETS - 1; i++) {
+        if (us <= bucketUpperUs(i)) return i;
+    }
+    return HISTOGRAM_BUCKETS - 1;
+}
+
+void RenderProfiler::addSample(ScreenStats& stats, uint32_t us) {
+    stats.frames++;
+    stats.totalUs += us;
+    if (us > stats.maxUs) stats.maxUs = us;
+    if (us > FrameScheduler::getFrameInterval() * 1000UL) stats.overBudget++;
+
+    // Rolling window: halving keeps the shape of recent frames while older
+    // ones fade out
+    if (stats.histogramTotal >= HISTOGRAM_WINDOW) {
+        stats.histogramTotal = 0;
+        for (uint8_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            stats.histogram[i] /= 2;
+            stats.histogramTotal += stats.histogram[i];
+        }
+    }
+    stats.histogram[bucketFor(us)]++;
+    stats.histogramTotal++;
+}
@@ -0,0 +1,122 @@
+#ifndef RENDER_PROFILER_H
+#define RENDER_PROFILER_H
+
+#include <Arduino.h>
+
+/**
+ * RenderProfiler
+ *
+ * Attributes display work to the screen being drawn, and within a screen to
+ * the component or draw region that did it. Fed by DisplayDriver (every GFX
+ * primitive and address window), GlyphCache, Screen::draw and
+ * ScreenManager::draw.
+ *
+ * Features:
+ * - Per screen: frames, draw time, frames over the frame budget, pixels
+ *   written, SPI transactions, address windows, fill/pixel calls and
+ *   text characters
+ * - Rolling frame-time histogram per screen (quarter-octave buckets,
+ *   halved when full) for p50/p95/p99 without storing samples
+ * - Per component / draw region: calls, time and pixels
+ * - Work done outside a frame (e.g. the clear before a cut) is kept
+ *   separately instead of being charged to a screen
+ * - Fixed tables, no allocation; a disabled profiler costs one branch
+ *
+ * Query with printReport() (serial command "prof") or getWorstScreen()
+ * (SystemInfoScreen).
+ */
+
+class RenderProfiler {
+public:
+    static const uint8_t MAX_SCREENS = 12;
+    static const uint8_t MAX_SECTIONS = 32;
+    static const uint8_t HISTOGRAM_BUCKETS = 32;       // 250us .. ~54ms, last bucket open-ended
+    static const uint16_t HISTOGRAM_WINDOW = 512;      // Counts are halved at this many frames
+
+    struct Counters {
+        uint32_t pixels = 0;         // Pixels pushed (sum of address windows)
+        uint32_t windows = 0;        // Address windows set
+        uint32_t transactions = 0;   // Outermost startWrite/endWrite pairs
+        uint32_t fillCalls = 0;      // fillRect / fast line calls
+        uint32_t pixelCalls = 0;     // drawPixel / writePixel calls
+        uint32_t textChars = 0;      // Characters drawn (GlyphCache and print())
+    };
+
+    struct ScreenStats {
+        const char* name = nullptr;
+        uint32_t frames = 0;
+        uint32_t overBudget = 0;     // Frames longer than the frame interval
+        uint64_t totalUs = 0;
+        uint32_t maxUs = 0;
+        Counters counters;
+        uint16_t histogram[HISTOGRAM_BUCKETS] = {0};
+        uint16_t histogramTotal = 0;
+    };
+
+    struct SectionStats {
+        const char* name = nullptr;
+        uint8_t screen = 0;          // Index into the screen table
+        uint32_t calls = 0;
+        uint32_t totalUs = 0;
+        uint32_t maxUs = 0;
+        uint32_t pixels = 0;
+    };
+
+    // Configuration
+    static void setEnabled(bool on) { enabled = on; }
+    static bool isEnabled() { return enabled; }
+
+    // Frame attribution (ScreenManager::draw)
+    static void beginFrame(const char* screenName);
+    static void endFrame();
+
+    // Section attribution (Screen::draw); sections do not nest
+    static void beginSection(const char* name);
+    static void endSection();
+
+    // Driver hooks
+    static void countWindow(uint32_t pixels) {
+        if (!enabled) return;
+        active->pixels += pixels;
+        active->windows++;
+    }
+    static void countTransaction() { if (enabled) active->transactions++; }
+    static void countFill() { if (enabled) active->fillCalls++; }
+    static void countPixelCall() { if (enabled) active->pixelCalls++; }
+    static void countText(uint16_t chars) { if (enabled) active->textChars += chars; }
+
+    // Queries
+    static uint8_t getScreenCount() { return screenCount; }
+    static const ScreenStats* getScreen(uint8_t index) { return index < screenCount ? &screens[index] : nullptr; }
+    static const Counters& getOutsideFrame() { return outsideFrame; }
+    static uint32_t getPercentileUs(const ScreenStats& stats, uint8_t percentile);
+    static const ScreenStats* getWorstScreen(uint8_t percentile = 95);
+
+    // Reporting
+    static void printSummary();      // One line per screen
+    static void printReport();       // Screens plus their sections
+    static void reset();
+
+private:
+    static bool enabled;
+    static ScreenStats screens[MAX_SCREENS];
+    static uint8_t screenCount;
+    static SectionStats sections[MAX_SECTIONS];
+    static uint8_t sectionCount;
+    static Counters outsideFrame;
+    static Counters* active;         // Where driver hooks count right now
+
+    static int8_t frameScreen;
+    static unsigned long frameStartUs;
+    static int8_t sectionIndex;
+    static unsigned long sectionStartUs;
+    static uint32_t sectionStartPixels;
+
+    static int8_t findScreen(const char* name);
+    static int8_t findSection(uint8_t screen, const char* name);
+    static uint8_t bucketFor(uint32_t us);
+    static uint32_t bucketUpperUs(uint8_t bucket);
+    static void addSample(ScreenStats& stats, uint32_t us);
+};
+
+#endif // RENDER_PROFILER_H
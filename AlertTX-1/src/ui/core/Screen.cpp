@@ -65,7 +65,9 @@ void Screen::draw() {
     
     // Full screen redraw if needed
     if (needsFullRedraw) {
+        RenderProfiler::beginSection("clear");
         clearScreen();
+        RenderProfiler::endSection();
         needsFullRedraw = false;
         
         // Mark all components dirty for redraw
@@ -79,13 +81,24 @@ void Screen::draw() {
         for (int i = 0; i < drawRegionCount; i++) {
             drawRegions[i].needsRedraw = true;
         }
+        
+        RenderManager* renderManager = GlobalRenderManager::getInstance();
+        if (renderManager) {
+            renderManager->markFullScreenDirty();
+        }
+    } else {
+        RenderProfiler::beginSection("damage repair");
+        repairDamage();
+        RenderProfiler::endSection();
     }
     
     // Draw direct regions first (static before dynamic)
     for (int i = 0; i < drawRegionCount; i++) {
         if (drawRegions[i].type == DirectDrawRegion::STATIC && 
             drawRegions[i].needsRedraw && drawRegions[i].drawFunc) {
+            RenderProfiler::beginSection("static region");
             drawRegions[i].drawFunc();
+            RenderProfiler::endSection();
             drawRegions[i].needsRedraw = false;
         }
     }
@@ -93,7 +106,9 @@ void Screen::draw() {
     // Draw all visible components that need redrawing
     for (int i = 0; i < componentCount; i++) {
         if (components[i] && components[i]->isVisible() && components[i]->isDirty()) {
+            RenderProfiler::beginSection(components[i]->getName());
             components[i]->draw();
+            RenderProfiler::endSection();
             components[i]->clearDirty();
         }
     }
@@ -102,12 +117,36 @@ void Screen::draw() {
     for (int i = 0; i < drawRegionCount; i++) {
         if (drawRegions[i].type == DirectDrawRegion::DYNAMIC && 
             drawRegions[i].needsRedraw && drawRegions[i].drawFunc) {
+            RenderProfiler::beginSection("dynamic region");
             drawRegions[i].drawFunc();
+            RenderProfiler::endSection();
             drawRegions[i].needsRedraw = false;
         }
     }
 }
 
+bool Screen::needsDraw() const {
+    if (!active) return false;
+    if (needsFullRedraw) return true;
+    
+    RenderManager* renderManager = GlobalRenderManager::getInstance();
+    if (renderManager && renderManager->needsRedraw()) return true;
+    
+    for (int i = 0; i < drawRegionCount; i++) {
+        if (drawRegions[i].needsRedraw && drawRegions[i].drawFunc) {
+            return true;
+        }
+    }
+    
+    for (int i = 0; i < componentCount; i++) {
+        if (components[i] && components[i]->isVisible() && components[i]->isDirty()) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
 bool Screen::addComponent(Component* component) {
     if (!component) {
         Serial.printf("ERROR: Attempted to add null component to screen '%s'\n", screenName);
@@ -216,6 +255,44 @@ void Screen::printComponents() const {
 
 // Protected helper methods
 
+void Screen::repairDamage() {
+    RenderManager* renderManager = GlobalRenderManager::getInstance();
+    if (!renderManager || componentCount == 0) return;
+    
+    const DamageTracker& damage = renderManager->getDamage();
+    for (int d = 0; d < damage.getRectCount(); d++) {
+        const DamageTracker::Rect& r = damage.getRect(d);
+        bool ownedByComponent = false;
+        
+        for (int i = 0; i < componentCount; i++) {
+            Component* c = components[i];
+            if (!c || !c->isVisible() || !c->intersects(r.x, r.y, r.w, r.h)) continue;
+            
+            c->markNeedsRepaint();
+            if (r.x >= c->getX() && r.y >= c->getY() &&
+                r.x + r.w <= c->getX() + c->getWidth() &&
+                r.y + r.h <= c->getY() + c->getHeight()) {
+                ownedByComponent = true;
+            }
+        }
+        
+        // Area left behind by a moved/hidden component: nothing repaints it
+        if (!ownedByComponent) {
+            display->fillRect(r.x, r.y, r.w, r.h, ThemeManager::getBackground());
+        }
+    }
+}
+
+void Screen::invalidateRect(int x, int y, int w, int h) {
+    GlobalRenderManager::reportDamage(x, y, w, h);
+    FrameScheduler::requestFrame();
+}
+
+bool Screen::isRectDamaged(int x, int y, int w, int h) const {
+    RenderManager* renderManager = GlobalRenderManager::getInstance();
+    return !renderManager || renderManager->isDamaged(x, y, w, h);
+}
+
 void Screen::clearScreen() {
     if (display) {
         display->fillScreen(ThemeManager::getBackground());
@@ -312,6 +389,7 @@ void Screen::markRegionDirty(DirectDrawRegion::Type type) {
             drawRegions[i].needsRedraw = true;
         }
     }
+    FrameScheduler::requestFrame();
 }
 
 void Screen::clearRegionDirty(DirectDrawRegion::Type type) {
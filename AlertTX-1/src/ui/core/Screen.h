@@ -8,6 +8,8 @@
 #include "Component.h"
 #include "Theme.h"
 #include "RenderManager.h"
+#include "FrameScheduler.h"
+#include "RenderProfiler.h"
 
 /**
  * Screen Base Class
@@ -20,6 +22,11 @@
  * - Fixed array of component pointers (no dynamic allocation)
  * - Minimal per-screen overhead
  * - Automatic component cleanup
+ * 
+ * Damage repair: each frame, components that intersect a damage rect
+ * (RenderManager) are repainted, and damage no visible component owns is
+ * cleared to the background. Direct-draw regions can call invalidateRect()
+ * and isRectDamaged() to repaint only their changed parts.
  */
 
 class Screen {
@@ -33,6 +40,7 @@ protected:
     
     // Screen state
     bool active = false;
+    bool covered = false;           // Under a pushed screen, see isCovered()
     bool needsFullRedraw = true;
     const char* screenName;
     
@@ -60,6 +68,15 @@ public:
     virtual void exit();    // Called when leaving screen
     virtual void update();  // Update all components (call in main loop)
     virtual void draw();    // Draw all components
+    virtual bool needsDraw() const;  // True when anything on screen is dirty
+    
+    // Slide transitions repaint the screen strip by strip through full
+    // redraws; screens that draw outside draw() (games) opt out
+    virtual bool supportsSlideTransition() const { return true; }
+
+    // Alerts below critical stay quiet (row only, no popup or ringtone)
+    // while this screen is up; games keep the screen to themselves
+    virtual bool holdsAlerts() const { return false; }
     
     // Input handling - must be implemented by subclasses
     virtual void handleButtonPress(int button) = 0;
@@ -74,12 +91,18 @@ public:
     // Screen state management
     bool isActive() const { return active; }
     void setActive(bool active);
+    // Set by ScreenManager while a pushed screen is on top of this one: the
+    // exit() on push and the enter() on pop then bracket a pause, not a
+    // visit, so a screen can keep its state (a song held, not stopped)
+    bool isCovered() const { return covered; }
+    void setCovered(bool covered) { this->covered = covered; }
     void markForFullRedraw() { 
         needsFullRedraw = true; 
         // Mark all regions as dirty
         for (auto& region : drawRegions) {
             region.needsRedraw = true;
         }
+        FrameScheduler::requestFrame();
     }
     
     // Direct drawing support for screens that don't use components
@@ -107,6 +130,11 @@ protected:
     void clearScreen();
     void drawTitle(const char* title, int x = 30, int y = 20);
     
+    // Damage helpers
+    void repairDamage();
+    void invalidateRect(int x, int y, int w, int h);
+    bool isRectDamaged(int x, int y, int w, int h) const;
+    
     // Component search helpers
     Component* findComponentByName(const char* name) const;
     int findComponentIndex(Component* component) const;
@@ -1,5 +1,6 @@
 #include "ScreenManager.h"
 #include "Theme.h"
+#include "OverdrawAnalyzer.h"
 
 // Initialize static member
 ScreenManager* GlobalScreenManager::instance = nullptr;
@@ -21,16 +22,22 @@ ScreenManager::ScreenManager(Adafruit_ST7789* display) : display(display) {
     Serial.println("ScreenManager initialized");
 }
 
+ScreenManager::ScreenManager(DisplayDriver* display)
+    : ScreenManager(static_cast<Adafruit_ST7789*>(display)) {
+    driver = display;
+}
+
 ScreenManager::~ScreenManager() {
+    if (hardwareTransition) {
+        driver->endScroll();
+    }
     clearStack();
     GlobalScreenManager::setInstance(nullptr);
     Serial.println("ScreenManager destroyed");
 }
 
 void ScreenManager::update() {
-    if (!shouldUpdate()) return;
-    
-    lastUpdateTime = millis();
+    if (!FrameScheduler::isFrameDue(lastUpdateTime)) return;
     
     // Update transition if in progress
     if (inTransition) {
@@ -44,17 +51,38 @@ void ScreenManager::update() {
 }
 
 void ScreenManager::draw() {
-    if (!shouldDraw()) return;
+    if (!shouldDraw()) {
+        FrameScheduler::frameSkipped();
+        return;
+    }
     
+    unsigned long startUs = micros();
     lastDrawTime = millis();
     
+    RenderManager* renderManager = GlobalRenderManager::getInstance();
+    if (renderManager) renderManager->beginFrame();
+    RenderProfiler::beginFrame(currentScreen ? currentScreen->getName() : nullptr);
+    
     if (inTransition) {
         drawTransition();
     } else if (currentScreen) {
         drawScreen(currentScreen);
     }
     
+    // Damage is consumed once the frame is out
+    if (renderManager) renderManager->endFrame();
+    RenderProfiler::endFrame();
+    OverdrawAnalyzer::endFrame();
     needsRedraw = false;
+    lastDrawDurationUs = micros() - startUs;
+    FrameScheduler::framePresented(lastDrawDurationUs);
+    
+    // Anything dirtied while drawing goes out on the next pass (a slide
+    // keeps the new screen dirty until its last strip; that is paced by
+    // updateTransition instead)
+    if (!hardwareTransition && currentScreen && currentScreen->needsDraw()) {
+        FrameScheduler::requestFrame();
+    }
 }
 
 bool ScreenManager::pushScreen(Screen* screen, bool takeOwnership) {
@@ -68,8 +96,11 @@ bool ScreenManager::pushScreen(Screen* screen, bool takeOwnership) {
         return false;
     }
     
-    // Exit current screen if any
+    bool slide = canSlideTo(screen);
+    
+    // Exit current screen if any; it comes back on pop
     if (currentScreen) {
+        currentScreen->setCovered(true);
         currentScreen->exit();
     }
     
@@ -79,9 +110,9 @@ bool ScreenManager::pushScreen(Screen* screen, bool takeOwnership) {
         return false;
     }
     
-    // Set new current screen
-    setCurrentScreen(screen, takeOwnership);
-    startTransition();
+    // Set new current screen; a slide keeps the old one on the glass
+    setCurrentScreen(screen, takeOwnership, !slide);
+    startTransition(slide ? 1 : 0);
     
     Serial.printf("Pushed screen '%s' (stack size: %d)\n", screen->getName(), stackSize);
     return true;
@@ -93,6 +124,8 @@ bool ScreenManager::popScreen() {
         return false;
     }
     
+    bool slide = canSlideTo(screenStack[stackSize - 1]);
+    
     // Exit current screen
     if (currentScreen) {
         currentScreen->exit();
@@ -109,9 +142,11 @@ bool ScreenManager::popScreen() {
         return false;
     }
     
-    // Set previous screen as current
-    setCurrentScreen(previousScreen, ownedPrev);
-    startTransition();
+    // Set previous screen as current; it enters still covered, to pick up
+    // where it left off
+    setCurrentScreen(previousScreen, ownedPrev, !slide);
+    previousScreen->setCovered(false);
+    startTransition(slide ? -1 : 0);
     
     Serial.printf("Popped to screen '%s' (stack size: %d)\n", 
                  previousScreen->getName(), stackSize);
@@ -124,6 +159,8 @@ bool ScreenManager::switchToScreen(Screen* screen) {
         return false;
     }
     
+    bool slide = canSlideTo(screen);
+    
     // Exit current screen
     if (currentScreen) {
         currentScreen->exit();
@@ -134,8 +171,8 @@ bool ScreenManager::switchToScreen(Screen* screen) {
     }
     
     // Don't push to stack - just replace
-    setCurrentScreen(screen, false /*owned*/);
-    startTransition();
+    setCurrentScreen(screen, false /*owned*/, !slide);
+    startTransition(slide ? 1 : 0);
     
     Serial.printf("Switched to screen '%s'\n", screen->getName());
     return true;
@@ -157,6 +194,7 @@ void ScreenManager::clearStack() {
     // Clear stack, deleting owned screens
     for (int i = 0; i < stackSize; i++) {
         if (screenStack[i]) {
+            screenStack[i]->setCovered(false);
             if (ownedStack[i]) {
                 screenStack[i]->exit();
                 delete screenStack[i];
@@ -201,9 +239,8 @@ void ScreenManager::handleButtonLongPress(int button) {
 }
 
 void ScreenManager::setTransitionDuration(unsigned long duration) {
-    // Could make TRANSITION_DURATION non-const for this to work
-    // For now, just log the request
-    Serial.printf("Transition duration change requested: %lu ms\n", duration);
+    transitionDuration = duration;
+    Serial.printf("Transition duration set to %lu ms\n", duration);
 }
 
 void ScreenManager::printStackState() const {
@@ -221,9 +258,12 @@ void ScreenManager::printPerformanceStats() const {
     unsigned long now = millis();
     Serial.printf("ScreenManager performance:\n");
     Serial.printf("  Last update: %lu ms ago\n", now - lastUpdateTime);
-    Serial.printf("  Last draw: %lu ms ago\n", now - lastDrawTime);
-    Serial.printf("  Update interval: %lu ms\n", UPDATE_INTERVAL);
+    Serial.printf("  Last draw: %lu ms ago (%lu us)\n", now - lastDrawTime, lastDrawDurationUs);
+    Serial.printf("  Frame interval: %lu ms\n", FrameScheduler::getFrameInterval());
     Serial.printf("  In transition: %s\n", inTransition ? "true" : "false");
+    Serial.printf("  Transitions: %s, %lu ms%s\n",
+                 transitionStyle == TRANSITION_SLIDE ? "slide" : "cut", transitionDuration,
+                 driver ? "" : " (no hardware scroll)");
 }
 
 bool ScreenManager::validate() const {
@@ -270,46 +310,130 @@ Screen* ScreenManager::popFromStack(bool& ownedOut) {
     return screen;
 }
 
-void ScreenManager::setCurrentScreen(Screen* screen, bool owned) {
+void ScreenManager::setCurrentScreen(Screen* screen, bool owned, bool clearDisplay) {
     currentScreen = screen;
     currentOwned = owned;
     if (currentScreen) {
         // Clear display before entering the new screen to avoid remnants
-        if (display) {
+        if (display && clearDisplay) {
+            OverdrawAnalyzer::beginSite("screen change clear");
             display->fillScreen(ThemeManager::getBackground());
+            OverdrawAnalyzer::endSite();
         }
         currentScreen->enter();
         needsRedraw = true;
     }
 }
 
-void ScreenManager::startTransition() {
+bool ScreenManager::canSlideTo(Screen* screen) {
+    // A slide that is still running has the glass half old, half new; the
+    // next screen then starts from a clean cut instead
+    bool interrupted = hardwareTransition;
+    if (hardwareTransition) {
+        driver->endScroll();
+        hardwareTransition = false;
+    }
+    
+    return driver && driver->canScroll() && !interrupted &&
+           transitionStyle == TRANSITION_SLIDE && transitionDuration > 0 &&
+           currentScreen && screen && screen->supportsSlideTransition();
+}
+
+void ScreenManager::startTransition(int8_t direction) {
     inTransition = true;
     transitionStartTime = millis();
+    transitionDirection = direction;
+    transitionRevealed = 0;
+    transitionStrips = 0;
+    hardwareTransition = direction != 0 && driver->beginScroll();
     needsRedraw = true;
+    FrameScheduler::requestFrame();
+    FrameScheduler::wakeAt(transitionStartTime + transitionDuration);
     // After transition completes, we will set a small input cooldown
     
-    Serial.println("Started screen transition");
+    Serial.printf("Started screen transition (%s)\n", hardwareTransition ? "slide" : "cut");
 }
 
 void ScreenManager::updateTransition() {
-    if (isTransitionComplete()) {
+    if (hardwareTransition) {
+        // One strip per frame until the new screen is fully on the glass
+        needsRedraw = true;
+        FrameScheduler::wakeWithin(FrameScheduler::getFrameInterval());
+    } else if (!isTransitionComplete()) {
+        FrameScheduler::wakeAt(transitionStartTime + transitionDuration);
+    } else {
         inTransition = false;
         needsRedraw = true;
         inputCooldownUntilMs = millis() + INPUT_COOLDOWN_MS;
-        Serial.println("Completed screen transition");
+        if (transitionStrips > 0) {
+            Serial.printf("Completed screen transition (%u strips)\n", transitionStrips);
+        } else {
+            Serial.println("Completed screen transition");
+        }
     }
 }
 
 bool ScreenManager::isTransitionComplete() const {
-    return (millis() - transitionStartTime) >= TRANSITION_DURATION;
+    return (millis() - transitionStartTime) >= transitionDuration;
+}
+
+float ScreenManager::applyEasing(float t) const {
+    switch (transitionEasing) {
+        case EASE_OUT: {
+            float u = 1.0f - t;
+            return 1.0f - u * u * u;
+        }
+        case EASE_IN_OUT: {
+            if (t < 0.5f) return 4.0f * t * t * t;
+            float u = 2.0f - 2.0f * t;
+            return 1.0f - u * u * u / 2.0f;
+        }
+        default:
+            return t;
+    }
 }
 
 void ScreenManager::drawTransition() {
-    // Simple fade transition - just draw current screen
-    // Could implement more sophisticated transitions here
-    if (currentScreen) {
+    if (!currentScreen) return;
+    if (!hardwareTransition) {
+        // Cut: the screen was cleared on entry, draw it as usual
         drawScreen(currentScreen);
+        return;
+    }
+    
+    // How far the slide should be by now, in columns
+    const int16_t span = driver->getScrollLength();
+    unsigned long elapsed = millis() - transitionStartTime;
+    int16_t target = span;
+    if (elapsed < transitionDuration) {
+        float t = (float)elapsed / (float)transitionDuration;
+        target = (int16_t)(applyEasing(t) * span + 0.5f);
+    }
+    
+    if (target > transitionRevealed) {
+        // Both screens sit at their normal positions in controller RAM.
+        // Rotating the scroll ring by `target` moves the old screen off one
+        // edge and wraps the columns it vacates in at the other; exactly
+        // those columns of the new screen are drawn, clipped to the strip.
+        int16_t x0 = (transitionDirection > 0) ? transitionRevealed : span - target;
+        driver->setScrollOffset(transitionDirection > 0 ? target : -target);
+        
+        DisplayDriver::setClip(x0, 0, target - transitionRevealed, display->height());
+        currentScreen->markForFullRedraw();
+        drawScreen(currentScreen);
+        DisplayDriver::clearClip();
+        
+        transitionRevealed = target;
+        transitionStrips++;
+    }
+    
+    if (transitionRevealed >= span) {
+        // Ring rotated all the way round: RAM and glass line up again
+        driver->endScroll();
+        hardwareTransition = false;
+        // Finish the transition on the next pass rather than whenever the
+        // next input arrives (which would then land in the cooldown)
+        FrameScheduler::wakeAt(millis());
     }
 }
 
@@ -319,14 +443,12 @@ void ScreenManager::drawScreen(Screen* screen) {
     }
 }
 
-bool ScreenManager::shouldUpdate() const {
-    unsigned long now = millis();
-    return (now - lastUpdateTime) >= UPDATE_INTERVAL;
-}
-
 bool ScreenManager::shouldDraw() const {
-    return needsRedraw || inTransition || 
-           (currentScreen && currentScreen->isActive());
+    // Present only when something changed; an idle screen costs nothing.
+    // During a slide the new screen stays dirty until its last strip, so
+    // only the transition's own frame requests count.
+    if (hardwareTransition) return needsRedraw;
+    return needsRedraw || (currentScreen && currentScreen->needsDraw());
 }
 
 bool ScreenManager::isValidScreen(Screen* screen) const {
@@ -5,6 +5,8 @@
 #include <Adafruit_ST7789.h>
 #include <Arduino.h>
 #include "Screen.h"
+#include "FrameScheduler.h"
+#include "DisplayDriver.h"
 
 /**
  * ScreenManager
@@ -16,13 +18,31 @@
  * - Stack-based navigation (push/pop screens)
  * - Automatic screen lifecycle management
  * - Memory efficient (fixed arrays)
- * - Transition support
+ * - Slide transitions on the panel's hardware scroll: the old screen is
+ *   scrolled off while the new one is drawn in strip by strip, so no frame
+ *   repaints the whole panel (needs a DisplayDriver, landscape only)
+ * - Configurable transition duration and easing
  * - Global input routing
+ * - Frames presented only when the current screen is dirty (FrameScheduler)
+ * - Frame time and bus traffic charged to the current screen (RenderProfiler)
  */
 
 class ScreenManager {
+public:
+    enum TransitionStyle {
+        TRANSITION_NONE,    // Cut: clear and draw the new screen at once
+        TRANSITION_SLIDE    // Push slides left, pop slides right
+    };
+
+    enum TransitionEasing {
+        EASE_LINEAR,
+        EASE_OUT,           // Cubic: fast start, settles gently
+        EASE_IN_OUT         // Cubic: gentle at both ends
+    };
+
 private:
     Adafruit_ST7789* display;
+    DisplayDriver* driver = nullptr;    // Set when hardware scroll is available
     
     // Screen stack (fixed array for memory efficiency)
     static const int MAX_SCREEN_STACK = 8;  // Maximum navigation depth
@@ -36,20 +56,28 @@ private:
     bool needsRedraw = true;
     
     // Transition management
+    static const unsigned long DEFAULT_TRANSITION_MS = 200;
     bool inTransition = false;
+    bool hardwareTransition = false;    // Slide in progress on the scroll registers
+    int8_t transitionDirection = 0;     // +1 content moves left, -1 right, 0 cut
+    int16_t transitionRevealed = 0;     // Columns of the new screen drawn so far
+    uint16_t transitionStrips = 0;      // Strips drawn for the current slide
     unsigned long transitionStartTime = 0;
-    static const unsigned long TRANSITION_DURATION = 200;  // 200ms transitions
+    unsigned long transitionDuration = DEFAULT_TRANSITION_MS;
+    TransitionStyle transitionStyle = TRANSITION_SLIDE;
+    TransitionEasing transitionEasing = EASE_OUT;
     // Global input cooldown after navigation to prevent stale presses
     unsigned long inputCooldownUntilMs = 0;
     static const unsigned long INPUT_COOLDOWN_MS = 300;
     
-    // Performance tracking
+    // Performance tracking (update pacing comes from FrameScheduler)
     unsigned long lastUpdateTime = 0;
     unsigned long lastDrawTime = 0;
-    static const unsigned long UPDATE_INTERVAL = 16;  // ~60 FPS
+    unsigned long lastDrawDurationUs = 0;
     
 public:
     ScreenManager(Adafruit_ST7789* display);
+    ScreenManager(DisplayDriver* display);    // Enables slide transitions
     ~ScreenManager();
     
     // Core update loop (call from main Arduino loop)
@@ -73,11 +101,15 @@ public:
     void handleButtonLongPress(int button);
     
     // Force redraw
-    void invalidate() { needsRedraw = true; }
+    void invalidate() { needsRedraw = true; FrameScheduler::requestFrame(); }
     
     // Transition control
     bool isInTransition() const { return inTransition; }
-    void setTransitionDuration(unsigned long duration);
+    void setTransitionDuration(unsigned long duration);   // 0 = always cut
+    unsigned long getTransitionDuration() const { return transitionDuration; }
+    void setTransitionStyle(TransitionStyle style) { transitionStyle = style; }
+    TransitionStyle getTransitionStyle() const { return transitionStyle; }
+    void setTransitionEasing(TransitionEasing easing) { transitionEasing = easing; }
     
     // Performance monitoring
     void printStackState() const;
@@ -90,19 +122,20 @@ private:
     // Stack management helpers
     bool pushToStack(Screen* screen, bool owned);
     Screen* popFromStack(bool& ownedOut);
-    void setCurrentScreen(Screen* screen, bool owned);
+    void setCurrentScreen(Screen* screen, bool owned, bool clearDisplay = true);
     
     // Transition management
-    void startTransition();
+    bool canSlideTo(Screen* screen);
+    void startTransition(int8_t direction = 0);
     void updateTransition();
     bool isTransitionComplete() const;
+    float applyEasing(float t) const;
     
     // Drawing helpers
     void drawTransition();
     void drawScreen(Screen* screen);
     
     // Performance helpers
-    bool shouldUpdate() const;
     bool shouldDraw() const;
     
     // Validation helpers
@@ -1,17 +1,13 @@
 #include "StandardGameLayout.h"
+#include "DisplayUtils.h"
 
 bool StandardGameLayout::isHeaderDirty = true;
 bool StandardGameLayout::isPlayAreaDirty = true;
 
 static void drawCenteredTitle(Adafruit_ST7789* display, const char* title, int y) {
     if (!display || !title) return;
-    display->setTextColor(ThemeManager::getPrimaryText());
-    display->setTextSize(2);
-    int16_t x1, y1; uint16_t w, h;
-    display->getTextBounds(title, 0, 0, &x1, &y1, &w, &h);
-    int x = (DISPLAY_WIDTH - (int)w) / 2;
-    display->setCursor(x, y);
-    display->print(title);
+    DisplayUtils::centerTextWithColor(display, title, 2, y,
+                                      ThemeManager::getPrimaryText(), ThemeManager::getBackground());
 }
 
 void StandardGameLayout::drawGameHeader(Adafruit_ST7789* display, const char* title, int score, const char* scoreLabel) {
@@ -24,13 +20,9 @@ void StandardGameLayout::drawGameHeader(Adafruit_ST7789* display, const char* ti
 
     // Optional score line near bottom of header
     if (score >= 0) {
-        display->setTextColor(ThemeManager::getPrimaryText());
-        display->setTextSize(1);
-        int y = HEADER_HEIGHT - 7;
-        display->setCursor(10, y);
-        display->print(scoreLabel ? scoreLabel : "Score");
-        display->print(": ");
-        display->print(score);
+        char line[32];
+        snprintf(line, sizeof(line), "%s: %d", scoreLabel ? scoreLabel : "Score", score);
+        DisplayUtils::drawText(display, line, 10, HEADER_HEIGHT - 7, 1, ThemeManager::getPrimaryText(), bg);
     }
 
     isHeaderDirty = false;
@@ -0,0 +1,150 @@
+#include "TextLayout.h"
+#include "DisplayUtils.h"
+#include "GlyphCache.h"
+#include <string.h>
+
+static const uint8_t ELLIPSIS_CHARS = 3;
+
+void TextLayout::setText(const char* newText, int maxWidth, uint8_t size, uint8_t maxLines) {
+    clear();
+    text = newText;
+    textSize = size;
+    if (!text) return;
+
+    const int maxChars = charsPerLine(maxWidth, size);
+    const uint8_t limit = (maxLines < MAX_LINES) ? maxLines : MAX_LINES;
+    if (limit == 0) return;
+
+    int pos = 0;
+    while (text[pos]) {
+        if (lineCount == limit) {
+            // Only whitespace left: nothing was actually cut off
+            int rest = pos;
+            while (text[rest] == ' ' || text[rest] == '\n' || text[rest] == '\r') rest++;
+            if (text[rest]) {
+                truncated = true;
+                addEllipsis(text, lines[lineCount - 1], maxChars);
+            }
+            break;
+        }
+
+        // Scan forward until the line is full or ends, remembering the last
+        // space so the break can fall on a word boundary
+        int len = 0;
+        int lastSpace = -1;
+        while (text[pos + len] && text[pos + len] != '\n' && len < maxChars) {
+            if (text[pos + len] == ' ') lastSpace = len;
+            len++;
+        }
+
+        int lineLen = len;
+        int next = pos + len;
+        char stop = text[next];
+        if (stop == '\n') {
+            next++;
+        } else if (stop == ' ') {
+            next++;
+        } else if (stop && lastSpace > 0) {
+            lineLen = lastSpace;
+            next = pos + lastSpace + 1;
+        }
+
+        // Trailing spaces are never drawn
+        while (lineLen > 0 && (text[pos + lineLen - 1] == ' ' || text[pos + lineLen - 1] == '\r')) lineLen--;
+
+        Span& line = lines[lineCount++];
+        line.start = pos;
+        line.length = lineLen;
+
+        // A wrapped line does not start with the spaces it wrapped on
+        if (stop != '\n') {
+            while (text[next] == ' ') next++;
+        }
+        pos = next;
+    }
+}
+
+void TextLayout::clear() {
+    text = nullptr;
+    lineCount = 0;
+    truncated = false;
+}
+
+int TextLayout::getLineWidth(uint8_t index) const {
+    if (index >= lineCount) return 0;
+    return spanWidth(lines[index], textSize);
+}
+
+int TextLayout::drawLines(Adafruit_ST7789* display, uint8_t first, uint8_t count, int x, int y,
+                          int lineSpacing, uint16_t fg, uint16_t bg) const {
+    for (uint8_t i = first; i < lineCount && i - first < count; i++) {
+        drawLine(display, i, x, y, fg, bg);
+        y += lineSpacing;
+    }
+    return y;
+}
+
+int TextLayout::drawLine(Adafruit_ST7789* display, uint8_t index, int x, int y, uint16_t fg, uint16_t bg) const {
+    if (!text || index >= lineCount) return 0;
+    return drawSpan(display, text, lines[index], x, y, textSize, fg, bg);
+}
+
+TextLayout::Span TextLayout::fitLine(const char* text, int maxWidth, uint8_t size) {
+    Span span;
+    if (!text) return span;
+
+    const int maxChars = charsPerLine(maxWidth, size);
+    int len = 0;
+    while (text[len] && text[len] != '\n' && len < maxChars) len++;
+    span.length = len;
+
+    // Anything left on this line means it did not fit
+    if (text[len] && text[len] != '\n') {
+        addEllipsis(text, span, maxChars);
+    }
+    return span;
+}
+
+int TextLayout::spanWidth(const Span& span, uint8_t size) {
+    int chars = span.length + (span.ellipsis ? ELLIPSIS_CHARS : 0);
+    return chars * GlyphCache::GLYPH_WIDTH * size;
+}
+
+int TextLayout::drawSpan(Adafruit_ST7789* display, const char* text, const Span& span,
+                         int x, int y, uint8_t size, uint16_t fg, uint16_t bg) {
+    if (!display || !text) return 0;
+
+    // Copy into a terminated buffer so the line (and its ellipsis) goes out
+    // as a single string
+    char buffer[MAX_LINE_CHARS + ELLIPSIS_CHARS + 1];
+    int len = (span.length < MAX_LINE_CHARS) ? span.length : MAX_LINE_CHARS;
+    memcpy(buffer, text + span.start, len);
+    if (span.ellipsis) {
+        memcpy(buffer + len, "...", ELLIPSIS_CHARS);
+        len += ELLIPSIS_CHARS;
+    }
+    buffer[len] = '\0';
+    if (len == 0) return 0;
+
+    DisplayUtils::drawText(display, buffer, x, y, size, fg, bg);
+    return len * GlyphCache::GLYPH_WIDTH * size;
+}
+
+// Private helpers
+
+int TextLayout::charsPerLine(int maxWidth, uint8_t size) {
+    int chars = maxWidth / (GlyphCache::GLYPH_WIDTH * (size ? size : 1));
+    if (chars < 1) chars = 1;
+    if (chars > MAX_LINE_CHARS) chars = MAX_LINE_CHARS;
+    return chars;
+}
+
+void TextLayout::addEllipsis(const char* text, Span& span, int maxChars) {
+    // Make room for "..." and do not leave a dangling space before it
+    int room = maxChars - ELLIPSIS_CHARS;
+    if (room < 0) room = 0;
+    int len = (span.length < room) ? span.length : room;
+    while (len > 0 && text[span.start + len - 1] == ' ') len--;
+    span.length = len;
+    span.ellipsis = true;
+}
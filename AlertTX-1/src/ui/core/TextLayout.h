@@ -0,0 +1,72 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <Adafruit_ST7789.h>
+#include <Arduino.h>
+
+/**
+ * TextLayout
+ *
+ * Breaks text into lines once, when the text is set, and keeps the result
+ * as a compact array of (offset, length) spans into the caller's string.
+ * Views then draw any range of lines without measuring anything again.
+ *
+ * Features:
+ * - Greedy word wrap: breaks at the last space that fits, hard-breaks words
+ *   longer than a line, honours '\n'
+ * - Ellipsis on the last line when the text needs more lines than allowed
+ * - Single-line fitting (fitLine) for list rows and popups
+ * - Linear time: the classic font is fixed-pitch, so width is chars x cell
+ * - Lines are drawn opaque through DisplayUtils::drawText (one window each)
+ *
+ * The layout does not copy the text. The string passed to setText() must
+ * stay unchanged for as long as the layout is used.
+ */
+
+class TextLayout {
+public:
+    static const uint8_t MAX_LINES = 12;
+    static const uint8_t MAX_LINE_CHARS = 64;   // wider than the panel at size 1
+
+    // A run of characters drawn as one line, optionally followed by "..."
+    struct Span {
+        uint16_t start = 0;
+        uint8_t length = 0;
+        bool ellipsis = false;
+    };
+
+    // Lay out text within maxWidth pixels, using at most maxLines lines
+    void setText(const char* text, int maxWidth, uint8_t textSize = 1, uint8_t maxLines = MAX_LINES);
+    void clear();
+
+    uint8_t getLineCount() const { return lineCount; }
+    bool isTruncated() const { return truncated; }
+    const Span& getLine(uint8_t index) const { return lines[index]; }
+    int getLineWidth(uint8_t index) const;
+    int getLineHeight() const { return 8 * textSize; }
+
+    // Draw lines [first, first + count) starting at (x, y), lineSpacing apart.
+    // Returns the y just below the last line drawn.
+    int drawLines(Adafruit_ST7789* display, uint8_t first, uint8_t count, int x, int y,
+                  int lineSpacing, uint16_t fg, uint16_t bg) const;
+    int drawLine(Adafruit_ST7789* display, uint8_t index, int x, int y, uint16_t fg, uint16_t bg) const;
+
+    // Single-line helpers: fit text (up to '\n') into maxWidth, with an
+    // ellipsis when it does not fit
+    static Span fitLine(const char* text, int maxWidth, uint8_t textSize = 1);
+    static int spanWidth(const Span& span, uint8_t textSize = 1);
+    static int drawSpan(Adafruit_ST7789* display, const char* text, const Span& span,
+                        int x, int y, uint8_t textSize, uint16_t fg, uint16_t bg);
+
+private:
+    const char* text = nullptr;
+    uint8_t textSize = 1;
+    uint8_t lineCount = 0;
+    bool truncated = false;
+    Span lines[MAX_LINES];
+
+    static int charsPerLine(int maxWidth, uint8_t textSize);
+    static void addEllipsis(const char* text, Span& span, int maxChars);
+};
+
+#endif // TEXT_LAYOUT_H
@@ -21,8 +21,14 @@ BeeperHeroScreen::BeeperHeroScreen(Adafruit_ST7789* display)
 void BeeperHeroScreen::enter() {
     GameScreen::enter();
     setTargetFPS(60);
-    player.begin(BUZZER_PIN);
     staticBackgroundCached = false;
+    if (isCovered()) {
+        // Back from a popup: the game and its song go on from where they were
+        player.resume();
+        return;
+    }
+    player.begin(BUZZER_PIN);
+    player.setChannel(ToneSequencer::CHANNEL_PREVIEW);     // Song select previews
     state = SONG_SELECT;
     selectedSongIndex = 0;
     buildSongSelectionMenu();
@@ -34,8 +40,11 @@ void BeeperHeroScreen::exit() {
     GameScreen::exit();
 }
 
+// Covered by a popup (a critical alert): pause the song and keep its
+// channel, so it picks up at the same note on the way back. Leaving stops it
 void BeeperHeroScreen::cleanup() {
-    player.stop();
+    if (isCovered()) player.pause();
+    else player.stop();
 }
 
 void BeeperHeroScreen::handleButtonPress(int button) {
@@ -53,12 +62,16 @@ void BeeperHeroScreen::handleButtonPress(int button) {
     if (state == GAME_OVER) {
         if (button == ButtonInput::BUTTON_B || button == ButtonInput::BUTTON_C || button == ButtonInput::BUTTON_A) {
             state = SONG_SELECT;
+            player.setChannel(ToneSequencer::CHANNEL_PREVIEW);
+            if (songMenu) songMenu->setVisible(true);
             markForFullRedraw();
         }
     }
 }
 
 void BeeperHeroScreen::updateGame() {
+    player.update();    // Keeps the tone queue topped up in every state
+
     if (state == SONG_SELECT) {
         if (pendingPreviewIndex >= 0 && millis() >= previewDueAtMs) {
             player.stop();
@@ -78,7 +91,8 @@ void BeeperHeroScreen::updateGame() {
     }
 
     if (state == PLAYING) {
-        player.update();
+        // An alert has the buzzer: the song is held, so the notes hold too
+        if (player.isHeld()) return;
         unsigned long t = player.getPlaybackTime();
         spawnDueNotes(t);
         updateNotes();
@@ -130,7 +144,7 @@ void BeeperHeroScreen::clearDirtyLanes() {
         int x1 = laneMaxX[lane];
         if (x0 > x1) continue;
         int w = x1 - x0;
-        display->fillRect(x0, y + 1, w, LANE_HEIGHT - 2, bg);
+        renderBatch.addRect(x0, y + 1, w, LANE_HEIGHT - 2, bg);
         lanesDirty[lane] = false;
         laneMinX[lane] = INT_MAX;
         laneMaxX[lane] = 0;
@@ -206,13 +220,13 @@ void BeeperHeroScreen::updateNotes() {
 }
 
 void BeeperHeroScreen::drawNotes() {
-    // Direct draw without relying on global batch flush
+    // Queued after the lane clears so notes land on top
     for (int i = 0; i < MAX_ACTIVE_NOTES; ++i) {
         if (!notes[i].active) continue;
         int x = notes[i].x - notes[i].width;
         int y = StandardGameLayout::PLAY_AREA_TOP + notes[i].lane * LANE_HEIGHT + 2;
         uint16_t color = ThemeManager::getPrimaryText();
-        display->fillRect(x, y, notes[i].width, LANE_HEIGHT - 4, color);
+        renderBatch.addRect(x, y, notes[i].width, LANE_HEIGHT - 4, color);
     }
 }
 
@@ -277,9 +291,13 @@ void BeeperHeroScreen::startCountdownForIndex(int index) {
         track.printTrackInfo();
     }
     player.stop();
+    player.setChannel(ToneSequencer::CHANNEL_GAME);
     player.playRingtoneByIndex(selectedSongIndex);
     countdownStartMs = millis();
     state = COUNTDOWN;
+    // Hidden while playing: a dirty menu nobody draws would keep the screen
+    // dirty and force a frame on every loop pass
+    if (songMenu) songMenu->setVisible(false);
     markForFullRedraw();
 }
 
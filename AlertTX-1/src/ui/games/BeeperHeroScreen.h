@@ -16,6 +16,9 @@ public:
     void exit() override;
     void handleButtonPress(int button) override;
 
+    // The game's song (previews in song select)
+    const RingtonePlayer& getPlayer() const { return player; }
+
 protected:
     void updateGame() override;
     void drawGame() override;
@@ -194,20 +194,20 @@ void PongScreen::drawObjects() {
     int playerX = courtLeft + 4;
     int aiX = courtRight - 4 - paddleWidth;
     // Always draw paddles at their current positions to ensure visibility
-    // Frame SPI transaction is handled by GameScreen::draw()
-    display->fillRect(playerX, paddlePlayerY, paddleWidth, paddleHeight, accent);
-    display->fillRect(aiX, paddleAiY, paddleWidth, paddleHeight, accent);
+    // Queued into the frame batch; GameScreen::draw() flushes it in one transaction
+    renderBatch.addRect(playerX, paddlePlayerY, paddleWidth, paddleHeight, accent);
+    renderBatch.addRect(aiX, paddleAiY, paddleWidth, paddleHeight, accent);
     // Ball
-    display->fillRect(ballX, ballY, ballSize, ballSize, ThemeManager::getPrimaryText());
+    renderBatch.addRect(ballX, ballY, ballSize, ballSize, ThemeManager::getPrimaryText());
 }
 
 void PongScreen::clearPrevious() {
     uint16_t bg = ThemeManager::getBackground();
     int playerX = courtLeft + 4;
     int aiX = courtRight - 4 - paddleWidth;
-    // Frame SPI transaction is handled by GameScreen::draw()
+    // Queued into the frame batch; GameScreen::draw() flushes it in one transaction
     // Clear previous ball
-    display->fillRect(prevBallX, prevBallY, ballSize, ballSize, bg);
+    renderBatch.addRect(prevBallX, prevBallY, ballSize, ballSize, bg);
     // Redraw center line if overwritten
     redrawCenterLineSegmentIn(prevBallX, prevBallY, ballSize, ballSize);
     // Clear only uncovered strips for paddles if they moved
@@ -215,24 +215,24 @@ void PongScreen::clearPrevious() {
     if (deltaPlayer != 0) {
         if (deltaPlayer > 0) {
             // Moved down: clear strip above new paddle top
-            display->fillRect(playerX, prevPaddlePlayerY, paddleWidth, deltaPlayer, bg);
+            renderBatch.addRect(playerX, prevPaddlePlayerY, paddleWidth, deltaPlayer, bg);
         } else {
             // Moved up: clear strip below new paddle bottom
             int clearY = paddlePlayerY + paddleHeight;
             int clearH = -deltaPlayer;
-            display->fillRect(playerX, clearY, paddleWidth, clearH, bg);
+            renderBatch.addRect(playerX, clearY, paddleWidth, clearH, bg);
         }
     }
     int deltaAi = paddleAiY - prevPaddleAiY;
     if (deltaAi != 0) {
         if (deltaAi > 0) {
             // Moved down
-            display->fillRect(aiX, prevPaddleAiY, paddleWidth, deltaAi, bg);
+            renderBatch.addRect(aiX, prevPaddleAiY, paddleWidth, deltaAi, bg);
         } else {
             // Moved up
             int clearY = paddleAiY + paddleHeight;
             int clearH = -deltaAi;
-            display->fillRect(aiX, clearY, paddleWidth, clearH, bg);
+            renderBatch.addRect(aiX, clearY, paddleWidth, clearH, bg);
         }
     }
     // End of incremental clears
@@ -246,7 +246,7 @@ void PongScreen::redrawCenterLineSegmentIn(int x0, int y0, int w, int h) {
     if (x0 <= centerX && centerX < x0 + w) {
         for (int y = courtTop; y < courtBottom; y += 6) {
             if (y + 3 >= y0 && y <= y0 + h) {
-                display->drawFastVLine(centerX, y, 3, ThemeManager::getSecondaryText());
+                renderBatch.addVLine(centerX, y, 3, ThemeManager::getSecondaryText());
             }
         }
     }
@@ -43,7 +43,7 @@ void SnakeScreen::drawGame() {
         int tailIdx = snakeLength;
         int x = StandardGameLayout::PLAY_AREA_LEFT + snakeX[tailIdx] * CELL_SIZE;
         int y = StandardGameLayout::PLAY_AREA_TOP + snakeY[tailIdx] * CELL_SIZE;
-        display->fillRect(x, y, CELL_SIZE - 1, CELL_SIZE - 1, bg);
+        renderBatch.addRect(x, y, CELL_SIZE - 1, CELL_SIZE - 1, bg);
     }
 }
 
@@ -112,7 +112,7 @@ void SnakeScreen::drawGrid() {
 void SnakeScreen::drawCell(int gx, int gy, uint16_t color) {
     int x = StandardGameLayout::PLAY_AREA_LEFT + gx * CELL_SIZE;
     int y = StandardGameLayout::PLAY_AREA_TOP + gy * CELL_SIZE;
-    display->fillRect(x, y, CELL_SIZE - 1, CELL_SIZE - 1, color);
+    renderBatch.addRect(x, y, CELL_SIZE - 1, CELL_SIZE - 1, color);
 }
 
 void SnakeScreen::stepOnce() {
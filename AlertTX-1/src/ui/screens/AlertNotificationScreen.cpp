@@ -64,6 +64,12 @@ void AlertNotificationScreen::update() {
             }
         }
     }
+    
+    // Storm summary changes are coalesced to one repaint per refresh interval
+    if (summaryPending && millis() - lastSummaryDraw >= SUMMARY_REFRESH_MS) {
+        summaryPending = false;
+        markDynamicContentDirty();
+    }
 }
 
 void AlertNotificationScreen::draw() {
@@ -101,6 +107,44 @@ void AlertNotificationScreen::setMessage(const char* msgTitle, const char* msgBo
     
     strncpy(timestamp, msgTimestamp ? msgTimestamp : "", sizeof(timestamp) - 1);
     timestamp[sizeof(timestamp) - 1] = '\0';
+    
+    fitMessage();
+    summaryMode = false;
+    summaryPending = false;
+    
+    // Already showing: repaint the text in place rather than the whole popup
+    if (isActive()) {
+        textDirty = true;
+        markDynamicContentDirty();
+    }
+}
+
+void AlertNotificationScreen::setSummary(uint32_t alertCount, uint32_t seconds, const char* latestTitle) {
+    snprintf(title, sizeof(title), "%lu new alerts in last %lus", (unsigned long)alertCount, (unsigned long)seconds);
+    if (latestTitle) snprintf(message, sizeof(message), "Latest: %s", latestTitle);
+    timestamp[0] = '\0';
+    fitMessage();
+    
+    // Keep the summary up while alerts keep coming
+    showTime = millis();
+    
+    bool switching = !summaryMode;
+    summaryMode = true;
+    if (!isActive()) return;   // Drawn in full on enter()
+    
+    textDirty = true;
+    if (switching) {
+        markDynamicContentDirty();
+    } else {
+        summaryPending = true;
+        FrameScheduler::wakeAt(lastSummaryDraw + SUMMARY_REFRESH_MS);
+    }
+}
+
+void AlertNotificationScreen::fitMessage() {
+    int contentWidth = POPUP_WIDTH - (PADDING * 2);
+    titleFit = TextLayout::fitLine(title, contentWidth);
+    messageFit = TextLayout::fitLine(message, contentWidth);
 }
 
 void AlertNotificationScreen::drawBackground() {
@@ -135,11 +179,17 @@ void AlertNotificationScreen::drawPopupWindow() {
                           BORDER_RADIUS - 1, accentColor);
 }
 
-void AlertNotificationScreen::drawHeader() {
+void AlertNotificationScreen::drawHeader(bool clear) {
     // Draw header with icon and "NEW ALERT" text
     int headerY = POPUP_Y + PADDING;
     uint16_t headerColor = ThemeManager::getAccent();
     
+    // Repaint in place: text is drawn transparent (countdown is redrawn after)
+    if (clear) {
+        display->fillRect(POPUP_X + PADDING, headerY, POPUP_WIDTH - (PADDING * 2), 16,
+                          ThemeManager::getSurfaceBackground());
+    }
+    
     // Draw alert icon (bell symbol using text)
     display->setTextSize(2);
     display->setTextColor(headerColor);
@@ -149,7 +199,7 @@ void AlertNotificationScreen::drawHeader() {
     // Draw "NEW ALERT" text
     display->setTextSize(2);
     display->setTextColor(headerColor);
-    const char* headerText = "NEW ALERT";
+    const char* headerText = summaryMode ? "ALERT STORM" : "NEW ALERT";
     int textWidth = strlen(headerText) * 12; // 6 pixels per char * 2 size
     int textX = POPUP_X + (POPUP_WIDTH - textWidth) / 2;
     display->setCursor(textX, headerY);
@@ -161,41 +211,25 @@ void AlertNotificationScreen::drawHeader() {
                           POPUP_WIDTH - (PADDING * 2), ThemeManager::getBorder());
 }
 
-void AlertNotificationScreen::drawMessage() {
-    // Draw title
+void AlertNotificationScreen::drawMessage(bool clear) {
+    // Title and preview were fitted in setMessage(); draw them opaque over
+    // the popup background
     int contentY = POPUP_Y + PADDING + 30;
-    display->setTextSize(1);
-    display->setTextColor(ThemeManager::getPrimaryText());
+    uint16_t bgColor = ThemeManager::getSurfaceBackground();
     
-    // Center and truncate title if needed
-    char truncatedTitle[25];
-    strncpy(truncatedTitle, title, sizeof(truncatedTitle) - 1);
-    truncatedTitle[sizeof(truncatedTitle) - 1] = '\0';
+    // Repaint in place: clear what the previous text covered
+    if (clear) {
+        display->fillRect(POPUP_X + PADDING, contentY, POPUP_WIDTH - (PADDING * 2), 23, bgColor);
+    }
     
-    int titleWidth = strlen(truncatedTitle) * 6;
-    int titleX = POPUP_X + (POPUP_WIDTH - titleWidth) / 2;
-    display->setCursor(titleX, contentY);
-    display->print(truncatedTitle);
+    // Centered title
+    int titleX = POPUP_X + (POPUP_WIDTH - TextLayout::spanWidth(titleFit)) / 2;
+    TextLayout::drawSpan(display, title, titleFit, titleX, contentY, 1, ThemeManager::getPrimaryText(), bgColor);
     
-    // Draw message preview (first line only)
+    // Message preview (first line only)
     contentY += 15;
-    display->setTextColor(ThemeManager::getSecondaryText());
-    
-    // Calculate how many characters fit in the popup width
-    int maxChars = (POPUP_WIDTH - (PADDING * 2)) / 6;
-    char truncatedMsg[30];
-    int copyLen = (maxChars < 29) ? maxChars : 29;
-    strncpy(truncatedMsg, message, copyLen);
-    truncatedMsg[copyLen] = '\0';
-    
-    // Add ellipsis if truncated
-    if (strlen(message) > maxChars) {
-        strcat(truncatedMsg, "...");
-    }
-    
-    int msgX = POPUP_X + PADDING;
-    display->setCursor(msgX, contentY);
-    display->print(truncatedMsg);
+    TextLayout::drawSpan(display, message, messageFit, POPUP_X + PADDING, contentY, 1,
+                         ThemeManager::getSecondaryText(), bgColor);
 }
 
 void AlertNotificationScreen::drawActions() {
@@ -304,9 +338,18 @@ void AlertNotificationScreen::drawStaticContent() {
     drawHeader();
     drawMessage();
     drawActions();
+    textDirty = false;
 }
 
 void AlertNotificationScreen::drawDynamicContent() {
+    // New alert or summary text on an open popup
+    if (textDirty) {
+        textDirty = false;
+        drawHeader(true);
+        drawMessage(true);
+        lastSummaryDraw = millis();
+    }
+    
     // Draw countdown if auto-dismiss is enabled
     if (shouldAutoDismiss) {
         drawCountdown();
@@ -5,6 +5,7 @@
 #include "../../config/DisplayConfig.h"
 #include "../core/DisplayUtils.h"
 #include "../core/ScreenManager.h"
+#include "../core/TextLayout.h"
 #include "AlertsScreen.h"
 
 /**
@@ -18,6 +19,9 @@
  * - Auto-dismiss after 10 seconds
  * - Centered popup design
  * - Quick actions (dismiss/view)
+ * - Storm summary mode (setSummary): one "N new alerts in last M s" popup,
+ *   refreshed in place at most every SUMMARY_REFRESH_MS, instead of one
+ *   popup per alert
  */
 
 class AlertNotificationScreen : public Screen {
@@ -27,6 +31,10 @@ private:
     char message[96];
     char timestamp[24];
     
+    // Title and preview fitted to the popup once, in setMessage()
+    TextLayout::Span titleFit;
+    TextLayout::Span messageFit;
+    
     // Timing
     unsigned long showTime = 0;
     static const unsigned long AUTO_DISMISS_TIME = 10000; // 10 seconds
@@ -48,6 +56,14 @@ private:
     // Countdown tracking
     unsigned long lastCountdownSecond = 0;
     
+    // Text changes on an open popup repaint header and message only (dynamic
+    // pass); storm summary refreshes are rate-limited on top of that
+    bool textDirty = false;
+    bool summaryMode = false;
+    bool summaryPending = false;
+    unsigned long lastSummaryDraw = 0;
+    static const unsigned long SUMMARY_REFRESH_MS = 250;
+    
 public:
     AlertNotificationScreen(Adafruit_ST7789* display);
     ~AlertNotificationScreen();
@@ -62,6 +78,10 @@ public:
     // Set the message to display
     void setMessage(const char* msgTitle, const char* msgBody, const char* msgTimestamp);
     
+    // Switch to (or refresh) the storm summary; also restarts auto-dismiss.
+    // A null latestTitle keeps the current "Latest:" line
+    void setSummary(uint32_t alertCount, uint32_t seconds, const char* latestTitle);
+    
     // Control auto-dismiss
     void setAutoDismiss(bool enabled) { shouldAutoDismiss = enabled; }
     
@@ -74,8 +94,9 @@ private:
     // Drawing helpers
     void drawBackground();
     void drawPopupWindow();
-    void drawHeader();
-    void drawMessage();
+    void drawHeader(bool clear = false);
+    void drawMessage(bool clear = false);
+    void fitMessage();
     void drawActions();
     void drawCountdown();
     
@@ -1,5 +1,6 @@
 #include "AlertsScreen.h"
 #include "../core/ScreenManager.h"
+#include "../core/OverdrawAnalyzer.h"
 #include "../../config/SettingsManager.h"
 
 AlertsScreen* AlertsScreen::instance = nullptr;
@@ -41,9 +42,15 @@ void AlertsScreen::exit() {
 
 void AlertsScreen::update() {
     Screen::update();
+    if (insertsPending && millis() - lastListDrawMs >= insertBatchMs) {
+        insertsPending = false;
+        invalidateList();
+    }
 }
 
 void AlertsScreen::draw() {
+    // A full redraw wipes the panel, so the list must be drawn from scratch
+    if (needsFullRedraw) listDrawn = false;
     // Base class handles drawing based on dirty regions
     Screen::draw();
 }
@@ -57,25 +64,52 @@ void AlertsScreen::drawList() {
     visibleRows = availableHeight / ROW_HEIGHT;
     if (visibleRows < 1) visibleRows = 1;
 
+    // Same rows on screen: only repaint the rows that were damaged
+    if (listDrawn && scrollOffset == drawnScrollOffset && messageCount == drawnMessageCount) {
+        int endIndex = min(messageCount, scrollOffset + visibleRows);
+        OverdrawAnalyzer::beginSite("alert rows");
+        for (int i = scrollOffset; i < endIndex; ++i) {
+            if (isRectDamaged(1, rowY(i), DISPLAY_WIDTH - 2, ROW_HEIGHT - 2)) {
+                drawRow(i, rowY(i));
+            }
+        }
+        OverdrawAnalyzer::endSite();
+        drawScrollIndicators(availableHeight);
+        return;
+    }
+
+    listDrawn = true;
+    drawnScrollOffset = scrollOffset;
+    drawnMessageCount = messageCount;
+    lastListDrawMs = millis();
+    insertsPending = false;   // Any batched inserts are on the panel now
+
     // Clear list area and draw a top separator to avoid artifacts under the title
+    OverdrawAnalyzer::beginSite("alert list clear");
     display->fillRect(0, LIST_START_Y, DISPLAY_WIDTH, availableHeight, ThemeManager::getSurfaceBackground());
+    OverdrawAnalyzer::endSite();
     DisplayUtils::drawSeparatorLine(display, LIST_START_Y - 1, ThemeManager::getBorder());
 
     if (messageCount == 0) {
         // Empty state placeholder (treated like a read message)
         const char* emptyMsg = "No new messages";
         int midY = LIST_START_Y + (availableHeight / 2) - 4;
-        DisplayUtils::centerTextWithColor(display, emptyMsg, 1, midY, ThemeManager::getSecondaryText());
+        DisplayUtils::centerTextWithColor(display, emptyMsg, 1, midY, ThemeManager::getSecondaryText(),
+                                          ThemeManager::getSurfaceBackground());
         return;
     }
 
     int endIndex = min(messageCount, scrollOffset + visibleRows);
-    int y = LIST_START_Y + 2;
+    OverdrawAnalyzer::beginSite("alert rows");
     for (int i = scrollOffset; i < endIndex; ++i) {
-        drawRow(i, y);
-        y += ROW_HEIGHT;
+        drawRow(i, rowY(i));
     }
+    OverdrawAnalyzer::endSite();
+
+    drawScrollIndicators(availableHeight);
+}
 
+void AlertsScreen::drawScrollIndicators(int availableHeight) {
     display->setTextSize(1);
     display->setTextColor(ThemeManager::getSecondaryText());
     if (scrollOffset > 0) {
@@ -96,25 +130,16 @@ void AlertsScreen::drawRow(int index, int y) {
     uint16_t fg = isSelected ? ThemeManager::getSelectedText() : ThemeManager::getPrimaryText();
     display->fillRect(1, y, DISPLAY_WIDTH - 2, ROW_HEIGHT - 2, bg);
 
-    display->setTextSize(1);
-    display->setTextColor(fg);
+    // Text is drawn opaque over the row color: one address window per string.
+    // Both lines were fitted to the row when the message arrived.
     int textX = ICON_PADDING_X + TEXT_PADDING_X; // no icon
     int textY = y + 6;
-    display->setCursor(textX, textY);
-    char titleBuf[22];
-    strncpy(titleBuf, msg.title, sizeof(titleBuf) - 1);
-    titleBuf[sizeof(titleBuf) - 1] = '\0';
-    display->print(titleBuf);
-    if (strlen(msg.timestamp) > 0) {
-        int tsWidth = DisplayUtils::getTextWidth(display, msg.timestamp, 1);
-        display->setCursor(DISPLAY_WIDTH - tsWidth - 6, textY);
-        display->print(msg.timestamp);
-    }
-    display->setCursor(textX, y + 16);
-    char bodyBuf[28];
-    strncpy(bodyBuf, msg.message, sizeof(bodyBuf) - 1);
-    bodyBuf[sizeof(bodyBuf) - 1] = '\0';
-    display->print(bodyBuf);
+    TextLayout::drawSpan(display, msg.title, msg.titleFit, textX, textY, 1, fg, bg);
+    if (msg.meta[0]) {
+        int metaWidth = DisplayUtils::getTextWidth(display, msg.meta, 1);
+        DisplayUtils::drawText(display, msg.meta, DISPLAY_WIDTH - metaWidth - 6, textY, 1, fg, bg);
+    }
+    TextLayout::drawSpan(display, msg.message, msg.bodyFit, textX, y + 16, 1, fg, bg);
 }
 
 void AlertsScreen::handleButtonPress(int button) {
@@ -139,28 +164,42 @@ void AlertsScreen::ensureSelectionVisible() {
     }
 }
 
-void AlertsScreen::moveUp() {
-    if (messageCount == 0) return;
+void AlertsScreen::invalidateRow(int index) {
+    if (index < scrollOffset || index >= scrollOffset + visibleRows) return;
+    invalidateRect(1, rowY(index), DISPLAY_WIDTH - 2, ROW_HEIGHT - 2);
+    markDynamicContentDirty();
+}
+
+void AlertsScreen::moveSelection(int newIndex, const char* direction) {
     int old = selectedIndex;
-    selectedIndex = (selectedIndex - 1 + messageCount) % messageCount;
+    selectedIndex = newIndex;
     ensureSelectionVisible();
-    markDynamicContentDirty();
-    Serial.printf("AlertsScreen: %d -> %d (up)\n", old, selectedIndex);
+    if (scrollOffset == drawnScrollOffset) {
+        invalidateRow(old);
+        invalidateRow(selectedIndex);
+    } else {
+        invalidateList();
+    }
+    Serial.printf("AlertsScreen: %d -> %d (%s)\n", old, selectedIndex, direction);
+}
+
+void AlertsScreen::moveUp() {
+    if (messageCount == 0) return;
+    moveSelection((selectedIndex - 1 + messageCount) % messageCount, "up");
 }
 
 void AlertsScreen::moveDown() {
     if (messageCount == 0) return;
-    int old = selectedIndex;
-    selectedIndex = (selectedIndex + 1) % messageCount;
-    ensureSelectionVisible();
-    markDynamicContentDirty();
-    Serial.printf("AlertsScreen: %d -> %d (down)\n", old, selectedIndex);
+    moveSelection((selectedIndex + 1) % messageCount, "down");
 }
 
 void AlertsScreen::openDetail() {
     if (selectedIndex < 0 || selectedIndex >= messageCount) return;
     // Mark as read
-    messages[selectedIndex].unread = false;
+    if (messages[selectedIndex].unread) {
+        messages[selectedIndex].unread = false;
+        persist(messages[selectedIndex]);
+    }
     // Lazily create detail screen
     if (!detailScreen) {
         detailScreen = new AlertDetailScreen(display, this);
@@ -175,10 +214,11 @@ void AlertsScreen::openDetail() {
 void AlertsScreen::toggleRead() {
     if (selectedIndex < 0 || selectedIndex >= messageCount) return;
     messages[selectedIndex].unread = !messages[selectedIndex].unread;
-    markDynamicContentDirty();
+    persist(messages[selectedIndex]);
+    invalidateRow(selectedIndex);
 }
 
-void AlertsScreen::addMessage(const char* title, const char* body, const char* timestamp, bool playTone) {
+uint32_t AlertsScreen::addMessage(const char* title, const char* body, const char* timestamp, bool playTone) {
     if (messageCount >= MAX_MESSAGES) {
         for (int i = MAX_MESSAGES - 1; i > 0; --i) {
             messages[i] = messages[i - 1];
@@ -197,11 +237,15 @@ void AlertsScreen::addMessage(const char* title, const char* body, const char* t
     m.message[sizeof(m.message) - 1] = '\0';
     strncpy(m.timestamp, timestamp ? timestamp : "", sizeof(m.timestamp) - 1);
     m.timestamp[sizeof(m.timestamp) - 1] = '\0';
+    m.id = ++newestId;
+    m.count = 1;
     m.unread = true;
+    fitRow(m);
 
     messageCount++;
     selectedIndex = 0;
     scrollOffset = 0;
+    persist(m);
 
     if (playTone) {
         int idx = SettingsManager::getRingtoneIndex();
@@ -209,5 +253,107 @@ void AlertsScreen::addMessage(const char* title, const char* body, const char* t
         ringtonePlayer.playRingtoneByIndex(idx);
     }
 
-    markDynamicContentDirty();
+    if (!isActive()) {
+        listDrawn = false;    // Redrawn in full on entry; no frame needed now
+    } else if (insertBatchMs > 0) {
+        deferListRedraw();
+    } else {
+        invalidateList();
+    }
+    return m.id;
+}
+
+bool AlertsScreen::mergeMessage(uint32_t id, const char* body, const char* timestamp) {
+    // Rows only ever shift down by one per new message, so the id gives the row
+    uint32_t index = newestId - id;
+    if (index >= (uint32_t)messageCount || messages[index].id != id) return false;
+
+    AlertMessage& m = messages[index];
+    if (m.count < 999) m.count++;
+    strncpy(m.message, body ? body : "", sizeof(m.message) - 1);
+    m.message[sizeof(m.message) - 1] = '\0';
+    strncpy(m.timestamp, timestamp ? timestamp : "", sizeof(m.timestamp) - 1);
+    m.timestamp[sizeof(m.timestamp) - 1] = '\0';
+    m.unread = true;
+    fitRow(m);
+    persist(m);
+
+    // A hidden list is redrawn in full on entry; no frame needed now
+    if (isActive()) {
+        if (insertBatchMs > 0) deferListRedraw();
+        else invalidateRow((int)index);
+    }
+    return true;
+}
+
+void AlertsScreen::setInsertBatching(unsigned long ms) {
+    insertBatchMs = ms;
+    // Leaving batch mode: show what is still held back
+    if (ms == 0 && insertsPending) {
+        insertsPending = false;
+        invalidateList();
+    }
+}
+
+void AlertsScreen::restoreFromLog() {
+    // Row i has id newest - i; stop at the first id the log no longer has
+    uint32_t newest = AlertLog::getNewestId();
+    AlertRecord record;
+    messageCount = 0;
+    while (messageCount < MAX_MESSAGES && (uint32_t)messageCount < newest &&
+           AlertLog::readLatest(newest - messageCount, record)) {
+        AlertMessage& m = messages[messageCount++];
+        memcpy(m.title, record.title, sizeof(m.title));
+        m.title[sizeof(m.title) - 1] = '\0';
+        memcpy(m.message, record.message, sizeof(m.message));
+        m.message[sizeof(m.message) - 1] = '\0';
+        memcpy(m.timestamp, record.timestamp, sizeof(m.timestamp));
+        m.timestamp[sizeof(m.timestamp) - 1] = '\0';
+        m.id = record.id;
+        m.count = record.count;
+        m.unread = (record.flags & AlertRecord::FLAG_UNREAD) != 0;
+        fitRow(m);
+    }
+    newestId = newest;
+    selectedIndex = 0;
+    scrollOffset = 0;
+    invalidateList();
+    Serial.printf("AlertsScreen: restored %d alerts from the log\n", messageCount);
+}
+
+// Snapshot of the row for the AlertLog; the newest snapshot of an id wins
+void AlertsScreen::persist(const AlertMessage& m) {
+    AlertRecord record;
+    memset(&record, 0, sizeof(record));
+    record.id = m.id;
+    record.count = m.count;
+    record.flags = m.unread ? AlertRecord::FLAG_UNREAD : 0;
+    memcpy(record.title, m.title, sizeof(record.title));
+    memcpy(record.message, m.message, sizeof(record.message));
+    memcpy(record.timestamp, m.timestamp, sizeof(record.timestamp));
+    AlertLog::append(record);
+}
+
+// Batched change: the whole list is repainted once the batch interval since
+// the last paint has passed (see update())
+void AlertsScreen::deferListRedraw() {
+    listDrawn = false;
+    insertsPending = true;
+    FrameScheduler::wakeAt(lastListDrawMs + insertBatchMs);
+}
+
+// Fit the row text now so drawRow() never measures: the title stops short
+// of the time/count, the body short of the scroll indicators
+void AlertsScreen::fitRow(AlertMessage& m) {
+    if (m.count > 1) {
+        snprintf(m.meta, sizeof(m.meta), m.timestamp[0] ? "%ux %s" : "%ux", (unsigned)m.count, m.timestamp);
+    } else {
+        strncpy(m.meta, m.timestamp, sizeof(m.meta) - 1);
+        m.meta[sizeof(m.meta) - 1] = '\0';
+    }
+    int textX = ICON_PADDING_X + TEXT_PADDING_X;
+    int metaWidth = GlyphCache::getTextWidth(m.meta, 1);
+    int titleRight = DISPLAY_WIDTH - 6 - (metaWidth > 0 ? metaWidth + 6 : 0);
+    m.titleFit = TextLayout::fitLine(m.title, titleRight - textX);
+    m.bodyFit = TextLayout::fitLine(m.message, DISPLAY_WIDTH - 12 - textX);
 }
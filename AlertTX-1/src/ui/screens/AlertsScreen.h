@@ -5,14 +5,22 @@
 #include "../../config/DisplayConfig.h"
 #include "../core/DisplayUtils.h"
 #include "../core/ScreenManager.h"
+#include "../core/TextLayout.h"
 #include "../../icons/mail_16.h"
 #include "../../icons/mail-unread_16.h"
 #include "../../ringtones/RingtonePlayer.h"
+#include "../../storage/AlertLog.h"
 
 /**
  * AlertsScreen
  * 
  * List view for incoming alerts (email/message style) with read/unread state.
+ * Repeats of an alert can be merged into its row (mergeMessage), which then
+ * shows an occurrence count next to the latest time. During an alert storm
+ * inserts can be batched (setInsertBatching) so a flood of alerts repaints
+ * the list a few times a second rather than once per alert. Every row change
+ * is appended to the AlertLog, and restoreFromLog() brings the newest rows
+ * back after a reboot or deep sleep.
  */
 
 class AlertsScreen : public Screen {
@@ -21,17 +29,35 @@ private:
         char title[64];
         char message[96];
         char timestamp[24];
+        char meta[32];        // Right-hand row text: "3x 10:02" or the timestamp
+        uint32_t id;          // Stable while the row is in the history
+        uint16_t count;       // Occurrences merged into this row
         bool unread;
+        // Row text fitted once in addMessage()/mergeMessage()
+        TextLayout::Span titleFit;
+        TextLayout::Span bodyFit;
     };
 
     static const int MAX_MESSAGES = 20;
     AlertMessage messages[MAX_MESSAGES];
     int messageCount = 0;
+    uint32_t newestId = 0;   // Id of messages[0]; row i has id newestId - i
 
     int selectedIndex = 0;
     int scrollOffset = 0;
     int visibleRows = 4;
 
+    // What is currently on the panel, so selection moves repaint two rows
+    bool listDrawn = false;
+    int drawnScrollOffset = 0;
+    int drawnMessageCount = 0;
+
+    // Insert batching (alert storms): new rows are painted at most once per
+    // insertBatchMs instead of once per addMessage()
+    unsigned long insertBatchMs = 0;
+    unsigned long lastListDrawMs = 0;
+    bool insertsPending = false;
+
     static const int ROW_HEIGHT = 28;
     static const int LIST_START_Y = MENU_START_Y; // Align with other screens
     static const int ICON_PADDING_X = 10;
@@ -54,7 +80,15 @@ public:
     
     void handleButtonPress(int button) override;
 
-    void addMessage(const char* title, const char* body, const char* timestamp, bool playTone = true);
+    // Returns the new row's id, for mergeMessage()
+    uint32_t addMessage(const char* title, const char* body, const char* timestamp, bool playTone = true);
+    // Fold a repeat into row `id` in place: count + 1, latest body and time,
+    // unread again. No tone, no reordering. False once the row has aged out.
+    bool mergeMessage(uint32_t id, const char* body, const char* timestamp);
+    // 0 = repaint on every insert (default); otherwise at most once per ms
+    void setInsertBatching(unsigned long ms);
+    // Reload the newest rows from the AlertLog (at boot)
+    void restoreFromLog();
 
     static AlertsScreen* getInstance();
 
@@ -64,8 +98,15 @@ private:
     void drawHeader();
     void drawList();
     void drawRow(int index, int y);
+    void drawScrollIndicators(int availableHeight);
+    void fitRow(AlertMessage& m);
+    void persist(const AlertMessage& m);
+    int rowY(int index) const { return LIST_START_Y + 2 + (index - scrollOffset) * ROW_HEIGHT; }
     void ensureSelectionVisible();
-    void invalidateList() { markDynamicContentDirty(); }
+    void invalidateList() { listDrawn = false; markDynamicContentDirty(); }
+    void invalidateRow(int index);
+    void deferListRedraw();
+    void moveSelection(int newIndex, const char* direction);
 
     void moveUp();
     void moveDown();
@@ -77,12 +118,25 @@ private:
     // Detail screen definition
     class AlertDetailScreen : public Screen {
     private:
+        static const int TEXT_X = 10;
+        static const int TEXT_WIDTH = DISPLAY_WIDTH - 2 * TEXT_X;
+        static const int BODY_Y = LIST_START_Y + 28;
+        static const int BODY_LINE_SPACING = 10;
+        static const int BODY_LINES = (DISPLAY_HEIGHT - 10 - BODY_Y) / BODY_LINE_SPACING + 1;
+
         AlertsScreen* parent;
         AlertMessage message;
+        TextLayout::Span titleFit;
+        TextLayout bodyLayout;
     public:
         AlertDetailScreen(Adafruit_ST7789* display, AlertsScreen* parentRef)
             : Screen(display, "AlertDetail", 100), parent(parentRef) {}
-        void setMessage(const AlertMessage& m) { message = m; }
+        void setMessage(const AlertMessage& m) {
+            message = m;
+            // Lay the text out once; draw() only paints the stored lines
+            titleFit = TextLayout::fitLine(message.title, TEXT_WIDTH);
+            bodyLayout.setText(message.message, TEXT_WIDTH, 1, BODY_LINES);
+        }
         void enter() override { Screen::enter(); }
         void exit() override { Screen::exit(); }
         void update() override { Screen::update(); }
@@ -91,54 +145,17 @@ private:
             // Title bar
             DisplayUtils::drawTitle(display, "Alert");
             // Body area
-            display->fillRect(0, LIST_START_Y, DISPLAY_WIDTH, DISPLAY_HEIGHT - LIST_START_Y, ThemeManager::getSurfaceBackground());
-            display->setTextColor(ThemeManager::getPrimaryText());
-            display->setTextSize(1);
-            int x = 10;
+            uint16_t bg = ThemeManager::getSurfaceBackground();
+            display->fillRect(0, LIST_START_Y, DISPLAY_WIDTH, DISPLAY_HEIGHT - LIST_START_Y, bg);
             int y = LIST_START_Y + 4;
             // Title
-            display->setCursor(x, y);
-            display->println(message.title);
-            y += 12;
-            // Timestamp (dim)
-            display->setTextColor(ThemeManager::getSecondaryText());
-            display->setCursor(x, y);
-            display->println(message.timestamp);
+            TextLayout::drawSpan(display, message.title, titleFit, TEXT_X, y, 1, ThemeManager::getPrimaryText(), bg);
             y += 12;
+            // Timestamp and repeat count (dim)
+            DisplayUtils::drawText(display, message.meta, TEXT_X, y, 1, ThemeManager::getSecondaryText(), bg);
             // Body
-            display->setTextColor(ThemeManager::getPrimaryText());
-            display->setCursor(x, y);
-            // Simple wrap: draw in chunks that fit width
-            int maxWidth = DISPLAY_WIDTH - 2 * x;
-            const char* p = message.message;
-            char line[48];
-            while (*p) {
-                int len = 0;
-                line[0] = '\0';
-                // accumulate until width would overflow or newline
-                while (p[len] && p[len] != '\n') {
-                    strncpy(line, p, len + 1);
-                    line[len + 1] = '\0';
-                    if (DisplayUtils::getTextWidth(display, line, 1) > maxWidth) {
-                        line[len] = '\0';
-                        break;
-                    }
-                    len++;
-                    if (len >= (int)sizeof(line) - 1) break;
-                }
-                if (len == 0) {
-                    // single word too long or newline
-                    display->println(" ");
-                    p += (p[0] == '\n') ? 1 : 0;
-                } else {
-                    display->println(line);
-                    p += len;
-                }
-                if (*p == '\n') { p++; }
-                y += 10;
-                if (y > DISPLAY_HEIGHT - 10) break;
-                display->setCursor(x, y);
-            }
+            bodyLayout.drawLines(display, 0, BODY_LINES, TEXT_X, BODY_Y, BODY_LINE_SPACING,
+                                 ThemeManager::getPrimaryText(), bg);
         }
         void handleButtonPress(int button) override {
             // Back is handled globally via long-press; short press C can also go back
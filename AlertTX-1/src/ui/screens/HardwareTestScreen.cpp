@@ -2,13 +2,17 @@
 #include "../../config/settings.h"
 #include "../core/ScreenManager.h"
 #include "../core/DisplayUtils.h"
+#include "../../ringtones/ToneSequencer.h"
 #include <Arduino.h>
 
-// Pin definitions for testing
-const int TEST_BUZZER_PIN_A4 = 14;  // A4 = GPIO14 (user's wiring)
-const int TEST_BUZZER_PIN_A3 = 15;  // A3 = GPIO15 (configured in settings.h)
+// Pin definitions for testing; the buzzer (A4/GPIO14) is BUZZER_PIN and is
+// driven through ToneSequencer
 const int TEST_LED_PIN_A0 = 18;     // A0 = GPIO18
 
+// Buzzer test sequence, one tone per step
+static const uint16_t BUZZER_TEST_TONES[] = {1000, 1500, 2000};
+static const int BUZZER_TEST_STEPS = sizeof(BUZZER_TEST_TONES) / sizeof(BUZZER_TEST_TONES[0]);
+
 // Static instance
 HardwareTestScreen* HardwareTestScreen::instance = nullptr;
 
@@ -56,8 +60,7 @@ void HardwareTestScreen::enter() {
 void HardwareTestScreen::exit() {
     // Make sure to stop any active tests
     if (buzzerTestActive) {
-        noTone(TEST_BUZZER_PIN_A4);
-        noTone(TEST_BUZZER_PIN_A3);
+        ToneSequencer::stopBeep();
     }
     if (ledTestActive && ledRef) {
         ledRef->off();
@@ -172,11 +175,8 @@ void HardwareTestScreen::onBuzzerTestSelected() {
         buzzerTestStartTime = millis();
         buzzerTestStep = 0;
         
-        // Setup pins for testing
-        pinMode(TEST_BUZZER_PIN_A4, OUTPUT);
-        pinMode(TEST_BUZZER_PIN_A3, OUTPUT);
-        
         Serial.println("Buzzer Test: Starting (Testing A4/GPIO14)");
+        playBuzzerTestTone();
         
         // Force redraw to show status
         markDynamicContentDirty();
@@ -214,67 +214,32 @@ void HardwareTestScreen::updateLEDTest() {
 void HardwareTestScreen::updateBuzzerTest() {
     if (!buzzerTestActive) return;
     
-    unsigned long elapsed = millis() - buzzerTestStartTime;
+    // Each step is a 200 ms tone and a 100 ms pause
+    if (millis() - buzzerTestStartTime < 300) return;
+    buzzerTestStep++;
+    buzzerTestStartTime = millis();
     
-    // Play different tones in sequence on A4 (user's pin)
-    switch (buzzerTestStep) {
-        case 0: // First tone
-            if (elapsed < 200) {
-                tone(TEST_BUZZER_PIN_A4, 1000); // 1kHz
-                if (elapsed == 0) Serial.println("Buzzer A4: 1000Hz");
-            } else {
-                noTone(TEST_BUZZER_PIN_A4);
-                buzzerTestStep++;
-                buzzerTestStartTime = millis();
-            }
-            break;
-            
-        case 1: // Pause
-            if (elapsed >= 100) {
-                buzzerTestStep++;
-                buzzerTestStartTime = millis();
-            }
-            break;
-            
-        case 2: // Second tone
-            if (elapsed < 200) {
-                tone(TEST_BUZZER_PIN_A4, 1500); // 1.5kHz
-                if (elapsed == 0) Serial.println("Buzzer A4: 1500Hz");
-            } else {
-                noTone(TEST_BUZZER_PIN_A4);
-                buzzerTestStep++;
-                buzzerTestStartTime = millis();
-            }
-            break;
-            
-        case 3: // Pause
-            if (elapsed >= 100) {
-                buzzerTestStep++;
-                buzzerTestStartTime = millis();
-            }
-            break;
-            
-        case 4: // Third tone
-            if (elapsed < 200) {
-                tone(TEST_BUZZER_PIN_A4, 2000); // 2kHz
-                if (elapsed == 0) Serial.println("Buzzer A4: 2000Hz");
-            } else {
-                noTone(TEST_BUZZER_PIN_A4);
-                buzzerTestStep++;
-                buzzerTestStartTime = millis();
-            }
-            break;
-            
-        case 5: // Final cleanup
-            if (elapsed >= 100) {
-                buzzerTestActive = false;
-                buzzerTestStep = 0;
-                Serial.println("Buzzer Test: Complete");
-                
-                // Force redraw to update status
-                markDynamicContentDirty();
-            }
-            break;
+    if (buzzerTestStep < BUZZER_TEST_STEPS) {
+        playBuzzerTestTone();
+    } else {
+        buzzerTestActive = false;
+        buzzerTestStep = 0;
+        Serial.println("Buzzer Test: Complete");
+        
+        // Force redraw to update status
+        markDynamicContentDirty();
+    }
+}
+
+// The tone goes out through the sequencer like any UI beep, so it never
+// talks over a ringtone and leaves the buzzer pin on LEDC
+void HardwareTestScreen::playBuzzerTestTone() {
+    uint16_t frequency = BUZZER_TEST_TONES[buzzerTestStep];
+    if (ToneSequencer::beep(frequency, 200)) {
+        Serial.printf("Buzzer A4: %uHz\n", (unsigned)frequency);
+    } else {
+        Serial.printf("Buzzer A4: %uHz skipped, %s has the buzzer\n", (unsigned)frequency,
+                      ToneSequencer::channelName(ToneSequencer::getActiveChannel()));
     }
 }
 
@@ -57,6 +57,7 @@ private:
     void setupMenu();
     void updateLEDTest();
     void updateBuzzerTest();
+    void playBuzzerTestTone();
     
     // Centralized rendering methods
     void drawStaticContent();
@@ -21,6 +21,10 @@ RingtonesScreen::~RingtonesScreen() {
 void RingtonesScreen::enter() {
     Screen::enter();
     DisplayUtils::debugScreenEnter("RINGTONES");
+    if (isCovered()) {
+        previewPlayer.resume();     // Back from a popup: the preview goes on
+        return;
+    }
     int saved = SettingsManager::getRingtoneIndex();
     if (saved >= 0 && saved < ringtonePlayer.getRingtoneCount()) {
         ringtoneMenu->setSelectedIndex(saved);
@@ -34,7 +38,8 @@ void RingtonesScreen::enter() {
 void RingtonesScreen::exit() {
     Screen::exit();
     DisplayUtils::debugScreenExit("RINGTONES");
-    ringtonePlayer.stop();
+    if (isCovered()) previewPlayer.pause();
+    else previewPlayer.stop();
 }
 
 void RingtonesScreen::update() {
@@ -90,8 +95,8 @@ void RingtonesScreen::previewIndex(int index) {
     if (index < 0 || index >= ringtonePlayer.getRingtoneCount()) return;
     if (lastPreviewIndex == index) return;
     // Stop any current preview, then play new
-    ringtonePlayer.stop();
-    ringtonePlayer.playRingtoneByIndex(index);
+    previewPlayer.stop();
+    previewPlayer.playRingtoneByIndex(index);
     lastPreviewIndex = index;
 }
 
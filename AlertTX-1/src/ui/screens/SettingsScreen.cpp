@@ -69,6 +69,7 @@ void SettingsScreen::enter() {
     if (flashlightOn) {
         statusLed.on();
         ringtonePlayer.setLedSyncEnabled(false);
+        previewPlayer.setLedSyncEnabled(false);
     }
 }
 
@@ -140,11 +141,13 @@ void SettingsScreen::onFlashlightSelected() {
         // Turn on flashlight and disable LED sync with ringtones
         statusLed.on();
         ringtonePlayer.setLedSyncEnabled(false);
+        previewPlayer.setLedSyncEnabled(false);
         Serial.println("Flashlight: ON (LED sync disabled)");
     } else {
         // Turn off flashlight and re-enable LED sync
         statusLed.off();
         ringtonePlayer.setLedSyncEnabled(true);
+        previewPlayer.setLedSyncEnabled(true);
         Serial.println("Flashlight: OFF (LED sync enabled)");
     }
     
@@ -225,7 +228,7 @@ void SettingsScreen::cycleRingtone() {
     const char* name = ringtonePlayer.getRingtoneName(currentRingtoneIndex);
     Serial.printf("Ringtone changed to: %s (%d/%d)\n", name ? name : "(unknown)", currentRingtoneIndex + 1, total);
     SettingsManager::setRingtoneIndex(currentRingtoneIndex);
-    ringtonePlayer.playRingtoneByIndex(currentRingtoneIndex);
+    previewPlayer.playRingtoneByIndex(currentRingtoneIndex);
 }
 
 void SettingsScreen::navigateToThemeSelection() {
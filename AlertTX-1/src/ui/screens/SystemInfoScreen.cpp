@@ -3,7 +3,7 @@
 
 SystemInfoScreen::SystemInfoScreen(Adafruit_ST7789* display)
      : Screen(display, "SystemInfo", 0), batteryPercent(0), batteryVoltage(0.0f), lastRenderMs(0), shouldRedraw(true),
-       lastConnected(false), lastCfgSsid(""), lastIp(""), lastBatteryPercent(-1), lastMetricsUpdateMs(0) {
+       lastConnected(false), lastCfgSsid(""), lastIp(""), lastRender(""), lastBatteryPercent(-1), lastMetricsUpdateMs(0) {
     
     // Set up draw regions for efficient rendering
     addDrawRegion(DirectDrawRegion::STATIC, [this, display]() { 
@@ -34,15 +34,18 @@ void SystemInfoScreen::update() {
     bool connected = (WiFi.status() == WL_CONNECTED);
     String cfgSsid = SettingsManager::getWifiSsid();
     String ip = connected ? WiFi.localIP().toString() : String("-");
+    String render = renderSummary();
 
         // Determine if anything changed
         if (connected != lastConnected ||
             cfgSsid != lastCfgSsid ||
             ip != lastIp ||
+            render != lastRender ||
             batteryPercent != lastBatteryPercent) {
             lastConnected = connected;
             lastCfgSsid = cfgSsid;
             lastIp = ip;
+            lastRender = render;
             lastBatteryPercent = batteryPercent;
             markDynamicContentDirty();
         }
@@ -66,7 +69,9 @@ void SystemInfoScreen::drawLabels() {
     display->setCursor(x, y);       display->print("Connected: ");
     y += line;
     display->setCursor(x, y);       display->print("IP: ");
-    y += line * 2;
+    y += line;
+    display->setCursor(x, y);       display->print("Slowest: ");
+    y += line;
     display->setCursor(x, y);       display->print("Battery: ");
 }
 
@@ -87,11 +92,23 @@ void SystemInfoScreen::drawValues() {
     display->setCursor(valueX, y);       display->print(lastConnected ? "Yes" : "No");
     y += line;
     display->setCursor(valueX, y);       display->print(lastIp);
-    y += line * 2;
+    y += line;
+    display->setCursor(valueX, y);       display->print(lastRender);
+    y += line;
     display->setCursor(valueX, y);       
     display->print(batteryPercent); display->print("% ("); display->print(batteryVoltage, 2); display->print(" V)");
 }
 
+String SystemInfoScreen::renderSummary() {
+    // Screen with the worst p95 draw time, e.g. "Alerts 4.2ms p95"
+    const RenderProfiler::ScreenStats* worst = RenderProfiler::getWorstScreen(95);
+    if (!worst) return String("-");
+    unsigned long us = RenderProfiler::getPercentileUs(*worst, 95);
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.10s %lu.%lums p95", worst->name, us / 1000, (us % 1000) / 100);
+    return String(buffer);
+}
+
 float SystemInfoScreen::readBatteryVoltage() {
 	// TODO: Replace with actual ADC read once power manager exists
 	// Placeholder returns nominal voltage if USB powered; otherwise a fixed value
@@ -3,6 +3,7 @@
 
 #include "../core/Screen.h"
 #include "../core/DisplayUtils.h"
+#include "../core/RenderProfiler.h"
 #include "../../config/SettingsManager.h"
 #include <WiFi.h>
 
@@ -13,6 +14,7 @@
  * - Configured WiFi SSID (from SettingsManager)
  * - Current connection status and active SSID/IP
  * - Battery percentage estimate
+ * - Slowest screen by p95 draw time (RenderProfiler)
  */
 class SystemInfoScreen : public Screen {
 public:
@@ -40,12 +42,14 @@ private:
     bool lastConnected;
     String lastCfgSsid;
     String lastIp;
+    String lastRender;
     int lastBatteryPercent;
     unsigned long lastMetricsUpdateMs;
 
  	void refreshMetrics();
 	void drawLabels();
 	void drawValues();
+	static String renderSummary();
  	static float readBatteryVoltage();
  	static int estimateBatteryPercent(float vbat);
 };
@@ -3,14 +3,13 @@
 RTTTL Data Generator for Alert TX-1
 
 This script scans the data/ringtones/ directory and generates a C++ header file
-containing all RTTTL ringtone data in multiple formats:
-- Binary RTTTL (compact)
-- Text RTTTL (for AnyRtttl nonblocking playback)
+containing all RTTTL ringtone data, parsed at build time:
+- Note events (pitch, duration ticks) played by RingtonePlayer
 - BeeperHero Track data (optimized binary for rhythm gameplay)
 
 Features:
-- Automatic caching: Only regenerates when RTTTL files change
-- Multiple formats: Flexible at runtime (audio + gameplay)
+- Automatic caching: Only regenerates when RTTTL files or the output format change
+- No RTTTL text on the device: nothing is parsed at runtime
 - Hash-based detection: Fast change detection
 
 Usage:
@@ -29,6 +28,12 @@ import json
 from pathlib import Path
 from datetime import datetime
 
+# Bump when the generated header changes shape, so cached output is rebuilt
+FORMAT_VERSION = '2.1'
+
+# Note events: 64 ticks = one whole note
+TICKS_PER_WHOLE = 64
+
 def sanitize_name(filename):
     """Convert filename to valid C++ identifier"""
     # Remove extension and replace non-alphanumeric chars with underscore
@@ -65,7 +70,7 @@ def load_cache(cache_file):
 def save_cache(cache_file, cache_data):
     """Save cache to file"""
     cache_data['timestamp'] = datetime.now().isoformat()
-    cache_data['version'] = '1.0'
+    cache_data['version'] = FORMAT_VERSION
     with open(cache_file, 'w') as f:
         json.dump(cache_data, f, indent=2)
 
@@ -107,6 +112,10 @@ def check_cache_validity(ringtone_dir, cache_data):
         changed_files.extend(deleted_files)
         print(f"  Detected deleted files: {', '.join(deleted_files)}")
     
+    if cache_data.get('version') != FORMAT_VERSION:
+        print(f"  Output format changed: {cache_data.get('version', 'none')} -> {FORMAT_VERSION}")
+        changed_files.append('(format)')
+
     # Cache is valid if no changes detected and we have files
     is_valid = len(changed_files) == 0 and len(current_hashes) > 0
     
@@ -119,157 +128,103 @@ def get_relative_path(file_path, base_path):
     except ValueError:
         return str(file_path)
 
-def parse_rtttl_to_binary(rtttl_text):
+def parse_rtttl_defaults(defaults):
+    """Default duration, octave and BPM from the RTTTL control section, in any order"""
+    values = {'d': 4, 'o': 6, 'b': 63}
+    for default in defaults.split(','):
+        key, _, value = default.strip().partition('=')
+        if key in values and value.strip().isdigit():
+            values[key] = int(value)
+    return values['d'], values['o'], max(1, values['b'])
+
+def parse_rtttl_to_events(rtttl_text):
     """
-    Parse RTTTL text and convert to binary format (10-bit)
-    Based on AnyRtttl library binary format specification
+    Parse RTTTL text into note events for RingtonePlayer.
+    Returns (events, whole_note_us, length_ms) or None on failure. Raises
+    ValueError for a note outside C3..B7 (the player's frequency table).
+
+    Each event is two bytes:
+      pitch: 0 = rest, 1..60 = C3..B7 (index into RingtonePlayer's frequency table)
+      ticks: duration, TICKS_PER_WHOLE per whole note (dotted notes included)
+    A note starts at cumulative_ticks * whole_note_us / TICKS_PER_WHOLE us, as
+    the player computes it, so rounding never adds up along the song.
     """
     if not rtttl_text or ':' not in rtttl_text:
         return None
-    
-    # Split into sections
+
     parts = rtttl_text.split(':', 2)
     if len(parts) < 3:
         return None
-    
-    name = parts[0]
-    defaults = parts[1]
-    notes = parts[2]
-    
-    # Parse defaults
-    default_duration = 4
-    default_octave = 5
-    default_bpm = 160
-    
-    for default in defaults.split(','):
-        if 'd=' in default:
-            default_duration = int(default.split('=')[1])
-        elif 'o=' in default:
-            default_octave = int(default.split('=')[1])
-        elif 'b=' in default:
-            default_bpm = int(default.split('=')[1])
-    
-    # Convert to binary format
-    binary_data = []
-    
-    # Header: song name (11 bytes) + default values (2 bytes)
-    # Song name (padded to 11 bytes)
-    name_bytes = name.encode('ascii')[:11].ljust(11, b'\0')
-    binary_data.extend(name_bytes)
-    
-    # Default values (duration, octave, BPM)
-    # Duration index: 1->0, 2->1, 4->2, 8->3, 16->4, 32->5
-    duration_map = {1: 0, 2: 1, 4: 2, 8: 3, 16: 4, 32: 5}
-    duration_idx = duration_map.get(default_duration, 2)
-    
-    # Octave index: 4->0, 5->1, 6->2, 7->3
-    octave_idx = max(0, min(3, default_octave - 4))
-    
-    # BPM index: map to predefined BPM values
-    bpm_values = [25, 28, 31, 35, 40, 45, 50, 56, 63, 70, 80, 90, 100, 112, 125, 140, 160, 180, 200, 225, 250, 285, 320, 355, 400, 450, 500, 565, 635, 715, 800, 900]
-    bpm_idx = 16  # Default to 160 BPM
-    for i, bpm in enumerate(bpm_values):
-        if bpm >= default_bpm:
-            bpm_idx = i
-            break
-    
-    # Pack default values into 2 bytes
-    default_byte1 = (duration_idx & 0x07) | ((octave_idx & 0x03) << 3)
-    default_byte2 = bpm_idx & 0x1F
-    binary_data.extend([default_byte1, default_byte2])
-    
-    # Parse notes
-    note_letters = {'c': 0, 'd': 1, 'e': 2, 'f': 3, 'g': 4, 'a': 5, 'b': 6, 'p': 7}
-    
-    for note in notes.split(','):
-        note = note.strip()
+
+    default_duration, default_octave, bpm = parse_rtttl_defaults(parts[1])
+    # 240 s / bpm, to the nearest us
+    whole_note_us = (240000000 + bpm // 2) // bpm
+
+    semitones = {'c': 1, 'd': 3, 'e': 5, 'f': 6, 'g': 8, 'a': 10, 'b': 12, 'p': 0}
+    events = []
+    total_ticks = 0
+
+    for raw in parts[2].split(','):
+        note = raw.strip().lower()
         if not note:
             continue
-        
-        # Parse note components
-        duration = default_duration
-        note_letter = 'p'
-        octave = default_octave
-        is_sharp = False
-        is_dotted = False
-        
-        # Extract duration
-        duration_match = re.match(r'(\d+)', note)
-        if duration_match:
-            duration = int(duration_match.group(1))
-            note = note[len(duration_match.group(1)):]
-        
-        # Extract note letter
-        if note and note[0].lower() in note_letters:
-            note_letter = note[0].lower()
+
+        m = re.match(r'^(\d+)', note)
+        duration = int(m.group(1)) if m else default_duration
+        note = note[m.end():] if m else note
+        # The dot may come after the duration, the note or the octave
+        dotted = note.startswith('.')
+        if dotted:
             note = note[1:]
-        
-        # Extract sharp
+
+        if not note or note[0] not in semitones:
+            print(f"  Warning: skipping note '{raw.strip()}'")
+            continue
+        pitch = semitones[note[0]]
+        note = note[1:]
+
         if note.startswith('#'):
-            is_sharp = True
+            pitch += 1
             note = note[1:]
-        
-        # Extract octave
-        octave_match = re.match(r'(\d+)', note)
-        if octave_match:
-            octave = int(octave_match.group(1))
-            note = note[len(octave_match.group(1)):]
-        
-        # Check for dotted
         if note.startswith('.'):
-            is_dotted = True
-        
-        # Pack note into 2 bytes (10-bit format)
-        duration_idx = duration_map.get(duration, 2)
-        note_idx = note_letters.get(note_letter, 7)
-        octave_idx = max(0, min(3, octave - 4))
-        
-        note_byte1 = (duration_idx & 0x07) | ((note_idx & 0x07) << 3) | (is_sharp << 6) | (is_dotted << 7)
-        note_byte2 = (octave_idx & 0x03)
-        
-        binary_data.extend([note_byte1, note_byte2])
-    
-    return binary_data
+            dotted = True
+            note = note[1:]
+        m = re.match(r'^(\d)', note)
+        octave = int(m.group(1)) if m else default_octave
+        note = note[m.end():] if m else note
+        dotted = dotted or note.startswith('.')
+
+        ticks = max(1, round(TICKS_PER_WHOLE / max(1, duration)))
+        if dotted:
+            ticks += ticks // 2
+        ticks = min(ticks, 255)
+
+        if pitch:
+            if not 3 <= octave <= 7:
+                raise ValueError(f"note '{raw.strip()}' is outside C3..B7")
+            pitch = (octave - 3) * 12 + pitch
+        events.extend([pitch, ticks])
+        total_ticks += ticks
+
+    if not events:
+        return None
+    return events, whole_note_us, total_ticks * whole_note_us // TICKS_PER_WHOLE // 1000
 
-def parse_rtttl_to_track(rtttl_text):
+def parse_rtttl_to_track(rtttl_text, parsed):
     """
-    Build BeeperHero track data (BPHR format) from an RTTTL string.
+    Build BeeperHero track data (BPHR format) from an RTTTL string and its
+    parsed note events. Note times are the player's: start and end are the
+    cumulative ticks at whole_note_us, in whole ms, so the lanes stay on the
+    beat of the audio.
     Returns a list of ints (bytes) or None on failure.
     """
-    if not rtttl_text or ':' not in rtttl_text:
+    if not parsed:
         return None
+    events, whole_note_us, length_ms = parsed
 
     parts = rtttl_text.split(':', 2)
-    if len(parts) < 3:
-        return None
-
     song_name = parts[0].strip()
-    defaults = parts[1]
-    notes_text = parts[2]
-
-    # Defaults
-    default_duration = 4
-    default_octave = 5
-    default_bpm = 160
-    for d in defaults.split(','):
-        d = d.strip()
-        if d.startswith('d='):
-            try:
-                default_duration = int(d.split('=')[1])
-            except Exception:
-                pass
-        elif d.startswith('o='):
-            try:
-                default_octave = int(d.split('=')[1])
-            except Exception:
-                pass
-        elif d.startswith('b='):
-            try:
-                default_bpm = int(d.split('=')[1])
-            except Exception:
-                pass
-
-    whole_note_ms = int(60000 * 4 / max(1, default_bpm))
+    default_bpm = parse_rtttl_defaults(parts[1])[2]
 
     def lane_from_octave(octave: int) -> int:
         if octave <= 4:
@@ -280,51 +235,17 @@ def parse_rtttl_to_track(rtttl_text):
             return 2
 
     parsed_notes = []  # (start_ms, duration_ms, lane, flags)
-    current_time = 0
-    for raw in notes_text.split(','):
-        note = raw.strip()
-        if not note:
-            continue
-
-        duration = default_duration
-        octave = default_octave
-        letter = 'p'
-        is_dotted = False
-
-        m = re.match(r'^(\d+)', note)
-        if m:
-            duration = int(m.group(1))
-            note = note[m.end():]
-
-        if note and note[0].lower() in 'cdefgabp':
-            letter = note[0].lower()
-            note = note[1:]
-
-        if note.startswith('#'):
-            # we ignore sharp for lane mapping
-            note = note[1:]
-
-        m = re.match(r'^(\d+)', note)
-        if m:
-            octave = int(m.group(1))
-            note = note[m.end():]
-
-        if note.startswith('.'):
-            is_dotted = True
-
-        base_div = max(1, duration)
-        dur_ms = int(whole_note_ms / base_div)
-        if is_dotted:
-            dur_ms = int(dur_ms * 1.5)
-
-        if letter == 'p':
-            current_time += dur_ms
+    ticks = 0
+    for i in range(0, len(events), 2):
+        pitch = events[i]
+        start_ms = ticks * whole_note_us // TICKS_PER_WHOLE // 1000
+        ticks += events[i + 1]
+        if pitch == 0:
             continue
-
-        lane = lane_from_octave(octave)
+        end_ms = ticks * whole_note_us // TICKS_PER_WHOLE // 1000
+        lane = lane_from_octave(3 + (pitch - 1) // 12)
         flags = 0
-        parsed_notes.append((current_time, dur_ms, lane, flags))
-        current_time += dur_ms
+        parsed_notes.append((start_ms, end_ms - start_ms, lane, flags))
 
     # Build header (BPHR)
     magic = b'BPHR'
@@ -334,7 +255,7 @@ def parse_rtttl_to_track(rtttl_text):
         song_name_bytes = song_name_bytes[:63]
     song_name_length = len(song_name_bytes)
     note_count = len(parsed_notes)
-    song_duration = current_time
+    song_duration = length_ms
     bpm = max(1, min(1000, default_bpm))
     reserved = 0
 
@@ -372,7 +293,7 @@ def parse_rtttl_to_track(rtttl_text):
     return blob
 
 def generate_header_file(ringtone_files):
-    """Generate the C++ header file with embedded RTTTL data"""
+    """Generate the C++ header file with embedded ringtone data"""
     
     header_content = f"""// Auto-generated by tools/generate_ringtone_data.py
 // Do not edit this file manually - it will be overwritten!
@@ -382,9 +303,12 @@ def generate_header_file(ringtone_files):
 
 #include <Arduino.h>
 
-// RTTTL ringtone data - embedded at compile time (multiple formats)
+// Ringtone data - parsed from RTTTL at build time
 // Generated from {len(ringtone_files)} files in data/ringtones/
-// Includes: Binary RTTTL, Text RTTTL, and BeeperHero Track data
+// Includes: note events (RingtonePlayer) and BeeperHero Track data
+//
+// Note events are (pitch, ticks) byte pairs: pitch 0 = rest, 1..60 = C3..B7;
+// {TICKS_PER_WHOLE} ticks = one whole note of whole_note_us
 
 """
     
@@ -392,32 +316,29 @@ def generate_header_file(ringtone_files):
     ringtone_names = []
     for filename, content, rtttl_name in ringtone_files:
         cpp_name = sanitize_name(filename)
-        ringtone_names.append((cpp_name, rtttl_name))
         
-        # Generate binary data
-        binary_data = parse_rtttl_to_binary(content)
-        # Text RTTTL
-        safe_text = content.replace('"', '\\"')
+        # Note events
+        try:
+            parsed = parse_rtttl_to_events(content)
+        except ValueError as e:
+            raise ValueError(f"{filename}: {e}")
+        events, whole_note_us, length_ms = parsed if parsed else ([], 0, 0)
         # BeeperHero Track
-        track_data = parse_rtttl_to_track(content)
+        track_data = parse_rtttl_to_track(content, parsed)
+        ringtone_names.append((cpp_name, rtttl_name, whole_note_us, length_ms))
         
         header_content += f"""// {rtttl_name} - from {filename}
 """
         
-        if binary_data:
-            # Convert binary data to C++ array
-            binary_array = ', '.join([f'0x{b:02X}' for b in binary_data])
-            header_content += f"""const unsigned char {cpp_name}_binary[] PROGMEM = {{{binary_array}}};
-const size_t {cpp_name}_binary_size = {len(binary_data)};
+        if events:
+            events_array = ', '.join([f'0x{b:02X}' for b in events])
+            header_content += f"""const uint8_t {cpp_name}_events[] PROGMEM = {{{events_array}}};
+const uint16_t {cpp_name}_event_count = {len(events) // 2};
 """
         else:
-            header_content += f"""// Binary conversion failed for {rtttl_name}
-const unsigned char* {cpp_name}_binary = nullptr;
-const size_t {cpp_name}_binary_size = 0;
-"""
-        
-        # Text RTTTL string
-        header_content += f"""const char {cpp_name}_text[] PROGMEM = "{safe_text}";
+            header_content += f"""// Parsing failed for {rtttl_name}
+const uint8_t* {cpp_name}_events = nullptr;
+const uint16_t {cpp_name}_event_count = 0;
 """
 
         # Track data
@@ -438,59 +359,37 @@ const size_t {cpp_name}_track_size = 0;
 // Ringtone registry - maps names to all formats
 struct RingtoneEntry {{
     const char* name;
-    const unsigned char* binary_data;
-    size_t binary_size;
-    const char* text_data;
+    const uint8_t* events;
+    uint16_t event_count;
+    uint32_t whole_note_us;
+    uint32_t length_ms;
     const uint8_t* track_data;
     size_t track_size;
     const char* filename;
 }};
 
+static const uint8_t RINGTONE_TICKS_PER_WHOLE = {TICKS_PER_WHOLE};
+
 static const RingtoneEntry RINGTONE_REGISTRY[] = {{
 """
     
-    for cpp_name, rtttl_name in ringtone_names:
-        header_content += f'    {{"{rtttl_name}", {cpp_name}_binary, {cpp_name}_binary_size, {cpp_name}_text, {cpp_name}_track, {cpp_name}_track_size, "{cpp_name}"}},\n'
+    for cpp_name, rtttl_name, whole_note_us, length_ms in ringtone_names:
+        header_content += f'    {{"{rtttl_name}", {cpp_name}_events, {cpp_name}_event_count, {whole_note_us}, {length_ms}, {cpp_name}_track, {cpp_name}_track_size, "{cpp_name}"}},\n'
     
-    header_content += f"""    {{nullptr, nullptr, 0, nullptr}}  // End marker
+    header_content += f"""    {{nullptr, nullptr, 0, 0, 0, nullptr, 0, nullptr}}  // End marker
 }};
 
 // Total number of ringtones
 static const int RINGTONE_COUNT = {len(ringtone_files)};
 
-// Helper functions - Binary RTTTL
-inline const unsigned char* getBinaryRTTTL(const char* name) {{
-    for (int i = 0; i < RINGTONE_COUNT; i++) {{
-        if (strcmp(RINGTONE_REGISTRY[i].name, name) == 0) {{
-            return RINGTONE_REGISTRY[i].binary_data;
-        }}
-    }}
-    return nullptr;
-}}
-
-inline const unsigned char* getBinaryRTTTL(int index) {{
+// Helper functions
+inline const RingtoneEntry* getRingtoneEntry(int index) {{
     if (index >= 0 && index < RINGTONE_COUNT) {{
-        return RINGTONE_REGISTRY[index].binary_data;
+        return &RINGTONE_REGISTRY[index];
     }}
     return nullptr;
 }}
 
-inline size_t getBinaryRTTTLSize(const char* name) {{
-    for (int i = 0; i < RINGTONE_COUNT; i++) {{
-        if (strcmp(RINGTONE_REGISTRY[i].name, name) == 0) {{
-            return RINGTONE_REGISTRY[i].binary_size;
-        }}
-    }}
-    return 0;
-}}
-
-inline size_t getBinaryRTTTLSize(int index) {{
-    if (index >= 0 && index < RINGTONE_COUNT) {{
-        return RINGTONE_REGISTRY[index].binary_size;
-    }}
-    return 0;
-}}
-
 inline const char* getRingtoneName(int index) {{
     if (index >= 0 && index < RINGTONE_COUNT) {{
         return RINGTONE_REGISTRY[index].name;
@@ -507,21 +406,12 @@ inline int findRingtoneIndex(const char* name) {{
     return -1;
 }}
 
-// Text RTTTL helpers
-inline const char* getTextRTTTL(int index) {{
+// Song length in ms, as RingtonePlayer plays it
+inline uint32_t getRingtoneLengthMs(int index) {{
     if (index >= 0 && index < RINGTONE_COUNT) {{
-        return RINGTONE_REGISTRY[index].text_data;
+        return RINGTONE_REGISTRY[index].length_ms;
     }}
-    return nullptr;
-}}
-
-inline const char* getTextRTTTL(const char* name) {{
-    for (int i = 0; i < RINGTONE_COUNT; i++) {{
-        if (strcmp(RINGTONE_REGISTRY[i].name, name) == 0) {{
-            return RINGTONE_REGISTRY[i].text_data;
-        }}
-    }}
-    return nullptr;
+    return 0;
 }}
 
 // BeeperHero Track helpers
@@ -621,7 +511,11 @@ def main():
     print(f"\nFound {len(ringtone_files)} ringtone files")
     
     # Generate header file
-    header_content = generate_header_file(ringtone_files)
+    try:
+        header_content = generate_header_file(ringtone_files)
+    except ValueError as e:
+        print(f"Error: {e}")
+        sys.exit(1)
     
     # Ensure output directory exists
     output_file.parent.mkdir(parents=True, exist_ok=True)
@@ -637,15 +531,14 @@ def main():
             print(f"  - {rtttl_name}")
         
         # Show memory savings
-        total_text_size = sum(len(content) for _, content, _ in ringtone_files)
-        total_binary_size = sum(len(parse_rtttl_to_binary(content) or []) for _, content, _ in ringtone_files)
-        savings = ((total_text_size - total_binary_size) / total_text_size) * 100 if total_text_size > 0 else 0
+        total_text_size = sum(len(content) + 1 for _, content, _ in ringtone_files)
+        total_event_size = sum(len((parse_rtttl_to_events(content) or ([],))[0]) for _, content, _ in ringtone_files)
+        savings = ((total_text_size - total_event_size) / total_text_size) * 100 if total_text_size > 0 else 0
         
         print(f"\n📊 Memory Analysis:")
-        print(f"  Text format: {total_text_size} bytes")
-        print(f"  Binary format: {total_binary_size} bytes")
+        print(f"  RTTTL text: {total_text_size} bytes (not embedded)")
+        print(f"  Note events: {total_event_size} bytes")
         print(f"  Memory savings: {savings:.1f}%")
-        print(f"  Using binary format only for maximum efficiency")
         
         # Update cache with relative paths
         cache_data['file_hashes'] = current_hashes
@@ -662,9 +555,8 @@ def main():
     print("\n✅ RTTTL data generation complete!")
     print("\nNext steps:")
     print("1. Include 'ringtone_data.h' in your RingtonePlayer class")
-    print("2. Use getTextRTTTL()/getBeeperHeroTrackData() as needed")
-    print("3. Binary format provides significant memory savings")
-    print("4. Script will automatically cache changes - re-run when adding new files")
+    print("2. Use getRingtoneEntry()/getBeeperHeroTrackData() as needed")
+    print("3. Script will automatically cache changes - re-run when adding new files")
 
 if __name__ == "__main__":
     main() 
\ No newline at end of file
@@ -31,7 +31,6 @@ def install_libraries():
         ("Adafruit GFX Library", "Adafruit GFX Library"),
         ("Adafruit ST7735 and ST7789 Library", "Adafruit ST7735 and ST7789 Library"),
         ("Adafruit BusIO", "Adafruit BusIO"),
-        ("AnyRtttl", "AnyRtttl"),
         ("PubSubClient", "PubSubClient"),
         ("ArduinoJson", "ArduinoJson")
     ]
@@ -68,7 +67,6 @@ def check_libraries():
             "adafruit gfx library",
             "adafruit st7735 and st7789 library",
             "adafruit busio",
-            "anyrtttl",
             "pubsubclient",
             "arduinojson"
         ]
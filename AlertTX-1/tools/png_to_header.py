@@ -1,16 +1,36 @@
 #!/usr/bin/env python3
 """
 PNG to Arduino Header Converter
-Converts PNG icons to Arduino-compatible header files with RGB565 format.
+Converts PNG icons to compact Arduino-compatible header files.
+
+Output formats (picked automatically per icon):
+- Tinted mask: every visible pixel has the same color (e.g. pixelarticons).
+  Stores 1/2/4-bpp coverage levels; the color comes from the theme at draw time.
+- Palette-indexed: up to 16 colors, index 0 is transparent.
+- RGB565: fallback for icons with more colors (or --rgb565).
+
+Indexed data is run-length encoded when that is smaller than plain packing.
 """
 
 import argparse
 import os
+import struct
 import sys
+import zlib
 from pathlib import Path
-from PIL import Image
 import re
 
+try:
+    from PIL import Image
+except ImportError:
+    Image = None
+
+# Must match Icon.h
+ICON_FORMAT_RGB565 = 0
+ICON_FORMAT_INDEXED = 1
+ICON_FLAG_RLE = 0x01
+ICON_FLAG_TINT = 0x02
+
 def rgb888_to_rgb565(r, g, b):
     """Convert RGB888 to RGB565 format."""
     r = (r >> 3) & 0x1F
@@ -20,88 +40,262 @@ def rgb888_to_rgb565(r, g, b):
 
 def parse_size_from_filename(filename):
     """Parse expected dimensions from filename.
-    
+
     Supports formats:
     - name_16.png -> (16, 16)
-    - name_32.png -> (32, 32) 
+    - name_32.png -> (32, 32)
     - name_240x135.png -> (240, 135)
     - name.png -> None (no size specified)
     """
     stem = Path(filename).stem
-    
+
     # Check for WxH format (e.g., splash_240x135)
     match = re.search(r'_(\d+)x(\d+)$', stem)
     if match:
         return int(match.group(1)), int(match.group(2))
-    
+
     # Check for square format (e.g., icon_32)
     match = re.search(r'_(\d+)$', stem)
     if match:
         size = int(match.group(1))
         return size, size
-    
+
     # No size specified
     return None
 
-def convert_png_to_header(png_path, output_dir, width=None, height=None):
+def read_png_rgba(png_path):
+    """Minimal PNG reader used when Pillow is not installed.
+
+    Handles non-interlaced 8-bit grayscale, RGB, palette, gray+alpha and RGBA
+    images, which covers everything in data/icons. Returns (width, height,
+    rows of (r, g, b, a) tuples).
+    """
+    data = Path(png_path).read_bytes()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError("not a PNG file")
+
+    pos = 8
+    idat = b''
+    palette = []
+    trns = b''
+    while pos < len(data):
+        length, = struct.unpack('>I', data[pos:pos + 4])
+        kind = data[pos + 4:pos + 8]
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE':
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b'tRNS':
+            trns = chunk
+        elif kind == b'IDAT':
+            idat += chunk
+        elif kind == b'IEND':
+            break
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color_type)
+    if depth != 8 or interlace != 0 or channels is None:
+        raise ValueError(f"unsupported PNG (depth {depth}, color type {color_type}, "
+                         f"interlace {interlace}); install Pillow to convert it")
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    prev = bytearray(stride)
+    rows = []
+    offset = 0
+    for _ in range(height):
+        filter_type = raw[offset]
+        line = bytearray(raw[offset + 1:offset + 1 + stride])
+        offset += 1 + stride
+        for i in range(stride):
+            left = line[i - channels] if i >= channels else 0
+            up = prev[i]
+            up_left = prev[i - channels] if i >= channels else 0
+            if filter_type == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif filter_type == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif filter_type == 3:
+                line[i] = (line[i] + (left + up) // 2) & 0xFF
+            elif filter_type == 4:
+                p = left + up - up_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+                pred = left if pa <= pb and pa <= pc else (up if pb <= pc else up_left)
+                line[i] = (line[i] + pred) & 0xFF
+        prev = line
+
+        pixels = []
+        for x in range(width):
+            px = line[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                pixels.append((px[0], px[0], px[0], 255))
+            elif color_type == 2:
+                pixels.append((px[0], px[1], px[2], 255))
+            elif color_type == 3:
+                r, g, b = palette[px[0]]
+                a = trns[px[0]] if px[0] < len(trns) else 255
+                pixels.append((r, g, b, a))
+            elif color_type == 4:
+                pixels.append((px[0], px[0], px[0], px[1]))
+            else:
+                pixels.append(tuple(px))
+        rows.append(pixels)
+
+    return width, height, rows
+
+def load_png_rgba(png_path, width=None, height=None):
+    """Load a PNG as RGBA rows, resizing with Pillow if requested."""
+    if Image is None:
+        if width or height:
+            raise ValueError("resizing requires Pillow (pip3 install -r tools/requirements.txt)")
+        return read_png_rgba(png_path)
+
+    img = Image.open(png_path)
+
+    # Convert to RGBA if not already
+    if img.mode != 'RGBA':
+        img = img.convert('RGBA')
+
+    # Resize if specified via command line args
+    if width and height:
+        img = img.resize((width, height), Image.Resampling.LANCZOS)
+    elif width:
+        # Maintain aspect ratio
+        ratio = width / img.width
+        height = int(img.height * ratio)
+        img = img.resize((width, height), Image.Resampling.LANCZOS)
+    elif height:
+        # Maintain aspect ratio
+        ratio = height / img.height
+        width = int(img.width * ratio)
+        img = img.resize((width, height), Image.Resampling.LANCZOS)
+
+    img_width, img_height = img.size
+    rows = [[img.getpixel((x, y)) for x in range(img_width)] for y in range(img_height)]
+    return img_width, img_height, rows
+
+def bpp_for_levels(levels):
+    """Smallest supported bit depth that can hold the given number of indices."""
+    for bpp in (1, 2, 4):
+        if levels <= (1 << bpp):
+            return bpp
+    return None
+
+def build_tinted(rows, bpp=None):
+    """Quantize alpha into coverage levels (0 = background, max = foreground).
+
+    Returns (bpp, indices) or None if the icon uses more than one color.
+    """
+    colors = {(r, g, b) for row in rows for (r, g, b, a) in row if a > 0}
+    if len(colors) > 1:
+        return None
+
+    alphas = {a for row in rows for (_, _, _, a) in row}
+    if bpp is None:
+        # Hard-edged art needs one bit; otherwise keep as many edge levels
+        # as the artwork has, up to 16
+        bpp = 1 if alphas <= {0, 255} else (2 if len(alphas) <= 4 else 4)
+
+    top = (1 << bpp) - 1
+    indices = []
+    for row in rows:
+        for (_, _, _, a) in row:
+            if bpp == 1:
+                # Same threshold the RGB565 path used for transparency
+                indices.append(1 if a >= 128 else 0)
+            else:
+                indices.append((a * top + 127) // 255)
+    return bpp, indices
+
+def build_palette(rows):
+    """Map pixels onto an RGB565 palette with index 0 reserved for transparency.
+
+    Returns (bpp, palette, indices) or None if more than 15 colors are used.
+    """
+    palette = [0x0000]
+    lookup = {}
+    indices = []
+    for row in rows:
+        for (r, g, b, a) in row:
+            if a < 128:
+                indices.append(0)
+                continue
+            color = rgb888_to_rgb565(r, g, b)
+            if color not in lookup:
+                lookup[color] = len(palette)
+                palette.append(color)
+            indices.append(lookup[color])
+
+    bpp = bpp_for_levels(len(palette))
+    if bpp is None:
+        return None
+    return bpp, palette, indices
+
+def pack_indices(indices, width, bpp):
+    """Pack indices MSB-first; every row starts on a byte boundary."""
+    per_byte = 8 // bpp
+    packed = []
+    for start in range(0, len(indices), width):
+        row = indices[start:start + width]
+        for i in range(0, width, per_byte):
+            byte = 0
+            for j, index in enumerate(row[i:i + per_byte]):
+                byte |= index << (8 - bpp * (j + 1))
+            packed.append(byte)
+    return packed
+
+def rle_indices(indices, bpp):
+    """Run-length encode the whole index stream.
+
+    Each byte is ((run - 1) << bpp) | index, so runs go up to 256 >> bpp.
+    Runs continue across row boundaries.
+    """
+    max_run = 256 >> bpp
+    encoded = []
+    i = 0
+    while i < len(indices):
+        index = indices[i]
+        run = 1
+        while i + run < len(indices) and indices[i + run] == index and run < max_run:
+            run += 1
+        encoded.append(((run - 1) << bpp) | index)
+        i += run
+    return encoded
+
+def format_array(values, hex_width, per_line):
+    """Format values as indented C initializer lines."""
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append("    " + ", ".join(f"0x{v:0{hex_width}X}" for v in chunk))
+    return ",\n".join(lines) + "\n"
+
+def convert_png_to_header(png_path, output_dir, width=None, height=None, bpp=None, force_rgb565=False):
     """Convert a PNG file to an Arduino header file."""
-    
-    # Load and process the image
+
     try:
-        img = Image.open(png_path)
-        
-        # Convert to RGBA if not already
-        if img.mode != 'RGBA':
-            img = img.convert('RGBA')
-        
+        # Load and process the image
+        img_width, img_height, rows = load_png_rgba(png_path, width, height)
+
         # Parse expected size from filename
         expected_size = parse_size_from_filename(png_path.name)
-        
-        # Resize if specified via command line args
-        if width and height:
-            img = img.resize((width, height), Image.Resampling.LANCZOS)
-        elif width:
-            # Maintain aspect ratio
-            ratio = width / img.width
-            height = int(img.height * ratio)
-            img = img.resize((width, height), Image.Resampling.LANCZOS)
-        elif height:
-            # Maintain aspect ratio
-            ratio = height / img.height
-            width = int(img.width * ratio)
-            img = img.resize((width, height), Image.Resampling.LANCZOS)
-        
-        img_width, img_height = img.size
-        
-        # Convert to RGB565
-        rgb565_data = []
-        for y in range(img_height):
-            for x in range(img_width):
-                r, g, b, a = img.getpixel((x, y))
-                
-                # Handle transparency - use black for transparent pixels
-                if a < 128:
-                    rgb565 = 0x0000  # Black for transparent
-                else:
-                    rgb565 = rgb888_to_rgb565(r, g, b)
-                
-                rgb565_data.append(rgb565)
-        
+
         # Generate header filename and C identifier
         icon_name = png_path.stem
-        
+
         # Remove size suffix from C identifier (but keep it in filename)
         c_icon_name = icon_name
         if expected_size:
             # Remove _WxH or _SIZE suffix for cleaner C identifiers
             c_icon_name = re.sub(r'_\d+x?\d*$', '', icon_name)
-        
+
         # Convert hyphens to underscores for C identifiers
         c_icon_name = c_icon_name.replace('-', '_')
-        
+
         header_filename = f"{icon_name}.h"
         header_path = output_dir / header_filename
-        
+
         # Validate image dimensions against filename
         if expected_size:
             expected_width, expected_height = expected_size
@@ -112,59 +306,105 @@ def convert_png_to_header(png_path, output_dir, width=None, height=None):
         else:
             # No size specified in filename - just inform about actual size
             print(f"ℹ️  {png_path.name}: {img_width}x{img_height} (no size validation - consider using name_WxH.png format)")
-        
+
+        # Pick the most compact encoding this icon allows
+        tinted = None if force_rgb565 else build_tinted(rows, bpp)
+        indexed = None if (force_rgb565 or tinted) else build_palette(rows)
+
+        rgb565_bytes = img_width * img_height * 2
+        upper = c_icon_name.upper()
+        arrays = ""
+
+        if tinted or indexed:
+            if tinted:
+                icon_bpp, indices = tinted
+                palette = None
+                flags = ["ICON_FLAG_TINT"]
+                format_desc = f"{icon_bpp}bpp coverage mask (tinted at draw time)"
+            else:
+                icon_bpp, palette, indices = indexed
+                flags = []
+                format_desc = f"{icon_bpp}bpp palette-indexed ({len(palette) - 1} colors, index 0 transparent)"
+
+            packed = pack_indices(indices, img_width, icon_bpp)
+            encoded = rle_indices(indices, icon_bpp)
+            if len(encoded) < len(packed):
+                pixel_bytes = encoded
+                flags.append("ICON_FLAG_RLE")
+                format_desc += ", RLE"
+            else:
+                pixel_bytes = packed
+
+            storage = len(pixel_bytes) + (len(palette) * 2 if palette else 0)
+            arrays += f"""// Pixel indices ({len(pixel_bytes)} bytes)
+const uint8_t {c_icon_name}_pixels[] PROGMEM = {{
+{format_array(pixel_bytes, 2, 12)}}};
+"""
+            palette_ref = "nullptr"
+            if palette:
+                arrays += f"""
+// RGB565 palette
+const uint16_t {c_icon_name}_palette[] PROGMEM = {{
+{format_array(palette, 4, 8)}}};
+"""
+                palette_ref = f"{c_icon_name}_palette"
+
+            initializer = (f"{{ 0, 0, {upper}_WIDTH, {upper}_HEIGHT, nullptr, ICON_FORMAT_INDEXED, "
+                           f"{icon_bpp}, {' | '.join(flags) if flags else '0'}, "
+                           f"{c_icon_name}_pixels, {palette_ref} }}")
+        else:
+            # Convert to RGB565
+            rgb565_data = []
+            for row in rows:
+                for (r, g, b, a) in row:
+                    # Handle transparency - use black for transparent pixels
+                    rgb565_data.append(0x0000 if a < 128 else rgb888_to_rgb565(r, g, b))
+
+            storage = rgb565_bytes
+            format_desc = "RGB565"
+            arrays += f"""// Icon data in RGB565 format ({len(rgb565_data)} pixels)
+const uint16_t {c_icon_name}_data[] PROGMEM = {{
+{format_array(rgb565_data, 4, 8)}}};
+"""
+            initializer = f"{{ 0, 0, {upper}_WIDTH, {upper}_HEIGHT, {c_icon_name}_data }}"
+
         # Generate the header content with size info
         size_info = f"Size: {img_width}x{img_height} pixels"
         if expected_size:
             size_info += f" (validated from filename)"
         else:
             size_info += f" (no filename validation)"
-            
-        header_content = f"""#ifndef {c_icon_name.upper()}_H
-#define {c_icon_name.upper()}_H
+
+        header_content = f"""#ifndef {upper}_H
+#define {upper}_H
 
 // AUTO-GENERATED FILE - DO NOT MODIFY
 // Generated from: {png_path.name}
 // {size_info}
-// Pixel format: RGB565
+// Pixel format: {format_desc}
+// Storage: {storage} bytes (RGB565 would be {rgb565_bytes} bytes)
 
 #include <Arduino.h>
 #include "Icon.h"
 
 // Icon dimensions
-#define {c_icon_name.upper()}_WIDTH {img_width}
-#define {c_icon_name.upper()}_HEIGHT {img_height}
+#define {upper}_WIDTH {img_width}
+#define {upper}_HEIGHT {img_height}
 
-// Icon data in RGB565 format ({len(rgb565_data)} pixels)
-const uint16_t {c_icon_name}_data[] PROGMEM = {{
-"""
-        
-        # Add the RGB565 data
-        for i, pixel in enumerate(rgb565_data):
-            if i % 8 == 0:
-                header_content += "    "
-            header_content += f"0x{pixel:04X}"
-            if i < len(rgb565_data) - 1:
-                header_content += ", "
-            if i % 8 == 7 or i == len(rgb565_data) - 1:
-                header_content += "\n"
-        
-        header_content += f"""}};
-
-// Icon struct instance
-extern const Icon {c_icon_name};
-extern const uint16_t* {c_icon_name}_data_ptr;
-
-#endif // {c_icon_name.upper()}_H
+{arrays}
+// Icon struct instance (const, so each including file gets its own copy)
+const Icon {c_icon_name} = {initializer};
+
+#endif // {upper}_H
 """
-        
+
         # Write the header file
         with open(header_path, 'w') as f:
             f.write(header_content)
-        
-        print(f"✅ Generated {header_path} ({img_width}x{img_height})")
+
+        print(f"✅ Generated {header_path} ({img_width}x{img_height}, {format_desc}, {storage} bytes)")
         return True
-        
+
     except Exception as e:
         print(f"❌ Error converting {png_path}: {e}")
         return False
@@ -175,42 +415,44 @@ def main():
     parser.add_argument('--output', '-o', help='Output directory for header files')
     parser.add_argument('--width', '-w', type=int, help='Resize width (maintains aspect ratio if height not specified)')
     parser.add_argument('--height', type=int, help='Resize height (maintains aspect ratio if width not specified)')
+    parser.add_argument('--bpp', type=int, choices=[1, 2, 4], help='Coverage bit depth for tinted icons (default: smallest that keeps the alpha levels, max 4)')
+    parser.add_argument('--rgb565', action='store_true', help='Always emit full RGB565 data (legacy format)')
     parser.add_argument('--recursive', '-r', action='store_true', help='Process subdirectories recursively')
-    
+
     args = parser.parse_args()
-    
+
     input_path = Path(args.input)
     output_dir = Path(args.output) if args.output else Path("src/icons")
-    
+
     # Create output directory if it doesn't exist
     output_dir.mkdir(parents=True, exist_ok=True)
-    
+
     if input_path.is_file():
         # Single file
         if input_path.suffix.lower() == '.png':
-            success = convert_png_to_header(input_path, output_dir, args.width, args.height)
+            success = convert_png_to_header(input_path, output_dir, args.width, args.height, args.bpp, args.rgb565)
             sys.exit(0 if success else 1)
         else:
             print(f"❌ {input_path} is not a PNG file")
             sys.exit(1)
-    
+
     elif input_path.is_dir():
         # Directory - find all PNG files
         pattern = "**/*.png" if args.recursive else "*.png"
-        png_files = list(input_path.glob(pattern))
-        
+        png_files = sorted(input_path.glob(pattern))
+
         if not png_files:
             print(f"❌ No PNG files found in {input_path}")
             sys.exit(1)
-        
+
         success_count = 0
         for png_file in png_files:
-            if convert_png_to_header(png_file, output_dir, args.width, args.height):
+            if convert_png_to_header(png_file, output_dir, args.width, args.height, args.bpp, args.rgb565):
                 success_count += 1
-        
+
         print(f"\n✅ Converted {success_count}/{len(png_files)} files successfully")
         sys.exit(0 if success_count == len(png_files) else 1)
-    
+
     else:
         print(f"❌ {input_path} does not exist")
         sys.exit(1)
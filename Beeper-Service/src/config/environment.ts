@@ -13,6 +13,10 @@ const EnvironmentSchema = z.object({
   MQTT_PASSWORD: z.string().optional(),
   MQTT_CLIENT_ID: z.string().default('beeper-service'),
   MQTT_TOPIC_PREFIX: z.string().default('alerts'),
+  // Compact frames; '' disables. The topic shares the device's 256-byte
+  // receive buffer with the frame, so a long prefix would leave no room
+  MQTT_BINARY_TOPIC_PREFIX: z.string().default('alerts-bin')
+    .refine(val => Buffer.byteLength(val, 'utf8') <= 64, 'must be at most 64 bytes'),
   MQTT_QOS: z.string().default('1').transform(Number).refine(val => [0, 1, 2].includes(val)),
   
   // Sentry configuration
@@ -0,0 +1,105 @@
+import type { MQTTMessage } from './mqtt.js';
+
+/**
+ * Compact binary alert frame for AlertTX-1 devices.
+ *
+ * Carries only the fields the device renders, so a typical alert fits in a
+ * few dozen bytes. PubSubClient on the device reads the whole PUBLISH,
+ * topic included, into a 256-byte buffer: the strings are cut further when
+ * the topic leaves less room than the 221 bytes of a worst-case frame.
+ * Decoded on the device by AlertWire (AlertTX-1/src/mqtt/AlertWire.h),
+ * which reads the strings in place; keep the two in sync.
+ *
+ * Layout (integers little-endian):
+ *   0  u8   magic 0xA7 (never the first byte of a JSON document)
+ *   1  u8   version (1)
+ *   2  u8   flags (reserved, 0)
+ *   3  u8   priority: 0 low, 1 medium, 2 high, 3 critical
+ *   4  u8   level: 0 debug, 1 info, 2 warning, 3 error, 4 fatal
+ *   5  u32  id (FNV-1a of the message id)
+ *   9  u32  timestamp (Unix seconds)
+ *   13 u32  URL hash (FNV-1a of the issue URL, 0 when there is none)
+ *   17 str  title, message, project, environment
+ *
+ * Each str is a u8 byte length, the UTF-8 bytes and a 0 terminator, so the
+ * device can use the text without copying it. New fields are appended
+ * after the last string; older decoders ignore trailing bytes. The version
+ * changes only when existing fields move or change meaning.
+ */
+
+export const ALERT_WIRE_MAGIC = 0xa7;
+export const ALERT_WIRE_VERSION = 1;
+
+// Byte limits match what the device stores (AlertsScreen: 64/96 incl. NUL)
+const TITLE_MAX = 63;
+const MESSAGE_MAX = 95;
+const PROJECT_MAX = 23;
+const ENVIRONMENT_MAX = 15;
+
+// PubSubClient's receive buffer holds up to 5 bytes of fixed header, the
+// 2-byte topic length, the topic and (QoS 1/2) the 2-byte packet id
+const DEVICE_BUFFER = 256;
+const PUBLISH_OVERHEAD = 5 + 2 + 2;
+const FIXED_SIZE = 17 + 4 * 2;   // Header, then a length byte and a NUL per string
+
+// Largest frame the device can receive whole on `topic`
+export function alertFrameBudget(topic: string): number {
+  return DEVICE_BUFFER - PUBLISH_OVERHEAD - Buffer.byteLength(topic, 'utf8');
+}
+
+const PRIORITIES: MQTTMessage['priority'][] = ['low', 'medium', 'high', 'critical'];
+const LEVELS = ['debug', 'info', 'warning', 'error', 'fatal'];
+
+export function fnv1a32(text: string): number {
+  let hash = 0x811c9dc5;
+  for (const byte of Buffer.from(text, 'utf8')) {
+    hash ^= byte;
+    hash = Math.imul(hash, 0x01000193) >>> 0;
+  }
+  return hash >>> 0;
+}
+
+// UTF-8 bytes of `text`, cut to `max` bytes without splitting a character
+function utf8Truncate(text: string, max: number): Buffer {
+  const bytes = Buffer.from(text, 'utf8');
+  if (bytes.length <= max) return bytes;
+  let end = max;
+  while (end > 0 && (bytes[end]! & 0xc0) === 0x80) end--;
+  return bytes.subarray(0, end);
+}
+
+export function encodeAlertFrame(message: MQTTMessage, topic: string): Buffer {
+  const texts = [message.data.title, message.data.message ?? '', message.data.project ?? '',
+    message.data.environment ?? ''];
+  const limits = [TITLE_MAX, MESSAGE_MAX, PROJECT_MAX, ENVIRONMENT_MAX];
+  const strings = texts.map((text, i) => utf8Truncate(text, limits[i]!));
+  // A long topic leaves less room: cut the message first, the title last
+  let over = FIXED_SIZE + strings.reduce((total, s) => total + s.length, 0) - alertFrameBudget(topic);
+  for (const i of [1, 3, 2, 0]) {
+    if (over <= 0) break;
+    const cut = utf8Truncate(texts[i]!, Math.max(0, strings[i]!.length - over));
+    over -= strings[i]!.length - cut.length;
+    strings[i] = cut;
+  }
+  const size = FIXED_SIZE + strings.reduce((total, s) => total + s.length, 0);
+  const frame = Buffer.alloc(size);
+
+  const level = LEVELS.indexOf(message.data.level);
+  const seconds = Math.floor(Date.parse(message.timestamp) / 1000);
+  frame.writeUInt8(ALERT_WIRE_MAGIC, 0);
+  frame.writeUInt8(ALERT_WIRE_VERSION, 1);
+  frame.writeUInt8(0, 2);
+  frame.writeUInt8(Math.max(0, PRIORITIES.indexOf(message.priority)), 3);
+  frame.writeUInt8(level < 0 ? LEVELS.indexOf('error') : level, 4);
+  frame.writeUInt32LE(fnv1a32(message.id), 5);
+  frame.writeUInt32LE(Number.isFinite(seconds) ? seconds >>> 0 : 0, 9);
+  frame.writeUInt32LE(message.data.url ? fnv1a32(message.data.url) : 0, 13);
+
+  let offset = 17;
+  for (const s of strings) {
+    frame.writeUInt8(s.length, offset++);
+    s.copy(frame, offset);
+    offset += s.length + 1;   // Buffer.alloc already zeroed the terminator
+  }
+  return frame;
+}
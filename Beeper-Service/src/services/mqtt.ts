@@ -1,6 +1,7 @@
 import mqtt, { MqttClient, IClientOptions, IClientPublishOptions } from 'mqtt';
 import { getConfig, type Config } from '../config/environment.js';
 import type { SentryWebhookPayload } from '../types/sentry.js';
+import { encodeAlertFrame } from './alertWire.js';
 
 export interface MQTTMessage {
   id: string;
@@ -28,9 +29,9 @@ export function createMQTTService() {
   const maxReconnectAttempts = 10;
   const reconnectDelay = 1000;
   let isConnected = false;
-  const messageQueue: Array<{ topic: string; message: string; options: IClientPublishOptions }> = [];
+  const messageQueue: Array<{ topic: string; message: string | Buffer; options: IClientPublishOptions }> = [];
 
-  function publishDirect(topic: string, message: string, options: IClientPublishOptions): void {
+  function publishDirect(topic: string, message: string | Buffer, options: IClientPublishOptions): void {
     if (!client || !isConnected) {
       throw new Error('MQTT client not connected');
     }
@@ -111,6 +112,11 @@ export function createMQTTService() {
       }
     }
 
+    // Fatal errors interrupt whatever the device is doing (games included)
+    if (level === 'fatal') {
+      priority = 'critical';
+    }
+
     // Ensure we have a title
     if (!title) {
       title = `Sentry ${payload.action || 'Alert'}`;
@@ -125,6 +131,12 @@ export function createMQTTService() {
     return `${config.MQTT_TOPIC_PREFIX}/${message.priority}`;
   }
 
+  // Parallel topic for the compact binary frame; empty prefix disables it
+  function buildBinaryTopic(message: MQTTMessage): string | null {
+    const prefix = config.MQTT_BINARY_TOPIC_PREFIX;
+    return prefix ? `${prefix}/${message.priority}` : null;
+  }
+
   async function connect(): Promise<void> {
     return new Promise((resolve, reject) => {
       const connectOptions: IClientOptions = {
@@ -189,11 +201,20 @@ export function createMQTTService() {
       type: message.type,
       size: messageJson.length 
     });
-    if (isConnected && client) {
-      publishDirect(topic, messageJson, publishOptions);
-    } else {
-      console.warn('MQTT client not connected, queueing message', { topic, messageId: message.id });
-      messageQueue.push({ topic, message: messageJson, options: publishOptions });
+    const outgoing: Array<{ topic: string; message: string | Buffer }> = [{ topic, message: messageJson }];
+    const binaryTopic = buildBinaryTopic(message);
+    if (binaryTopic) {
+      const frame = encodeAlertFrame(message, binaryTopic);
+      console.log('Publishing binary alert frame', { topic: binaryTopic, messageId: message.id, size: frame.length });
+      outgoing.push({ topic: binaryTopic, message: frame });
+    }
+    for (const { topic: outTopic, message: payload } of outgoing) {
+      if (isConnected && client) {
+        publishDirect(outTopic, payload, publishOptions);
+      } else {
+        console.warn('MQTT client not connected, queueing message', { topic: outTopic, messageId: message.id });
+        messageQueue.push({ topic: outTopic, message: payload, options: publishOptions });
+      }
     }
   }
 